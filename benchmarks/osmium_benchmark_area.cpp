@@ -0,0 +1,185 @@
+/*
+
+  The code in this file is released into the Public Domain.
+
+*/
+
+#include "phase_assembler.hpp"
+
+#include <osmium/area/assembler.hpp>
+#include <osmium/area/detail/segment_list.hpp>
+#include <osmium/area/multipolygon_manager.hpp>
+#include <osmium/builder/osm_object_builder.hpp>
+#include <osmium/handler/node_locations_for_ways.hpp>
+#include <osmium/index/map/flex_mem.hpp>
+#include <osmium/io/any_input.hpp>
+#include <osmium/memory/buffer.hpp>
+#include <osmium/relations/relations_manager.hpp>
+#include <osmium/visitor.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using index_type = osmium::index::map::FlexMem<osmium::unsigned_object_id_type, osmium::Location>;
+using location_handler_type = osmium::handler::NodeLocationsForWays<index_type>;
+
+/**
+ * Accumulated time (in microseconds) spent in the different phases of
+ * the area assembly.
+ */
+struct phase_timings {
+    int64_t segments = 0;
+    int64_t sort = 0;
+    int64_t duplicates = 0;
+    int64_t intersections = 0;
+    int64_t create_rings = 0;
+    int64_t output = 0;
+    int64_t total = 0;
+    uint64_t areas = 0;
+};
+
+static phase_timings timings;
+
+/**
+ * Assembler that runs the segment based phases of the assembly on its
+ * own segment list and the later phases in a PhaseAssembler to time them
+ * separately and then calls the normal assembler. Because all phases are
+ * run twice, this should only be used for profiling, not for measuring
+ * overall performance.
+ */
+class ProfilingAssembler : public osmium::area::Assembler {
+
+    template <typename TFunc>
+    void profile_segments(TFunc&& extract) {
+        osmium::area::detail::SegmentList segment_list{false};
+        uint64_t dummy1 = 0;
+        uint64_t dummy2 = 0;
+
+        auto start = clock_type::now();
+        extract(segment_list);
+        timings.segments += microseconds_since(start);
+
+        start = clock_type::now();
+        segment_list.sort();
+        timings.sort += microseconds_since(start);
+
+        start = clock_type::now();
+        segment_list.erase_duplicate_segments(nullptr, dummy1, dummy2);
+        timings.duplicates += microseconds_since(start);
+
+        start = clock_type::now();
+        segment_list.find_intersections(nullptr);
+        timings.intersections += microseconds_since(start);
+    }
+
+public:
+
+    explicit ProfilingAssembler(const config_type& config) :
+        osmium::area::Assembler(config) {
+    }
+
+    bool operator()(const osmium::Way& way, osmium::memory::Buffer& out_buffer) {
+        profile_segments([&way](osmium::area::detail::SegmentList& segment_list) {
+            uint64_t dummy = 0;
+            segment_list.extract_segments_from_way(nullptr, dummy, way);
+        });
+        PhaseAssembler{config(), timings.create_rings, timings.output}.profile(way);
+
+        const auto start = clock_type::now();
+        const bool result = osmium::area::Assembler::operator()(way, out_buffer);
+        timings.total += microseconds_since(start);
+        ++timings.areas;
+
+        return result;
+    }
+
+    bool operator()(const osmium::Relation& relation, const std::vector<const osmium::Way*>& members, osmium::memory::Buffer& out_buffer) {
+        profile_segments([&](osmium::area::detail::SegmentList& segment_list) {
+            uint64_t dummy1 = 0;
+            uint64_t dummy2 = 0;
+            segment_list.extract_segments_from_ways(nullptr, dummy1, dummy2, relation, members);
+        });
+        PhaseAssembler{config(), timings.create_rings, timings.output}.profile(relation, members);
+
+        const auto start = clock_type::now();
+        const bool result = osmium::area::Assembler::operator()(relation, members, out_buffer);
+        timings.total += microseconds_since(start);
+        ++timings.areas;
+
+        return result;
+    }
+
+}; // class ProfilingAssembler
+
+template <typename TAssembler>
+osmium::area::area_stats assemble(const osmium::io::File& input_file) {
+    const osmium::area::AssemblerConfig assembler_config;
+    osmium::area::MultipolygonManager<TAssembler> mp_manager{assembler_config};
+
+    auto start = clock_type::now();
+    osmium::relations::read_relations(input_file, mp_manager);
+    std::cout << "Pass 1 (relations): " << microseconds_since(start) << " us\n";
+
+    index_type index;
+    location_handler_type location_handler{index};
+    location_handler.ignore_errors();
+
+    uint64_t areas = 0;
+    start = clock_type::now();
+    osmium::io::Reader reader{input_file};
+    osmium::apply(reader, location_handler, mp_manager.handler([&areas](osmium::memory::Buffer&& buffer) {
+        areas += std::distance(buffer.select<osmium::Area>().begin(), buffer.select<osmium::Area>().end());
+    }));
+    reader.close();
+    std::cout << "Pass 2 (nodes, ways, assembly): " << microseconds_since(start) << " us\n";
+    std::cout << "Areas: " << areas << '\n';
+
+    return mp_manager.stats();
+}
+
+int main(int argc, char* argv[]) {
+    bool profile = false;
+    if (argc == 3 && !std::strcmp(argv[1], "-p")) {
+        profile = true;
+    } else if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " [-p] OSMFILE\n"
+                  << "  -p  profile the phases of the area assembly (slower)\n";
+        return 1;
+    }
+
+    try {
+        const osmium::io::File input_file{argv[argc - 1]};
+
+        const osmium::area::area_stats stats = profile ? assemble<ProfilingAssembler>(input_file)
+                                                       : assemble<osmium::area::Assembler>(input_file);
+
+        if (profile) {
+            // create_rings() also does the segment phases after collection.
+            const int64_t rings = timings.create_rings - timings.sort - timings.duplicates - timings.intersections;
+            std::cout << "Assembler calls: " << timings.areas << '\n'
+                      << "Phase times (us):\n"
+                      << "  segment collection:         " << timings.segments << '\n'
+                      << "  segment sorting:            " << timings.sort << '\n'
+                      << "  duplicate segments:         " << timings.duplicates << '\n'
+                      << "  intersection finding:       " << timings.intersections << '\n'
+                      << "  ring building and nesting:  " << rings << '\n'
+                      << "  output:                     " << timings.output << '\n'
+                      << "  total assembly:             " << timings.total << '\n';
+        }
+
+        std::cout << "Stats:" << stats << '\n';
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+
+    return 0;
+}
+
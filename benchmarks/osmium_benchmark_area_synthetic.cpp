@@ -0,0 +1,178 @@
+/*
+
+  The code in this file is released into the Public Domain.
+
+*/
+
+#include "phase_assembler.hpp"
+
+#include <osmium/area/assembler.hpp>
+#include <osmium/area/detail/segment_list.hpp>
+#include <osmium/builder/osm_object_builder.hpp>
+#include <osmium/memory/buffer.hpp>
+#include <osmium/osm/relation.hpp>
+#include <osmium/osm/way.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * Add a closed square way with the given number of nodes per side to the
+ * buffer. The lower left corner is at (x, y), the side length is size.
+ */
+static void add_square(osmium::memory::Buffer& buffer, osmium::object_id_type way_id, osmium::object_id_type& node_id, double x, double y, double size, int nodes_per_side) {
+    {
+        osmium::builder::WayBuilder builder{buffer};
+        builder.set_id(way_id);
+        osmium::builder::WayNodeListBuilder wnl_builder{builder};
+        const osmium::object_id_type first_id = node_id;
+        const double step = size / nodes_per_side;
+        for (int i = 0; i < nodes_per_side; ++i) {
+            wnl_builder.add_node_ref(node_id++, osmium::Location{x + i * step, y});
+        }
+        for (int i = 0; i < nodes_per_side; ++i) {
+            wnl_builder.add_node_ref(node_id++, osmium::Location{x + size, y + i * step});
+        }
+        for (int i = 0; i < nodes_per_side; ++i) {
+            wnl_builder.add_node_ref(node_id++, osmium::Location{x + size - i * step, y + size});
+        }
+        for (int i = 0; i < nodes_per_side; ++i) {
+            wnl_builder.add_node_ref(node_id++, osmium::Location{x, y + size - i * step});
+        }
+        wnl_builder.add_node_ref(first_id, osmium::Location{x, y});
+    }
+    buffer.commit();
+}
+
+/**
+ * Create a multipolygon relation made up of a grid of grid x grid
+ * squares, each with a hole in it. Returns the offset of the relation
+ * in the buffer. The member ways are added to the buffer before the
+ * relation and their pointers are appended to the ways vector.
+ */
+static std::size_t create_relation(osmium::memory::Buffer& buffer, std::vector<const osmium::Way*>& ways, int grid, int nodes_per_side) {
+    osmium::object_id_type way_id = 1;
+    osmium::object_id_type node_id = 1;
+    std::vector<std::size_t> offsets;
+
+    const double cell = 0.01;
+    for (int gx = 0; gx < grid; ++gx) {
+        for (int gy = 0; gy < grid; ++gy) {
+            const double x = gx * cell;
+            const double y = gy * cell;
+            offsets.push_back(buffer.committed());
+            add_square(buffer, way_id++, node_id, x, y, cell * 0.8, nodes_per_side);
+            offsets.push_back(buffer.committed());
+            add_square(buffer, way_id++, node_id, x + cell * 0.2, y + cell * 0.2, cell * 0.4, nodes_per_side);
+        }
+    }
+
+    const std::size_t relation_offset = buffer.committed();
+    {
+        osmium::builder::RelationBuilder builder{buffer};
+        builder.set_id(1);
+        {
+            osmium::builder::TagListBuilder tl_builder{builder};
+            tl_builder.add_tag("type", "multipolygon");
+            tl_builder.add_tag("landuse", "forest");
+        }
+        osmium::builder::RelationMemberListBuilder rml_builder{builder};
+        for (osmium::object_id_type id = 1; id < way_id; ++id) {
+            rml_builder.add_member(osmium::item_type::way, id, (id % 2) ? "outer" : "inner");
+        }
+    }
+    buffer.commit();
+
+    for (const auto offset : offsets) {
+        ways.push_back(&buffer.get<osmium::Way>(offset));
+    }
+
+    return relation_offset;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 4) {
+        std::cerr << "Usage: " << argv[0] << " GRID NODES_PER_SIDE ITERATIONS\n";
+        return 1;
+    }
+
+    try {
+        const int grid = std::atoi(argv[1]);
+        const int nodes_per_side = std::atoi(argv[2]);
+        const int iterations = std::atoi(argv[3]);
+        if (grid <= 0 || nodes_per_side <= 0 || iterations <= 0) {
+            std::cerr << "All arguments must be positive integers\n";
+            return 1;
+        }
+
+        osmium::memory::Buffer buffer{1024 * 1024, osmium::memory::Buffer::auto_grow::yes};
+        std::vector<const osmium::Way*> ways;
+        const std::size_t relation_offset = create_relation(buffer, ways, grid, nodes_per_side);
+        const auto& relation = buffer.get<osmium::Relation>(relation_offset);
+
+        int64_t segments = 0;
+        int64_t sort = 0;
+        int64_t duplicates = 0;
+        int64_t intersections = 0;
+        int64_t create_rings = 0;
+        int64_t output = 0;
+        int64_t total = 0;
+        osmium::area::area_stats stats;
+
+        const osmium::area::AssemblerConfig config;
+        for (int i = 0; i < iterations; ++i) {
+            osmium::area::detail::SegmentList segment_list{false};
+            uint64_t dummy1 = 0;
+            uint64_t dummy2 = 0;
+
+            auto start = clock_type::now();
+            segment_list.extract_segments_from_ways(nullptr, dummy1, dummy2, relation, ways);
+            segments += microseconds_since(start);
+
+            start = clock_type::now();
+            segment_list.sort();
+            sort += microseconds_since(start);
+
+            start = clock_type::now();
+            segment_list.erase_duplicate_segments(nullptr, dummy1, dummy2);
+            duplicates += microseconds_since(start);
+
+            start = clock_type::now();
+            segment_list.find_intersections(nullptr);
+            intersections += microseconds_since(start);
+
+            PhaseAssembler{config, create_rings, output, 1024 * 1024}.profile(relation, ways);
+
+            osmium::memory::Buffer out_buffer{1024 * 1024, osmium::memory::Buffer::auto_grow::yes};
+            osmium::area::Assembler assembler{config};
+            start = clock_type::now();
+            assembler(relation, ways, out_buffer);
+            total += microseconds_since(start);
+            stats += assembler.stats();
+        }
+
+        // create_rings() also does the segment phases after collection.
+        const int64_t rings = create_rings - sort - duplicates - intersections;
+        std::cout << "Member ways: " << ways.size() << '\n'
+                  << "Average phase times over " << iterations << " iterations (us):\n"
+                  << "  segment collection:         " << segments / iterations << '\n'
+                  << "  segment sorting:            " << sort / iterations << '\n'
+                  << "  duplicate segments:         " << duplicates / iterations << '\n'
+                  << "  intersection finding:       " << intersections / iterations << '\n'
+                  << "  ring building and nesting:  " << rings / iterations << '\n'
+                  << "  output:                     " << output / iterations << '\n'
+                  << "  total assembly:             " << total / iterations << '\n'
+                  << "Stats:" << stats << '\n';
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+
+    return 0;
+}
+
@@ -4,16 +4,33 @@
 
 */
 
+#include <osmium/geom/haversine.hpp>
 #include <osmium/geom/mercator_projection.hpp>
 #include <osmium/geom/wkb.hpp>
 #include <osmium/handler.hpp>
+#include <osmium/handler/node_locations_for_ways.hpp>
+#include <osmium/index/map/flex_mem.hpp>
 #include <osmium/io/any_input.hpp>
 #include <osmium/visitor.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <exception>
 #include <iostream>
 #include <string>
+#include <vector>
+
+using index_type = osmium::index::map::FlexMem<osmium::unsigned_object_id_type, osmium::Location>;
+using location_handler_type = osmium::handler::NodeLocationsForWays<index_type>;
+
+using clock_type = std::chrono::steady_clock;
+
+static int64_t microseconds_since(clock_type::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now() - start).count();
+}
 
 struct GeomHandler : public osmium::handler::Handler {
 
@@ -25,20 +42,143 @@ struct GeomHandler : public osmium::handler::Handler {
 
 };
 
+/**
+ * Compares projecting and measuring the node lists of ways one location
+ * at a time with the batch functions.
+ */
+class WayBenchmark {
+
+    std::vector<const osmium::WayNodeList*> m_node_lists;
+    std::vector<osmium::geom::Coordinates> m_coordinates;
+
+    int64_t m_time_project_single = 0;
+    int64_t m_time_project_batch = 0;
+    int64_t m_time_length_single = 0;
+    int64_t m_time_length_batch = 0;
+
+    uint64_t m_ways = 0;
+    uint64_t m_node_refs = 0;
+
+    // Results are summed up so that the compiler can not optimize
+    // the calculations away.
+    double m_sum_project_single = 0;
+    double m_sum_project_batch = 0;
+    double m_sum_length_single = 0;
+    double m_sum_length_batch = 0;
+
+    static bool all_locations_valid(const osmium::WayNodeList& wnl) noexcept {
+        return std::all_of(wnl.cbegin(), wnl.cend(), [](const osmium::NodeRef& nr) {
+            return nr.location().valid();
+        });
+    }
+
+public:
+
+    void operator()(const osmium::memory::Buffer& buffer) {
+        m_node_lists.clear();
+        for (const auto& way : buffer.select<osmium::Way>()) {
+            const auto& wnl = way.nodes();
+            if (wnl.size() > 1 && all_locations_valid(wnl)) {
+                m_node_lists.push_back(&wnl);
+                m_node_refs += wnl.size();
+                if (m_coordinates.size() < wnl.size()) {
+                    m_coordinates.resize(wnl.size());
+                }
+            }
+        }
+        m_ways += m_node_lists.size();
+
+        const osmium::geom::MercatorProjection projection;
+        auto start = clock_type::now();
+        for (const auto* wnl : m_node_lists) {
+            auto* out = m_coordinates.data();
+            for (const auto& nr : *wnl) {
+                *out++ = projection(nr.location());
+            }
+            m_sum_project_single += m_coordinates[wnl->size() - 1].y;
+        }
+        m_time_project_single += microseconds_since(start);
+
+        start = clock_type::now();
+        for (const auto* wnl : m_node_lists) {
+            osmium::geom::lonlat_to_mercator(*wnl, m_coordinates.data());
+            m_sum_project_batch += m_coordinates[wnl->size() - 1].y;
+        }
+        m_time_project_batch += microseconds_since(start);
+
+        start = clock_type::now();
+        for (const auto* wnl : m_node_lists) {
+            m_sum_length_single += osmium::geom::haversine::distance(*wnl);
+        }
+        m_time_length_single += microseconds_since(start);
+
+        start = clock_type::now();
+        for (const auto* wnl : m_node_lists) {
+            m_sum_length_batch += osmium::geom::haversine::fast_distance(*wnl);
+        }
+        m_time_length_batch += microseconds_since(start);
+    }
+
+    void print(std::ostream& out) const {
+        out << "Ways: " << m_ways << " with " << m_node_refs << " node refs\n"
+            << "Mercator projection (us):\n"
+            << "  single: " << m_time_project_single << " (checksum " << m_sum_project_single << ")\n"
+            << "  batch:  " << m_time_project_batch << " (checksum " << m_sum_project_batch << ")\n"
+            << "Haversine way length (us):\n"
+            << "  single: " << m_time_length_single << " (total " << m_sum_length_single << " m)\n"
+            << "  batch:  " << m_time_length_batch << " (total " << m_sum_length_batch << " m)\n";
+    }
+
+}; // class WayBenchmark
+
 int main(int argc, char* argv[]) {
-    if (argc != 2) {
-        std::cerr << "Usage: " << argv[0] << " OSMFILE\n";
+    bool compare_ways = false;
+    if (argc == 3 && !std::strcmp(argv[1], "-w")) {
+        compare_ways = true;
+    } else if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " [-w] OSMFILE\n"
+                  << "  -w  also compare single location and batch functions on ways (slower)\n";
         return 1;
     }
 
     try {
-        const std::string input_filename{argv[1]};
+        const std::string input_filename{argv[argc - 1]};
 
         osmium::io::Reader reader{input_filename};
 
         GeomHandler handler;
-        osmium::apply(reader, handler);
+
+        // Without -w only the node geometries are created, so results
+        // can be compared with earlier versions of this benchmark.
+        if (!compare_ways) {
+            osmium::apply(reader, handler);
+            reader.close();
+            return 0;
+        }
+
+        index_type index;
+        location_handler_type location_handler{index};
+        location_handler.ignore_errors();
+
+        WayBenchmark way_benchmark;
+        int64_t time_locations = 0;
+        int64_t time_points = 0;
+        while (osmium::memory::Buffer buffer = reader.read()) {
+            auto start = clock_type::now();
+            osmium::apply(buffer, location_handler);
+            time_locations += microseconds_since(start);
+
+            start = clock_type::now();
+            osmium::apply(buffer, handler);
+            time_points += microseconds_since(start);
+
+            way_benchmark(buffer);
+        }
         reader.close();
+
+        std::cout << "Node locations for ways (us): " << time_locations << '\n'
+                  << "Node geometries (us): " << time_points << '\n';
+        way_benchmark.print(std::cout);
     } catch (const std::exception& e) {
         std::cerr << e.what() << '\n';
         return 1;
@@ -46,4 +186,3 @@ int main(int argc, char* argv[]) {
 
     return 0;
 }
-
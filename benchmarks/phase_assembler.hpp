@@ -0,0 +1,105 @@
+#ifndef OSMIUM_BENCHMARK_PHASE_ASSEMBLER_HPP
+#define OSMIUM_BENCHMARK_PHASE_ASSEMBLER_HPP
+
+/*
+
+  The code in this file is released into the Public Domain.
+
+*/
+
+#include <osmium/area/assembler.hpp>
+#include <osmium/area/detail/segment_list.hpp>
+#include <osmium/builder/osm_object_builder.hpp>
+#include <osmium/memory/buffer.hpp>
+#include <osmium/osm/object.hpp>
+#include <osmium/osm/relation.hpp>
+#include <osmium/osm/way.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using clock_type = std::chrono::steady_clock;
+
+inline int64_t microseconds_since(clock_type::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now() - start).count();
+}
+
+/**
+ * Assembler running the steps after segment collection one by one
+ * through the protected interface of the assembler to time the ring
+ * building (including nesting) and the output separately. The times
+ * (in microseconds) are added to the variables given to the constructor.
+ *
+ * Ring building and nesting can not be timed separately: In the common
+ * case without touching rings the assembler decides whether a ring is an
+ * inner or outer ring as soon as it is closed while building the rings.
+ * Only the case with touching rings has a separate nesting step, but that
+ * is not accessible from outside the assembler. create_rings() also does
+ * the segment phases (sorting, duplicate removal, intersection finding),
+ * so time them separately and subtract them when reporting.
+ */
+class PhaseAssembler : public osmium::area::Assembler {
+
+    int64_t& m_create_rings_time;
+    int64_t& m_output_time;
+    std::size_t m_buffer_size;
+
+    template <typename TAddTags>
+    void rings_and_output(const osmium::OSMObject& object, TAddTags&& add_tags) {
+        auto start = clock_type::now();
+        const bool okay = create_rings();
+        m_create_rings_time += microseconds_since(start);
+        if (!okay) {
+            return;
+        }
+
+        osmium::memory::Buffer buffer{m_buffer_size, osmium::memory::Buffer::auto_grow::yes};
+        start = clock_type::now();
+        {
+            osmium::builder::AreaBuilder builder{buffer};
+            builder.initialize_from_object(object);
+            add_tags(builder);
+            add_rings_to_area(builder);
+        }
+        buffer.commit();
+        m_output_time += microseconds_since(start);
+    }
+
+public:
+
+    /**
+     * @param config Assembler configuration.
+     * @param create_rings_time Time for create_rings() is added here.
+     * @param output_time Time for building the area is added here.
+     * @param buffer_size Initial size of the output buffer. Make this
+     *        large enough for the areas, so that growing the buffer
+     *        doesn't show up in the output time.
+     */
+    PhaseAssembler(const config_type& config, int64_t& create_rings_time, int64_t& output_time, std::size_t buffer_size = 10240) :
+        osmium::area::Assembler(config),
+        m_create_rings_time(create_rings_time),
+        m_output_time(output_time),
+        m_buffer_size(buffer_size) {
+    }
+
+    void profile(const osmium::Way& way) {
+        segment_list().extract_segments_from_way(nullptr, stats().duplicate_nodes, way);
+        rings_and_output(way, [&way](osmium::builder::AreaBuilder& builder) {
+            builder.add_item(way.tags());
+        });
+    }
+
+    void profile(const osmium::Relation& relation, const std::vector<const osmium::Way*>& members) {
+        ++stats().from_relations;
+        set_num_members(members.size());
+        segment_list().extract_segments_from_ways(nullptr, stats().duplicate_nodes, stats().duplicate_ways, relation, members);
+        rings_and_output(relation, [&relation](osmium::builder::AreaBuilder& builder) {
+            copy_tags_without_type(builder, relation.tags());
+        });
+    }
+
+}; // class PhaseAssembler
+
+#endif // OSMIUM_BENCHMARK_PHASE_ASSEMBLER_HPP
@@ -0,0 +1,25 @@
+#!/bin/sh
+#
+#  run_benchmark_area_synthetic.sh
+#
+
+set -e
+
+BENCHMARK_NAME=area_synthetic
+
+. @CMAKE_BINARY_DIR@/benchmarks/setup.sh
+
+CMD=$OB_DIR/osmium_benchmark_$BENCHMARK_NAME
+
+# Number of times the relation is assembled in each run
+ITERATIONS=10
+
+echo "# grid nodes_per_side num mem time cpu_kernel cpu_user cpu_percent cmd options"
+for grid in 10 30 100; do
+    for nodes in 4 32; do
+        for n in $OB_SEQ; do
+            $OB_TIME_CMD -f "$grid $nodes $n $OB_TIME_FORMAT" $CMD $grid $nodes $ITERATIONS 2>&1 >/dev/null | sed -e "s%$OB_DIR/%%"
+        done
+    done
+done
+
@@ -211,6 +211,11 @@ namespace osmium {
                     m_debug = debug;
                 }
 
+                /// Remove all segments from the list.
+                void clear() noexcept {
+                    m_segments.clear();
+                }
+
                 /// Sort the list of segments.
                 void sort() {
                     std::sort(m_segments.begin(), m_segments.end());
@@ -231,6 +236,23 @@ namespace osmium {
                     return extract_segments_from_way_impl(problem_reporter, duplicate_nodes, way, role_type::outer);
                 }
 
+                /**
+                 * Add segments between consecutive node refs in the range
+                 * [begin, end) to the list. The segments will not have a
+                 * way set. Consecutive node refs must not have the same
+                 * location.
+                 */
+                template <typename TIter>
+                void add_segments(TIter begin, TIter end, role_type role) {
+                    if (begin == end) {
+                        return;
+                    }
+                    for (auto it = std::next(begin); it != end; ++it) {
+                        assert(std::prev(it)->location() != it->location());
+                        m_segments.emplace_back(*std::prev(it), *it, role, nullptr);
+                    }
+                }
+
                 /**
                  * Extract all segments from all ways that make up this
                  * multipolygon relation and add them to the list.
@@ -341,8 +363,8 @@ namespace osmium {
                                         std::cerr << "  segments " << s1 << " and " << s2 << " intersecting at " << intersection << "\n";
                                     }
                                     if (problem_reporter) {
-                                        problem_reporter->report_intersection(s1.way()->id(), s1.first().location(), s1.second().location(),
-                                                                              s2.way()->id(), s2.first().location(), s2.second().location(), intersection);
+                                        problem_reporter->report_intersection(s1.way() ? s1.way()->id() : 0, s1.first().location(), s1.second().location(),
+                                                                              s2.way() ? s2.way()->id() : 0, s2.first().location(), s2.second().location(), intersection);
                                     }
                                 }
                             }
@@ -98,6 +98,25 @@ namespace osmium {
                 m_filter(std::move(filter)) {
             }
 
+            /**
+             * Construct a MultipolygonManager storing the relations and
+             * their member ways in a stash with the specified storage type.
+             * Use osmium::ItemStash::storage_type::tmpfile for very large
+             * inputs if the data might not fit into memory.
+             *
+             * @param assembler_config The configuration that will be given to
+             *                         any newly constructed area assembler.
+             * @param filter A filter specifying what tags are needed on
+             *               closed ways or multipolygon relations to build
+             *               the area.
+             * @param storage Storage type for the relations and members.
+             */
+            MultipolygonManager(assembler_config_type assembler_config, osmium::TagsFilter filter, osmium::ItemStash::storage_type storage) :
+                osmium::relations::RelationsManager<MultipolygonManager<TAssembler>, false, true, false>(storage),
+                m_assembler_config(std::move(assembler_config)),
+                m_filter(std::move(filter)) {
+            }
+
             /**
              * Access the aggregated statistics generated by the assemblers
              * called from the manager.
@@ -0,0 +1,389 @@
+#ifndef OSMIUM_AREA_VALIDATOR_HPP
+#define OSMIUM_AREA_VALIDATOR_HPP
+
+/*
+
+This file is part of Osmium (https://osmcode.org/libosmium).
+
+Copyright 2013-2026 Jochen Topf <jochen@topf.org> and others (see README).
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include <osmium/area/detail/node_ref_segment.hpp>
+#include <osmium/area/detail/segment_list.hpp>
+#include <osmium/area/detail/vector.hpp>
+#include <osmium/area/problem_reporter.hpp>
+#include <osmium/builder/osm_object_builder.hpp>
+#include <osmium/memory/buffer.hpp>
+#include <osmium/osm/area.hpp>
+#include <osmium/osm/item_type.hpp>
+#include <osmium/osm/node_ref.hpp>
+#include <osmium/osm/node_ref_list.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace osmium {
+
+    namespace area {
+
+        /**
+         * The result of checking an area with the Validator.
+         */
+        struct validation_result {
+            uint32_t open_rings = 0; ///< Rings where first and last location differ
+            uint32_t short_rings = 0; ///< Rings with less than three different locations (after removing spikes)
+            uint32_t duplicate_nodes = 0; ///< Consecutive nodes with same location
+            uint32_t spikes = 0; ///< Ring going to a location and directly back
+            uint32_t wrong_direction = 0; ///< Outer rings not counter-clockwise or inner rings not clockwise
+            uint32_t degenerate_rings = 0; ///< Rings with all locations on one line
+            uint32_t duplicate_segments = 0; ///< Segments used more than once in the area (not counting spikes)
+            uint32_t intersections = 0; ///< Number of intersections between segments
+
+            /**
+             * Is the area valid? Duplicate nodes are allowed in a valid
+             * area.
+             */
+            bool valid() const noexcept {
+                return open_rings == 0 &&
+                       short_rings == 0 &&
+                       spikes == 0 &&
+                       wrong_direction == 0 &&
+                       degenerate_rings == 0 &&
+                       duplicate_segments == 0 &&
+                       intersections == 0;
+            }
+
+            /**
+             * Can the area be repaired with Validator::repair()?
+             */
+            bool repairable() const noexcept {
+                return open_rings == 0 &&
+                       duplicate_segments == 0 &&
+                       intersections == 0;
+            }
+
+        }; // struct validation_result
+
+        template <typename TChar, typename TTraits>
+        inline std::basic_ostream<TChar, TTraits>& operator<<(std::basic_ostream<TChar, TTraits>& out, const validation_result& r) {
+            return out << " open_rings=" << r.open_rings
+                       << " short_rings=" << r.short_rings
+                       << " duplicate_nodes=" << r.duplicate_nodes
+                       << " spikes=" << r.spikes
+                       << " wrong_direction=" << r.wrong_direction
+                       << " degenerate_rings=" << r.degenerate_rings
+                       << " duplicate_segments=" << r.duplicate_segments
+                       << " intersections=" << r.intersections;
+        }
+
+        /**
+         * Checks areas for validity and repairs simple problems without
+         * converting them to some other geometry library.
+         *
+         * The check looks at the rings of the area as they are, it does
+         * not check whether inner rings are inside their outer ring. Rings
+         * touching in a node are allowed.
+         *
+         * A Validator keeps some internal buffers between calls, so it is
+         * most efficient to use the same object for checking many areas.
+         * It is not thread-safe.
+         */
+        class Validator {
+
+            struct ring_info {
+                std::size_t begin;
+                std::size_t end;
+                bool outer;
+                bool reverse;
+                bool degenerate = false;
+
+                ring_info(std::size_t b, std::size_t e, bool o, bool r) noexcept :
+                    begin(b),
+                    end(e),
+                    outer(o),
+                    reverse(r) {
+                }
+
+                std::size_t size() const noexcept {
+                    return end - begin;
+                }
+
+                bool keep() const noexcept {
+                    return !degenerate && size() >= 4;
+                }
+
+            }; // struct ring_info
+
+            detail::SegmentList m_segment_list{false};
+            std::vector<osmium::NodeRef> m_nodes;
+            std::vector<ring_info> m_rings;
+            ProblemReporter* m_problem_reporter;
+
+            /**
+             * Copy the ring to m_nodes removing duplicate nodes and spikes
+             * on the way.
+             */
+            void clean_ring(const osmium::NodeRefList& ring, validation_result& result) {
+                const std::size_t begin = m_nodes.size();
+                for (const osmium::NodeRef& nr : ring) {
+                    const std::size_t size = m_nodes.size() - begin;
+                    if (size > 0 && m_nodes.back().location() == nr.location()) {
+                        ++result.duplicate_nodes;
+                        if (m_problem_reporter) {
+                            m_problem_reporter->report_duplicate_node(m_nodes.back().ref(), nr.ref(), nr.location());
+                        }
+                    } else if (size > 1 && m_nodes[m_nodes.size() - 2].location() == nr.location()) {
+                        ++result.spikes;
+                        if (m_problem_reporter) {
+                            m_problem_reporter->report_duplicate_segment(m_nodes.back(), nr);
+                        }
+                        m_nodes.pop_back();
+                    } else {
+                        m_nodes.push_back(nr);
+                    }
+                }
+
+                // Spikes where the ring starts and ends.
+                while (m_nodes.size() - begin >= 4 &&
+                       m_nodes[begin].location() == m_nodes.back().location() &&
+                       m_nodes[begin + 1].location() == m_nodes[m_nodes.size() - 2].location()) {
+                    ++result.spikes;
+                    if (m_problem_reporter) {
+                        m_problem_reporter->report_duplicate_segment(m_nodes[begin], m_nodes[begin + 1]);
+                    }
+                    m_nodes.pop_back();
+                    m_nodes.erase(m_nodes.begin() + static_cast<std::ptrdiff_t>(begin));
+                }
+            }
+
+            /**
+             * Calculate twice the signed area of the ring. Positive for
+             * counter-clockwise rings.
+             */
+            int64_t ring_sum(const ring_info& ring) const noexcept {
+                const detail::vec origin{m_nodes[ring.begin]};
+                int64_t sum = 0;
+                for (std::size_t i = ring.begin + 1; i < ring.end - 1; ++i) {
+                    sum += (detail::vec{m_nodes[i]} - origin) * (detail::vec{m_nodes[i + 1]} - origin);
+                }
+                return sum;
+            }
+
+            /**
+             * Are all locations of the ring on one line? The second node
+             * is always at a different location than the first, because
+             * duplicate nodes have been removed.
+             */
+            bool on_one_line(const ring_info& ring) const noexcept {
+                const detail::vec origin{m_nodes[ring.begin]};
+                const detail::vec direction{detail::vec{m_nodes[ring.begin + 1]} - origin};
+                for (std::size_t i = ring.begin + 2; i < ring.end - 1; ++i) {
+                    if ((detail::vec{m_nodes[i]} - origin) * direction != 0) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            void add_ring(const osmium::NodeRefList& ring, bool outer, validation_result& result) {
+                const std::size_t begin = m_nodes.size();
+                clean_ring(ring, result);
+
+                const std::size_t size = m_nodes.size() - begin;
+                if (size > 0 && m_nodes[begin].location() != m_nodes.back().location()) {
+                    ++result.open_rings;
+                    if (m_problem_reporter) {
+                        m_problem_reporter->report_ring_not_closed(m_nodes.back(), nullptr);
+                    }
+                    m_rings.emplace_back(begin, m_nodes.size(), outer, false);
+                    return;
+                }
+
+                if (size < 4) {
+                    ++result.short_rings;
+                    m_rings.emplace_back(begin, m_nodes.size(), outer, false);
+                    return;
+                }
+
+                m_rings.emplace_back(begin, m_nodes.size(), outer, false);
+                const int64_t sum = ring_sum(m_rings.back());
+
+                // A ring with all nodes on one line has no area and no
+                // direction and its segments overlap each other, so it is
+                // not added to the segment list and will be dropped when
+                // repairing. Other rings with a zero sum intersect
+                // themselves, that is found when checking the segments.
+                if (sum == 0 && on_one_line(m_rings.back())) {
+                    ++result.degenerate_rings;
+                    m_rings.back().degenerate = true;
+                    return;
+                }
+
+                if (outer ? sum < 0 : sum > 0) {
+                    ++result.wrong_direction;
+                    m_rings.back().reverse = true;
+                }
+
+                m_segment_list.add_segments(m_nodes.cbegin() + static_cast<std::ptrdiff_t>(begin),
+                                            m_nodes.cend(),
+                                            outer ? detail::role_type::outer : detail::role_type::inner);
+            }
+
+            validation_result check_impl(const osmium::Area& area) {
+                m_segment_list.clear();
+                m_nodes.clear();
+                m_rings.clear();
+
+                if (m_problem_reporter) {
+                    m_problem_reporter->set_object(osmium::item_type::area, area.id());
+                }
+
+                validation_result result;
+
+                for (const auto& item : area) {
+                    if (item.type() == osmium::item_type::outer_ring) {
+                        add_ring(static_cast<const osmium::OuterRing&>(item), true, result);
+                    } else if (item.type() == osmium::item_type::inner_ring) {
+                        add_ring(static_cast<const osmium::InnerRing&>(item), false, result);
+                    }
+                }
+
+                if (m_problem_reporter) {
+                    m_problem_reporter->set_nodes(m_segment_list.size());
+                }
+
+                m_segment_list.sort();
+
+                uint64_t duplicate_segments = 0;
+                uint64_t overlapping_segments = 0;
+                m_segment_list.erase_duplicate_segments(m_problem_reporter, duplicate_segments, overlapping_segments);
+                result.duplicate_segments = static_cast<uint32_t>(duplicate_segments);
+
+                result.intersections = m_segment_list.find_intersections(m_problem_reporter);
+
+                return result;
+            }
+
+            template <typename TBuilder>
+            void build_ring(osmium::builder::AreaBuilder& builder, const ring_info& ring) const {
+                TBuilder ring_builder{builder};
+                if (ring.reverse) {
+                    for (std::size_t i = ring.end; i > ring.begin; --i) {
+                        ring_builder.add_node_ref(m_nodes[i - 1]);
+                    }
+                } else {
+                    for (std::size_t i = ring.begin; i < ring.end; ++i) {
+                        ring_builder.add_node_ref(m_nodes[i]);
+                    }
+                }
+            }
+
+            bool build_area(const osmium::Area& area, osmium::memory::Buffer& out_buffer) const {
+                osmium::builder::AreaBuilder builder{out_buffer};
+                builder.initialize_from_object(area);
+                // initialize_from_object() converts way and relation ids,
+                // the area already has its final id.
+                builder.set_id(area.id());
+                builder.add_item(area.tags());
+
+                bool has_outer_ring = false;
+                bool outer_ring_kept = false;
+                for (const ring_info& ring : m_rings) {
+                    if (ring.outer) {
+                        outer_ring_kept = ring.keep();
+                        if (outer_ring_kept) {
+                            has_outer_ring = true;
+                            build_ring<osmium::builder::OuterRingBuilder>(builder, ring);
+                        }
+                    } else if (outer_ring_kept && ring.keep()) {
+                        build_ring<osmium::builder::InnerRingBuilder>(builder, ring);
+                    }
+                }
+
+                return has_outer_ring;
+            }
+
+        public:
+
+            explicit Validator(ProblemReporter* problem_reporter = nullptr) :
+                m_problem_reporter(problem_reporter) {
+            }
+
+            /**
+             * Check the area for validity. Problems found are reported to
+             * the problem reporter (if there is one).
+             */
+            validation_result check(const osmium::Area& area) {
+                return check_impl(area);
+            }
+
+            /**
+             * Check the area and, if it is not valid but can be repaired,
+             * add a repaired copy to the out_buffer. Repairs done are:
+             *
+             * * Remove duplicate nodes.
+             * * Remove spikes.
+             * * Remove rings that have become too short, rings enclosing
+             *   no area, and inner rings of outer rings that have been
+             *   removed.
+             * * Reverse rings that have the wrong direction.
+             *
+             * Nothing is added to the out_buffer if the area is valid
+             * already or if it can not be repaired (because it has
+             * open rings, intersections, or duplicate segments) or if
+             * there are no outer rings left after the repair. Use the
+             * returned result to find out which case it is.
+             *
+             * @returns The result of checking the original area.
+             */
+            validation_result repair(const osmium::Area& area, osmium::memory::Buffer& out_buffer) {
+                validation_result result = check_impl(area);
+
+                if ((result.valid() && result.duplicate_nodes == 0) || !result.repairable()) {
+                    return result;
+                }
+
+                if (build_area(area, out_buffer)) {
+                    out_buffer.commit();
+                } else {
+                    out_buffer.rollback();
+                }
+
+                return result;
+            }
+
+        }; // class Validator
+
+    } // namespace area
+
+} // namespace osmium
+
+#endif // OSMIUM_AREA_VALIDATOR_HPP
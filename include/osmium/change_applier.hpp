@@ -0,0 +1,352 @@
+#ifndef OSMIUM_CHANGE_APPLIER_HPP
+#define OSMIUM_CHANGE_APPLIER_HPP
+
+/*
+
+This file is part of Osmium (https://osmcode.org/libosmium).
+
+Copyright 2013-2026 Jochen Topf <jochen@topf.org> and others (see README).
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include <osmium/io/file.hpp>
+#include <osmium/io/reader.hpp>
+#include <osmium/memory/buffer.hpp>
+#include <osmium/memory/item_iterator.hpp>
+#include <osmium/object_pointer_collection.hpp>
+#include <osmium/osm/entity_bits.hpp>
+#include <osmium/osm/object.hpp>
+#include <osmium/osm/object_comparisons.hpp>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace osmium {
+
+    /**
+     * Applies changes (usually read from OSM change files) to a sorted
+     * base file and creates a new snapshot (or history file) from it.
+     *
+     * All changes are kept in memory. Before they are applied, they are
+     * sorted and deduplicated. In snapshot mode only the latest version
+     * of each object is kept and deleted objects are removed from the
+     * output. A change only replaces an object from the base file if its
+     * version is at least as large as the version in the base file,
+     * changes with smaller versions (for instance from applying an old
+     * change file again) are skipped and the base object is kept. In
+     * history mode all versions are kept and merged with the versions in
+     * the base file.
+     *
+     * The base file is read as a stream of buffers, usually from a Reader
+     * which decodes the data in background threads while the changes are
+     * applied. Buffers from the base file that are not affected by any
+     * change are handed on to the output unchanged without copying the
+     * objects in them. All other buffers are merged with the changes
+     * object by object. If the Reader was opened with the
+     * osmium::io::keep_source_blocks::yes option and the output is a PBF
+     * file, the unchanged buffers are written without re-encoding them.
+     *
+     * Usage:
+     *
+     * @code
+     * osmium::ChangeApplier applier;
+     * for (const auto& change_file : change_files) {
+     *     applier.read_changes(change_file);
+     * }
+     *
+     * osmium::io::Reader reader{base_file, osmium::osm_entity_bits::nwr,
+     *                          osmium::io::keep_source_blocks::yes};
+     * osmium::io::Writer writer{output_file, reader.header()};
+     * applier.apply(reader, writer);
+     * writer.close();
+     * reader.close();
+     * @endcode
+     */
+    class ChangeApplier {
+
+        enum {
+            output_buffer_size = 1024UL * 1024UL
+        };
+
+        std::vector<osmium::memory::Buffer> m_change_buffers;
+        ObjectPointerCollection m_changes;
+        ObjectPointerCollection::iterator m_next_change{m_changes.end()};
+        osmium::memory::Buffer m_output{output_buffer_size, osmium::memory::Buffer::auto_grow::yes};
+
+        std::size_t m_base_objects = 0;
+        std::size_t m_unchanged_buffers = 0;
+        std::size_t m_changes_applied = 0;
+        std::size_t m_changes_skipped = 0;
+        bool m_with_history;
+        bool m_prepared = false;
+
+        // Are the objects the same object? In history mode this takes
+        // the version into account, in snapshot mode it doesn't.
+        bool same(const osmium::OSMObject& lhs, const osmium::OSMObject& rhs) const noexcept {
+            if (m_with_history) {
+                return osmium::object_equal_type_id_version{}(lhs, rhs);
+            }
+            return osmium::object_equal_type_id{}(lhs, rhs);
+        }
+
+        // Is lhs ordered before rhs in the order used in OSM files?
+        // Different versions of the same object are considered the
+        // same in snapshot mode.
+        bool before(const osmium::OSMObject& lhs, const osmium::OSMObject& rhs) const noexcept {
+            return !same(lhs, rhs) &&
+                   osmium::object_order_type_id_version_without_timestamp{}(lhs, rhs);
+        }
+
+        void prepare() {
+            if (m_with_history) {
+                m_changes.sort(osmium::object_order_type_id_version{});
+                m_changes.unique(osmium::object_equal_type_id_version{});
+            } else {
+                m_changes.sort(osmium::object_order_type_id_reverse_version{});
+                m_changes.unique(osmium::object_equal_type_id{});
+            }
+            m_next_change = m_changes.begin();
+            m_prepared = true;
+        }
+
+        template <typename TOutput>
+        void flush(TOutput& output) {
+            if (m_output.committed() > 0) {
+                output(std::move(m_output));
+                m_output = osmium::memory::Buffer{output_buffer_size, osmium::memory::Buffer::auto_grow::yes};
+            }
+        }
+
+        template <typename TOutput>
+        void add_to_output(const osmium::OSMObject& object, TOutput& output) {
+            m_output.add_item(object);
+            m_output.commit();
+            if (m_output.committed() >= output_buffer_size) {
+                flush(output);
+            }
+        }
+
+        template <typename TOutput>
+        void add_change(TOutput& output) {
+            const osmium::OSMObject& change = *m_next_change;
+            if (m_with_history || change.visible()) {
+                add_to_output(change, output);
+            }
+            ++m_changes_applied;
+            ++m_next_change;
+        }
+
+        // Add all changes to the output that are ordered before the
+        // object.
+        template <typename TOutput>
+        void add_changes_before(const osmium::OSMObject& object, TOutput& output) {
+            while (m_next_change != m_changes.end() && before(*m_next_change, object)) {
+                add_change(output);
+            }
+        }
+
+        template <typename TOutput>
+        void merge_object(const osmium::OSMObject& object, TOutput& output) {
+            ++m_base_objects;
+            add_changes_before(object, output);
+            if (m_next_change != m_changes.end() && same(*m_next_change, object)) {
+                if (m_next_change->version() >= object.version()) {
+                    // Object is replaced by the change.
+                    add_change(output);
+                    return;
+                }
+                // Change is older than the object.
+                ++m_changes_skipped;
+                ++m_next_change;
+            }
+            add_to_output(object, output);
+        }
+
+        template <typename TOutput>
+        void merge_buffer(osmium::memory::Buffer&& buffer, TOutput& output) {
+            auto objects = buffer.select<osmium::OSMObject>();
+            if (objects.begin() == objects.end()) {
+                return;
+            }
+
+            const osmium::OSMObject* first = &*objects.begin();
+            const osmium::OSMObject* last = first;
+            std::size_t count = 0;
+            for (const auto& object : objects) {
+                last = &object;
+                ++count;
+            }
+
+            add_changes_before(*first, output);
+
+            if (m_next_change == m_changes.end() || before(*last, *m_next_change)) {
+                // No changes affect this buffer, hand it on as it is.
+                flush(output);
+                m_base_objects += count;
+                ++m_unchanged_buffers;
+                buffer.mark_unchanged();
+                output(std::move(buffer));
+                return;
+            }
+
+            for (const auto& object : objects) {
+                merge_object(object, output);
+            }
+        }
+
+    public:
+
+        /**
+         * Create ChangeApplier.
+         *
+         * @param with_history If this is false (default), a new snapshot
+         *                     is created containing only the latest
+         *                     version of each object. If this is true,
+         *                     all versions from the base file and the
+         *                     changes are kept (history mode).
+         */
+        explicit ChangeApplier(bool with_history = false) :
+            m_with_history(with_history) {
+        }
+
+        ChangeApplier(const ChangeApplier&) = delete;
+        ChangeApplier& operator=(const ChangeApplier&) = delete;
+
+        ChangeApplier(ChangeApplier&&) = delete;
+        ChangeApplier& operator=(ChangeApplier&&) = delete;
+
+        ~ChangeApplier() noexcept = default;
+
+        /**
+         * Add all OSM objects in the buffer as changes. The buffer is
+         * kept in memory until the ChangeApplier is destroyed.
+         */
+        void add_changes(osmium::memory::Buffer&& buffer) {
+            m_change_buffers.push_back(std::move(buffer));
+            for (auto& object : m_change_buffers.back().select<osmium::OSMObject>()) {
+                m_changes.osm_object(object);
+            }
+            m_prepared = false;
+        }
+
+        /**
+         * Read all nodes, ways, and relations from the file and add them
+         * as changes.
+         *
+         * @throws Some form of osmium::io_error if there is an error.
+         */
+        void read_changes(const osmium::io::File& file) {
+            osmium::io::Reader reader{file, osmium::osm_entity_bits::nwr};
+            while (osmium::memory::Buffer buffer = reader.read()) {
+                add_changes(std::move(buffer));
+            }
+            reader.close();
+        }
+
+        /**
+         * The number of changes added. After apply() was called, this is
+         * the number of changes after deduplication.
+         */
+        std::size_t num_changes() const noexcept {
+            return m_changes.size();
+        }
+
+        /**
+         * Apply the changes to the base data and write the result to
+         * the output.
+         *
+         * The base data must be sorted in the usual order of OSM files.
+         * Changes can be applied to several base files one after the
+         * other, for instance to the same data in different formats.
+         *
+         * @tparam TSource Class with a read() function returning buffers
+         *                 and an invalid buffer at the end, usually a
+         *                 Reader or MergingReader.
+         * @tparam TOutput Callable with a osmium::memory::Buffer&&
+         *                 parameter, usually a Writer.
+         * @param base The source of the base data.
+         * @param output Sorted buffers of the new data will be sent here.
+         *
+         * @throws Any exception the source or the output throw.
+         */
+        template <typename TSource, typename TOutput>
+        void apply(TSource& base, TOutput&& output) {
+            if (!m_prepared) {
+                prepare();
+            }
+            m_next_change = m_changes.begin();
+
+            while (osmium::memory::Buffer buffer = base.read()) {
+                merge_buffer(std::move(buffer), output);
+            }
+
+            while (m_next_change != m_changes.end()) {
+                add_change(output);
+            }
+            flush(output);
+        }
+
+        /**
+         * The number of objects read from the base data (summed up over
+         * all calls to apply()).
+         */
+        std::size_t base_objects() const noexcept {
+            return m_base_objects;
+        }
+
+        /**
+         * The number of buffers from the base data that were handed on to
+         * the output unchanged (summed up over all calls to apply()).
+         */
+        std::size_t unchanged_buffers() const noexcept {
+            return m_unchanged_buffers;
+        }
+
+        /**
+         * The number of changes applied (after deduplication) in all
+         * calls to apply().
+         */
+        std::size_t changes_applied() const noexcept {
+            return m_changes_applied;
+        }
+
+        /**
+         * The number of changes (after deduplication) that were not
+         * applied in snapshot mode because the base data contained a
+         * newer version of the object (summed up over all calls to
+         * apply()).
+         */
+        std::size_t changes_skipped() const noexcept {
+            return m_changes_skipped;
+        }
+
+    }; // class ChangeApplier
+
+} // namespace osmium
+
+#endif // OSMIUM_CHANGE_APPLIER_HPP
@@ -0,0 +1,370 @@
+#ifndef OSMIUM_EXTERNAL_SORTER_HPP
+#define OSMIUM_EXTERNAL_SORTER_HPP
+
+/*
+
+This file is part of Osmium (https://osmcode.org/libosmium).
+
+Copyright 2013-2026 Jochen Topf <jochen@topf.org> and others (see README).
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include <osmium/handler.hpp>
+#include <osmium/index/detail/tmpfile.hpp>
+#include <osmium/io/detail/read_write.hpp>
+#include <osmium/memory/buffer.hpp>
+#include <osmium/memory/item_iterator.hpp>
+#include <osmium/object_pointer_collection.hpp>
+#include <osmium/osm/object.hpp>
+#include <osmium/osm/object_comparisons.hpp>
+#include <osmium/util/file.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace osmium {
+
+    /**
+     * Sorts OSM objects that don't fit into memory. Objects are collected
+     * in memory until a configurable limit is reached. They are then
+     * sorted and written as a "run" to a temporary file in the internal
+     * serialized format. When all objects are added, the runs are merged
+     * and returned in order in buffers which can, for instance, be handed
+     * to a Writer. If everything fits into memory, no temporary files are
+     * used.
+     *
+     * Objects are sorted by type, id, version, and timestamp (see
+     * osmium::object_order_type_id_version). The sort is stable, objects
+     * that compare equal are returned in the order they were added.
+     *
+     * Usage:
+     *
+     * @code
+     * osmium::ExternalSorter sorter{4UL * 1024UL * 1024UL * 1024UL};
+     * osmium::io::Reader reader{input_file};
+     * osmium::apply(reader, sorter);
+     * reader.close();
+     *
+     * osmium::io::Writer writer{output_file};
+     * while (osmium::memory::Buffer buffer = sorter.read()) {
+     *     writer(std::move(buffer));
+     * }
+     * writer.close();
+     * @endcode
+     *
+     * This class implements the visitor pattern, so it can be used as
+     * handler with osmium::apply(). Only OSM objects (nodes, ways,
+     * relations, and areas) are sorted, everything else is ignored.
+     */
+    class ExternalSorter : public osmium::handler::Handler {
+
+        using iterator_type = osmium::memory::ItemIterator<osmium::OSMObject>;
+
+        // The data of a run is stored as a sequence of chunks, each
+        // consisting of the size of the chunk followed by the contents
+        // of a buffer with that many bytes.
+        struct run {
+
+            int fd;
+            osmium::memory::Buffer buffer{};
+            iterator_type it{};
+            iterator_type end{};
+
+            explicit run(int run_fd) noexcept :
+                fd(run_fd) {
+            }
+
+        }; // struct run
+
+        struct heap_element {
+
+            const osmium::OSMObject* object;
+            std::size_t run;
+
+            // The heap is a max heap, so this is reversed: The element
+            // with the smallest object (and, for equal objects, from the
+            // earliest run) is at the top.
+            bool operator<(const heap_element& other) const noexcept {
+                if (*other.object < *object) {
+                    return true;
+                }
+                if (*object < *other.object) {
+                    return false;
+                }
+                return other.run < run;
+            }
+
+        }; // struct heap_element
+
+        std::vector<osmium::memory::Buffer> m_buffers;
+        std::vector<run> m_runs;
+        std::priority_queue<heap_element> m_heap;
+        ObjectPointerCollection m_sorted;
+        ObjectPointerCollection::iterator m_sorted_it{m_sorted.end()};
+        std::size_t m_max_memory;
+        std::size_t m_buffer_size;
+        std::size_t m_memory_used = 0;
+        std::size_t m_count = 0;
+        bool m_reading = false;
+
+        void sort_in_memory() {
+            m_sorted.clear();
+            for (auto& buffer : m_buffers) {
+                for (auto& object : buffer.select<osmium::OSMObject>()) {
+                    m_sorted.osm_object(object);
+                }
+            }
+            m_sorted.sort(osmium::object_order_type_id_version{});
+        }
+
+        void write_chunk(int fd, const osmium::memory::Buffer& buffer) const {
+            const uint64_t size = buffer.committed();
+            osmium::io::detail::reliable_write(fd, reinterpret_cast<const char*>(&size), sizeof(size));
+            osmium::io::detail::reliable_write(fd, buffer.data(), buffer.committed());
+        }
+
+        void spill_run() {
+            if (m_memory_used == 0) {
+                return;
+            }
+
+            sort_in_memory();
+
+            const int fd = osmium::detail::create_tmp_file();
+            m_runs.emplace_back(fd);
+
+            osmium::memory::Buffer buffer{m_buffer_size, osmium::memory::Buffer::auto_grow::yes};
+            for (const auto& object : m_sorted) {
+                if (buffer.committed() > 0 && buffer.committed() + object.padded_size() > buffer.capacity()) {
+                    write_chunk(fd, buffer);
+                    buffer.clear();
+                }
+                buffer.add_item(object);
+                buffer.commit();
+            }
+            write_chunk(fd, buffer);
+
+            osmium::file_seek(fd, 0);
+
+            m_sorted.clear();
+            m_buffers.clear();
+            m_memory_used = 0;
+        }
+
+        // Read the next chunk of run r into its buffer. Returns false
+        // at the end of the run.
+        bool read_chunk(run& r) {
+            uint64_t size = 0;
+            if (!osmium::io::detail::read_exactly(r.fd, reinterpret_cast<char*>(&size), sizeof(size))) {
+                return false;
+            }
+            r.buffer = osmium::memory::Buffer{static_cast<std::size_t>(size)};
+            auto* data = r.buffer.reserve_space(static_cast<std::size_t>(size));
+            if (!osmium::io::detail::read_exactly(r.fd, reinterpret_cast<char*>(data), static_cast<unsigned int>(size))) {
+                throw std::runtime_error{"ExternalSorter: temporary file truncated"};
+            }
+            r.buffer.commit();
+            return true;
+        }
+
+        // Advance run n to its next object and add that to the heap.
+        void next_object(const std::size_t n) {
+            auto& r = m_runs[n];
+
+            if (r.it != r.end) {
+                ++r.it;
+            }
+            while (r.it == r.end) {
+                if (!read_chunk(r)) {
+                    osmium::io::detail::reliable_close(r.fd);
+                    r.fd = -1;
+                    r.buffer = osmium::memory::Buffer{};
+                    return;
+                }
+                auto range = r.buffer.select<osmium::OSMObject>();
+                r.it = range.begin();
+                r.end = range.end();
+            }
+
+            m_heap.push(heap_element{&*r.it, n});
+        }
+
+        void start_reading() {
+            m_reading = true;
+
+            if (m_runs.empty()) {
+                sort_in_memory();
+                m_sorted_it = m_sorted.begin();
+                return;
+            }
+
+            spill_run();
+            for (std::size_t n = 0; n < m_runs.size(); ++n) {
+                next_object(n);
+            }
+        }
+
+    public:
+
+        enum {
+            default_buffer_size = 1024UL * 1024UL
+        };
+
+        /**
+         * Create ExternalSorter.
+         *
+         * @param max_memory Maximum number of bytes of object data kept in
+         *                   memory before a sorted run is written to disk.
+         *                   During the merge phase one buffer per run is
+         *                   held in memory.
+         * @param buffer_size Size of the buffers used internally and
+         *                    returned from read().
+         */
+        explicit ExternalSorter(std::size_t max_memory = 1024UL * 1024UL * 1024UL, std::size_t buffer_size = default_buffer_size) :
+            m_max_memory(max_memory),
+            m_buffer_size(buffer_size) {
+        }
+
+        ExternalSorter(const ExternalSorter&) = delete;
+        ExternalSorter& operator=(const ExternalSorter&) = delete;
+
+        ExternalSorter(ExternalSorter&&) = delete;
+        ExternalSorter& operator=(ExternalSorter&&) = delete;
+
+        ~ExternalSorter() noexcept {
+            for (const auto& r : m_runs) {
+                try {
+                    osmium::io::detail::reliable_close(r.fd);
+                } catch (...) { // NOLINT(bugprone-empty-catch)
+                    // Ignore any exceptions because destructor must not throw.
+                }
+            }
+        }
+
+        /**
+         * Add a copy of an object to the sorter.
+         *
+         * @throws std::logic_error If called after read().
+         */
+        void osm_object(const osmium::OSMObject& object) {
+            if (m_reading) {
+                throw std::logic_error{"ExternalSorter: can not add objects after read() was called"};
+            }
+
+            if (m_buffers.empty() || m_buffers.back().committed() + object.padded_size() > m_buffers.back().capacity()) {
+                if (m_memory_used >= m_max_memory) {
+                    spill_run();
+                }
+                m_buffers.emplace_back(std::max(m_buffer_size, static_cast<std::size_t>(object.padded_size())), osmium::memory::Buffer::auto_grow::no);
+            }
+
+            m_buffers.back().add_item(object);
+            m_buffers.back().commit();
+            m_memory_used += object.padded_size();
+            ++m_count;
+        }
+
+        /**
+         * Add copies of all OSM objects in a buffer to the sorter.
+         */
+        void operator()(const osmium::memory::Buffer& buffer) {
+            for (const auto& object : buffer.select<osmium::OSMObject>()) {
+                osm_object(object);
+            }
+        }
+
+        /**
+         * The number of objects added.
+         */
+        std::size_t size() const noexcept {
+            return m_count;
+        }
+
+        /**
+         * The number of sorted runs written to temporary files so far.
+         */
+        std::size_t runs() const noexcept {
+            return m_runs.size();
+        }
+
+        /**
+         * Get the next buffer with sorted objects. An invalid buffer
+         * signals that all objects have been returned. After the first
+         * call to this function, no more objects can be added.
+         *
+         * @returns Buffer.
+         * @throws std::system_error If there is a problem with the
+         *         temporary files.
+         */
+        osmium::memory::Buffer read() {
+            if (!m_reading) {
+                start_reading();
+            }
+
+            osmium::memory::Buffer buffer{m_buffer_size, osmium::memory::Buffer::auto_grow::yes};
+
+            if (m_runs.empty()) {
+                while (m_sorted_it != m_sorted.end()) {
+                    if (buffer.committed() > 0 && buffer.committed() + m_sorted_it->padded_size() > buffer.capacity()) {
+                        return buffer;
+                    }
+                    buffer.add_item(*m_sorted_it);
+                    buffer.commit();
+                    ++m_sorted_it;
+                }
+                m_sorted.clear();
+                m_sorted_it = m_sorted.end();
+                m_buffers.clear();
+            } else {
+                while (!m_heap.empty()) {
+                    const heap_element top = m_heap.top();
+                    if (buffer.committed() > 0 && buffer.committed() + top.object->padded_size() > buffer.capacity()) {
+                        return buffer;
+                    }
+                    m_heap.pop();
+                    buffer.add_item(*top.object);
+                    buffer.commit();
+                    next_object(top.run);
+                }
+            }
+
+            if (buffer.committed() == 0) {
+                return osmium::memory::Buffer{};
+            }
+            return buffer;
+        }
+
+    }; // class ExternalSorter
+
+} // namespace osmium
+
+#endif // OSMIUM_EXTERNAL_SORTER_HPP
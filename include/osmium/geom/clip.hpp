@@ -0,0 +1,319 @@
+#ifndef OSMIUM_GEOM_CLIP_HPP
+#define OSMIUM_GEOM_CLIP_HPP
+
+/*
+
+This file is part of Osmium (https://osmcode.org/libosmium).
+
+Copyright 2013-2026 Jochen Topf <jochen@topf.org> and others (see README).
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include <osmium/geom/coordinates.hpp>
+#include <osmium/osm/area.hpp>
+#include <osmium/osm/item_type.hpp>
+#include <osmium/osm/node_ref_list.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace osmium {
+
+    namespace geom {
+
+        /**
+         * Clips linestrings and rings given as coordinates to an axis
+         * aligned box. Coordinates are usually in some projection created
+         * with GeometryFactory::project(), the box must be in the same
+         * projection. The results can be turned into geometries with the
+         * GeometryFactory::create_*_from_coordinates() functions.
+         *
+         * Rings are clipped with the Sutherland-Hodgman algorithm. If a
+         * ring goes out of the box and back in several times, the parts
+         * inside the box are connected along the boundary of the box, so
+         * the result is a single ring which might have zero-width parts
+         * on the boundary. This is usually fine for rendering.
+         *
+         * The object keeps some internal buffers between uses, so it is
+         * most efficient to use the same object for many geometries.
+         */
+        class BoxClipper {
+
+        public:
+
+            using ring_type = std::vector<Coordinates>;
+            using polygon_type = std::vector<ring_type>;
+
+        private:
+
+            Coordinates m_bottom_left;
+            Coordinates m_top_right;
+
+            ring_type m_buffer;
+            ring_type m_projected;
+
+            enum class edge {
+                left,
+                right,
+                bottom,
+                top
+            };
+
+            bool inside(const Coordinates& c, edge e) const noexcept {
+                switch (e) {
+                    case edge::left:
+                        return c.x >= m_bottom_left.x;
+                    case edge::right:
+                        return c.x <= m_top_right.x;
+                    case edge::bottom:
+                        return c.y >= m_bottom_left.y;
+                    default: // top
+                        break;
+                }
+                return c.y <= m_top_right.y;
+            }
+
+            Coordinates intersection(const Coordinates& a, const Coordinates& b, edge e) const noexcept {
+                switch (e) {
+                    case edge::left:
+                        return Coordinates{m_bottom_left.x, a.y + (b.y - a.y) * (m_bottom_left.x - a.x) / (b.x - a.x)};
+                    case edge::right:
+                        return Coordinates{m_top_right.x, a.y + (b.y - a.y) * (m_top_right.x - a.x) / (b.x - a.x)};
+                    case edge::bottom:
+                        return Coordinates{a.x + (b.x - a.x) * (m_bottom_left.y - a.y) / (b.y - a.y), m_bottom_left.y};
+                    default: // top
+                        break;
+                }
+                return Coordinates{a.x + (b.x - a.x) * (m_top_right.y - a.y) / (b.y - a.y), m_top_right.y};
+            }
+
+            // One step of the Sutherland-Hodgman algorithm on an open ring
+            // (without the closing point).
+            void clip_ring_at_edge(const ring_type& in, ring_type& out, edge e) const {
+                out.clear();
+                if (in.empty()) {
+                    return;
+                }
+                const Coordinates* prev = &in.back();
+                bool prev_inside = inside(*prev, e);
+                for (const auto& c : in) {
+                    const bool c_inside = inside(c, e);
+                    if (c_inside != prev_inside) {
+                        out.push_back(intersection(*prev, c, e));
+                    }
+                    if (c_inside) {
+                        out.push_back(c);
+                    }
+                    prev = &c;
+                    prev_inside = c_inside;
+                }
+            }
+
+            // Clip the segment a-b with the Liang-Barsky algorithm. Returns
+            // false if the segment is completely outside. Otherwise t0 and
+            // t1 are set to the parameters of the part inside.
+            bool clip_segment(const Coordinates& a, const Coordinates& b, double& t0, double& t1) const noexcept {
+                const double dx = b.x - a.x;
+                const double dy = b.y - a.y;
+                const double p[4] = {-dx, dx, -dy, dy};
+                const double q[4] = {a.x - m_bottom_left.x, m_top_right.x - a.x, a.y - m_bottom_left.y, m_top_right.y - a.y};
+
+                t0 = 0.0;
+                t1 = 1.0;
+                for (int i = 0; i < 4; ++i) {
+                    if (p[i] == 0.0) {
+                        if (q[i] < 0.0) {
+                            return false;
+                        }
+                    } else {
+                        const double t = q[i] / p[i];
+                        if (p[i] < 0.0) {
+                            if (t > t1) {
+                                return false;
+                            }
+                            if (t > t0) {
+                                t0 = t;
+                            }
+                        } else {
+                            if (t < t0) {
+                                return false;
+                            }
+                            if (t < t1) {
+                                t1 = t;
+                            }
+                        }
+                    }
+                }
+                return true;
+            }
+
+            static void finish_part(ring_type& part, std::vector<ring_type>& out) {
+                if (part.size() >= 2) {
+                    out.push_back(std::move(part));
+                }
+                part.clear();
+            }
+
+        public:
+
+            /**
+             * Create a clipper for the box with the given corners.
+             *
+             * @pre @code bottom_left.x <= top_right.x && bottom_left.y <= top_right.y @endcode
+             */
+            BoxClipper(const Coordinates& bottom_left, const Coordinates& top_right) noexcept :
+                m_bottom_left(bottom_left),
+                m_top_right(top_right) {
+                assert(bottom_left.x <= top_right.x);
+                assert(bottom_left.y <= top_right.y);
+            }
+
+            const Coordinates& bottom_left() const noexcept {
+                return m_bottom_left;
+            }
+
+            const Coordinates& top_right() const noexcept {
+                return m_top_right;
+            }
+
+            /**
+             * Clip a linestring. Because a linestring can go out of the
+             * box and back in, the result can consist of several parts,
+             * which are appended to out.
+             *
+             * @param in The coordinates of the linestring.
+             * @param out The parts of the linestring inside the box (each
+             *            with at least two points) are appended here.
+             * @returns The number of parts appended.
+             */
+            std::size_t clip_linestring(const ring_type& in, std::vector<ring_type>& out) const {
+                const std::size_t old_size = out.size();
+                ring_type part;
+                for (std::size_t i = 1; i < in.size(); ++i) {
+                    double t0 = 0.0;
+                    double t1 = 1.0;
+                    const auto& a = in[i - 1];
+                    const auto& b = in[i];
+                    if (!clip_segment(a, b, t0, t1)) {
+                        finish_part(part, out);
+                        continue;
+                    }
+
+                    const Coordinates start = t0 == 0.0 ? a : Coordinates{a.x + (b.x - a.x) * t0, a.y + (b.y - a.y) * t0};
+                    const Coordinates end = t1 == 1.0 ? b : Coordinates{a.x + (b.x - a.x) * t1, a.y + (b.y - a.y) * t1};
+
+                    if (part.empty() || part.back() != start) {
+                        finish_part(part, out);
+                        part.push_back(start);
+                    }
+                    if (part.back() != end) {
+                        part.push_back(end);
+                    }
+                    if (t1 != 1.0) {
+                        finish_part(part, out);
+                    }
+                }
+                finish_part(part, out);
+                return out.size() - old_size;
+            }
+
+            /**
+             * Clip a closed ring.
+             *
+             * @param in The coordinates of the ring. The first and last
+             *           point must be the same.
+             * @param out The clipped ring, closed again. Empty if nothing
+             *            (or only a line or point) is left of the ring.
+             */
+            void clip_ring(const ring_type& in, ring_type& out) {
+                out.clear();
+                if (in.size() < 4) {
+                    return;
+                }
+
+                out.assign(in.begin(), in.end() - 1);
+                clip_ring_at_edge(out, m_buffer, edge::left);
+                clip_ring_at_edge(m_buffer, out, edge::right);
+                clip_ring_at_edge(out, m_buffer, edge::bottom);
+                clip_ring_at_edge(m_buffer, out, edge::top);
+
+                if (out.size() < 3) {
+                    out.clear();
+                    return;
+                }
+                out.push_back(out.front());
+            }
+
+            /**
+             * Clip all rings of an area.
+             *
+             * @param area The area.
+             * @param factory The GeometryFactory (or anything else with a
+             *                compatible project() function) used to
+             *                project the locations of the area.
+             * @param out The clipped polygons are appended here. Each
+             *            polygon has the outer ring first, followed by
+             *            the inner rings. Polygons whose outer ring is
+             *            completely outside the box are not added,
+             *            inner rings completely outside are removed.
+             * @returns The number of polygons appended.
+             */
+            template <typename TFactory>
+            std::size_t clip_area(const osmium::Area& area, const TFactory& factory, std::vector<polygon_type>& out) {
+                const std::size_t old_size = out.size();
+                bool outer_ring_kept = false;
+                for (const auto& item : area) {
+                    if (item.type() == osmium::item_type::outer_ring) {
+                        factory.project(static_cast<const osmium::NodeRefList&>(item), m_projected);
+                        ring_type ring;
+                        clip_ring(m_projected, ring);
+                        outer_ring_kept = !ring.empty();
+                        if (outer_ring_kept) {
+                            out.emplace_back();
+                            out.back().push_back(std::move(ring));
+                        }
+                    } else if (item.type() == osmium::item_type::inner_ring && outer_ring_kept) {
+                        factory.project(static_cast<const osmium::NodeRefList&>(item), m_projected);
+                        ring_type ring;
+                        clip_ring(m_projected, ring);
+                        if (!ring.empty()) {
+                            out.back().push_back(std::move(ring));
+                        }
+                    }
+                }
+                return out.size() - old_size;
+            }
+
+        }; // class BoxClipper
+
+    } // namespace geom
+
+} // namespace osmium
+
+#endif // OSMIUM_GEOM_CLIP_HPP
@@ -50,6 +50,7 @@ DEALINGS IN THE SOFTWARE.
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace osmium {
 
@@ -161,6 +162,16 @@ namespace osmium {
                 }
             }
 
+            /**
+             * Add coordinates of an outer or inner ring to a multipolygon.
+             */
+            template <typename TRing>
+            void add_coordinates(const TRing& ring) {
+                for (const auto& coordinates : ring) {
+                    m_impl.multipolygon_add_location(coordinates);
+                }
+            }
+
             TProjection m_projection;
             TGeomImpl m_impl;
 
@@ -418,6 +429,124 @@ namespace osmium {
                 }
             }
 
+            /* Projected coordinates */
+
+            /**
+             * Project the locations of the nodes in the node ref list with
+             * the projection of this factory and write them into out.
+             * Consecutive nodes with the same location are only added
+             * once. The result can be modified (for instance simplified
+             * or clipped) and then turned into a geometry with one of the
+             * create_*_from_coordinates() functions.
+             *
+             * @param nrl The node ref list with the locations.
+             * @param out The vector for the results. Existing contents
+             *            is removed.
+             * @throws osmium::invalid_location If a location is invalid.
+             */
+            void project(const osmium::NodeRefList& nrl, std::vector<Coordinates>& out) const {
+                out.clear();
+                out.reserve(nrl.size());
+                osmium::Location last_location;
+                for (const osmium::NodeRef& node_ref : nrl) {
+                    if (last_location != node_ref.location()) {
+                        last_location = node_ref.location();
+                        out.push_back(m_projection(last_location));
+                    }
+                }
+            }
+
+            /**
+             * Create a linestring from coordinates that are already in
+             * the projection of this factory, usually the result of
+             * project() and further processing.
+             *
+             * @tparam TIter Iterator over osmium::geom::Coordinates.
+             * @throws osmium::geometry_error If there are less than two
+             *         coordinates.
+             */
+            template <typename TIter>
+            linestring_type create_linestring_from_coordinates(TIter it, TIter end) {
+                size_t num_points = 0;
+                m_impl.linestring_start();
+                for (; it != end; ++it, ++num_points) {
+                    m_impl.linestring_add_location(*it);
+                }
+
+                if (num_points < 2) {
+                    throw osmium::geometry_error{"need at least two points for linestring"};
+                }
+
+                return m_impl.linestring_finish(num_points);
+            }
+
+            /**
+             * Create a polygon from coordinates of a closed ring that are
+             * already in the projection of this factory.
+             *
+             * @tparam TIter Iterator over osmium::geom::Coordinates.
+             * @throws osmium::geometry_error If there are less than four
+             *         coordinates.
+             */
+            template <typename TIter>
+            polygon_type create_polygon_from_coordinates(TIter it, TIter end) {
+                size_t num_points = 0;
+                m_impl.polygon_start();
+                for (; it != end; ++it, ++num_points) {
+                    m_impl.polygon_add_location(*it);
+                }
+
+                if (num_points < 4) {
+                    throw osmium::geometry_error{"need at least four points for polygon"};
+                }
+
+                return m_impl.polygon_finish(num_points);
+            }
+
+            /**
+             * Create a multipolygon from coordinates that are already in
+             * the projection of this factory.
+             *
+             * @tparam TPolygons Container of polygons, each a container
+             *         of closed rings, each a container of
+             *         osmium::geom::Coordinates. The first ring of each
+             *         polygon is the outer ring, all others are inner
+             *         rings. Empty polygons and rings are ignored.
+             * @throws osmium::geometry_error If there are no polygons.
+             */
+            template <typename TPolygons>
+            multipolygon_type create_multipolygon_from_coordinates(const TPolygons& polygons) {
+                size_t num_polygons = 0;
+                m_impl.multipolygon_start();
+
+                for (const auto& polygon : polygons) {
+                    auto ring = polygon.begin();
+                    if (ring == polygon.end() || ring->empty()) {
+                        continue;
+                    }
+                    m_impl.multipolygon_polygon_start();
+                    m_impl.multipolygon_outer_ring_start();
+                    add_coordinates(*ring);
+                    m_impl.multipolygon_outer_ring_finish();
+                    for (++ring; ring != polygon.end(); ++ring) {
+                        if (ring->empty()) {
+                            continue;
+                        }
+                        m_impl.multipolygon_inner_ring_start();
+                        add_coordinates(*ring);
+                        m_impl.multipolygon_inner_ring_finish();
+                    }
+                    m_impl.multipolygon_polygon_finish();
+                    ++num_polygons;
+                }
+
+                if (num_polygons == 0) {
+                    throw osmium::geometry_error{"invalid area"};
+                }
+
+                return m_impl.multipolygon_finish();
+            }
+
         }; // class GeometryFactory
 
     } // namespace geom
@@ -50,8 +50,30 @@ namespace osmium {
             class GeoJSONFactoryImpl {
 
                 std::string m_str;
+                std::string* m_out = nullptr;
                 int m_precision;
 
+                // The string the geometry is written to.
+                std::string& out() noexcept {
+                    return m_out ? *m_out : m_str;
+                }
+
+                void start(const char* str) {
+                    if (!m_out) {
+                        m_str.clear();
+                    }
+                    out() += str;
+                }
+
+                std::string result() {
+                    std::string str;
+                    if (!m_out) {
+                        using std::swap;
+                        swap(str, m_str);
+                    }
+                    return str;
+                }
+
             public:
 
                 using point_type        = std::string;
@@ -64,13 +86,32 @@ namespace osmium {
                     m_precision(precision) {
                 }
 
+                /**
+                 * Create a factory that appends all geometries to the
+                 * given string instead of returning them. In this mode
+                 * the functions creating the geometries return empty
+                 * strings. This avoids allocating a new string for every
+                 * geometry.
+                 *
+                 * If creating a geometry fails with an exception, parts of
+                 * it might already have been written to the string. Remember
+                 * the size of the string before and resize it back in this
+                 * case.
+                 */
+                GeoJSONFactoryImpl(int /*srid*/, std::string& out, int precision = 7) :
+                    m_out(&out),
+                    m_precision(precision) {
+                }
+
                 /* Point */
 
                 // { "type": "Point", "coordinates": [100.0, 0.0] }
                 point_type make_point(const osmium::geom::Coordinates& xy) const {
-                    std::string str{"{\"type\":\"Point\",\"coordinates\":"};
-                    xy.append_to_string(str, '[', ',', ']', m_precision);
-                    str += "}";
+                    std::string str;
+                    std::string& s = m_out ? *m_out : str;
+                    s += "{\"type\":\"Point\",\"coordinates\":";
+                    xy.append_to_string(s, '[', ',', ']', m_precision);
+                    s += "}";
                     return str;
                 }
 
@@ -78,95 +119,80 @@ namespace osmium {
 
                 // { "type": "LineString", "coordinates": [ [100.0, 0.0], [101.0, 1.0] ] }
                 void linestring_start() {
-                    m_str = "{\"type\":\"LineString\",\"coordinates\":[";
+                    start("{\"type\":\"LineString\",\"coordinates\":[");
                 }
 
                 void linestring_add_location(const osmium::geom::Coordinates& xy) {
-                    xy.append_to_string(m_str, '[', ',', ']', m_precision);
-                    m_str += ',';
+                    xy.append_to_string(out(), '[', ',', ']', m_precision);
+                    out() += ',';
                 }
 
                 linestring_type linestring_finish(size_t /*num_points*/) {
-                    assert(!m_str.empty());
-                    std::string str;
-
-                    using std::swap;
-                    swap(str, m_str);
-
-                    str.back() = ']';
-                    str += "}";
-                    return str;
+                    assert(!out().empty());
+                    out().back() = ']';
+                    out() += "}";
+                    return result();
                 }
 
                 /* Polygon */
                 void polygon_start() {
-                    m_str = "{\"type\":\"Polygon\",\"coordinates\":[[";
+                    start("{\"type\":\"Polygon\",\"coordinates\":[[");
                 }
 
                 void polygon_add_location(const osmium::geom::Coordinates& xy) {
-                    xy.append_to_string(m_str, '[', ',', ']', m_precision);
-                    m_str += ',';
+                    xy.append_to_string(out(), '[', ',', ']', m_precision);
+                    out() += ',';
                 }
 
                 polygon_type polygon_finish(size_t /*num_points*/) {
-                    assert(!m_str.empty());
-                    std::string str;
-
-                    using std::swap;
-                    swap(str, m_str);
-
-                    str.back() = ']';
-                    str += "]}";
-                    return str;
+                    assert(!out().empty());
+                    out().back() = ']';
+                    out() += "]}";
+                    return result();
                 }
 
                 /* MultiPolygon */
 
                 void multipolygon_start() {
-                    m_str = "{\"type\":\"MultiPolygon\",\"coordinates\":[";
+                    start("{\"type\":\"MultiPolygon\",\"coordinates\":[");
                 }
 
                 void multipolygon_polygon_start() {
-                    m_str += '[';
+                    out() += '[';
                 }
 
                 void multipolygon_polygon_finish() {
-                    m_str += "],";
+                    out() += "],";
                 }
 
                 void multipolygon_outer_ring_start() {
-                    m_str += '[';
+                    out() += '[';
                 }
 
                 void multipolygon_outer_ring_finish() {
-                    assert(!m_str.empty());
-                    m_str.back() = ']';
+                    assert(!out().empty());
+                    out().back() = ']';
                 }
 
                 void multipolygon_inner_ring_start() {
-                    m_str += ",[";
+                    out() += ",[";
                 }
 
                 void multipolygon_inner_ring_finish() {
-                    assert(!m_str.empty());
-                    m_str.back() = ']';
+                    assert(!out().empty());
+                    out().back() = ']';
                 }
 
                 void multipolygon_add_location(const osmium::geom::Coordinates& xy) {
-                    xy.append_to_string(m_str, '[', ',', ']', m_precision);
-                    m_str += ',';
+                    xy.append_to_string(out(), '[', ',', ']', m_precision);
+                    out() += ',';
                 }
 
                 multipolygon_type multipolygon_finish() {
-                    assert(!m_str.empty());
-                    std::string str;
-
-                    using std::swap;
-                    swap(str, m_str);
-
-                    str.back() = ']';
-                    str += "}";
-                    return str;
+                    assert(!out().empty());
+                    out().back() = ']';
+                    out() += "}";
+                    return result();
                 }
 
             }; // class GeoJSONFactoryImpl
@@ -35,10 +35,16 @@ DEALINGS IN THE SOFTWARE.
 
 #include <osmium/geom/coordinates.hpp>
 #include <osmium/geom/util.hpp>
+#include <osmium/osm/location.hpp>
+#include <osmium/osm/node_ref.hpp>
 #include <osmium/osm/node_ref_list.hpp>
 #include <osmium/osm/way.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <iterator>
 
 namespace osmium {
@@ -102,6 +108,181 @@ namespace osmium {
                 return sum_length;
             }
 
+            namespace detail {
+
+                // Segments where the differences in longitude and latitude
+                // are both at most twice this value (in radians, about 11.4
+                // degrees) are calculated with the polynomial approximations
+                // below. All others use the exact distance() function.
+                constexpr const double max_half_delta = 0.1;
+
+                // Twice max_half_delta in fixed-point coordinates.
+                constexpr const int64_t max_delta_fixed = 114591559;
+
+                enum {
+                    batch_size = 256
+                };
+
+                // Taylor polynomial for sin(x). For |x| <= max_half_delta
+                // the absolute error is below 3e-19.
+                constexpr double sin_small(double x) noexcept {
+                    return x * (1.0 + x * x * (-1.0 / 6.0 + x * x * (1.0 / 120.0 + x * x * (-1.0 / 5040.0 + x * x * (1.0 / 362880.0)))));
+                }
+
+                // Taylor polynomial for cos(x). For |x| <= PI/2 the absolute
+                // error is below 2e-17. The last term is positive so the
+                // result never drops below the true value, which means it
+                // can't become negative at the poles.
+                constexpr double cos_half_pi(double x) noexcept {
+                    return 1.0 + x * x * (-1.0 / 2.0 + x * x * (1.0 / 24.0 + x * x * (-1.0 / 720.0 + x * x * (1.0 / 40320.0 + x * x * (-1.0 / 3628800.0 +
+                           x * x * (1.0 / 479001600.0 + x * x * (-1.0 / 87178291200.0 + x * x * (1.0 / 20922789888000.0 + x * x * (-1.0 / 6402373705728000.0 +
+                           x * x * (1.0 / 2432902008176640000.0))))))))));
+                }
+
+                // Taylor polynomial for asin(x). For 0 <= x <= 0.142 (the
+                // largest value possible for segments within the limits given
+                // by max_half_delta) the relative error is below 2e-14.
+                constexpr double asin_small(double x) noexcept {
+                    return x * (1.0 + x * x * (1.0 / 6.0 + x * x * (3.0 / 40.0 + x * x * (5.0 / 112.0 + x * x * (35.0 / 1152.0 + x * x * (63.0 / 2816.0 + x * x * (231.0 / 13312.0)))))));
+                }
+
+                // Convert fixed-point coordinate (difference) to radians.
+                constexpr double to_rad(double c) noexcept {
+                    return c * (osmium::geom::PI / 180.0 / osmium::detail::coordinate_precision);
+                }
+
+                /**
+                 * Calculate the distances between consecutive locations in
+                 * the range [first, last) and write them to out. The
+                 * get_location function is called on each element of the
+                 * range to get its location.
+                 *
+                 * The first pass only uses polynomial approximations and
+                 * no branches so that it can be vectorized by the compiler.
+                 * Segments too long for the approximations are recalculated
+                 * in a second pass.
+                 */
+                template <typename TIterator, typename TGetLocation>
+                void segment_distances_range(TIterator first, TIterator last, double* out, TGetLocation&& get_location) {
+                    if (first == last) {
+                        return;
+                    }
+
+                    double* o = out;
+                    for (auto it = first; std::next(it) != last; ++it, ++o) {
+                        const osmium::Location l1 = get_location(*it);
+                        const osmium::Location l2 = get_location(*std::next(it));
+                        const double lat1 = to_rad(static_cast<double>(l1.y()));
+                        const double lat2 = to_rad(static_cast<double>(l2.y()));
+                        // The differences are calculated on the fixed-point
+                        // coordinates (which is exact in double precision)
+                        // to avoid cancellation errors.
+                        const double lonh = sin_small(to_rad(static_cast<double>(l1.x()) - static_cast<double>(l2.x())) * 0.5);
+                        const double lath = sin_small(to_rad(static_cast<double>(l1.y()) - static_cast<double>(l2.y())) * 0.5);
+                        // The std::abs() guards against tiny negative values
+                        // from rounding errors in cos_half_pi() near the poles.
+                        const double h = std::abs(lath * lath + cos_half_pi(lat1) * cos_half_pi(lat2) * lonh * lonh);
+                        *o = 2.0 * EARTH_RADIUS_IN_METERS * asin_small(std::sqrt(h));
+                    }
+
+                    // This check is not done in the loop above, because
+                    // the compiler would not vectorize it then.
+                    o = out;
+                    for (auto it = first; std::next(it) != last; ++it, ++o) {
+                        const osmium::Location l1 = get_location(*it);
+                        const osmium::Location l2 = get_location(*std::next(it));
+                        if (std::abs(static_cast<int64_t>(l1.x()) - l2.x()) > max_delta_fixed ||
+                            std::abs(static_cast<int64_t>(l1.y()) - l2.y()) > max_delta_fixed) {
+                            *o = distance(l1, l2);
+                        }
+                    }
+                }
+
+                template <typename TIterator, typename TGetLocation>
+                double length_range(TIterator first, TIterator last, TGetLocation&& get_location) {
+                    std::array<double, batch_size> distances; // NOLINT(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
+                    double sum_length = 0;
+
+                    while (std::distance(first, last) > 1) {
+                        const auto points = std::min<std::ptrdiff_t>(std::distance(first, last), batch_size + 1);
+                        const auto chunk_last = std::next(first, points);
+                        segment_distances_range(first, chunk_last, distances.data(), get_location);
+                        for (std::ptrdiff_t i = 0; i < points - 1; ++i) {
+                            sum_length += distances[i];
+                        }
+                        first = std::prev(chunk_last);
+                    }
+
+                    return sum_length;
+                }
+
+            } // namespace detail
+
+            /**
+             * Calculate the distances in meters between consecutive
+             * locations in the range [first, last) and write them to out,
+             * which must have space for (last - first - 1) values.
+             *
+             * This uses polynomial approximations which allow the compiler
+             * to vectorize the calculation. For segments shorter than about
+             * 11 degrees in longitude and latitude the relative difference
+             * to the result of distance() is below 1e-11, longer segments
+             * are calculated with distance(). Because the coordinate
+             * differences are calculated before converting to floating
+             * point, the results for very short segments are usually more
+             * precise than those of distance().
+             *
+             * Note that GCC will only vectorize this if compiled with
+             * -fno-math-errno (which is implied by -ffast-math), because
+             * otherwise std::sqrt() must set errno.
+             *
+             * @pre All locations must be valid.
+             */
+            inline void segment_distances(const osmium::Location* first, const osmium::Location* last, double* out) {
+                detail::segment_distances_range(first, last, out, [](const osmium::Location& location) noexcept {
+                    return location;
+                });
+            }
+
+            /**
+             * Calculate the distances in meters between consecutive nodes
+             * in the node ref list and write them to out, which must have
+             * space for (nrl.size() - 1) values. See the other overload of
+             * this function for details.
+             *
+             * @pre The locations of all nodes must be valid.
+             */
+            inline void segment_distances(const osmium::NodeRefList& nrl, double* out) {
+                detail::segment_distances_range(nrl.cbegin(), nrl.cend(), out, [](const osmium::NodeRef& node_ref) noexcept {
+                    return node_ref.location();
+                });
+            }
+
+            /**
+             * Calculate length of the line through all locations in the
+             * range [first, last). Uses the same approximations as
+             * segment_distances().
+             *
+             * @pre All locations must be valid.
+             */
+            inline double fast_distance(const osmium::Location* first, const osmium::Location* last) {
+                return detail::length_range(first, last, [](const osmium::Location& location) noexcept {
+                    return location;
+                });
+            }
+
+            /**
+             * Calculate length of node list. Uses the same approximations
+             * as segment_distances().
+             *
+             * @pre The locations of all nodes must be valid.
+             */
+            inline double fast_distance(const osmium::NodeRefList& nrl) {
+                return detail::length_range(nrl.cbegin(), nrl.cend(), [](const osmium::NodeRef& node_ref) noexcept {
+                    return node_ref.location();
+                });
+            }
+
         } // namespace haversine
 
     } // namespace geom
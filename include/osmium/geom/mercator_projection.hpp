@@ -36,8 +36,11 @@ DEALINGS IN THE SOFTWARE.
 #include <osmium/geom/coordinates.hpp>
 #include <osmium/geom/util.hpp>
 #include <osmium/osm/location.hpp>
+#include <osmium/osm/node_ref.hpp>
+#include <osmium/osm/node_ref_list.hpp>
 
 #include <cmath>
+#include <cstdint>
 #include <string>
 
 namespace osmium {
@@ -57,20 +60,10 @@ namespace osmium {
                 return earth_radius_for_epsg3857 * std::log(std::tan((osmium::geom::PI / 4) + (deg_to_rad(lat) / 2)));
             }
 
-#ifdef OSMIUM_USE_SLOW_MERCATOR_PROJECTION
-            inline double lat_to_y(double lat) {
-                return lat_to_y_with_tan(lat);
-            }
-#else
-
-            // This is a much faster implementation than the canonical
-            // implementation using the tan() function. For details
-            // see https://github.com/osmcode/mercator-projection .
-            inline double lat_to_y(double lat) { // not constexpr because math functions aren't
-                if (lat < -78.0 || lat > 78.0) {
-                    return lat_to_y_with_tan(lat);
-                }
-
+            // Rational polynomial approximation of lat_to_y_with_tan(). Only
+            // valid for latitudes between -78 and +78 degrees. There are no
+            // branches in here so loops calling this can be vectorized.
+            constexpr double lat_to_y_polynomial(double lat) noexcept {
                 return earth_radius_for_epsg3857 *
                     ((((((((((-3.1112583378460085319e-23  * lat +
                                2.0465852743943268009e-19) * lat +
@@ -94,6 +87,23 @@ namespace osmium {
                               -3.4554675198786337842e-4)  * lat +
                               -5.4367203601085991108e-4)  * lat + 1.0);
             }
+
+#ifdef OSMIUM_USE_SLOW_MERCATOR_PROJECTION
+            inline double lat_to_y(double lat) {
+                return lat_to_y_with_tan(lat);
+            }
+#else
+
+            // This is a much faster implementation than the canonical
+            // implementation using the tan() function. For details
+            // see https://github.com/osmcode/mercator-projection .
+            inline double lat_to_y(double lat) { // not constexpr because math functions aren't
+                if (lat < -78.0 || lat > 78.0) {
+                    return lat_to_y_with_tan(lat);
+                }
+
+                return lat_to_y_polynomial(lat);
+            }
 #endif
 
             constexpr double x_to_lon(double x) {
@@ -104,6 +114,51 @@ namespace osmium {
                 return rad_to_deg((2 * std::atan(std::exp(y / earth_radius_for_epsg3857))) - (osmium::geom::PI / 2));
             }
 
+            /**
+             * Project all locations in the range [first, last) into out.
+             * The get_location function is called on each element of the
+             * range to get its location.
+             *
+             * This is done in two passes: The first pass uses only the
+             * branch-free lon_to_x() and lat_to_y_polynomial() functions
+             * so that the compiler can vectorize it. The (rare) latitudes
+             * outside the range of the polynomial are fixed up in a second
+             * pass. The results are the same as those from lat_to_y().
+             */
+            template <typename TIterator, typename TGetLocation>
+            void lonlat_to_mercator_range(TIterator first, TIterator last, Coordinates* out, TGetLocation&& get_location) {
+                int needs_fixup = 0;
+                Coordinates* o = out;
+                for (auto it = first; it != last; ++it, ++o) {
+                    const osmium::Location location = get_location(*it);
+                    const double lon = static_cast<double>(location.x()) / osmium::detail::coordinate_precision;
+                    const double lat = static_cast<double>(location.y()) / osmium::detail::coordinate_precision;
+                    o->x = lon_to_x(lon);
+#ifdef OSMIUM_USE_SLOW_MERCATOR_PROJECTION
+                    o->y = lat_to_y_with_tan(lat);
+#else
+                    o->y = lat_to_y_polynomial(lat);
+                    // Check the latitude limit of lat_to_y_polynomial() on
+                    // the fixed-point coordinates, because the compiler
+                    // can't vectorize this loop when comparing doubles here.
+                    needs_fixup |= (location.y() < -78 * osmium::detail::coordinate_precision) |
+                                   (location.y() > 78 * osmium::detail::coordinate_precision);
+#endif
+                }
+
+                if (!needs_fixup) {
+                    return;
+                }
+
+                o = out;
+                for (auto it = first; it != last; ++it, ++o) {
+                    const double lat = static_cast<double>(get_location(*it).y()) / osmium::detail::coordinate_precision;
+                    if (lat < -78.0 || lat > 78.0) {
+                        o->y = lat_to_y_with_tan(lat);
+                    }
+                }
+            }
+
         } // namespace detail
 
         /**
@@ -135,6 +190,38 @@ namespace osmium {
             return Coordinates{detail::x_to_lon(c.x), detail::y_to_lat(c.y)};
         }
 
+        /**
+         * Convert the locations in the range [first, last) from WGS84
+         * lon/lat to web mercator and write the results to out, which
+         * must have space for (last - first) coordinates.
+         *
+         * This gives the same results as calling lonlat_to_mercator() on
+         * each location, but is much faster on larger numbers of locations
+         * because the calculation can be vectorized.
+         *
+         * @pre All locations must be valid and in the range described
+         *      for lonlat_to_mercator().
+         */
+        inline void lonlat_to_mercator(const osmium::Location* first, const osmium::Location* last, Coordinates* out) {
+            detail::lonlat_to_mercator_range(first, last, out, [](const osmium::Location& location) noexcept {
+                return location;
+            });
+        }
+
+        /**
+         * Convert the locations of all nodes in the node ref list from
+         * WGS84 lon/lat to web mercator and write the results to out,
+         * which must have space for nrl.size() coordinates.
+         *
+         * @pre All locations must be valid and in the range described
+         *      for lonlat_to_mercator().
+         */
+        inline void lonlat_to_mercator(const osmium::NodeRefList& nrl, Coordinates* out) {
+            detail::lonlat_to_mercator_range(nrl.cbegin(), nrl.cend(), out, [](const osmium::NodeRef& node_ref) noexcept {
+                return node_ref.location();
+            });
+        }
+
         /**
          * Functor that does projection from WGS84 (EPSG:4326) to "Web
          * Mercator" (EPSG:3857)
@@ -0,0 +1,250 @@
+#ifndef OSMIUM_GEOM_SIMPLIFY_HPP
+#define OSMIUM_GEOM_SIMPLIFY_HPP
+
+/*
+
+This file is part of Osmium (https://osmcode.org/libosmium).
+
+Copyright 2013-2026 Jochen Topf <jochen@topf.org> and others (see README).
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include <osmium/geom/coordinates.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace osmium {
+
+    namespace geom {
+
+        namespace detail {
+
+            /**
+             * Squared distance of point p from the segment a-b.
+             */
+            inline double squared_segment_distance(const Coordinates& p, const Coordinates& a, const Coordinates& b) noexcept {
+                double x = a.x;
+                double y = a.y;
+                const double dx = b.x - x;
+                const double dy = b.y - y;
+
+                if (dx != 0.0 || dy != 0.0) {
+                    const double t = ((p.x - x) * dx + (p.y - y) * dy) / (dx * dx + dy * dy);
+                    if (t > 1.0) {
+                        x = b.x;
+                        y = b.y;
+                    } else if (t > 0.0) {
+                        x += dx * t;
+                        y += dy * t;
+                    }
+                }
+
+                const double ex = p.x - x;
+                const double ey = p.y - y;
+                return ex * ex + ey * ey;
+            }
+
+            /**
+             * Area of the triangle a-b-c.
+             */
+            inline double triangle_area(const Coordinates& a, const Coordinates& b, const Coordinates& c) noexcept {
+                return std::abs((b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y)) / 2;
+            }
+
+        } // namespace detail
+
+        /**
+         * Simplifies linestrings and rings given as coordinates, usually
+         * in some projection created with GeometryFactory::project(). The
+         * first and last points are always kept, so closed rings stay
+         * closed. Simplification can make rings degenerate, check that
+         * there are at least four points left before creating a polygon.
+         *
+         * The object keeps some internal buffers between uses, so it is
+         * most efficient to use the same object for many geometries.
+         */
+        class Simplifier {
+
+            // Point queued in the Visvalingam algorithm: effective area
+            // and index.
+            using area_entry = std::pair<double, std::size_t>;
+
+            std::vector<char> m_keep;
+            std::vector<std::pair<std::size_t, std::size_t>> m_stack;
+            std::vector<std::size_t> m_prev;
+            std::vector<std::size_t> m_next;
+            std::vector<double> m_area;
+            std::vector<area_entry> m_queue;
+
+            void remove_dropped(std::vector<Coordinates>& coordinates) const {
+                std::size_t out = 0;
+                for (std::size_t i = 0; i < coordinates.size(); ++i) {
+                    if (m_keep[i]) {
+                        coordinates[out++] = coordinates[i];
+                    }
+                }
+                coordinates.resize(out);
+            }
+
+        public:
+
+            /**
+             * Simplify with the Douglas-Peucker algorithm. All points that
+             * are less than tolerance away from the simplified line are
+             * removed.
+             *
+             * @param coordinates The points, they are modified in place.
+             * @param tolerance Maximum distance (in the units of the
+             *                  coordinates) between original and
+             *                  simplified line.
+             */
+            void douglas_peucker(std::vector<Coordinates>& coordinates, double tolerance) {
+                if (coordinates.size() < 3) {
+                    return;
+                }
+
+                const double max_squared_distance = tolerance * tolerance;
+                m_keep.assign(coordinates.size(), 0);
+                m_keep.front() = 1;
+                m_keep.back() = 1;
+
+                m_stack.clear();
+                m_stack.emplace_back(0, coordinates.size() - 1);
+                while (!m_stack.empty()) {
+                    const auto first = m_stack.back().first;
+                    const auto last = m_stack.back().second;
+                    m_stack.pop_back();
+
+                    double max_distance = 0.0;
+                    std::size_t index = 0;
+                    for (std::size_t i = first + 1; i < last; ++i) {
+                        const double distance = detail::squared_segment_distance(coordinates[i], coordinates[first], coordinates[last]);
+                        if (distance > max_distance) {
+                            max_distance = distance;
+                            index = i;
+                        }
+                    }
+
+                    if (max_distance > max_squared_distance) {
+                        m_keep[index] = 1;
+                        if (index - first > 1) {
+                            m_stack.emplace_back(first, index);
+                        }
+                        if (last - index > 1) {
+                            m_stack.emplace_back(index, last);
+                        }
+                    }
+                }
+
+                remove_dropped(coordinates);
+            }
+
+            /**
+             * Simplify with the Visvalingam-Whyatt algorithm. Points are
+             * removed in the order of the area of the triangle they form
+             * with their neighbours until all remaining points have an
+             * area of at least min_area.
+             *
+             * @param coordinates The points, they are modified in place.
+             * @param min_area Minimum area (in the square of the units of
+             *                 the coordinates) of the triangle formed by
+             *                 a point and its neighbours.
+             */
+            void visvalingam(std::vector<Coordinates>& coordinates, double min_area) {
+                if (coordinates.size() < 3) {
+                    return;
+                }
+
+                const std::size_t size = coordinates.size();
+                m_keep.assign(size, 1);
+                m_prev.resize(size);
+                m_next.resize(size);
+                m_area.resize(size);
+                m_queue.clear();
+
+                for (std::size_t i = 1; i < size - 1; ++i) {
+                    m_prev[i] = i - 1;
+                    m_next[i] = i + 1;
+                    m_area[i] = detail::triangle_area(coordinates[i - 1], coordinates[i], coordinates[i + 1]);
+                    m_queue.emplace_back(m_area[i], i);
+                }
+
+                // Min heap on the effective area.
+                const std::greater<area_entry> compare;
+                std::make_heap(m_queue.begin(), m_queue.end(), compare);
+
+                // Areas of the neighbours of a removed point never get
+                // smaller than the area of that point, so that the points
+                // are removed in a well defined order.
+                const auto update = [&](std::size_t i, double removed_area) {
+                    if (i == 0 || i == size - 1) {
+                        return;
+                    }
+                    const double area = detail::triangle_area(coordinates[m_prev[i]], coordinates[i], coordinates[m_next[i]]);
+                    m_area[i] = area < removed_area ? removed_area : area;
+                    m_queue.emplace_back(m_area[i], i);
+                    std::push_heap(m_queue.begin(), m_queue.end(), compare);
+                };
+
+                while (!m_queue.empty()) {
+                    const auto entry = m_queue.front();
+                    if (entry.first >= min_area) {
+                        break;
+                    }
+                    std::pop_heap(m_queue.begin(), m_queue.end(), compare);
+                    m_queue.pop_back();
+
+                    const std::size_t i = entry.second;
+                    // Skip removed points and outdated entries.
+                    if (!m_keep[i] || entry.first != m_area[i]) {
+                        continue;
+                    }
+
+                    m_keep[i] = 0;
+                    const std::size_t prev = m_prev[i];
+                    const std::size_t next = m_next[i];
+                    m_next[prev] = next;
+                    m_prev[next] = prev;
+                    update(prev, entry.first);
+                    update(next, entry.first);
+                }
+
+                remove_dropped(coordinates);
+            }
+
+        }; // class Simplifier
+
+    } // namespace geom
+
+} // namespace osmium
+
+#endif // OSMIUM_GEOM_SIMPLIFY_HPP
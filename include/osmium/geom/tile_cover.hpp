@@ -0,0 +1,354 @@
+#ifndef OSMIUM_GEOM_TILE_COVER_HPP
+#define OSMIUM_GEOM_TILE_COVER_HPP
+
+/*
+
+This file is part of Osmium (https://osmcode.org/libosmium).
+
+Copyright 2013-2026 Jochen Topf <jochen@topf.org> and others (see README).
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include <osmium/geom/coordinates.hpp>
+#include <osmium/geom/mercator_projection.hpp>
+#include <osmium/geom/tile.hpp>
+#include <osmium/osm/area.hpp>
+#include <osmium/osm/item_type.hpp>
+#include <osmium/osm/location.hpp>
+#include <osmium/osm/node_ref_list.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+namespace osmium {
+
+    namespace geom {
+
+        /**
+         * Calculates the set of tiles in a zoom level touched by a
+         * location, a linestring or an area. Linestrings touch all tiles
+         * any of their segments pass through, areas additionally touch all
+         * tiles that are completely inside them.
+         *
+         * Locations outside the range of the web mercator projection are
+         * clamped to the border tiles, invalid locations are ignored.
+         *
+         * The object keeps some internal buffers between uses, so it is
+         * most efficient to use the same object for many calculations.
+         * Typical use:
+         * @code
+         * osmium::geom::TileCover cover{14};
+         * ...
+         * cover.clear();
+         * cover.add_linestring(way.nodes());
+         * cover.for_each_tile([](const osmium::geom::Tile& tile) {
+         *     ...
+         * });
+         * @endcode
+         */
+        class TileCover {
+
+            uint32_t m_zoom;
+            uint32_t m_num_tiles;
+
+            // Valid locations of the current linestring or ring with
+            // latitudes clamped to the range of the projection.
+            std::vector<osmium::Location> m_locations;
+
+            // Coordinates of the current linestring or ring in tile units,
+            // ie. the integer part is the tile number.
+            std::vector<osmium::geom::Coordinates> m_coordinates;
+
+            // Tile row and x coordinate (in tile units) where a ring crosses
+            // the horizontal line through the centers of the tiles in
+            // that row.
+            std::vector<std::pair<uint32_t, double>> m_crossings;
+
+            // Tiles found with x in the high and y in the low 32 bits.
+            std::vector<uint64_t> m_tiles;
+
+            bool m_sorted = true;
+
+            static uint64_t tile_key(uint32_t x, uint32_t y) noexcept {
+                return (static_cast<uint64_t>(x) << 32U) | y;
+            }
+
+            void add_tile(uint32_t x, uint32_t y) {
+                const auto key = tile_key(x, y);
+                if (m_tiles.empty() || m_tiles.back() != key) {
+                    m_sorted = m_sorted && (m_tiles.empty() || m_tiles.back() < key);
+                    m_tiles.push_back(key);
+                }
+            }
+
+            uint32_t cell(double value) const noexcept {
+                if (value <= 0.0) {
+                    return 0;
+                }
+                if (value >= static_cast<double>(m_num_tiles)) {
+                    return m_num_tiles - 1;
+                }
+                return static_cast<uint32_t>(value);
+            }
+
+            // Project the valid locations from the node ref list into
+            // m_coordinates in tile units.
+            void project(const osmium::NodeRefList& nrl) {
+                constexpr const int32_t max_y = static_cast<int32_t>(MERCATOR_MAX_LAT * osmium::detail::coordinate_precision);
+
+                m_locations.clear();
+                for (const auto& node_ref : nrl) {
+                    const auto location = node_ref.location();
+                    if (location.valid()) {
+                        m_locations.emplace_back(location.x(), std::max(-max_y, std::min(max_y, location.y())));
+                    }
+                }
+
+                m_coordinates.resize(m_locations.size());
+                if (m_locations.empty()) {
+                    return;
+                }
+                lonlat_to_mercator(m_locations.data(), m_locations.data() + m_locations.size(), m_coordinates.data());
+
+                const double factor = static_cast<double>(m_num_tiles) / (detail::max_coordinate_epsg3857 * 2);
+                for (auto& c : m_coordinates) {
+                    c.x = (c.x + detail::max_coordinate_epsg3857) * factor;
+                    c.y = (detail::max_coordinate_epsg3857 - c.y) * factor;
+                }
+            }
+
+            // Add all tiles the segment from a to b (in tile units) passes
+            // through.
+            void add_segment(const osmium::geom::Coordinates& a, const osmium::geom::Coordinates& b) {
+                uint32_t x = cell(a.x);
+                uint32_t y = cell(a.y);
+                const uint32_t end_x = cell(b.x);
+                const uint32_t end_y = cell(b.y);
+
+                add_tile(x, y);
+
+                const double dx = b.x - a.x;
+                const double dy = b.y - a.y;
+                const bool forward_x = end_x > x;
+                const bool forward_y = end_y > y;
+
+                // Parameter along the segment (0 at a, 1 at b) where the
+                // next tile border in x or y direction is crossed and
+                // the increments of that parameter from one border to the
+                // next.
+                double next_x = dx == 0.0 ? 2.0 : ((forward_x ? x + 1 : x) - a.x) / dx;
+                double next_y = dy == 0.0 ? 2.0 : ((forward_y ? y + 1 : y) - a.y) / dy;
+                const double step_x = dx == 0.0 ? 0.0 : std::abs(1.0 / dx);
+                const double step_y = dy == 0.0 ? 0.0 : std::abs(1.0 / dy);
+
+                // Number of tile borders crossed. Counting the steps instead
+                // of comparing with the end tile makes sure the loop
+                // terminates even with rounding errors.
+                std::size_t steps = (forward_x ? end_x - x : x - end_x) +
+                                    (forward_y ? end_y - y : y - end_y);
+                while (steps > 0) {
+                    if (x != end_x && (y == end_y || next_x < next_y)) {
+                        forward_x ? ++x : --x;
+                        next_x += step_x;
+                    } else {
+                        forward_y ? ++y : --y;
+                        next_y += step_y;
+                    }
+                    add_tile(x, y);
+                    --steps;
+                }
+            }
+
+            void add_segments() {
+                if (m_coordinates.size() == 1) {
+                    add_tile(cell(m_coordinates[0].x), cell(m_coordinates[0].y));
+                    return;
+                }
+                for (std::size_t i = 1; i < m_coordinates.size(); ++i) {
+                    add_segment(m_coordinates[i - 1], m_coordinates[i]);
+                }
+            }
+
+            // Remember where the segments of the current ring cross the
+            // center lines of the tile rows.
+            void add_crossings() {
+                for (std::size_t i = 1; i < m_coordinates.size(); ++i) {
+                    const auto& a = m_coordinates[i - 1];
+                    const auto& b = m_coordinates[i];
+                    const double min_y = std::min(a.y, b.y);
+                    const double max_y = std::max(a.y, b.y);
+                    const double first_row = std::max(0.0, std::ceil(min_y - 0.5));
+                    const double end_row = std::min(static_cast<double>(m_num_tiles), std::ceil(max_y - 0.5));
+                    for (double row = first_row; row < end_row; ++row) {
+                        const double x = a.x + (row + 0.5 - a.y) * (b.x - a.x) / (b.y - a.y);
+                        m_crossings.emplace_back(static_cast<uint32_t>(row), x);
+                    }
+                }
+            }
+
+            // Add all tiles whose centers are inside the rings using the
+            // even-odd rule on the crossings found.
+            void fill_interior() {
+                std::sort(m_crossings.begin(), m_crossings.end());
+                auto it = m_crossings.cbegin();
+                while (it != m_crossings.cend()) {
+                    const auto row = it->first;
+                    const auto next = std::next(it);
+                    if (next == m_crossings.cend() || next->first != row) {
+                        // Odd number of crossings, can only happen with
+                        // rings that are not closed.
+                        it = next;
+                        continue;
+                    }
+                    const double first_col = std::max(0.0, std::ceil(it->second - 0.5));
+                    const double last_col = std::min(static_cast<double>(m_num_tiles - 1), std::floor(next->second - 0.5));
+                    for (double col = first_col; col <= last_col; ++col) {
+                        add_tile(static_cast<uint32_t>(col), row);
+                    }
+                    it = std::next(next);
+                }
+                m_crossings.clear();
+            }
+
+            void normalize() {
+                if (!m_sorted) {
+                    std::sort(m_tiles.begin(), m_tiles.end());
+                    m_tiles.erase(std::unique(m_tiles.begin(), m_tiles.end()), m_tiles.end());
+                    m_sorted = true;
+                }
+            }
+
+        public:
+
+            /**
+             * Create a TileCover for the given zoom level.
+             *
+             * @pre @code zoom <= Tile::max_zoom @endcode
+             */
+            explicit TileCover(uint32_t zoom) noexcept :
+                m_zoom(zoom),
+                m_num_tiles(num_tiles_in_zoom(zoom)) {
+                assert(zoom <= Tile::max_zoom);
+            }
+
+            /// The zoom level of the tiles.
+            uint32_t zoom() const noexcept {
+                return m_zoom;
+            }
+
+            /// Remove all tiles, keeping the capacity of internal buffers.
+            void clear() noexcept {
+                m_tiles.clear();
+                m_sorted = true;
+            }
+
+            /// Is the set of tiles empty?
+            bool empty() const noexcept {
+                return m_tiles.empty();
+            }
+
+            /**
+             * Add the tile containing the location. Does nothing if the
+             * location is invalid.
+             */
+            void add_location(const osmium::Location& location) {
+                if (!location.valid()) {
+                    return;
+                }
+                const auto c = lonlat_to_mercator(Coordinates{location.lon_without_check(),
+                                                              std::max(-MERCATOR_MAX_LAT, std::min(MERCATOR_MAX_LAT, location.lat_without_check()))});
+                const double factor = static_cast<double>(m_num_tiles) / (detail::max_coordinate_epsg3857 * 2);
+                add_tile(cell((c.x + detail::max_coordinate_epsg3857) * factor),
+                         cell((detail::max_coordinate_epsg3857 - c.y) * factor));
+            }
+
+            /**
+             * Add all tiles touched by the linestring. Node refs with
+             * invalid locations are skipped.
+             */
+            void add_linestring(const osmium::NodeRefList& nrl) {
+                project(nrl);
+                add_segments();
+            }
+
+            /**
+             * Add all tiles touched by the rings of the area and all tiles
+             * inside the area. A tile is inside the area if its center is
+             * inside an outer ring and not inside an inner ring.
+             */
+            void add_area(const osmium::Area& area) {
+                for (const auto& item : area) {
+                    if (item.type() == osmium::item_type::outer_ring ||
+                        item.type() == osmium::item_type::inner_ring) {
+                        project(static_cast<const osmium::NodeRefList&>(item));
+                        add_segments();
+                        add_crossings();
+                    }
+                }
+                fill_interior();
+            }
+
+            /**
+             * Call func with each tile (as const osmium::geom::Tile&)
+             * found. Each tile is only reported once. Tiles are sorted by
+             * x, then y coordinate.
+             */
+            template <typename TFunc>
+            void for_each_tile(TFunc&& func) {
+                normalize();
+                for (const auto key : m_tiles) {
+                    const Tile tile{m_zoom, static_cast<uint32_t>(key >> 32U), static_cast<uint32_t>(key & 0xffffffffU)};
+                    std::forward<TFunc>(func)(tile);
+                }
+            }
+
+            /**
+             * Return all tiles found sorted by x, then y coordinate.
+             */
+            std::vector<Tile> tiles() {
+                std::vector<Tile> result;
+                normalize();
+                result.reserve(m_tiles.size());
+                for_each_tile([&result](const Tile& tile) {
+                    result.push_back(tile);
+                });
+                return result;
+            }
+
+        }; // class TileCover
+
+    } // namespace geom
+
+} // namespace osmium
+
+#endif // OSMIUM_GEOM_TILE_COVER_HPP
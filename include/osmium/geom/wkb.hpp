@@ -40,7 +40,9 @@ DEALINGS IN THE SOFTWARE.
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <string>
+#include <utility>
 
 namespace osmium {
 
@@ -76,6 +78,24 @@ namespace osmium {
                 return out;
             }
 
+            /**
+             * Convert the binary data in str starting at offset to hex
+             * in place.
+             */
+            inline void convert_to_hex_in_place(std::string& str, std::size_t offset) {
+                static const char* lookup_hex = "0123456789ABCDEF";
+                const std::size_t size = str.size() - offset;
+                str.resize(offset + size * 2);
+
+                // Going backwards makes sure that no byte is overwritten
+                // before it is converted.
+                for (std::size_t i = size; i > 0; --i) {
+                    const auto c = static_cast<unsigned int>(str[offset + i - 1]);
+                    str[offset + (i - 1) * 2]     = lookup_hex[(c >> 4U) & 0xfU];
+                    str[offset + (i - 1) * 2 + 1] = lookup_hex[ c        & 0xfU];
+                }
+            }
+
             class WKBFactoryImpl {
 
                 /**
@@ -107,6 +127,8 @@ namespace osmium {
                 }; // enum class wkb_byte_order_type
 
                 std::string m_data;
+                std::string* m_out = nullptr;
+                std::size_t m_start = 0;
                 uint32_t m_points = 0;
                 int m_srid;
                 wkb_type m_wkb_type;
@@ -143,7 +165,42 @@ namespace osmium {
                         throw geometry_error{"Too many points in geometry"};
                     }
                     const auto s = static_cast<uint32_t>(size);
-                    std::copy_n(reinterpret_cast<const char*>(&s), sizeof(uint32_t), &m_data[offset]);
+                    std::copy_n(reinterpret_cast<const char*>(&s), sizeof(uint32_t), &out()[offset]);
+                }
+
+                // The string the geometry is written to. When appending to
+                // a caller-supplied string, the binary data is written there
+                // directly and converted to hex in place if needed.
+                std::string& out() noexcept {
+                    return m_out ? *m_out : m_data;
+                }
+
+                void start() {
+                    if (m_out) {
+                        m_start = m_out->size();
+                    } else {
+                        m_data.clear();
+                    }
+                }
+
+                std::string result() {
+                    if (m_out) {
+                        if (m_out_type == out_type::hex) {
+                            convert_to_hex_in_place(*m_out, m_start);
+                        }
+                        return std::string{};
+                    }
+
+                    std::string data;
+
+                    using std::swap;
+                    swap(data, m_data);
+
+                    if (m_out_type == out_type::hex) {
+                        return convert_to_hex(data);
+                    }
+
+                    return data;
                 }
 
             public:
@@ -160,9 +217,39 @@ namespace osmium {
                     m_out_type(otype) {
                 }
 
+                /**
+                 * Create a factory that appends all geometries to the
+                 * given string instead of returning them. In this mode
+                 * the functions creating the geometries return empty
+                 * strings. This avoids allocating a new string for every
+                 * geometry.
+                 *
+                 * If creating a geometry fails with an exception, parts of
+                 * it might already have been written to the string. Remember
+                 * the size of the string before and resize it back in this
+                 * case.
+                 */
+                WKBFactoryImpl(int srid, std::string& out, wkb_type wtype = wkb_type::wkb, out_type otype = out_type::binary) :
+                    m_out(&out),
+                    m_srid(srid),
+                    m_wkb_type(wtype),
+                    m_out_type(otype) {
+                }
+
                 /* Point */
 
                 point_type make_point(const osmium::geom::Coordinates& xy) const {
+                    if (m_out) {
+                        const std::size_t start = m_out->size();
+                        header(*m_out, wkbPoint, false);
+                        str_push(*m_out, xy.x);
+                        str_push(*m_out, xy.y);
+                        if (m_out_type == out_type::hex) {
+                            convert_to_hex_in_place(*m_out, start);
+                        }
+                        return std::string{};
+                    }
+
                     std::string data;
                     header(data, wkbPoint, false);
                     str_push(data, xy.x);
@@ -178,69 +265,51 @@ namespace osmium {
                 /* LineString */
 
                 void linestring_start() {
-                    m_data.clear();
-                    m_linestring_size_offset = header(m_data, wkbLineString, true);
+                    start();
+                    m_linestring_size_offset = header(out(), wkbLineString, true);
                 }
 
                 void linestring_add_location(const osmium::geom::Coordinates& xy) {
-                    str_push(m_data, xy.x);
-                    str_push(m_data, xy.y);
+                    str_push(out(), xy.x);
+                    str_push(out(), xy.y);
                 }
 
                 linestring_type linestring_finish(std::size_t num_points) {
                     set_size(m_linestring_size_offset, num_points);
-                    std::string data;
-
-                    using std::swap;
-                    swap(data, m_data);
-
-                    if (m_out_type == out_type::hex) {
-                        return convert_to_hex(data);
-                    }
-
-                    return data;
+                    return result();
                 }
 
                 /* Polygon */
 
                 void polygon_start() {
-                    m_data.clear();
-                    set_size(header(m_data, wkbPolygon, true), 1);
-                    m_ring_size_offset = m_data.size();
-                    str_push(m_data, static_cast<uint32_t>(0));
+                    start();
+                    set_size(header(out(), wkbPolygon, true), 1);
+                    m_ring_size_offset = out().size();
+                    str_push(out(), static_cast<uint32_t>(0));
                 }
 
                 void polygon_add_location(const osmium::geom::Coordinates& xy) {
-                    str_push(m_data, xy.x);
-                    str_push(m_data, xy.y);
+                    str_push(out(), xy.x);
+                    str_push(out(), xy.y);
                 }
 
                 polygon_type polygon_finish(std::size_t num_points) {
                     set_size(m_ring_size_offset, num_points);
-                    std::string data;
-
-                    using std::swap;
-                    swap(data, m_data);
-
-                    if (m_out_type == out_type::hex) {
-                        return convert_to_hex(data);
-                    }
-
-                    return data;
+                    return result();
                 }
 
                 /* MultiPolygon */
 
                 void multipolygon_start() {
-                    m_data.clear();
+                    start();
                     m_polygons = 0;
-                    m_multipolygon_size_offset = header(m_data, wkbMultiPolygon, true);
+                    m_multipolygon_size_offset = header(out(), wkbMultiPolygon, true);
                 }
 
                 void multipolygon_polygon_start() {
                     ++m_polygons;
                     m_rings = 0;
-                    m_polygon_size_offset = header(m_data, wkbPolygon, true);
+                    m_polygon_size_offset = header(out(), wkbPolygon, true);
                 }
 
                 void multipolygon_polygon_finish() {
@@ -250,8 +319,8 @@ namespace osmium {
                 void multipolygon_outer_ring_start() {
                     ++m_rings;
                     m_points = 0;
-                    m_ring_size_offset = m_data.size();
-                    str_push(m_data, static_cast<uint32_t>(0));
+                    m_ring_size_offset = out().size();
+                    str_push(out(), static_cast<uint32_t>(0));
                 }
 
                 void multipolygon_outer_ring_finish() {
@@ -261,8 +330,8 @@ namespace osmium {
                 void multipolygon_inner_ring_start() {
                     ++m_rings;
                     m_points = 0;
-                    m_ring_size_offset = m_data.size();
-                    str_push(m_data, static_cast<uint32_t>(0));
+                    m_ring_size_offset = out().size();
+                    str_push(out(), static_cast<uint32_t>(0));
                 }
 
                 void multipolygon_inner_ring_finish() {
@@ -270,23 +339,14 @@ namespace osmium {
                 }
 
                 void multipolygon_add_location(const osmium::geom::Coordinates& xy) {
-                    str_push(m_data, xy.x);
-                    str_push(m_data, xy.y);
+                    str_push(out(), xy.x);
+                    str_push(out(), xy.y);
                     ++m_points;
                 }
 
                 multipolygon_type multipolygon_finish() {
                     set_size(m_multipolygon_size_offset, m_polygons);
-                    std::string data;
-
-                    using std::swap;
-                    swap(data, m_data);
-
-                    if (m_out_type == out_type::hex) {
-                        return convert_to_hex(data);
-                    }
-
-                    return data;
+                    return result();
                 }
 
             }; // class WKBFactoryImpl
@@ -56,9 +56,40 @@ namespace osmium {
 
                 std::string m_srid_prefix;
                 std::string m_str;
+                std::string* m_out = nullptr;
                 int m_precision;
                 wkt_type m_wkt_type;
 
+                void init_srid_prefix(int srid) {
+                    if (m_wkt_type == wkt_type::ewkt) {
+                        m_srid_prefix = "SRID=";
+                        m_srid_prefix += std::to_string(srid);
+                        m_srid_prefix += ';';
+                    }
+                }
+
+                // The string the geometry is written to.
+                std::string& out() noexcept {
+                    return m_out ? *m_out : m_str;
+                }
+
+                void start(const char* type) {
+                    if (!m_out) {
+                        m_str.clear();
+                    }
+                    out() += m_srid_prefix;
+                    out() += type;
+                }
+
+                std::string result() {
+                    std::string str;
+                    if (!m_out) {
+                        using std::swap;
+                        swap(str, m_str);
+                    }
+                    return str;
+                }
+
             public:
 
                 using point_type        = std::string;
@@ -70,115 +101,114 @@ namespace osmium {
                 explicit WKTFactoryImpl(int srid, int precision = 7, wkt_type wtype = wkt_type::wkt) :
                     m_precision(precision),
                     m_wkt_type(wtype) {
-                    if (m_wkt_type == wkt_type::ewkt) {
-                        m_srid_prefix = "SRID=";
-                        m_srid_prefix += std::to_string(srid);
-                        m_srid_prefix += ';';
-                    }
+                    init_srid_prefix(srid);
+                }
+
+                /**
+                 * Create a factory that appends all geometries to the
+                 * given string instead of returning them. In this mode
+                 * the functions creating the geometries return empty
+                 * strings. This avoids allocating a new string for every
+                 * geometry.
+                 *
+                 * If creating a geometry fails with an exception, parts of
+                 * it might already have been written to the string. Remember
+                 * the size of the string before and resize it back in this
+                 * case.
+                 */
+                WKTFactoryImpl(int srid, std::string& out, int precision = 7, wkt_type wtype = wkt_type::wkt) :
+                    m_out(&out),
+                    m_precision(precision),
+                    m_wkt_type(wtype) {
+                    init_srid_prefix(srid);
                 }
 
                 /* Point */
 
                 point_type make_point(const osmium::geom::Coordinates& xy) const {
-                    std::string str{m_srid_prefix};
-                    str += "POINT";
-                    xy.append_to_string(str, '(', ' ', ')', m_precision);
+                    std::string str;
+                    std::string& s = m_out ? *m_out : str;
+                    s += m_srid_prefix;
+                    s += "POINT";
+                    xy.append_to_string(s, '(', ' ', ')', m_precision);
                     return str;
                 }
 
                 /* LineString */
 
                 void linestring_start() {
-                    m_str = m_srid_prefix;
-                    m_str += "LINESTRING(";
+                    start("LINESTRING(");
                 }
 
                 void linestring_add_location(const osmium::geom::Coordinates& xy) {
-                    xy.append_to_string(m_str, ' ', m_precision);
-                    m_str += ',';
+                    xy.append_to_string(out(), ' ', m_precision);
+                    out() += ',';
                 }
 
                 linestring_type linestring_finish(size_t /* num_points */) {
-                    assert(!m_str.empty());
-                    std::string str;
-
-                    using std::swap;
-                    swap(str, m_str);
-
-                    str.back() = ')';
-                    return str;
+                    assert(!out().empty());
+                    out().back() = ')';
+                    return result();
                 }
 
                 /* Polygon */
                 void polygon_start() {
-                    m_str = m_srid_prefix;
-                    m_str += "POLYGON((";
+                    start("POLYGON((");
                 }
 
                 void polygon_add_location(const osmium::geom::Coordinates& xy) {
-                    xy.append_to_string(m_str, ' ', m_precision);
-                    m_str += ',';
+                    xy.append_to_string(out(), ' ', m_precision);
+                    out() += ',';
                 }
 
                 polygon_type polygon_finish(size_t /* num_points */) {
-                    assert(!m_str.empty());
-                    std::string str;
-
-                    using std::swap;
-                    swap(str, m_str);
-
-                    str.back() = ')';
-                    str += ")";
-                    return str;
+                    assert(!out().empty());
+                    out().back() = ')';
+                    out() += ")";
+                    return result();
                 }
 
                 /* MultiPolygon */
 
                 void multipolygon_start() {
-                    m_str = m_srid_prefix;
-                    m_str += "MULTIPOLYGON(";
+                    start("MULTIPOLYGON(");
                 }
 
                 void multipolygon_polygon_start() {
-                    m_str += '(';
+                    out() += '(';
                 }
 
                 void multipolygon_polygon_finish() {
-                    m_str += "),";
+                    out() += "),";
                 }
 
                 void multipolygon_outer_ring_start() {
-                    m_str += '(';
+                    out() += '(';
                 }
 
                 void multipolygon_outer_ring_finish() {
-                    assert(!m_str.empty());
-                    m_str.back() = ')';
+                    assert(!out().empty());
+                    out().back() = ')';
                 }
 
                 void multipolygon_inner_ring_start() {
-                    m_str += ",(";
+                    out() += ",(";
                 }
 
                 void multipolygon_inner_ring_finish() {
-                    assert(!m_str.empty());
-                    m_str.back() = ')';
+                    assert(!out().empty());
+                    out().back() = ')';
                 }
 
                 void multipolygon_add_location(const osmium::geom::Coordinates& xy) {
-                    xy.append_to_string(m_str, ' ', m_precision);
-                    m_str += ',';
+                    xy.append_to_string(out(), ' ', m_precision);
+                    out() += ',';
                 }
 
                 multipolygon_type multipolygon_finish() {
-                    assert(!m_str.empty());
-                    std::string str;
-
-                    using std::swap;
-                    swap(str, m_str);
-
-                    str.back() = ')';
-                    return str;
+                    assert(!out().empty());
+                    out().back() = ')';
+                    return result();
                 }
 
             }; // class WKTFactoryImpl
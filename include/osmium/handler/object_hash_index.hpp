@@ -0,0 +1,172 @@
+#ifndef OSMIUM_HANDLER_OBJECT_HASH_INDEX_HPP
+#define OSMIUM_HANDLER_OBJECT_HASH_INDEX_HPP
+
+/*
+
+This file is part of Osmium (https://osmcode.org/libosmium).
+
+Copyright 2013-2026 Jochen Topf <jochen@topf.org> and others (see README).
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include <osmium/handler.hpp>
+#include <osmium/handler/check_order.hpp>
+#include <osmium/index/object_hash.hpp>
+#include <osmium/io/detail/read_write.hpp>
+#include <osmium/osm/metadata_options.hpp>
+#include <osmium/osm/node.hpp>
+#include <osmium/osm/object.hpp>
+#include <osmium/osm/relation.hpp>
+#include <osmium/osm/way.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace osmium {
+
+    namespace handler {
+
+        /**
+         * Handler that calculates a hash for each node, way, and relation
+         * (see osmium::index::object_hash()) and writes an index with the
+         * type, id, version, and hash of each object to a file. Two of
+         * those indexes can later be compared with
+         * osmium::index::diff_object_hash_files() to find out which objects
+         * have changed between two snapshots without reading the snapshots
+         * again.
+         *
+         * The index is written while the data is read, so this needs only
+         * constant memory. The input must be ordered as usual for OSM files
+         * (see the CheckOrder handler), otherwise an out_of_order_error is
+         * thrown. Several versions of the same object (from history files)
+         * are allowed.
+         *
+         * Call flush() after the last object to write out all remaining
+         * entries. The destructor will also do this, but it will ignore any
+         * errors.
+         */
+        class ObjectHashIndex : public osmium::handler::Handler {
+
+            enum {
+                entries_per_block = 16 * 1024
+            };
+
+            std::vector<osmium::index::object_hash_entry> m_entries;
+            osmium::index::object_hash_entry m_last;
+            int m_fd;
+            osmium::metadata_options m_metadata;
+            std::size_t m_count = 0;
+
+            void add(const osmium::OSMObject& object) {
+                const osmium::index::object_hash_entry entry{object.type(), object.id(), object.version(), osmium::index::object_hash(object, m_metadata)};
+
+                if (m_count > 0 && !(m_last < entry)) {
+                    throw out_of_order_error{"object hash index needs ordered input", object.id()};
+                }
+                m_last = entry;
+                ++m_count;
+
+                m_entries.push_back(entry);
+                if (m_entries.size() == entries_per_block) {
+                    flush();
+                }
+            }
+
+        public:
+
+            /**
+             * Create handler.
+             *
+             * @param fd File descriptor the index is written to. The handler
+             *           doesn't take ownership, it will not close the file.
+             * @param metadata Which metadata fields should be part of the
+             *                 hash. By default no metadata is used, so only
+             *                 changes in the contents (tags, locations, way
+             *                 nodes, members, and the visible flag) are
+             *                 detected.
+             */
+            explicit ObjectHashIndex(int fd, const osmium::metadata_options metadata = osmium::metadata_options{"none"}) :
+                m_fd(fd),
+                m_metadata(metadata) {
+                m_entries.reserve(entries_per_block);
+            }
+
+            ObjectHashIndex(const ObjectHashIndex&) = delete;
+            ObjectHashIndex& operator=(const ObjectHashIndex&) = delete;
+
+            ObjectHashIndex(ObjectHashIndex&&) = delete;
+            ObjectHashIndex& operator=(ObjectHashIndex&&) = delete;
+
+            ~ObjectHashIndex() noexcept {
+                try {
+                    flush();
+                } catch (...) { // NOLINT(bugprone-empty-catch)
+                    // Ignore any exceptions because destructor must not throw.
+                }
+            }
+
+            void node(const osmium::Node& node) {
+                add(node);
+            }
+
+            void way(const osmium::Way& way) {
+                add(way);
+            }
+
+            void relation(const osmium::Relation& relation) {
+                add(relation);
+            }
+
+            /**
+             * Write all buffered entries to the file.
+             *
+             * @throws std::system_error if the write fails.
+             */
+            void flush() {
+                if (m_entries.empty()) {
+                    return;
+                }
+                osmium::io::detail::reliable_write(m_fd,
+                                                   reinterpret_cast<const char*>(m_entries.data()),
+                                                   m_entries.size() * sizeof(osmium::index::object_hash_entry));
+                m_entries.clear();
+            }
+
+            /**
+             * The number of entries added to the index so far.
+             */
+            std::size_t count() const noexcept {
+                return m_count;
+            }
+
+        }; // class ObjectHashIndex
+
+    } // namespace handler
+
+} // namespace osmium
+
+#endif // OSMIUM_HANDLER_OBJECT_HASH_INDEX_HPP
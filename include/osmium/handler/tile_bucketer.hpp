@@ -0,0 +1,210 @@
+#ifndef OSMIUM_HANDLER_TILE_BUCKETER_HPP
+#define OSMIUM_HANDLER_TILE_BUCKETER_HPP
+
+/*
+
+This file is part of Osmium (https://osmcode.org/libosmium).
+
+Copyright 2013-2026 Jochen Topf <jochen@topf.org> and others (see README).
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include <osmium/geom/tile.hpp>
+#include <osmium/geom/tile_cover.hpp>
+#include <osmium/handler.hpp>
+#include <osmium/memory/buffer.hpp>
+#include <osmium/osm/area.hpp>
+#include <osmium/osm/item_type.hpp>
+#include <osmium/osm/node.hpp>
+#include <osmium/osm/object.hpp>
+#include <osmium/osm/way.hpp>
+#include <osmium/storage/tile_bucket_store.hpp>
+#include <osmium/thread/pool.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <vector>
+
+namespace osmium {
+
+    namespace handler {
+
+        /**
+         * Handler that finds all tiles in the zoom level of a
+         * TileBucketStore touched by nodes, ways, and areas and adds
+         * entries for them to the store. Ways and areas touch all tiles
+         * their segments go through, areas also touch all tiles inside
+         * them. See osmium::geom::TileCover for the details.
+         *
+         * Ways need node locations, so use this together with a
+         * NodeLocationsForWays handler that is called first. Objects
+         * without any valid location are ignored.
+         *
+         * Use it as a normal handler or call it on whole buffers with
+         * operator(), which calculates the tiles using several threads.
+         * Entries are written to disk when a bucket in the store is full.
+         * Call close() at the end to write the rest.
+         */
+        class TileBucketer : public osmium::handler::Handler {
+
+            osmium::TileBucketStore& m_store;
+            osmium::geom::TileCover m_cover;
+            std::vector<osmium::tile_bucket_entry> m_entries;
+
+            enum {
+                min_objects_per_shard = 1000
+            };
+
+            // Calculate the tiles for the object and add entries for them
+            // to out.
+            static void find_tiles(osmium::geom::TileCover& cover, const osmium::OSMObject& object, std::vector<osmium::tile_bucket_entry>& out) {
+                cover.clear();
+                switch (object.type()) {
+                    case osmium::item_type::node:
+                        cover.add_location(static_cast<const osmium::Node&>(object).location());
+                        break;
+                    case osmium::item_type::way:
+                        cover.add_linestring(static_cast<const osmium::Way&>(object).nodes());
+                        break;
+                    case osmium::item_type::area:
+                        cover.add_area(static_cast<const osmium::Area&>(object));
+                        break;
+                    default:
+                        return;
+                }
+                cover.for_each_tile([&](const osmium::geom::Tile& tile) {
+                    out.emplace_back(tile, object.type(), object.id());
+                });
+            }
+
+            void add(const osmium::OSMObject& object) {
+                m_entries.clear();
+                find_tiles(m_cover, object, m_entries);
+                for (const auto& entry : m_entries) {
+                    m_store.add(entry);
+                }
+            }
+
+        public:
+
+            explicit TileBucketer(osmium::TileBucketStore& store) :
+                m_store(store),
+                m_cover(store.zoom()) {
+            }
+
+            void node(const osmium::Node& node) {
+                add(node);
+            }
+
+            void way(const osmium::Way& way) {
+                add(way);
+            }
+
+            void area(const osmium::Area& area) {
+                add(area);
+            }
+
+            /**
+             * Handle all nodes, ways, and areas in the buffer. The buffer
+             * is split into as many consecutive shards as there are
+             * threads in the pool and the tiles are calculated for each
+             * shard in parallel. The entries are then added to the store in
+             * the calling thread in the order of the objects in the buffer.
+             *
+             * @param buffer The buffer with the input data.
+             * @param pool The thread pool used for the calculations.
+             * @throws std::system_error If writing to disk failed.
+             */
+            void operator()(const osmium::memory::Buffer& buffer, osmium::thread::Pool& pool = osmium::thread::Pool::default_instance()) {
+                std::vector<const osmium::OSMObject*> objects;
+                for (const auto& object : buffer.select<osmium::OSMObject>()) {
+                    if (object.type() != osmium::item_type::relation) {
+                        objects.push_back(&object);
+                    }
+                }
+
+                const auto num_threads = static_cast<std::size_t>(pool.num_threads());
+                if (num_threads < 2 || objects.size() < min_objects_per_shard * 2) {
+                    for (const auto* object : objects) {
+                        add(*object);
+                    }
+                    return;
+                }
+
+                const std::size_t shard_size = std::max(static_cast<std::size_t>(min_objects_per_shard),
+                                                        (objects.size() + num_threads - 1) / num_threads);
+                const std::size_t num_shards = (objects.size() + shard_size - 1) / shard_size;
+                std::vector<std::vector<osmium::tile_bucket_entry>> results(num_shards);
+
+                const auto zoom = m_store.zoom();
+                std::vector<std::future<void>> futures;
+                for (std::size_t shard = 0; shard < num_shards; ++shard) {
+                    futures.push_back(pool.submit([&objects, &results, zoom, shard, shard_size] {
+                        osmium::geom::TileCover cover{zoom};
+                        const std::size_t end = std::min((shard + 1) * shard_size, objects.size());
+                        for (std::size_t i = shard * shard_size; i < end; ++i) {
+                            find_tiles(cover, *objects[i], results[shard]);
+                        }
+                    }));
+                }
+
+                // Wait for all tasks before possibly rethrowing an
+                // exception, they reference local variables.
+                for (auto& future : futures) {
+                    future.wait();
+                }
+                for (auto& future : futures) {
+                    future.get();
+                }
+
+                for (const auto& result : results) {
+                    for (const auto& entry : result) {
+                        m_store.add(entry);
+                    }
+                }
+            }
+
+            /**
+             * Write all entries still in memory to disk. Call this after
+             * the last object was handled. (This is not done in flush(),
+             * because that is called after every buffer by
+             * osmium::apply() and would write many small pieces.)
+             *
+             * @throws std::system_error If writing to disk failed.
+             */
+            void close() {
+                m_store.flush();
+            }
+
+        }; // class TileBucketer
+
+    } // namespace handler
+
+} // namespace osmium
+
+#endif // OSMIUM_HANDLER_TILE_BUCKETER_HPP
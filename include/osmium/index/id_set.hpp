@@ -40,6 +40,7 @@ DEALINGS IN THE SOFTWARE.
 #include <array>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <iterator>
 #include <memory>
@@ -503,6 +504,450 @@ namespace osmium {
 
         }; // class IdSetSmall
 
+        namespace detail {
+
+            inline int popcount(uint64_t word) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+                return __builtin_popcountll(word);
+#else
+                int count = 0;
+                for (; word != 0; word &= word - 1) {
+                    ++count;
+                }
+                return count;
+#endif
+            }
+
+            // Position of the lowest set bit. Word must not be 0.
+            inline int count_trailing_zeros(uint64_t word) noexcept {
+                assert(word != 0);
+#if defined(__GNUC__) || defined(__clang__)
+                return __builtin_ctzll(word);
+#else
+                int count = 0;
+                while ((word & 1U) == 0) {
+                    word >>= 1U;
+                    ++count;
+                }
+                return count;
+#endif
+            }
+
+        } // namespace detail
+
+        template <typename T>
+        class IdSetCompact;
+
+        /**
+         * Const_iterator for iterating over a IdSetCompact.
+         */
+        template <typename T>
+        class IdSetCompactIterator {
+
+            using id_set = IdSetCompact<T>;
+
+            const id_set* m_set = nullptr;
+            std::size_t m_index = 0;
+            std::size_t m_pos = 0;
+
+        public:
+
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = T;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = value_type*;
+            using reference         = value_type&;
+
+            IdSetCompactIterator() noexcept = default;
+
+            IdSetCompactIterator(const id_set* set, std::size_t index) noexcept :
+                m_set(set),
+                m_index(index),
+                m_pos(index < set->size() ? set->next_upper_bit(0) : 0) {
+            }
+
+            IdSetCompactIterator& operator++() noexcept {
+                if (m_index != m_set->size()) {
+                    ++m_index;
+                    if (m_index != m_set->size()) {
+                        m_pos = m_set->next_upper_bit(m_pos + 1);
+                    }
+                }
+                return *this;
+            }
+
+            IdSetCompactIterator operator++(int) noexcept {
+                IdSetCompactIterator tmp{*this};
+                operator++();
+                return tmp;
+            }
+
+            bool operator==(const IdSetCompactIterator& rhs) const noexcept {
+                return m_set == rhs.m_set && m_index == rhs.m_index;
+            }
+
+            bool operator!=(const IdSetCompactIterator& rhs) const noexcept {
+                return !(*this == rhs);
+            }
+
+            T operator*() const noexcept {
+                assert(m_index < m_set->size());
+                return m_set->value(m_index, m_pos);
+            }
+
+        }; // class IdSetCompactIterator
+
+        /**
+         * Immutable compressed set of Ids. The Ids are stored using the
+         * Elias-Fano encoding which needs less than 2 + log2(max_id / size)
+         * bits per Id. This is much less than an IdSetSmall needs and, for
+         * sets that are not very dense, also less than an IdSetDense needs.
+         * Lookups with get() are done in (roughly) constant time.
+         *
+         * Create the set from a sorted range of Ids or from an existing
+         * IdSetSmall or IdSetDense. The set can not be changed after it has
+         * been created, but you can create new sets from the union or
+         * intersection of two sets.
+         */
+        template <typename T>
+        class IdSetCompact {
+
+            static_assert(std::is_unsigned<T>::value, "Needs unsigned type");
+
+            friend class IdSetCompactIterator<T>;
+
+            enum : std::size_t {
+                // Remember the position of every nth zero in the upper bits
+                zero_sample_rate = 256
+            };
+
+            // The lower bits of all Ids
+            std::vector<uint64_t> m_lower;
+
+            // The upper bits of all Ids in unary coding
+            std::vector<uint64_t> m_upper;
+
+            // Positions of every zero_sample_rate-th zero in m_upper
+            std::vector<std::size_t> m_zero_samples;
+
+            std::size_t m_size = 0;
+            std::size_t m_upper_bits = 0;
+            unsigned int m_lower_bits = 0;
+            T m_max = 0;
+
+            static unsigned int floor_log2(uint64_t value) noexcept {
+                unsigned int result = 0;
+                while (value >>= 1U) {
+                    ++result;
+                }
+                return result;
+            }
+
+            bool upper_bit(std::size_t pos) const noexcept {
+                return (m_upper[pos / 64] >> (pos % 64)) & 1U;
+            }
+
+            uint64_t lower(std::size_t index) const noexcept {
+                if (m_lower_bits == 0) {
+                    return 0;
+                }
+                const std::size_t bit = index * m_lower_bits;
+                const std::size_t word = bit / 64;
+                const unsigned int shift = bit % 64;
+                uint64_t value = m_lower[word] >> shift;
+                if (shift + m_lower_bits > 64) {
+                    value |= m_lower[word + 1] << (64 - shift);
+                }
+                return value & ((uint64_t(1) << m_lower_bits) - 1);
+            }
+
+            T value(std::size_t index, std::size_t pos) const noexcept {
+                const uint64_t high = pos - index;
+                return static_cast<T>((high << m_lower_bits) | lower(index));
+            }
+
+            // Position of the first set bit in the upper bits at or after
+            // pos. There must be such a bit.
+            std::size_t next_upper_bit(std::size_t pos) const noexcept {
+                std::size_t word = pos / 64;
+                uint64_t bits = m_upper[word] & (~uint64_t(0) << (pos % 64));
+                while (bits == 0) {
+                    ++word;
+                    assert(word < m_upper.size());
+                    bits = m_upper[word];
+                }
+                return word * 64 + detail::count_trailing_zeros(bits);
+            }
+
+            // Position of the nth (counting from 0) zero in the upper bits.
+            std::size_t select_zero(std::size_t n) const noexcept {
+                const std::size_t sample = n / zero_sample_rate;
+                assert(sample < m_zero_samples.size());
+                std::size_t pos = m_zero_samples[sample];
+                std::size_t remaining = n - sample * zero_sample_rate;
+                if (remaining == 0) {
+                    return pos;
+                }
+
+                ++pos;
+                std::size_t word = pos / 64;
+                uint64_t bits = ~m_upper[word] & (~uint64_t(0) << (pos % 64));
+                while (true) {
+                    const auto count = static_cast<std::size_t>(detail::popcount(bits));
+                    if (remaining <= count) {
+                        for (; remaining > 1; --remaining) {
+                            bits &= bits - 1;
+                        }
+                        return word * 64 + detail::count_trailing_zeros(bits);
+                    }
+                    remaining -= count;
+                    ++word;
+                    assert(word < m_upper.size());
+                    bits = ~m_upper[word];
+                }
+            }
+
+            // Allocate memory for a set of the given size and maximum Id.
+            void init(std::size_t size, T max) {
+                m_size = size;
+                m_max = max;
+                if (size == 0) {
+                    return;
+                }
+                const uint64_t ratio = static_cast<uint64_t>(max) / size;
+                m_lower_bits = ratio == 0 ? 0 : floor_log2(ratio);
+                // one extra word so that reading two words is always okay
+                m_lower.resize(((size * m_lower_bits) / 64) + 2);
+                m_upper_bits = size + (static_cast<uint64_t>(max) >> m_lower_bits) + 1;
+                m_upper.resize((m_upper_bits + 63) / 64);
+            }
+
+            void append(std::size_t index, T id) {
+                assert(index < m_size);
+                const auto value = static_cast<uint64_t>(id);
+                if (m_lower_bits > 0) {
+                    const uint64_t low = value & ((uint64_t(1) << m_lower_bits) - 1);
+                    const std::size_t bit = index * m_lower_bits;
+                    const unsigned int shift = bit % 64;
+                    m_lower[bit / 64] |= low << shift;
+                    if (shift + m_lower_bits > 64) {
+                        m_lower[(bit / 64) + 1] |= low >> (64 - shift);
+                    }
+                }
+                const std::size_t pos = (value >> m_lower_bits) + index;
+                m_upper[pos / 64] |= uint64_t(1) << (pos % 64);
+            }
+
+            void build_zero_samples() {
+                std::size_t zeros = 0;
+                for (std::size_t word = 0; word < m_upper.size(); ++word) {
+                    uint64_t bits = ~m_upper[word];
+                    if (word == m_upper.size() - 1 && m_upper_bits % 64 != 0) {
+                        bits &= (uint64_t(1) << (m_upper_bits % 64)) - 1;
+                    }
+                    const auto count = static_cast<std::size_t>(detail::popcount(bits));
+                    while (m_zero_samples.size() * zero_sample_rate < zeros + count) {
+                        uint64_t b = bits;
+                        for (std::size_t n = m_zero_samples.size() * zero_sample_rate - zeros; n > 0; --n) {
+                            b &= b - 1;
+                        }
+                        m_zero_samples.push_back(word * 64 + detail::count_trailing_zeros(b));
+                    }
+                    zeros += count;
+                }
+            }
+
+            template <typename TIterator>
+            void build(TIterator first, TIterator last) {
+                std::size_t size = 0;
+                T max = 0;
+                for (auto it = first; it != last; ++it) {
+                    assert((size == 0 || *it > max) && "Ids must be sorted and unique");
+                    max = *it;
+                    ++size;
+                }
+
+                init(size, max);
+                std::size_t index = 0;
+                for (auto it = first; it != last; ++it) {
+                    append(index++, *it);
+                }
+                build_zero_samples();
+            }
+
+            // Run the merge of two sets calling the function for every Id
+            // in the result.
+            template <typename TFunc>
+            static void for_each_merged(const IdSetCompact& a, const IdSetCompact& b, bool intersection, TFunc&& func) {
+                auto ait = a.begin();
+                auto bit = b.begin();
+                while (ait != a.end() && bit != b.end()) {
+                    const T aid = *ait;
+                    const T bid = *bit;
+                    if (aid < bid) {
+                        if (!intersection) {
+                            func(aid);
+                        }
+                        ++ait;
+                    } else if (bid < aid) {
+                        if (!intersection) {
+                            func(bid);
+                        }
+                        ++bit;
+                    } else {
+                        func(aid);
+                        ++ait;
+                        ++bit;
+                    }
+                }
+                if (!intersection) {
+                    for (; ait != a.end(); ++ait) {
+                        func(*ait);
+                    }
+                    for (; bit != b.end(); ++bit) {
+                        func(*bit);
+                    }
+                }
+            }
+
+            static IdSetCompact merge(const IdSetCompact& a, const IdSetCompact& b, bool intersection) {
+                std::size_t size = 0;
+                T max = 0;
+                for_each_merged(a, b, intersection, [&](T id) {
+                    max = id;
+                    ++size;
+                });
+
+                IdSetCompact result;
+                result.init(size, max);
+                std::size_t index = 0;
+                for_each_merged(a, b, intersection, [&](T id) {
+                    result.append(index++, id);
+                });
+                result.build_zero_samples();
+
+                return result;
+            }
+
+        public:
+
+            using const_iterator = IdSetCompactIterator<T>;
+
+            /// Create an empty set.
+            IdSetCompact() = default;
+
+            /**
+             * Create a set from a range of Ids.
+             *
+             * @pre The Ids must be sorted and unique.
+             */
+            template <typename TIterator>
+            IdSetCompact(TIterator first, TIterator last) {
+                build(first, last);
+            }
+
+            /**
+             * Create a set from an IdSetSmall.
+             *
+             * @pre You must have called sort_unique() on the IdSetSmall or be
+             *      sure there are no duplicates and the Ids have been set in
+             *      order.
+             */
+            explicit IdSetCompact(const IdSetSmall<T>& set) {
+                build(set.cbegin(), set.cend());
+            }
+
+            /**
+             * Create a set from an IdSetDense.
+             */
+            template <std::size_t chunk_bits>
+            explicit IdSetCompact(const IdSetDense<T, chunk_bits>& set) {
+                build(set.begin(), set.end());
+            }
+
+            /**
+             * Is the Id in the set?
+             *
+             * @param id The Id to check.
+             */
+            bool get(T id) const noexcept {
+                if (m_size == 0 || id > m_max) {
+                    return false;
+                }
+
+                const uint64_t high = static_cast<uint64_t>(id) >> m_lower_bits;
+                const uint64_t low = static_cast<uint64_t>(id) & ((uint64_t(1) << m_lower_bits) - 1);
+
+                // All Ids with the same upper bits are stored as consecutive
+                // ones in the upper bits after the high-th zero.
+                std::size_t pos = high == 0 ? 0 : select_zero(high - 1) + 1;
+                for (std::size_t index = pos - high; pos < m_upper_bits && upper_bit(pos); ++pos, ++index) {
+                    const uint64_t l = lower(index);
+                    if (l == low) {
+                        return true;
+                    }
+                    if (l > low) {
+                        return false;
+                    }
+                }
+
+                return false;
+            }
+
+            /**
+             * Is the set empty?
+             */
+            bool empty() const noexcept {
+                return m_size == 0;
+            }
+
+            /**
+             * The number of Ids stored in the set.
+             */
+            std::size_t size() const noexcept {
+                return m_size;
+            }
+
+            /**
+             * Get an estimate of the amount of memory used for the set.
+             */
+            std::size_t used_memory() const noexcept {
+                return (m_lower.capacity() + m_upper.capacity()) * sizeof(uint64_t) +
+                       m_zero_samples.capacity() * sizeof(std::size_t);
+            }
+
+            const_iterator begin() const noexcept {
+                return {this, 0};
+            }
+
+            const_iterator end() const noexcept {
+                return {this, m_size};
+            }
+
+            const_iterator cbegin() const noexcept {
+                return begin();
+            }
+
+            const_iterator cend() const noexcept {
+                return end();
+            }
+
+            /**
+             * Create a new set with all Ids that are in any of the two sets.
+             */
+            friend IdSetCompact set_union(const IdSetCompact& a, const IdSetCompact& b) {
+                return merge(a, b, false);
+            }
+
+            /**
+             * Create a new set with all Ids that are in both sets.
+             */
+            friend IdSetCompact set_intersection(const IdSetCompact& a, const IdSetCompact& b) {
+                return merge(a, b, true);
+            }
+
+        }; // class IdSetCompact
+
     } // namespace index
 
 } // namespace osmium
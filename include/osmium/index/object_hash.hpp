@@ -0,0 +1,402 @@
+#ifndef OSMIUM_INDEX_OBJECT_HASH_HPP
+#define OSMIUM_INDEX_OBJECT_HASH_HPP
+
+/*
+
+This file is part of Osmium (https://osmcode.org/libosmium).
+
+Copyright 2013-2026 Jochen Topf <jochen@topf.org> and others (see README).
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include <osmium/io/detail/read_write.hpp>
+#include <osmium/osm/crc.hpp>
+#include <osmium/osm/crc64.hpp>
+#include <osmium/osm/item_type.hpp>
+#include <osmium/osm/metadata_options.hpp>
+#include <osmium/osm/node.hpp>
+#include <osmium/osm/object.hpp>
+#include <osmium/osm/object_comparisons.hpp>
+#include <osmium/osm/relation.hpp>
+#include <osmium/osm/types.hpp>
+#include <osmium/osm/way.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace osmium {
+
+    namespace index {
+
+        /**
+         * One entry in an object hash index: The type, id, and version
+         * of an object and a 64 bit hash of its contents. Entries are
+         * stored in index files in exactly this layout (24 bytes per
+         * entry in native byte order).
+         */
+        struct object_hash_entry {
+
+            osmium::object_id_type id = 0;
+            uint64_t hash = 0;
+            osmium::object_version_type version = 0;
+            uint32_t type = 0;
+
+            object_hash_entry() noexcept = default;
+
+            object_hash_entry(const osmium::item_type t, const osmium::object_id_type i, const osmium::object_version_type v, const uint64_t h) noexcept :
+                id(i),
+                hash(h),
+                version(v),
+                type(static_cast<uint32_t>(t)) {
+            }
+
+            osmium::item_type item_type() const noexcept {
+                return static_cast<osmium::item_type>(type);
+            }
+
+        }; // struct object_hash_entry
+
+        static_assert(sizeof(object_hash_entry) == 24, "object_hash_entry must have size 24");
+
+        /**
+         * Order object hash entries the same way objects are ordered in
+         * OSM files: by type, then id (see osmium::id_order), then version.
+         */
+        inline bool operator<(const object_hash_entry& lhs, const object_hash_entry& rhs) noexcept {
+            if (lhs.type != rhs.type) {
+                return lhs.type < rhs.type;
+            }
+            if (lhs.id != rhs.id) {
+                return osmium::id_order{}(lhs.id, rhs.id);
+            }
+            return lhs.version < rhs.version;
+        }
+
+        /**
+         * Are the two entries for the same object (type and id), maybe in
+         * different versions?
+         */
+        inline bool same_object(const object_hash_entry& lhs, const object_hash_entry& rhs) noexcept {
+            return lhs.type == rhs.type && lhs.id == rhs.id;
+        }
+
+        /**
+         * Calculate a 64 bit hash over the contents of an OSM object. The
+         * hash always covers the visible flag, the tags, and the location
+         * (nodes), node ids (ways), or members (relations). Node locations
+         * in ways are not included, so the hash doesn't depend on whether
+         * a file has way node locations or not. Which of the metadata
+         * fields are included is set with the metadata_options. The id is
+         * never part of the hash.
+         *
+         * The hash is calculated with osmium::CRC and CRC-64, it is stable
+         * across runs and platforms.
+         */
+        inline uint64_t object_hash(const osmium::OSMObject& object, const osmium::metadata_options metadata = osmium::metadata_options{"none"}) noexcept {
+            osmium::CRC<osmium::CRC_crc64> crc;
+
+            crc.update_bool(object.visible());
+            if (metadata.version()) {
+                crc.update_int32(object.version());
+            }
+            if (metadata.timestamp()) {
+                crc.update(object.timestamp());
+            }
+            if (metadata.changeset()) {
+                crc.update_int32(object.changeset());
+            }
+            if (metadata.uid()) {
+                crc.update_int32(object.uid());
+            }
+            if (metadata.user()) {
+                crc.update_string(object.user());
+            }
+            crc.update(object.tags());
+
+            switch (object.type()) {
+                case osmium::item_type::node:
+                    crc.update(static_cast<const osmium::Node&>(object).location());
+                    break;
+                case osmium::item_type::way:
+                    for (const auto& node_ref : static_cast<const osmium::Way&>(object).nodes()) {
+                        crc.update_int64(static_cast<uint64_t>(node_ref.ref()));
+                    }
+                    break;
+                case osmium::item_type::relation:
+                    crc.update(static_cast<const osmium::Relation&>(object).members());
+                    break;
+                default:
+                    break;
+            }
+
+            return crc().checksum();
+        }
+
+        /**
+         * Reads object hash entries from a file descriptor. The entries
+         * are read in larger blocks.
+         */
+        class ObjectHashReader {
+
+            enum {
+                entries_per_block = 16 * 1024
+            };
+
+            std::vector<object_hash_entry> m_block;
+            std::size_t m_pos = 0;
+            int m_fd;
+            bool m_eof = false;
+
+            void read_block() {
+                m_block.resize(entries_per_block);
+                const std::size_t bytes = m_block.size() * sizeof(object_hash_entry);
+                auto* data = reinterpret_cast<char*>(m_block.data());
+
+                std::size_t offset = 0;
+                while (offset < bytes) {
+                    const auto nread = osmium::io::detail::reliable_read(m_fd, data + offset, static_cast<unsigned int>(bytes - offset));
+                    if (nread == 0) {
+                        m_eof = true;
+                        break;
+                    }
+                    offset += static_cast<std::size_t>(nread);
+                }
+
+                if (offset % sizeof(object_hash_entry) != 0) {
+                    throw std::runtime_error{"object hash index has incomplete entry at end"};
+                }
+                m_block.resize(offset / sizeof(object_hash_entry));
+                m_pos = 0;
+            }
+
+        public:
+
+            /**
+             * Create reader.
+             *
+             * @param fd File descriptor to read from. The reader doesn't
+             *           take ownership, it will not close the file.
+             */
+            explicit ObjectHashReader(int fd) :
+                m_fd(fd) {
+            }
+
+            /**
+             * Read the next entry.
+             *
+             * @param entry Entry will be written here.
+             * @returns false if there are no more entries, true otherwise.
+             * @throws std::system_error if the file can not be read.
+             * @throws std::runtime_error if the file has an incomplete
+             *         entry at the end.
+             */
+            bool read(object_hash_entry& entry) {
+                if (m_pos == m_block.size()) {
+                    if (m_eof) {
+                        return false;
+                    }
+                    read_block();
+                    if (m_block.empty()) {
+                        return false;
+                    }
+                }
+                entry = m_block[m_pos++];
+                return true;
+            }
+
+        }; // class ObjectHashReader
+
+        /**
+         * Read all entries from an object hash index file.
+         *
+         * @param fd File descriptor to read from.
+         * @returns Vector with all entries in the order they are in the file.
+         */
+        inline std::vector<object_hash_entry> read_object_hashes(int fd) {
+            std::vector<object_hash_entry> entries;
+            ObjectHashReader reader{fd};
+            object_hash_entry entry;
+            while (reader.read(entry)) {
+                entries.push_back(entry);
+            }
+            return entries;
+        }
+
+        /**
+         * The kind of change found between two object hash indexes.
+         */
+        enum class object_hash_change : uint8_t {
+            created  = 0, ///< object only in new index
+            deleted  = 1, ///< object only in old index
+            modified = 2  ///< object in both indexes with different hashes
+        };
+
+        namespace detail {
+
+            template <typename TIterator>
+            class object_hash_range_source {
+
+                TIterator m_it;
+                TIterator m_end;
+
+            public:
+
+                object_hash_range_source(TIterator begin, TIterator end) :
+                    m_it(begin),
+                    m_end(end) {
+                }
+
+                bool read(object_hash_entry& entry) {
+                    if (m_it == m_end) {
+                        return false;
+                    }
+                    entry = *m_it++;
+                    return true;
+                }
+
+            }; // class object_hash_range_source
+
+            /**
+             * Wraps a source of object hash entries and only returns the
+             * last entry (the one with the highest version) for each
+             * object. This makes diffs work on history indexes, too.
+             */
+            template <typename TSource>
+            class latest_version_source {
+
+                TSource& m_source;
+                object_hash_entry m_next;
+                bool m_has_next;
+
+            public:
+
+                explicit latest_version_source(TSource& source) :
+                    m_source(source),
+                    m_has_next(source.read(m_next)) {
+                }
+
+                bool read(object_hash_entry& entry) {
+                    if (!m_has_next) {
+                        return false;
+                    }
+                    entry = m_next;
+                    while ((m_has_next = m_source.read(m_next)) && same_object(entry, m_next)) {
+                        entry = m_next;
+                    }
+                    return true;
+                }
+
+            }; // class latest_version_source
+
+        } // namespace detail
+
+        /**
+         * Compare two object hash indexes and call a function for each
+         * object that was created, deleted, or modified. Both sources
+         * must return their entries in order (see operator< on
+         * object_hash_entry) as written by the ObjectHashIndex handler.
+         * Sources are read in a single pass, so this needs only constant
+         * memory. If there are several versions of an object in an index,
+         * only the last one is compared.
+         *
+         * An object is reported as modified if the hashes differ. Whether
+         * a new version with the same contents counts as a change depends
+         * on the metadata options used when calculating the hashes.
+         *
+         * @tparam TSource1 Any class with a member function
+         *                  `bool read(object_hash_entry&)` such as the
+         *                  ObjectHashReader.
+         * @tparam TSource2 Same as TSource1.
+         * @param old_source Source with entries from old data.
+         * @param new_source Source with entries from new data.
+         * @param func Function called as
+         *             `func(object_hash_change, const object_hash_entry&)`
+         *             with the new entry for created and modified objects
+         *             and the old entry for deleted objects.
+         */
+        template <typename TSource1, typename TSource2, typename TFunc>
+        void diff_object_hashes(TSource1& old_source, TSource2& new_source, TFunc&& func) {
+            detail::latest_version_source<TSource1> old_entries{old_source};
+            detail::latest_version_source<TSource2> new_entries{new_source};
+
+            object_hash_entry old_entry;
+            object_hash_entry new_entry;
+            bool has_old = old_entries.read(old_entry);
+            bool has_new = new_entries.read(new_entry);
+
+            while (has_old || has_new) {
+                if (has_old && has_new && same_object(old_entry, new_entry)) {
+                    if (old_entry.hash != new_entry.hash) {
+                        func(object_hash_change::modified, new_entry);
+                    }
+                    has_old = old_entries.read(old_entry);
+                    has_new = new_entries.read(new_entry);
+                } else if (!has_new || (has_old && old_entry < new_entry)) {
+                    func(object_hash_change::deleted, old_entry);
+                    has_old = old_entries.read(old_entry);
+                } else {
+                    func(object_hash_change::created, new_entry);
+                    has_new = new_entries.read(new_entry);
+                }
+            }
+        }
+
+        /**
+         * Compare two sorted vectors of object hash entries. See the
+         * diff_object_hashes() function for sources for details.
+         */
+        template <typename TFunc>
+        void diff_object_hashes(const std::vector<object_hash_entry>& old_entries, const std::vector<object_hash_entry>& new_entries, TFunc&& func) {
+            using source_type = detail::object_hash_range_source<std::vector<object_hash_entry>::const_iterator>;
+            source_type old_source{old_entries.cbegin(), old_entries.cend()};
+            source_type new_source{new_entries.cbegin(), new_entries.cend()};
+            diff_object_hashes(old_source, new_source, std::forward<TFunc>(func));
+        }
+
+        /**
+         * Compare two object hash index files. See the diff_object_hashes()
+         * function for sources for details.
+         *
+         * @param old_fd File descriptor of the index of the old data.
+         * @param new_fd File descriptor of the index of the new data.
+         * @param func Function called for each changed object.
+         */
+        template <typename TFunc>
+        void diff_object_hash_files(int old_fd, int new_fd, TFunc&& func) {
+            ObjectHashReader old_source{old_fd};
+            ObjectHashReader new_source{new_fd};
+            diff_object_hashes(old_source, new_source, std::forward<TFunc>(func));
+        }
+
+    } // namespace index
+
+} // namespace osmium
+
+#endif // OSMIUM_INDEX_OBJECT_HASH_HPP
@@ -33,6 +33,7 @@ DEALINGS IN THE SOFTWARE.
 
 */
 
+#include <osmium/io/detail/read_ahead.hpp>
 #include <osmium/io/detail/read_write.hpp>
 #include <osmium/io/error.hpp>
 #include <osmium/io/file_compression.hpp>
@@ -57,6 +58,8 @@ namespace osmium {
         class Compressor {
 
             fsync m_fsync;
+            std::size_t m_fsync_interval = 0;
+            std::size_t m_bytes_since_fsync = 0;
 
         protected:
 
@@ -64,6 +67,23 @@ namespace osmium {
                 return m_fsync == fsync::yes;
             }
 
+            /**
+             * Call this after size bytes have been written to the file
+             * descriptor. Does an fsync if the fsync interval is set and
+             * enough data was written since the last one.
+             */
+            void fsync_if_interval_reached(const int fd, const std::size_t size) {
+                // Do not sync stdout
+                if (m_fsync_interval == 0 || fd == 1) {
+                    return;
+                }
+                m_bytes_since_fsync += size;
+                if (m_bytes_since_fsync >= m_fsync_interval) {
+                    osmium::io::detail::reliable_fsync(fd);
+                    m_bytes_since_fsync = 0;
+                }
+            }
+
         public:
 
             explicit Compressor(const fsync sync) noexcept :
@@ -78,6 +98,16 @@ namespace osmium {
 
             virtual ~Compressor() noexcept = default;
 
+            /**
+             * Set the number of bytes after which the file should be
+             * synced while writing. See osmium::io::fsync_interval. Not
+             * all compressors support this. 0 (the default) disables
+             * periodic syncing.
+             */
+            void set_fsync_interval(const std::size_t bytes) noexcept {
+                m_fsync_interval = bytes;
+            }
+
             virtual void write(const std::string& data) = 0;
 
             virtual void close() = 0;
@@ -258,6 +288,7 @@ namespace osmium {
             void write(const std::string& data) override {
                 osmium::io::detail::reliable_write(m_fd, data.data(), data.size());
                 m_file_size += data.size();
+                fsync_if_interval_reached(m_fd, data.size());
             }
 
             void close() override {
@@ -321,10 +352,37 @@ namespace osmium {
             std::size_t m_buffer_size = 0;
             std::size_t m_offset = 0;
 
+#ifndef _WIN32
+            std::unique_ptr<detail::ReadAhead> m_read_ahead;
+#endif
+
+            std::string read_from_file() {
+#ifndef _WIN32
+                if (m_read_ahead) {
+                    return m_read_ahead->read();
+                }
+#endif
+                std::string buffer(osmium::io::Decompressor::input_buffer_size, '\0');
+                const auto nread = detail::reliable_read(m_fd, &*buffer.begin(), osmium::io::Decompressor::input_buffer_size);
+                buffer.resize(static_cast<std::string::size_type>(nread));
+                return buffer;
+            }
+
         public:
 
+            /**
+             * Read from the file descriptor. If read ahead threads are
+             * configured (see osmium::config::get_read_ahead_threads())
+             * and fd refers to a regular file, several reads will be in
+             * flight at the same time.
+             */
             explicit NoDecompressor(const int fd) :
                 m_fd(fd) {
+#ifndef _WIN32
+                if (detail::want_read_ahead(fd)) {
+                    m_read_ahead = std::make_unique<detail::ReadAhead>(fd, osmium::config::get_read_ahead_threads());
+                }
+#endif
             }
 
             NoDecompressor(const char* buffer, const std::size_t size) :
@@ -356,12 +414,10 @@ namespace osmium {
                         buffer.append(m_buffer, size);
                     }
                 } else {
-                    buffer.resize(osmium::io::Decompressor::input_buffer_size);
                     if (want_buffered_pages_removed()) {
                         osmium::io::detail::remove_buffered_pages(m_fd, m_offset);
                     }
-                    const auto nread = detail::reliable_read(m_fd, &*buffer.begin(), osmium::io::Decompressor::input_buffer_size);
-                    buffer.resize(static_cast<std::string::size_type>(nread));
+                    buffer = read_from_file();
                 }
 
                 m_offset += buffer.size();
@@ -371,6 +427,11 @@ namespace osmium {
             }
 
             void close() override {
+#ifndef _WIN32
+                if (m_read_ahead) {
+                    m_read_ahead->close();
+                }
+#endif
                 if (m_fd >= 0) {
                     if (want_buffered_pages_removed()) {
                         osmium::io::detail::remove_buffered_pages(m_fd);
@@ -38,11 +38,14 @@ DEALINGS IN THE SOFTWARE.
 #include <osmium/io/file.hpp>
 #include <osmium/io/file_format.hpp>
 #include <osmium/io/header.hpp>
+#include <osmium/io/read_tags_filter.hpp>
 #include <osmium/memory/buffer.hpp>
 #include <osmium/osm/entity_bits.hpp>
 #include <osmium/thread/pool.hpp>
+#include <osmium/util/metrics.hpp>
 
 #include <array>
+#include <cstdint>
 #include <exception>
 #include <functional>
 #include <future>
@@ -56,6 +59,46 @@ namespace osmium {
 
         namespace detail {
 
+            /**
+             * The metrics collected by the parsers. All parsers count the
+             * buffers they create ("reader.buffers") and record their size
+             * ("reader.buffer_bytes") and the time needed to parse each of
+             * them in microseconds ("reader.parse_us") not counting the
+             * time waiting for input or for space in the output queue. The
+             * PBF parser also counts the blobs ("reader.pbf_blobs" and
+             * "reader.pbf_blobs_decompressed") and records the time needed
+             * to decompress them ("reader.pbf_decompress_us").
+             */
+            struct parser_metrics {
+
+                std::shared_ptr<osmium::metrics::Counter> input_chunks;
+                std::shared_ptr<osmium::metrics::Counter> input_bytes;
+                std::shared_ptr<osmium::metrics::Counter> buffers;
+                std::shared_ptr<osmium::metrics::Histogram> buffer_bytes;
+                std::shared_ptr<osmium::metrics::Histogram> parse_time;
+                std::shared_ptr<osmium::metrics::Counter> pbf_blobs;
+                std::shared_ptr<osmium::metrics::Counter> pbf_blobs_decompressed;
+                std::shared_ptr<osmium::metrics::Histogram> pbf_decompress_time;
+
+                explicit parser_metrics(osmium::metrics::Registry& registry) :
+                    input_chunks(registry.shared_counter("reader.input_chunks")),
+                    input_bytes(registry.shared_counter("reader.input_bytes")),
+                    buffers(registry.shared_counter("reader.buffers")),
+                    buffer_bytes(registry.shared_histogram("reader.buffer_bytes")),
+                    parse_time(registry.shared_histogram("reader.parse_us")),
+                    pbf_blobs(registry.shared_counter("reader.pbf_blobs")),
+                    pbf_blobs_decompressed(registry.shared_counter("reader.pbf_blobs_decompressed")),
+                    pbf_decompress_time(registry.shared_histogram("reader.pbf_decompress_us")) {
+                }
+
+                void record_buffer(const osmium::memory::Buffer& buffer, const uint64_t parse_time_us) const {
+                    buffers->add();
+                    buffer_bytes->record(buffer.committed());
+                    parse_time->record(parse_time_us);
+                }
+
+            }; // struct parser_metrics
+
             struct parser_arguments {
                 osmium::thread::Pool& pool;
                 int fd;
@@ -67,6 +110,10 @@ namespace osmium {
                 osmium::io::read_meta read_metadata;
                 osmium::io::buffers_type buffers_kind;
                 bool want_buffered_pages_removed;
+                osmium::io::read_tags_filter tags_filter;
+                osmium::io::read_fields::type read_fields;
+                osmium::metrics::Registry* metrics;
+                osmium::io::keep_source_blocks keep_source_blocks;
             };
 
             class Parser {
@@ -77,6 +124,12 @@ namespace osmium {
                 queue_wrapper<std::string> m_input_queue;
                 osmium::osm_entity_bits::type m_read_which_entities;
                 osmium::io::read_meta m_read_metadata;
+                osmium::io::read_tags_filter m_tags_filter;
+                osmium::io::read_fields::type m_read_fields;
+                osmium::io::keep_source_blocks m_keep_source_blocks;
+                std::shared_ptr<const parser_metrics> m_metrics;
+                osmium::metrics::clock_type::time_point m_parse_start;
+                uint64_t m_input_wait_us = 0;
                 bool m_header_is_done = false;
 
             protected:
@@ -93,6 +146,23 @@ namespace osmium {
                     return m_read_metadata;
                 }
 
+                const osmium::io::read_tags_filter& tags_filter() const noexcept {
+                    return m_tags_filter;
+                }
+
+                osmium::io::read_fields::type read_fields() const noexcept {
+                    return m_read_fields;
+                }
+
+                osmium::io::keep_source_blocks keep_source_blocks() const noexcept {
+                    return m_keep_source_blocks;
+                }
+
+                /// The metrics for this parser (or nullptr if not enabled).
+                const std::shared_ptr<const parser_metrics>& metrics() const noexcept {
+                    return m_metrics;
+                }
+
                 bool header_is_done() const noexcept {
                     return m_header_is_done;
                 }
@@ -115,6 +185,29 @@ namespace osmium {
                  * Wrap the buffer into a future and add it to the output queue.
                  */
                 void send_to_output_queue(osmium::memory::Buffer&& buffer) {
+                    if (m_metrics) {
+                        const auto time = osmium::metrics::microseconds_since(m_parse_start);
+                        m_metrics->record_buffer(buffer, time > m_input_wait_us ? time - m_input_wait_us : 0);
+                    }
+                    add_to_queue(m_output_queue, std::move(buffer));
+                    if (m_metrics) {
+                        m_parse_start = osmium::metrics::clock_type::now();
+                        m_input_wait_us = 0;
+                    }
+                }
+
+                /**
+                 * Tag for send_to_output_queue(): The metrics for the
+                 * buffer were already recorded by the caller.
+                 */
+                struct metrics_recorded {};
+
+                /**
+                 * Wrap the buffer into a future and add it to the output
+                 * queue without recording it in the metrics. Used by
+                 * parsers which record the buffer themselves.
+                 */
+                void send_to_output_queue(osmium::memory::Buffer&& buffer, metrics_recorded /*tag*/) {
                     add_to_queue(m_output_queue, std::move(buffer));
                 }
 
@@ -130,7 +223,12 @@ namespace osmium {
                     m_header_promise(args.header_promise),
                     m_input_queue(args.input_queue),
                     m_read_which_entities(args.read_which_entities),
-                    m_read_metadata(args.read_metadata) {
+                    m_read_metadata(args.read_metadata),
+                    m_tags_filter(args.tags_filter),
+                    m_read_fields(args.read_fields),
+                    m_keep_source_blocks(args.keep_source_blocks),
+                    m_metrics(args.metrics ? std::make_shared<const parser_metrics>(*args.metrics) : nullptr),
+                    m_parse_start(osmium::metrics::clock_type::now()) {
                 }
 
                 Parser(const Parser&) = delete;
@@ -144,6 +242,12 @@ namespace osmium {
                 virtual void run() = 0;
 
                 std::string get_input() {
+                    if (m_metrics) {
+                        const auto start = osmium::metrics::clock_type::now();
+                        std::string data{m_input_queue.pop()};
+                        m_input_wait_us += osmium::metrics::microseconds_since(start);
+                        return data;
+                    }
                     return m_input_queue.pop();
                 }
 
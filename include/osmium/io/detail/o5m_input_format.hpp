@@ -313,37 +313,51 @@ namespace osmium {
                     return {static_cast<osmium::user_id_type>(uid), user};
                 }
 
-                void decode_tags(osmium::builder::Builder& parent, const char** dataptr, const char* const end) {
-                    osmium::builder::TagListBuilder builder{parent};
-
-                    while (*dataptr != end) {
-                        const bool update_pointer = (**dataptr == 0x00);
-                        const char* data = decode_string(dataptr, end);
-                        const char* start = data;
+                std::pair<const char*, const char*> decode_tag(const char** dataptr, const char* const end) {
+                    const bool update_pointer = (**dataptr == 0x00);
+                    const char* data = decode_string(dataptr, end);
+                    const char* start = data;
 
-                        while (*data++) {
-                            if (data == end) {
-                                throw o5m_error{"no null byte in tag key"};
-                            }
+                    while (*data++) {
+                        if (data == end) {
+                            throw o5m_error{"no null byte in tag key"};
                         }
+                    }
 
+                    if (data == end) {
+                        throw o5m_error{"no null byte in tag value"};
+                    }
+
+                    const char* value = data;
+                    while (*data++) {
                         if (data == end) {
                             throw o5m_error{"no null byte in tag value"};
                         }
+                    }
 
-                        const char* value = data;
-                        while (*data++) {
-                            if (data == end) {
-                                throw o5m_error{"no null byte in tag value"};
-                            }
-                        }
+                    if (update_pointer) {
+                        m_reference_table.add(start, data - start);
+                        *dataptr = data;
+                    }
 
-                        if (update_pointer) {
-                            m_reference_table.add(start, data - start);
-                            *dataptr = data;
+                    return {start, value};
+                }
+
+                void decode_tags(osmium::builder::Builder& parent, const char** dataptr, const char* const end) {
+                    if (!(read_fields() & osmium::io::read_fields::tags)) {
+                        // The tags must still be decoded because they can
+                        // add strings to the reference table.
+                        while (*dataptr != end) {
+                            decode_tag(dataptr, end);
                         }
+                        return;
+                    }
 
-                        builder.add_tag(start, value);
+                    osmium::builder::TagListBuilder builder{parent};
+
+                    while (*dataptr != end) {
+                        const auto tag = decode_tag(dataptr, end);
+                        builder.add_tag(tag.first, tag.second);
                     }
                 }
 
@@ -380,12 +394,19 @@ namespace osmium {
                     return user;
                 }
 
+                template <typename TBuilder>
+                void maybe_set_user(TBuilder& builder, const char* user) const {
+                    if (read_fields() & osmium::io::read_fields::user) {
+                        builder.set_user(user);
+                    }
+                }
+
                 void decode_node(const char* data, const char* const end) {
                     osmium::builder::NodeBuilder builder{buffer()};
 
                     builder.set_id(m_delta_id.update(zvarint(&data, end)));
 
-                    builder.set_user(decode_info(builder.object(), &data, end));
+                    maybe_set_user(builder, decode_info(builder.object(), &data, end));
 
                     if (data == end) {
                         // no location, object is deleted
@@ -394,7 +415,9 @@ namespace osmium {
                     } else {
                         const auto lon = m_delta_lon.update(zvarint(&data, end));
                         const auto lat = m_delta_lat.update(zvarint(&data, end));
-                        builder.set_location(osmium::Location{lon, lat});
+                        if (read_fields() & osmium::io::read_fields::locations) {
+                            builder.set_location(osmium::Location{lon, lat});
+                        }
 
                         if (data != end) {
                             decode_tags(builder, &data, end);
@@ -407,7 +430,7 @@ namespace osmium {
 
                     builder.set_id(m_delta_id.update(zvarint(&data, end)));
 
-                    builder.set_user(decode_info(builder.object(), &data, end));
+                    maybe_set_user(builder, decode_info(builder.object(), &data, end));
 
                     if (data == end) {
                         // no reference section, object is deleted
@@ -420,10 +443,16 @@ namespace osmium {
                                 throw o5m_error{"way nodes ref section too long"};
                             }
 
-                            osmium::builder::WayNodeListBuilder wn_builder{builder};
+                            if (read_fields() & osmium::io::read_fields::refs) {
+                                osmium::builder::WayNodeListBuilder wn_builder{builder};
 
-                            while (data < end_refs) {
-                                wn_builder.add_node_ref(m_delta_way_node_id.update(zvarint(&data, end)));
+                                while (data < end_refs) {
+                                    wn_builder.add_node_ref(m_delta_way_node_id.update(zvarint(&data, end)));
+                                }
+                            } else {
+                                while (data < end_refs) {
+                                    m_delta_way_node_id.update(zvarint(&data, end));
+                                }
                             }
                         }
 
@@ -467,12 +496,30 @@ namespace osmium {
                     return {member_type, role};
                 }
 
+                // The members are always decoded, because the roles can add
+                // strings to the reference table, but only added to the
+                // builder if there is one.
+                void decode_members(const char** dataptr, const char* const end_refs, const char* const end, osmium::builder::RelationMemberListBuilder* builder) {
+                    while (*dataptr < end_refs) {
+                        const auto delta_id = zvarint(dataptr, end);
+                        if (*dataptr == end) {
+                            throw o5m_error{"relation member format error"};
+                        }
+                        const auto type_role = decode_role(dataptr, end);
+                        const auto i = osmium::item_type_to_nwr_index(type_role.first);
+                        const auto ref = m_delta_member_ids[i].update(delta_id);
+                        if (builder) {
+                            builder->add_member(type_role.first, ref, type_role.second);
+                        }
+                    }
+                }
+
                 void decode_relation(const char* data, const char* const end) {
                     osmium::builder::RelationBuilder builder{buffer()};
 
                     builder.set_id(m_delta_id.update(zvarint(&data, end)));
 
-                    builder.set_user(decode_info(builder.object(), &data, end));
+                    maybe_set_user(builder, decode_info(builder.object(), &data, end));
 
                     if (data == end) {
                         // no reference section, object is deleted
@@ -485,17 +532,11 @@ namespace osmium {
                                 throw o5m_error{"relation format error"};
                             }
 
-                            osmium::builder::RelationMemberListBuilder rml_builder{builder};
-
-                            while (data < end_refs) {
-                                const auto delta_id = zvarint(&data, end);
-                                if (data == end) {
-                                    throw o5m_error{"relation member format error"};
-                                }
-                                const auto type_role = decode_role(&data, end);
-                                const auto i = osmium::item_type_to_nwr_index(type_role.first);
-                                const auto ref = m_delta_member_ids[i].update(delta_id);
-                                rml_builder.add_member(type_role.first, ref, type_role.second);
+                            if (read_fields() & osmium::io::read_fields::refs) {
+                                osmium::builder::RelationMemberListBuilder rml_builder{builder};
+                                decode_members(&data, end_refs, end, &rml_builder);
+                            } else {
+                                decode_members(&data, end_refs, end, nullptr);
                             }
                         }
 
@@ -36,6 +36,7 @@ DEALINGS IN THE SOFTWARE.
 #include <osmium/builder/osm_object_builder.hpp>
 #include <osmium/io/detail/string_util.hpp>
 #include <osmium/io/error.hpp>
+#include <osmium/io/file_format.hpp>
 #include <osmium/memory/buffer.hpp>
 #include <osmium/osm/box.hpp>
 #include <osmium/osm/changeset.hpp>
@@ -330,7 +331,7 @@ namespace osmium {
              *
              * Nodes will be added to the buffer using a WayNodeListBuilder.
              */
-            inline void opl_parse_way_nodes(const char* s, const char* e, osmium::memory::Buffer& buffer, osmium::builder::WayBuilder* parent_builder = nullptr) {
+            inline void opl_parse_way_nodes(const char* s, const char* e, osmium::memory::Buffer& buffer, osmium::builder::WayBuilder* parent_builder = nullptr, bool with_locations = true) {
                 if (s == e) {
                     return;
                 }
@@ -358,7 +359,11 @@ namespace osmium {
                         }
                     }
 
-                    builder.add_node_ref(ref, location);
+                    if (with_locations) {
+                        builder.add_node_ref(ref, location);
+                    } else {
+                        builder.add_node_ref(ref);
+                    }
 
                     if (s == e) {
                         return;
@@ -368,7 +373,7 @@ namespace osmium {
                 }
             }
 
-            inline void opl_parse_node(const char** data, osmium::memory::Buffer& buffer) {
+            inline void opl_parse_node(const char** data, osmium::memory::Buffer& buffer, const osmium::io::read_fields::type fields = osmium::io::read_fields::all) {
                 osmium::builder::NodeBuilder builder{buffer};
 
                 builder.set_id(opl_parse_id(data));
@@ -435,7 +440,11 @@ namespace osmium {
                                 throw opl_error{"Duplicate attribute: user (u)"};
                             }
                             has_user = true;
-                            opl_parse_string(data, user);
+                            if (fields & osmium::io::read_fields::user) {
+                                opl_parse_string(data, user);
+                            } else {
+                                opl_skip_section(data);
+                            }
                             break;
                         case 'T':
                             if (has_tags) {
@@ -452,7 +461,9 @@ namespace osmium {
                                 throw opl_error{"Duplicate attribute: lon (x)"};
                             }
                             has_lon = true;
-                            if (opl_non_empty(*data)) {
+                            if (!(fields & osmium::io::read_fields::locations)) {
+                                opl_skip_section(data);
+                            } else if (opl_non_empty(*data)) {
                                 location.set_lon_partial(data);
                             }
                             break;
@@ -461,7 +472,9 @@ namespace osmium {
                                 throw opl_error{"Duplicate attribute: lat (y)"};
                             }
                             has_lat = true;
-                            if (opl_non_empty(*data)) {
+                            if (!(fields & osmium::io::read_fields::locations)) {
+                                opl_skip_section(data);
+                            } else if (opl_non_empty(*data)) {
                                 location.set_lat_partial(data);
                             }
                             break;
@@ -477,12 +490,12 @@ namespace osmium {
 
                 builder.set_user(user);
 
-                if (tags_begin) {
+                if (tags_begin && (fields & osmium::io::read_fields::tags)) {
                     opl_parse_tags(tags_begin, buffer, &builder);
                 }
             }
 
-            inline void opl_parse_way(const char** data, osmium::memory::Buffer& buffer) {
+            inline void opl_parse_way(const char** data, osmium::memory::Buffer& buffer, const osmium::io::read_fields::type fields = osmium::io::read_fields::all) {
                 osmium::builder::WayBuilder builder{buffer};
 
                 builder.set_id(opl_parse_id(data));
@@ -550,7 +563,11 @@ namespace osmium {
                                 throw opl_error{"Duplicate attribute: user (u)"};
                             }
                             has_user = true;
-                            opl_parse_string(data, user);
+                            if (fields & osmium::io::read_fields::user) {
+                                opl_parse_string(data, user);
+                            } else {
+                                opl_skip_section(data);
+                            }
                             break;
                         case 'T':
                             if (has_tags) {
@@ -578,11 +595,13 @@ namespace osmium {
 
                 builder.set_user(user);
 
-                if (tags_begin) {
+                if (tags_begin && (fields & osmium::io::read_fields::tags)) {
                     opl_parse_tags(tags_begin, buffer, &builder);
                 }
 
-                opl_parse_way_nodes(nodes_begin, nodes_end, buffer, &builder);
+                if (fields & osmium::io::read_fields::refs) {
+                    opl_parse_way_nodes(nodes_begin, nodes_end, buffer, &builder, (fields & osmium::io::read_fields::locations) != 0);
+                }
             }
 
             inline void opl_parse_relation_members(const char* s, const char* e, osmium::memory::Buffer& buffer, osmium::builder::RelationBuilder* parent_builder = nullptr) {
@@ -620,7 +639,7 @@ namespace osmium {
                 }
             }
 
-            inline void opl_parse_relation(const char** data, osmium::memory::Buffer& buffer) {
+            inline void opl_parse_relation(const char** data, osmium::memory::Buffer& buffer, const osmium::io::read_fields::type fields = osmium::io::read_fields::all) {
                 osmium::builder::RelationBuilder builder{buffer};
 
                 builder.set_id(opl_parse_id(data));
@@ -688,7 +707,11 @@ namespace osmium {
                                 throw opl_error{"Duplicate attribute: user (u)"};
                             }
                             has_user = true;
-                            opl_parse_string(data, user);
+                            if (fields & osmium::io::read_fields::user) {
+                                opl_parse_string(data, user);
+                            } else {
+                                opl_skip_section(data);
+                            }
                             break;
                         case 'T':
                             if (has_tags) {
@@ -716,11 +739,11 @@ namespace osmium {
 
                 builder.set_user(user);
 
-                if (tags_begin) {
+                if (tags_begin && (fields & osmium::io::read_fields::tags)) {
                     opl_parse_tags(tags_begin, buffer, &builder);
                 }
 
-                if (members_begin != members_end) {
+                if (members_begin != members_end && (fields & osmium::io::read_fields::refs)) {
                     opl_parse_relation_members(members_begin, members_end, buffer, &builder);
                 }
             }
@@ -860,7 +883,8 @@ namespace osmium {
             inline bool opl_parse_line(uint64_t line_count,
                                        const char* data,
                                        osmium::memory::Buffer& buffer,
-                                       osmium::osm_entity_bits::type read_types = osmium::osm_entity_bits::all) {
+                                       osmium::osm_entity_bits::type read_types = osmium::osm_entity_bits::all,
+                                       osmium::io::read_fields::type fields = osmium::io::read_fields::all) {
                 const char* start_of_line = data;
                 try {
                     switch (*data) {
@@ -873,7 +897,7 @@ namespace osmium {
                         case 'n':
                             if (read_types & osmium::osm_entity_bits::node) {
                                 ++data;
-                                opl_parse_node(&data, buffer);
+                                opl_parse_node(&data, buffer, fields);
                                 buffer.commit();
                                 return true;
                             }
@@ -881,7 +905,7 @@ namespace osmium {
                         case 'w':
                             if (read_types & osmium::osm_entity_bits::way) {
                                 ++data;
-                                opl_parse_way(&data, buffer);
+                                opl_parse_way(&data, buffer, fields);
                                 buffer.commit();
                                 return true;
                             }
@@ -889,7 +913,7 @@ namespace osmium {
                         case 'r':
                             if (read_types & osmium::osm_entity_bits::relation) {
                                 ++data;
-                                opl_parse_relation(&data, buffer);
+                                opl_parse_relation(&data, buffer, fields);
                                 buffer.commit();
                                 return true;
                             }
@@ -92,6 +92,18 @@ namespace osmium {
                 throw std::invalid_argument{"Unknown value for 'pbf_compression' option."};
             }
 
+            inline const char* compression_type_name(const pbf_compression compression) noexcept {
+                switch (compression) {
+                    case pbf_compression::none:
+                        break;
+                    case pbf_compression::zlib:
+                        return "zlib";
+                    case pbf_compression::lz4:
+                        return "lz4";
+                }
+                return "none";
+            }
+
         } // namespace detail
 
     } // namespace io
@@ -43,16 +43,20 @@ DEALINGS IN THE SOFTWARE.
 #include <vector>
 
 #include <osmium/builder/osm_object_builder.hpp>
+#include <osmium/io/detail/input_format.hpp>
 #include <osmium/io/detail/pbf.hpp> // IWYU pragma: export
 #include <osmium/io/detail/protobuf_tags.hpp>
+#include <osmium/io/detail/string_table_tags_filter.hpp>
 #include <osmium/io/detail/zlib.hpp>
 #include <osmium/io/file_format.hpp>
 #include <osmium/io/header.hpp>
+#include <osmium/io/read_tags_filter.hpp>
 #include <osmium/memory/buffer.hpp>
 #include <osmium/osm/box.hpp>
 #include <osmium/osm/entity_bits.hpp>
 #include <osmium/osm/item_type.hpp>
 #include <osmium/osm/location.hpp>
+#include <osmium/osm/metadata_options.hpp>
 #include <osmium/osm/node.hpp>
 #include <osmium/osm/object.hpp>
 #include <osmium/osm/relation.hpp>
@@ -60,6 +64,7 @@ DEALINGS IN THE SOFTWARE.
 #include <osmium/osm/types.hpp>
 #include <osmium/osm/way.hpp>
 #include <osmium/util/delta.hpp>
+#include <osmium/util/options.hpp>
 
 #ifdef OSMIUM_WITH_LZ4
 # include <osmium/io/detail/lz4.hpp>
@@ -197,8 +202,6 @@ namespace osmium {
 
             }; // class values_access_sint64
 
-            using osm_string_len_type = std::pair<const char*, osmium::string_size_type>;
-
             class PBFPrimitiveBlockDecoder {
 
                 enum {
@@ -208,6 +211,11 @@ namespace osmium {
                 data_view m_data;
                 std::vector<osm_string_len_type> m_stringtable;
 
+                // The string table is only decoded if the block contains
+                // any objects of the types we are interested in.
+                data_view m_stringtable_data;
+                bool m_has_stringtable = false;
+
                 int64_t m_lon_offset = 0;
                 int64_t m_lat_offset = 0;
                 int64_t m_date_factor = 1000;
@@ -215,16 +223,31 @@ namespace osmium {
 
                 osmium::osm_entity_bits::type m_read_types;
 
-                osmium::memory::Buffer m_buffer{initial_buffer_size, osmium::memory::Buffer::auto_grow::internal};
+                osmium::memory::Buffer m_buffer;
 
                 osmium::io::read_meta m_read_metadata;
 
-                void decode_stringtable(const data_view& data) {
-                    if (!m_stringtable.empty()) {
-                        throw osmium::pbf_error{"more than one stringtable in pbf file"};
+                osmium::io::read_tags_filter m_tags_filter;
+
+                osmium::io::read_fields::type m_read_fields;
+
+                // Created when the string table is decoded if there is a
+                // tags filter.
+                std::unique_ptr<string_table_tags_filter> m_stringtable_filter;
+
+                void decode_stringtable() {
+                    decode_stringtable_data();
+                    if (m_tags_filter.filter() && !m_stringtable_filter) {
+                        m_stringtable_filter.reset(new string_table_tags_filter{*m_tags_filter.filter(), m_stringtable});
+                    }
+                }
+
+                void decode_stringtable_data() {
+                    if (!m_has_stringtable || !m_stringtable.empty()) {
+                        return;
                     }
 
-                    protozero::pbf_message<OSMFormat::StringTable> pbf_string_table{data};
+                    protozero::pbf_message<OSMFormat::StringTable> pbf_string_table{m_stringtable_data};
                     while (pbf_string_table.next(OSMFormat::StringTable::repeated_bytes_s, protozero::pbf_wire_type::length_delimited)) {
                         const auto str_view = pbf_string_table.get_view();
                         if (str_view.size() > osmium::max_osm_string_length) {
@@ -235,12 +258,58 @@ namespace osmium {
                     }
                 }
 
+                // Should an object with these tags be built? The arguments
+                // are copies, so the caller can still use the originals.
+                bool keep_object(const osmium::item_type type, values_access_uint32 keys, values_access_uint32 vals) {
+                    if (!m_stringtable_filter || !m_tags_filter.applies_to(type)) {
+                        return true;
+                    }
+                    while (!keys.empty() && !vals.empty()) {
+                        if ((*m_stringtable_filter)(keys.next_uint32(), vals.next_uint32())) {
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+
+                // Should a node from a DenseNodes group with these tags be
+                // built? The argument is a copy, so the caller can still
+                // use the original.
+                bool keep_dense_node(values_access_int32 tags) {
+                    if (!m_stringtable_filter || !m_tags_filter.applies_to(osmium::item_type::node)) {
+                        return true;
+                    }
+                    while (!tags.empty()) {
+                        const auto key = tags.next_int32();
+                        if (key == 0) {
+                            return false;
+                        }
+                        if (tags.empty()) {
+                            throw osmium::pbf_error{"PBF format error"}; // this is against the spec, keys/vals must come in pairs
+                        }
+                        const auto value = tags.next_int32();
+                        if ((*m_stringtable_filter)(static_cast<uint32_t>(key), static_cast<uint32_t>(value))) {
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+
+                static void skip_dense_node_tags(values_access_int32& tags) {
+                    while (!tags.empty() && tags.next_int32() != 0) {
+                    }
+                }
+
                 void decode_primitive_block_metadata() {
                     protozero::pbf_message<OSMFormat::PrimitiveBlock> pbf_primitive_block{m_data};
                     while (pbf_primitive_block.next()) {
                         switch (pbf_primitive_block.tag_and_type()) {
                             case protozero::tag_and_type(OSMFormat::PrimitiveBlock::required_StringTable_stringtable, protozero::pbf_wire_type::length_delimited):
-                                decode_stringtable(pbf_primitive_block.get_view());
+                                if (m_has_stringtable) {
+                                    throw osmium::pbf_error{"more than one stringtable in pbf file"};
+                                }
+                                m_stringtable_data = pbf_primitive_block.get_view();
+                                m_has_stringtable = true;
                                 break;
                             case protozero::tag_and_type(OSMFormat::PrimitiveBlock::optional_int32_granularity, protozero::pbf_wire_type::varint):
                                 m_granularity = pbf_primitive_block.get_int32();
@@ -268,6 +337,7 @@ namespace osmium {
                             switch (pbf_primitive_group.tag_and_type()) {
                                 case protozero::tag_and_type(OSMFormat::PrimitiveGroup::repeated_Node_nodes, protozero::pbf_wire_type::length_delimited):
                                     if (m_read_types & osmium::osm_entity_bits::node) {
+                                        decode_stringtable();
                                         decode_node(pbf_primitive_group.get_view());
                                         m_buffer.commit();
                                     } else {
@@ -276,6 +346,7 @@ namespace osmium {
                                     break;
                                 case protozero::tag_and_type(OSMFormat::PrimitiveGroup::optional_DenseNodes_dense, protozero::pbf_wire_type::length_delimited):
                                     if (m_read_types & osmium::osm_entity_bits::node) {
+                                        decode_stringtable();
                                         if (m_read_metadata == osmium::io::read_meta::yes) {
                                             decode_dense_nodes(pbf_primitive_group.get_view());
                                         } else {
@@ -288,6 +359,7 @@ namespace osmium {
                                     break;
                                 case protozero::tag_and_type(OSMFormat::PrimitiveGroup::repeated_Way_ways, protozero::pbf_wire_type::length_delimited):
                                     if (m_read_types & osmium::osm_entity_bits::way) {
+                                        decode_stringtable();
                                         decode_way(pbf_primitive_group.get_view());
                                         m_buffer.commit();
                                     } else {
@@ -296,6 +368,7 @@ namespace osmium {
                                     break;
                                 case protozero::tag_and_type(OSMFormat::PrimitiveGroup::repeated_Relation_relations, protozero::pbf_wire_type::length_delimited):
                                     if (m_read_types & osmium::osm_entity_bits::relation) {
+                                        decode_stringtable();
                                         decode_relation(pbf_primitive_group.get_view());
                                         m_buffer.commit();
                                     } else {
@@ -385,21 +458,18 @@ namespace osmium {
                 }
 
                 void decode_node(const data_view& data) {
-                    osmium::builder::NodeBuilder builder{m_buffer};
-                    osmium::Node& node = builder.object();
-
                     values_access_uint32 keys;
                     values_access_uint32 vals;
+                    int64_t id = 0;
                     int64_t lon = std::numeric_limits<int64_t>::max();
                     int64_t lat = std::numeric_limits<int64_t>::max();
-
-                    osm_string_len_type user{"", 0};
+                    data_view info;
 
                     protozero::pbf_message<OSMFormat::Node> pbf_node{data};
                     while (pbf_node.next()) {
                         switch (pbf_node.tag_and_type()) {
                             case protozero::tag_and_type(OSMFormat::Node::required_sint64_id, protozero::pbf_wire_type::varint):
-                                node.set_id(pbf_node.get_sint64());
+                                id = pbf_node.get_sint64();
                                 break;
                             case protozero::tag_and_type(OSMFormat::Node::packed_uint32_keys, protozero::pbf_wire_type::length_delimited):
                                 keys = values_access_uint32{pbf_node.get_view()};
@@ -415,7 +485,7 @@ namespace osmium {
                                 break;
                             case protozero::tag_and_type(OSMFormat::Node::optional_Info_info, protozero::pbf_wire_type::length_delimited):
                                 if (m_read_metadata == osmium::io::read_meta::yes) {
-                                    user = decode_info(pbf_node.get_view(), builder.object());
+                                    info = pbf_node.get_view();
                                 } else {
                                     pbf_node.skip();
                                 }
@@ -431,38 +501,55 @@ namespace osmium {
                         }
                     }
 
+                    if (!keep_object(osmium::item_type::node, keys, vals)) {
+                        return;
+                    }
+
+                    osmium::builder::NodeBuilder builder{m_buffer};
+                    osmium::Node& node = builder.object();
+                    node.set_id(id);
+
+                    osm_string_len_type user{"", 0};
+                    if (!info.empty()) {
+                        user = decode_info(info, node);
+                    }
+
                     if (node.visible()) {
                         if (lon == std::numeric_limits<int64_t>::max() ||
                             lat == std::numeric_limits<int64_t>::max()) {
                             throw osmium::pbf_error{"illegal coordinate format"};
                         }
-                        node.set_location(osmium::Location{
-                                convert_pbf_lon(lon),
-                                convert_pbf_lat(lat)
-                        });
+                        if (m_read_fields & osmium::io::read_fields::locations) {
+                            node.set_location(osmium::Location{
+                                    convert_pbf_lon(lon),
+                                    convert_pbf_lat(lat)
+                            });
+                        }
                     }
 
-                    builder.set_user(user.first, user.second);
+                    if (m_read_fields & osmium::io::read_fields::user) {
+                        builder.set_user(user.first, user.second);
+                    }
 
-                    build_tag_list(builder, keys, vals);
+                    if (m_read_fields & osmium::io::read_fields::tags) {
+                        build_tag_list(builder, keys, vals);
+                    }
                 }
 
                 void decode_way(const data_view& data) {
-                    osmium::builder::WayBuilder builder{m_buffer};
-
                     values_access_uint32 keys;
                     values_access_uint32 vals;
                     values_access_sint64 refs;
                     values_access_sint64 lats;
                     values_access_sint64 lons;
-
-                    osm_string_len_type user{"", 0};
+                    int64_t id = 0;
+                    data_view info;
 
                     protozero::pbf_message<OSMFormat::Way> pbf_way{data};
                     while (pbf_way.next()) {
                         switch (pbf_way.tag_and_type()) {
                             case protozero::tag_and_type(OSMFormat::Way::required_int64_id, protozero::pbf_wire_type::varint):
-                                builder.object().set_id(pbf_way.get_int64());
+                                id = pbf_way.get_int64();
                                 break;
                             case protozero::tag_and_type(OSMFormat::Way::packed_uint32_keys, protozero::pbf_wire_type::length_delimited):
                                 keys = values_access_uint32{pbf_way.get_view()};
@@ -478,7 +565,7 @@ namespace osmium {
                                 break;
                             case protozero::tag_and_type(OSMFormat::Way::optional_Info_info, protozero::pbf_wire_type::length_delimited):
                                 if (m_read_metadata == osmium::io::read_meta::yes) {
-                                    user = decode_info(pbf_way.get_view(), builder.object());
+                                    info = pbf_way.get_view();
                                 } else {
                                     pbf_way.skip();
                                 }
@@ -506,12 +593,26 @@ namespace osmium {
                         }
                     }
 
-                    builder.set_user(user.first, user.second);
+                    if (!keep_object(osmium::item_type::way, keys, vals)) {
+                        return;
+                    }
+
+                    osmium::builder::WayBuilder builder{m_buffer};
+                    builder.object().set_id(id);
 
-                    if (!refs.empty()) {
+                    osm_string_len_type user{"", 0};
+                    if (!info.empty()) {
+                        user = decode_info(info, builder.object());
+                    }
+
+                    if (m_read_fields & osmium::io::read_fields::user) {
+                        builder.set_user(user.first, user.second);
+                    }
+
+                    if (!refs.empty() && (m_read_fields & osmium::io::read_fields::refs)) {
                         osmium::builder::WayNodeListBuilder wnl_builder{builder};
                         osmium::DeltaDecode<int64_t> ref;
-                        if (lats.empty()) {
+                        if (lats.empty() || !(m_read_fields & osmium::io::read_fields::locations)) {
                             while (!refs.empty()) {
                                 wnl_builder.add_node_ref(ref.update(refs.next_sint64()));
                             }
@@ -528,25 +629,25 @@ namespace osmium {
                         }
                     }
 
-                    build_tag_list(builder, keys, vals);
+                    if (m_read_fields & osmium::io::read_fields::tags) {
+                        build_tag_list(builder, keys, vals);
+                    }
                 }
 
                 void decode_relation(const data_view& data) {
-                    osmium::builder::RelationBuilder builder{m_buffer};
-
                     values_access_uint32 keys;
                     values_access_uint32 vals;
                     values_access_int32 roles;
                     values_access_sint64 refs;
                     values_access_int32 types;
-
-                    osm_string_len_type user{"", 0};
+                    int64_t id = 0;
+                    data_view info;
 
                     protozero::pbf_message<OSMFormat::Relation> pbf_relation{data};
                     while (pbf_relation.next()) {
                         switch (pbf_relation.tag_and_type()) {
                             case protozero::tag_and_type(OSMFormat::Relation::required_int64_id, protozero::pbf_wire_type::varint):
-                                builder.object().set_id(pbf_relation.get_int64());
+                                id = pbf_relation.get_int64();
                                 break;
                             case protozero::tag_and_type(OSMFormat::Relation::packed_uint32_keys, protozero::pbf_wire_type::length_delimited):
                                 keys = values_access_uint32{pbf_relation.get_view()};
@@ -562,7 +663,7 @@ namespace osmium {
                                 break;
                             case protozero::tag_and_type(OSMFormat::Relation::optional_Info_info, protozero::pbf_wire_type::length_delimited):
                                 if (m_read_metadata == osmium::io::read_meta::yes) {
-                                    user = decode_info(pbf_relation.get_view(), builder.object());
+                                    info = pbf_relation.get_view();
                                 } else {
                                     pbf_relation.skip();
                                 }
@@ -590,9 +691,23 @@ namespace osmium {
                         }
                     }
 
-                    builder.set_user(user.first, user.second);
+                    if (!keep_object(osmium::item_type::relation, keys, vals)) {
+                        return;
+                    }
 
-                    if (!refs.empty()) {
+                    osmium::builder::RelationBuilder builder{m_buffer};
+                    builder.object().set_id(id);
+
+                    osm_string_len_type user{"", 0};
+                    if (!info.empty()) {
+                        user = decode_info(info, builder.object());
+                    }
+
+                    if (m_read_fields & osmium::io::read_fields::user) {
+                        builder.set_user(user.first, user.second);
+                    }
+
+                    if (!refs.empty() && (m_read_fields & osmium::io::read_fields::refs)) {
                         osmium::builder::RelationMemberListBuilder rml_builder{builder};
                         osmium::DeltaDecode<int64_t> ref;
                         while (!roles.empty() && !refs.empty() && !types.empty()) {
@@ -610,7 +725,9 @@ namespace osmium {
                         }
                     }
 
-                    build_tag_list(builder, keys, vals);
+                    if (m_read_fields & osmium::io::read_fields::tags) {
+                        build_tag_list(builder, keys, vals);
+                    }
                 }
 
                 void build_tag_list_from_dense_nodes(osmium::builder::NodeBuilder& builder, values_access_int32& tags) {
@@ -678,6 +795,14 @@ namespace osmium {
                             throw osmium::pbf_error{"PBF format error"};
                         }
 
+                        if (!keep_dense_node(tags)) {
+                            dense_id.update(ids.next_sint64());
+                            dense_longitude.update(lons.next_sint64());
+                            dense_latitude.update(lats.next_sint64());
+                            skip_dense_node_tags(tags);
+                            continue;
+                        }
+
                         {
                             osmium::builder::NodeBuilder builder{m_buffer};
                             osmium::Node& node = builder.object();
@@ -686,12 +811,16 @@ namespace osmium {
 
                             const auto lon = dense_longitude.update(lons.next_sint64());
                             const auto lat = dense_latitude.update(lats.next_sint64());
-                            builder.object().set_location(osmium::Location{
-                                    convert_pbf_lon(lon),
-                                    convert_pbf_lat(lat)
-                            });
+                            if (m_read_fields & osmium::io::read_fields::locations) {
+                                builder.object().set_location(osmium::Location{
+                                        convert_pbf_lon(lon),
+                                        convert_pbf_lat(lat)
+                                });
+                            }
 
-                            if (!tags.empty()) {
+                            if (!(m_read_fields & osmium::io::read_fields::tags)) {
+                                skip_dense_node_tags(tags);
+                            } else if (!tags.empty()) {
                                 build_tag_list_from_dense_nodes(builder, tags);
                             }
                         }
@@ -809,6 +938,36 @@ namespace osmium {
                             throw osmium::pbf_error{"PBF format error"};
                         }
 
+                        if (!keep_dense_node(tags)) {
+                            // The delta encoded values must still be
+                            // decoded for the following nodes.
+                            dense_id.update(ids.next_sint64());
+                            dense_longitude.update(lons.next_sint64());
+                            dense_latitude.update(lats.next_sint64());
+                            if (has_info) {
+                                if (!versions.empty()) {
+                                    versions.next_int32();
+                                }
+                                if (!changesets.empty()) {
+                                    dense_changeset.update(changesets.next_sint64());
+                                }
+                                if (!timestamps.empty()) {
+                                    dense_timestamp.update(timestamps.next_sint64());
+                                }
+                                if (!uids.empty()) {
+                                    dense_uid.update(uids.next_sint32());
+                                }
+                                if (!visibles.empty()) {
+                                    visibles.next_int32();
+                                }
+                                if (!user_sids.empty()) {
+                                    dense_user_sid.update(user_sids.next_sint32());
+                                }
+                            }
+                            skip_dense_node_tags(tags);
+                            continue;
+                        }
+
                         {
                             bool visible = true;
 
@@ -859,7 +1018,9 @@ namespace osmium {
 
                                 if (!user_sids.empty()) {
                                     const auto& u = m_stringtable.at(dense_user_sid.update(user_sids.next_sint32()));
-                                    builder.set_user(u.first, u.second);
+                                    if (m_read_fields & osmium::io::read_fields::user) {
+                                        builder.set_user(u.first, u.second);
+                                    }
                                 }
                             }
 
@@ -867,14 +1028,16 @@ namespace osmium {
                             // of its lat/lon in the dense arrays.
                             const auto lon = dense_longitude.update(lons.next_sint64());
                             const auto lat = dense_latitude.update(lats.next_sint64());
-                            if (visible) {
+                            if (visible && (m_read_fields & osmium::io::read_fields::locations)) {
                                 builder.object().set_location(osmium::Location{
                                         convert_pbf_lon(lon),
                                         convert_pbf_lat(lat)
                                 });
                             }
 
-                            if (!tags.empty()) {
+                            if (!(m_read_fields & osmium::io::read_fields::tags)) {
+                                skip_dense_node_tags(tags);
+                            } else if (!tags.empty()) {
                                 build_tag_list_from_dense_nodes(builder, tags);
                             }
                         }
@@ -884,10 +1047,18 @@ namespace osmium {
 
             public:
 
-                PBFPrimitiveBlockDecoder(const data_view& data, const osmium::osm_entity_bits::type read_types, const osmium::io::read_meta read_metadata) :
+                PBFPrimitiveBlockDecoder(const data_view& data,
+                                         const osmium::osm_entity_bits::type read_types,
+                                         const osmium::io::read_meta read_metadata,
+                                         const osmium::io::read_tags_filter& tags_filter = osmium::io::read_tags_filter{},
+                                         const osmium::io::read_fields::type read_fields = osmium::io::read_fields::all,
+                                         const osmium::memory::Buffer::auto_grow grow = osmium::memory::Buffer::auto_grow::internal) :
                     m_data(data),
                     m_read_types(read_types),
-                    m_read_metadata(read_metadata) {
+                    m_buffer(initial_buffer_size, grow),
+                    m_read_metadata(read_metadata),
+                    m_tags_filter(tags_filter),
+                    m_read_fields(read_fields) {
                 }
 
                 PBFPrimitiveBlockDecoder(const PBFPrimitiveBlockDecoder&) = delete;
@@ -1098,24 +1269,260 @@ namespace osmium {
                 return decode_header_block(decode_blob(header_block_data, output));
             }
 
+            // Info and DenseInfo messages use the same field numbers, so
+            // this works for both of them.
+            inline void detect_info_encoding(protozero::pbf_reader pbf_info, osmium::metadata_options& metadata, bool& visible) {
+                while (pbf_info.next()) {
+                    switch (pbf_info.tag()) {
+                        case static_cast<protozero::pbf_tag_type>(OSMFormat::Info::optional_int32_version):
+                            metadata.set_version(true);
+                            break;
+                        case static_cast<protozero::pbf_tag_type>(OSMFormat::Info::optional_int64_timestamp):
+                            metadata.set_timestamp(true);
+                            break;
+                        case static_cast<protozero::pbf_tag_type>(OSMFormat::Info::optional_int64_changeset):
+                            metadata.set_changeset(true);
+                            break;
+                        case static_cast<protozero::pbf_tag_type>(OSMFormat::Info::optional_int32_uid):
+                            metadata.set_uid(true);
+                            break;
+                        case static_cast<protozero::pbf_tag_type>(OSMFormat::Info::optional_uint32_user_sid):
+                            metadata.set_user(true);
+                            break;
+                        case static_cast<protozero::pbf_tag_type>(OSMFormat::Info::optional_bool_visible):
+                            visible = true;
+                            break;
+                        default:
+                            break;
+                    }
+                    pbf_info.skip();
+                }
+            }
+
+            /**
+             * Find out with which options the PrimitiveBlock in a Blob was
+             * encoded. The options are named like the settings of the PBF
+             * writer: "pbf_compression", "add_metadata", "add_visible_flag",
+             * and, if the block contains nodes or ways, "pbf_dense_nodes"
+             * and "locations_on_ways". The writer encodes all objects in a
+             * block in the same way, so only the metadata of the first
+             * object of each type is looked at.
+             *
+             * @param blob_data The Blob message.
+             * @param data The uncompressed PrimitiveBlock from that Blob.
+             * @returns Options describing the encoding.
+             * @throws osmium::pbf_error If there was a parsing error
+             */
+            inline osmium::Options detect_primitive_block_encoding(const std::string& blob_data, const data_view& data) {
+                osmium::Options encoding;
+
+                protozero::pbf_message<FileFormat::Blob> pbf_blob{blob_data};
+                while (pbf_blob.next()) {
+                    switch (pbf_blob.tag()) {
+                        case FileFormat::Blob::optional_bytes_raw:
+                            encoding.set("pbf_compression", "none");
+                            break;
+                        case FileFormat::Blob::optional_bytes_zlib_data:
+                            encoding.set("pbf_compression", "zlib");
+                            break;
+                        case FileFormat::Blob::optional_bytes_lzma_data:
+                            encoding.set("pbf_compression", "lzma");
+                            break;
+                        case FileFormat::Blob::optional_bytes_lz4_data:
+                            encoding.set("pbf_compression", "lz4");
+                            break;
+                        case FileFormat::Blob::optional_bytes_zstd_data:
+                            encoding.set("pbf_compression", "zstd");
+                            break;
+                        default:
+                            break;
+                    }
+                    pbf_blob.skip();
+                }
+
+                osmium::metadata_options metadata{"none"};
+                bool visible = false;
+                bool seen_node = false;
+                bool seen_way = false;
+                bool seen_relation = false;
+
+                protozero::pbf_message<OSMFormat::PrimitiveBlock> pbf_primitive_block{data};
+                while (pbf_primitive_block.next(OSMFormat::PrimitiveBlock::repeated_PrimitiveGroup_primitivegroup, protozero::pbf_wire_type::length_delimited)) {
+                    protozero::pbf_message<OSMFormat::PrimitiveGroup> pbf_primitive_group{pbf_primitive_block.get_message()};
+                    while (pbf_primitive_group.next()) {
+                        switch (pbf_primitive_group.tag_and_type()) {
+                            case protozero::tag_and_type(OSMFormat::PrimitiveGroup::repeated_Node_nodes, protozero::pbf_wire_type::length_delimited):
+                                encoding.set("pbf_dense_nodes", false);
+                                if (seen_node) {
+                                    pbf_primitive_group.skip();
+                                } else {
+                                    seen_node = true;
+                                    protozero::pbf_message<OSMFormat::Node> pbf_node{pbf_primitive_group.get_message()};
+                                    if (pbf_node.next(OSMFormat::Node::optional_Info_info, protozero::pbf_wire_type::length_delimited)) {
+                                        detect_info_encoding(pbf_node.get_message(), metadata, visible);
+                                    }
+                                }
+                                break;
+                            case protozero::tag_and_type(OSMFormat::PrimitiveGroup::optional_DenseNodes_dense, protozero::pbf_wire_type::length_delimited):
+                                encoding.set("pbf_dense_nodes", true);
+                                if (seen_node) {
+                                    pbf_primitive_group.skip();
+                                } else {
+                                    seen_node = true;
+                                    protozero::pbf_message<OSMFormat::DenseNodes> pbf_dense_nodes{pbf_primitive_group.get_message()};
+                                    if (pbf_dense_nodes.next(OSMFormat::DenseNodes::optional_DenseInfo_denseinfo, protozero::pbf_wire_type::length_delimited)) {
+                                        detect_info_encoding(pbf_dense_nodes.get_message(), metadata, visible);
+                                    }
+                                }
+                                break;
+                            case protozero::tag_and_type(OSMFormat::PrimitiveGroup::repeated_Way_ways, protozero::pbf_wire_type::length_delimited):
+                                // Ways without nodes have no locations
+                                // either, so look for the first way with
+                                // nodes to find out about locations.
+                                if (seen_way && !encoding.get("locations_on_ways").empty()) {
+                                    pbf_primitive_group.skip();
+                                } else {
+                                    bool has_refs = false;
+                                    bool has_locations = false;
+                                    protozero::pbf_message<OSMFormat::Way> pbf_way{pbf_primitive_group.get_message()};
+                                    while (pbf_way.next()) {
+                                        switch (pbf_way.tag_and_type()) {
+                                            case protozero::tag_and_type(OSMFormat::Way::optional_Info_info, protozero::pbf_wire_type::length_delimited):
+                                                if (seen_way) {
+                                                    pbf_way.skip();
+                                                } else {
+                                                    detect_info_encoding(pbf_way.get_message(), metadata, visible);
+                                                }
+                                                break;
+                                            case protozero::tag_and_type(OSMFormat::Way::packed_sint64_refs, protozero::pbf_wire_type::length_delimited):
+                                                has_refs = true;
+                                                pbf_way.skip();
+                                                break;
+                                            case protozero::tag_and_type(OSMFormat::Way::packed_sint64_lat, protozero::pbf_wire_type::length_delimited):
+                                                has_locations = true;
+                                                pbf_way.skip();
+                                                break;
+                                            default:
+                                                pbf_way.skip();
+                                        }
+                                    }
+                                    seen_way = true;
+                                    if (has_refs) {
+                                        encoding.set("locations_on_ways", has_locations);
+                                    }
+                                }
+                                break;
+                            case protozero::tag_and_type(OSMFormat::PrimitiveGroup::repeated_Relation_relations, protozero::pbf_wire_type::length_delimited):
+                                if (seen_relation) {
+                                    pbf_primitive_group.skip();
+                                } else {
+                                    seen_relation = true;
+                                    protozero::pbf_message<OSMFormat::Relation> pbf_relation{pbf_primitive_group.get_message()};
+                                    if (pbf_relation.next(OSMFormat::Relation::optional_Info_info, protozero::pbf_wire_type::length_delimited)) {
+                                        detect_info_encoding(pbf_relation.get_message(), metadata, visible);
+                                    }
+                                }
+                                break;
+                            default:
+                                pbf_primitive_group.skip();
+                        }
+                    }
+                }
+
+                encoding.set("add_metadata", metadata.to_string());
+                encoding.set("add_visible_flag", visible);
+
+                return encoding;
+            }
+
             class PBFDataBlobDecoder {
 
                 std::shared_ptr<std::string> m_input_buffer;
                 osmium::osm_entity_bits::type m_read_types;
                 osmium::io::read_meta m_read_metadata;
+                osmium::io::read_tags_filter m_tags_filter;
+                osmium::io::read_fields::type m_read_fields;
+                std::shared_ptr<const parser_metrics> m_metrics;
+                bool m_keep_source_block;
+
+                // If the source block is kept, all objects from the blob
+                // must end up in a single buffer, otherwise the block
+                // can't be matched to the buffer contents.
+                osmium::memory::Buffer::auto_grow buffer_growth() const noexcept {
+                    return m_keep_source_block ? osmium::memory::Buffer::auto_grow::yes
+                                               : osmium::memory::Buffer::auto_grow::internal;
+                }
+
+                // Attach the (still compressed) blob to the buffer so that
+                // it can be written out again without re-encoding. The
+                // uncompressed data is needed to find out how the blob
+                // was encoded.
+                void attach_source_block(osmium::memory::Buffer& buffer, const data_view& data) {
+                    auto objects = buffer.select<osmium::OSMObject>();
+                    if (objects.begin() == objects.end()) {
+                        return;
+                    }
+
+                    auto block = std::make_shared<osmium::memory::source_block>();
+                    block->format = "pbf";
+                    block->encoding = detect_primitive_block_encoding(*m_input_buffer, data);
+                    block->data = std::move(*m_input_buffer);
+                    block->first_type = objects.begin()->type();
+                    block->first_id = objects.begin()->id();
+                    for (const auto& object : objects) {
+                        block->last_type = object.type();
+                        block->last_id = object.id();
+                    }
+                    buffer.set_source_block(std::move(block));
+                }
+
+                osmium::memory::Buffer decode(const data_view& data) {
+                    PBFPrimitiveBlockDecoder decoder{data, m_read_types, m_read_metadata, m_tags_filter, m_read_fields, buffer_growth()};
+                    osmium::memory::Buffer buffer{decoder()};
+                    if (m_keep_source_block) {
+                        attach_source_block(buffer, data);
+                    }
+                    return buffer;
+                }
+
+                osmium::memory::Buffer decode_with_metrics() {
+                    const auto start = osmium::metrics::clock_type::now();
+                    std::string output;
+                    const auto data = decode_blob(*m_input_buffer, output);
+                    m_metrics->pbf_blobs->add();
+                    if (!output.empty()) {
+                        m_metrics->pbf_blobs_decompressed->add();
+                        m_metrics->pbf_decompress_time->record(osmium::metrics::microseconds_since(start));
+                    }
+                    osmium::memory::Buffer buffer{decode(data)};
+                    m_metrics->record_buffer(buffer, osmium::metrics::microseconds_since(start));
+                    return buffer;
+                }
 
             public:
 
-                PBFDataBlobDecoder(std::string&& input_buffer, const osmium::osm_entity_bits::type read_types, const osmium::io::read_meta read_metadata) :
+                PBFDataBlobDecoder(std::string&& input_buffer,
+                                   const osmium::osm_entity_bits::type read_types,
+                                   const osmium::io::read_meta read_metadata,
+                                   const osmium::io::read_tags_filter& tags_filter = osmium::io::read_tags_filter{},
+                                   const osmium::io::read_fields::type read_fields = osmium::io::read_fields::all,
+                                   std::shared_ptr<const parser_metrics> metrics = nullptr,
+                                   const bool keep_source_block = false) :
                     m_input_buffer(std::make_shared<std::string>(std::move(input_buffer))),
                     m_read_types(read_types),
-                    m_read_metadata(read_metadata) {
+                    m_read_metadata(read_metadata),
+                    m_tags_filter(tags_filter),
+                    m_read_fields(read_fields),
+                    m_metrics(std::move(metrics)),
+                    m_keep_source_block(keep_source_block) {
                 }
 
                 osmium::memory::Buffer operator()() {
+                    if (m_metrics) {
+                        return decode_with_metrics();
+                    }
                     std::string output;
-                    PBFPrimitiveBlockDecoder decoder{decode_blob(*m_input_buffer, output), m_read_types, m_read_metadata};
-                    return decoder();
+                    return decode(decode_blob(*m_input_buffer, output));
                 }
 
             }; // class PBFDataBlobDecoder
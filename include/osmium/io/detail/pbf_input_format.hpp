@@ -66,6 +66,7 @@ namespace osmium {
             class PBFParser final : public Parser {
 
                 std::string m_input_buffer;
+                std::size_t m_input_offset = 0;
                 std::atomic<std::size_t>* m_offset_ptr;
                 int m_fd;
                 bool m_want_buffered_pages_removed;
@@ -78,6 +79,16 @@ namespace osmium {
                  */
                 void ensure_available_in_input_queue(size_t size) {
                     assert(m_fd == -1);
+                    if (m_input_buffer.size() - m_input_offset >= size) {
+                        return;
+                    }
+
+                    // Only move the remaining data to the front of the
+                    // buffer when more data is needed, not every time
+                    // something is removed from it.
+                    m_input_buffer.erase(0, m_input_offset);
+                    m_input_offset = 0;
+
                     if (m_input_buffer.size() < size) {
                         m_input_buffer.reserve(size);
                     }
@@ -90,6 +101,10 @@ namespace osmium {
                     }
                 }
 
+                const char* input_queue_data() const noexcept {
+                    return m_input_buffer.data() + m_input_offset;
+                }
+
                 /**
                  * Removes the specified number of bytes from the input data.
                  *
@@ -97,7 +112,7 @@ namespace osmium {
                  */
                 void pop_from_input_queue(size_t size) {
                     assert(m_fd == -1);
-                    m_input_buffer.erase(0, size);
+                    m_input_offset += size;
                 }
 
                 static uint32_t check_size(uint32_t size) {
@@ -122,6 +137,10 @@ namespace osmium {
                             *m_offset_ptr += buffer.size();
                         }
 
+                        if (metrics()) {
+                            metrics()->input_bytes->add(buffer.size());
+                        }
+
                         return check_size(get_size_in_network_byte_order(buffer.data()));
                     }
 
@@ -129,7 +148,7 @@ namespace osmium {
 
                     try {
                         ensure_available_in_input_queue(sizeof(size));
-                        size = get_size_in_network_byte_order(m_input_buffer.data());
+                        size = get_size_in_network_byte_order(input_queue_data());
                         pop_from_input_queue(sizeof(size));
                     } catch (const osmium::pbf_error&) {
                         return 0; // EOF
@@ -142,39 +161,6 @@ namespace osmium {
                     return size;
                 }
 
-                /**
-                 * Decode the BlobHeader. Make sure it contains the expected
-                 * type. Return the size of the following Blob.
-                 */
-                static size_t decode_blob_header(const protozero::data_view& data, const char* expected_type) {
-                    protozero::pbf_message<FileFormat::BlobHeader> pbf_blob_header{data};
-                    protozero::data_view blob_header_type;
-                    size_t blob_header_datasize = 0;
-
-                    while (pbf_blob_header.next()) {
-                        switch (pbf_blob_header.tag_and_type()) {
-                            case protozero::tag_and_type(FileFormat::BlobHeader::required_string_type, protozero::pbf_wire_type::length_delimited):
-                                blob_header_type = pbf_blob_header.get_view();
-                                break;
-                            case protozero::tag_and_type(FileFormat::BlobHeader::required_int32_datasize, protozero::pbf_wire_type::varint):
-                                blob_header_datasize = pbf_blob_header.get_int32();
-                                break;
-                            default:
-                                pbf_blob_header.skip();
-                        }
-                    }
-
-                    if (blob_header_datasize == 0) {
-                        throw osmium::pbf_error{"PBF format error: BlobHeader.datasize missing or zero."};
-                    }
-
-                    if (std::strncmp(expected_type, blob_header_type.data(), blob_header_type.size()) != 0) {
-                        throw osmium::pbf_error{"blob does not have expected type (OSMHeader in first blob, OSMData in following blobs)"};
-                    }
-
-                    return blob_header_datasize;
-                }
-
                 size_t check_type_and_get_blob_size(const char* expected_type) {
                     assert(expected_type);
 
@@ -190,7 +176,7 @@ namespace osmium {
                     }
 
                     ensure_available_in_input_queue(size);
-                    const auto blob_size = decode_blob_header(protozero::data_view{m_input_buffer.data(), size}, expected_type);
+                    const auto blob_size = decode_blob_header(protozero::data_view{input_queue_data(), size}, expected_type);
                     pop_from_input_queue(size);
                     return blob_size;
                 }
@@ -209,12 +195,16 @@ namespace osmium {
                             throw osmium::pbf_error{"unexpected EOF"};
                         }
 
+                        if (metrics()) {
+                            metrics()->input_bytes->add(size);
+                        }
+
                         if (m_offset_ptr) {
                             *m_offset_ptr += buffer.size();
                         }
                     } else {
                         ensure_available_in_input_queue(size);
-                        buffer.append(m_input_buffer, 0, size);
+                        buffer.append(input_queue_data(), size);
                         pop_from_input_queue(size);
                     }
 
@@ -228,17 +218,36 @@ namespace osmium {
                     set_header_value(header);
                 }
 
+                // Source blocks can only be kept if the buffers contain
+                // exactly the data from the blobs.
+                bool want_source_blocks() const noexcept {
+                    return keep_source_blocks() == osmium::io::keep_source_blocks::yes &&
+                           (read_types() & osmium::osm_entity_bits::nwr) == osmium::osm_entity_bits::nwr &&
+                           read_metadata() == osmium::io::read_meta::yes &&
+                           !tags_filter().filter() &&
+                           read_fields() == osmium::io::read_fields::all;
+                }
+
                 void parse_data_blobs() {
                     const bool use_pool = osmium::config::use_pool_threads_for_pbf_parsing();
+                    const bool keep_source_block = want_source_blocks();
                     while (const auto size = check_type_and_get_blob_size("OSMData")) {
                         std::string input_buffer{read_from_input_queue_with_check(size)};
 
-                        PBFDataBlobDecoder data_blob_parser{std::move(input_buffer), read_types(), read_metadata()};
+                        // Only data blobs are counted as chunks, otherwise
+                        // the header blob would be counted, too.
+                        if (m_fd != -1 && metrics()) {
+                            metrics()->input_chunks->add();
+                        }
+
+                        PBFDataBlobDecoder data_blob_parser{std::move(input_buffer), read_types(), read_metadata(), tags_filter(), read_fields(), metrics(), keep_source_block};
 
                         if (use_pool) {
                             send_to_output_queue(get_pool().submit(std::move(data_blob_parser)));
                         } else {
-                            send_to_output_queue(data_blob_parser());
+                            // The decoder records the buffer in the
+                            // metrics in both cases.
+                            send_to_output_queue(data_blob_parser(), metrics_recorded{});
                         }
 
                         if (m_want_buffered_pages_removed) {
@@ -249,6 +258,39 @@ namespace osmium {
 
             public:
 
+                /**
+                 * Decode the BlobHeader. Make sure it contains the expected
+                 * type. Return the size of the following Blob.
+                 */
+                static size_t decode_blob_header(const protozero::data_view& data, const char* expected_type) {
+                    protozero::pbf_message<FileFormat::BlobHeader> pbf_blob_header{data};
+                    protozero::data_view blob_header_type;
+                    size_t blob_header_datasize = 0;
+
+                    while (pbf_blob_header.next()) {
+                        switch (pbf_blob_header.tag_and_type()) {
+                            case protozero::tag_and_type(FileFormat::BlobHeader::required_string_type, protozero::pbf_wire_type::length_delimited):
+                                blob_header_type = pbf_blob_header.get_view();
+                                break;
+                            case protozero::tag_and_type(FileFormat::BlobHeader::required_int32_datasize, protozero::pbf_wire_type::varint):
+                                blob_header_datasize = pbf_blob_header.get_int32();
+                                break;
+                            default:
+                                pbf_blob_header.skip();
+                        }
+                    }
+
+                    if (blob_header_datasize == 0) {
+                        throw osmium::pbf_error{"PBF format error: BlobHeader.datasize missing or zero."};
+                    }
+
+                    if (std::strncmp(expected_type, blob_header_type.data(), blob_header_type.size()) != 0) {
+                        throw osmium::pbf_error{"blob does not have expected type (OSMHeader in first blob, OSMData in following blobs)"};
+                    }
+
+                    return blob_header_datasize;
+                }
+
                 static uint32_t get_size_in_network_byte_order(const char* d) noexcept {
                     return (static_cast<uint32_t>(static_cast<uint8_t>(d[3]))) |
                            (static_cast<uint32_t>(static_cast<uint8_t>(d[2])) <<  8U) |
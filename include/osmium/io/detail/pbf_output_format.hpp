@@ -69,6 +69,7 @@ DEALINGS IN THE SOFTWARE.
 #include <osmium/thread/pool.hpp>
 #include <osmium/util/delta.hpp>
 #include <osmium/util/misc.hpp>
+#include <osmium/util/options.hpp>
 #include <osmium/visitor.hpp>
 
 #ifdef OSMIUM_WITH_LZ4
@@ -364,6 +365,40 @@ namespace osmium {
 
             }; // class PrimitiveBlock
 
+            /**
+             * Add the BlobHeader (and its size) in front of the serialized
+             * Blob, ready to be written to a file.
+             */
+            inline std::string add_blob_header(const std::string& blob_data, pbf_blob_type type) {
+                std::string blob_header_data;
+                protozero::pbf_builder<FileFormat::BlobHeader> pbf_blob_header{blob_header_data};
+
+                pbf_blob_header.add_string(FileFormat::BlobHeader::required_string_type, type == pbf_blob_type::data ? "OSMData" : "OSMHeader");
+
+                // The static_cast is okay, because the size can never
+                // be much larger than max_uncompressed_blob_size. This
+                // is due to the assert in SerializeBlob and the fact that
+                // the zlib library will not grow deflated data beyond the
+                // original data plus a few header bytes
+                // (https://zlib.net/zlib_tech.html).
+                pbf_blob_header.add_int32(FileFormat::BlobHeader::required_int32_datasize, static_cast<int32_t>(blob_data.size()));
+
+                const auto size = static_cast<uint32_t>(blob_header_data.size());
+
+                // write to output: the 4-byte BlobHeader size in network
+                // byte order followed by the BlobHeader followed by the Blob
+                std::string output;
+                output.reserve(4 + blob_header_data.size() + blob_data.size());
+                output += static_cast<char>((size >> 24U) & 0xffU);
+                output += static_cast<char>((size >> 16U) & 0xffU);
+                output += static_cast<char>((size >>  8U) & 0xffU);
+                output += static_cast<char>( size         & 0xffU);
+                output.append(blob_header_data);
+                output.append(blob_data);
+
+                return output;
+            }
+
             class SerializeBlob {
 
                 std::shared_ptr<PrimitiveBlock> m_block;
@@ -448,32 +483,7 @@ namespace osmium {
 #endif
                     }
 
-                    std::string blob_header_data;
-                    protozero::pbf_builder<FileFormat::BlobHeader> pbf_blob_header{blob_header_data};
-
-                    pbf_blob_header.add_string(FileFormat::BlobHeader::required_string_type, m_blob_type == pbf_blob_type::data ? "OSMData" : "OSMHeader");
-
-                    // The static_cast is okay, because the size can never
-                    // be much larger than max_uncompressed_blob_size. This
-                    // is due to the assert above and the fact that the zlib
-                    // library will not grow deflated data beyond the original
-                    // data plus a few header bytes (https://zlib.net/zlib_tech.html).
-                    pbf_blob_header.add_int32(FileFormat::BlobHeader::required_int32_datasize, static_cast<int32_t>(blob_data.size()));
-
-                    const auto size = static_cast<uint32_t>(blob_header_data.size());
-
-                    // write to output: the 4-byte BlobHeader size in network
-                    // byte order followed by the BlobHeader followed by the Blob
-                    std::string output;
-                    output.reserve(4 + blob_header_data.size() + blob_data.size());
-                    output += static_cast<char>((size >> 24U) & 0xffU);
-                    output += static_cast<char>((size >> 16U) & 0xffU);
-                    output += static_cast<char>((size >>  8U) & 0xffU);
-                    output += static_cast<char>( size         & 0xffU);
-                    output.append(blob_header_data);
-                    output.append(blob_data);
-
-                    return output;
+                    return add_blob_header(blob_data, m_blob_type);
                 }
 
             }; // class SerializeBlob
@@ -666,7 +676,46 @@ namespace osmium {
                                       m_options.compression_level}));
                 }
 
+                // Source blocks can only be copied if they were encoded
+                // with the same options this writer uses. The compression
+                // level can't be found out from the data, so blocks with
+                // a different level of the same compression are copied.
+                bool can_copy(const osmium::memory::source_block& block) const {
+                    if (block.format != "pbf") {
+                        return false;
+                    }
+
+                    const auto& encoding = block.encoding;
+                    if (encoding.get("pbf_compression") != compression_type_name(m_options.use_compression) ||
+                        encoding.get("add_metadata") != m_options.add_metadata.to_string() ||
+                        encoding.is_true("add_visible_flag") != m_options.add_visible_flag) {
+                        return false;
+                    }
+
+                    // These are only set if the block contains nodes or
+                    // ways, respectively.
+                    if (!encoding.get("pbf_dense_nodes").empty() &&
+                        encoding.is_true("pbf_dense_nodes") != m_options.use_dense_nodes) {
+                        return false;
+                    }
+                    if (!encoding.get("locations_on_ways").empty() &&
+                        encoding.is_true("locations_on_ways") != m_options.locations_on_ways) {
+                        return false;
+                    }
+
+                    return true;
+                }
+
                 void write_buffer(osmium::memory::Buffer&& buffer) final {
+                    // Buffers read from a PBF file and marked as unchanged
+                    // are written out as they are without encoding and
+                    // compressing them again, as long as they were encoded
+                    // with the same options this writer uses.
+                    if (buffer.is_unchanged() && can_copy(*buffer.get_source_block())) {
+                        store_primitive_block();
+                        add_to_queue(m_output_queue, add_blob_header(buffer.get_source_block()->data, pbf_blob_type::data));
+                        return;
+                    }
                     osmium::apply(buffer.cbegin(), buffer.cend(), *this);
                 }
 
@@ -37,6 +37,7 @@ DEALINGS IN THE SOFTWARE.
 #include <osmium/thread/queue.hpp>
 
 #include <cassert>
+#include <chrono>
 #include <exception>
 #include <future>
 #include <string>
@@ -102,6 +103,18 @@ namespace osmium {
 
                 future_queue_type<T>& m_queue;
 
+                // Future taken from the queue by try_pop() that was
+                // not ready yet. It will be returned next.
+                std::future<T> m_pending;
+
+                T get_data(std::future<T>& data_future) {
+                    T data{std::move(data_future.get())};
+                    if (at_end_of_data(data)) {
+                        m_queue.shutdown();
+                    }
+                    return data;
+                }
+
             public:
 
                 explicit queue_wrapper(future_queue_type<T>& queue) :
@@ -131,20 +144,43 @@ namespace osmium {
                 }
 
                 T pop() {
+                    if (m_pending.valid()) {
+                        return get_data(m_pending);
+                    }
                     T data;
                     if (m_queue.in_use()) {
                         std::future<T> data_future;
                         m_queue.wait_and_pop(data_future);
                         if (data_future.valid()) {
-                            data = std::move(data_future.get());
-                            if (at_end_of_data(data)) {
-                                m_queue.shutdown();
-                            }
+                            data = get_data(data_future);
                         }
                     }
                     return data;
                 }
 
+                /**
+                 * Get the next data from the queue without blocking. This
+                 * only succeeds if there is something in the queue and it
+                 * is ready, otherwise false is returned and nothing
+                 * is lost, the next pop() will return the data.
+                 *
+                 * @param data Set to the data if there was any.
+                 * @returns true if data was set.
+                 * @throws Any exception stored in the queue.
+                 */
+                bool try_pop(T& data) {
+                    if (!m_pending.valid()) {
+                        if (!m_queue.in_use() || !m_queue.try_pop(m_pending) || !m_pending.valid()) {
+                            return false;
+                        }
+                    }
+                    if (m_pending.wait_for(std::chrono::seconds{0}) != std::future_status::ready) {
+                        return false;
+                    }
+                    data = get_data(m_pending);
+                    return true;
+                }
+
             }; // class queue_wrapper
 
         } // namespace detail
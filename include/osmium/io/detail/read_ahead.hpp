@@ -0,0 +1,268 @@
+#ifndef OSMIUM_IO_DETAIL_READ_AHEAD_HPP
+#define OSMIUM_IO_DETAIL_READ_AHEAD_HPP
+
+/*
+
+This file is part of Osmium (https://osmcode.org/libosmium).
+
+Copyright 2013-2026 Jochen Topf <jochen@topf.org> and others (see README).
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include <osmium/io/detail/read_write.hpp>
+#include <osmium/thread/util.hpp>
+#include <osmium/util/config.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+# include <sys/stat.h>
+# include <sys/types.h>
+#endif
+
+namespace osmium {
+
+    namespace io {
+
+        namespace detail {
+
+#ifndef _WIN32
+
+            /**
+             * Reads a file from start to end in chunks using several threads
+             * with pread(2), so that several reads are in flight at the same
+             * time. The chunks are returned by read() in file order. This is
+             * only possible for regular files, not for pipes etc.
+             *
+             * The threads read at most max_chunks_per_thread chunks per
+             * thread ahead of the chunk returned last.
+             */
+            class ReadAhead {
+
+                enum {
+                    max_chunks_per_thread = 2
+                };
+
+            public:
+
+                enum : std::size_t {
+                    default_chunk_size = 4UL * 1024UL * 1024UL
+                };
+
+            private:
+
+                struct chunk {
+                    std::string data;
+                    std::exception_ptr exception;
+                    bool ready = false;
+                };
+
+                int m_fd;
+                std::size_t m_chunk_size;
+                std::size_t m_max_in_flight;
+
+                std::mutex m_mutex;
+                std::condition_variable m_cond;
+
+                // Chunks from m_next_to_return on. Protected by m_mutex.
+                std::deque<chunk> m_chunks;
+                std::size_t m_next_to_return = 0;
+                std::size_t m_next_to_read = 0;
+
+                // The number of the first chunk that is known to be the
+                // last one, because it was short or had an error.
+                std::size_t m_last_chunk = std::numeric_limits<std::size_t>::max();
+
+                bool m_done = false;
+
+                std::vector<std::thread> m_threads;
+
+                void run_in_thread() {
+                    osmium::thread::set_thread_name("_osmium_rdahead");
+
+                    while (true) {
+                        std::size_t num = 0;
+                        {
+                            std::unique_lock<std::mutex> lock{m_mutex};
+                            m_cond.wait(lock, [this] {
+                                return m_done ||
+                                       m_next_to_read > m_last_chunk ||
+                                       m_next_to_read < m_next_to_return + m_max_in_flight;
+                            });
+                            if (m_done || m_next_to_read > m_last_chunk) {
+                                return;
+                            }
+                            num = m_next_to_read++;
+                        }
+
+                        std::string data(m_chunk_size, '\0');
+                        std::exception_ptr exception;
+                        try {
+                            data.resize(reliable_pread(m_fd, &*data.begin(), m_chunk_size, num * m_chunk_size));
+                        } catch (...) {
+                            exception = std::current_exception();
+                        }
+
+                        {
+                            const std::lock_guard<std::mutex> lock{m_mutex};
+                            if (data.size() < m_chunk_size || exception) {
+                                if (num < m_last_chunk) {
+                                    m_last_chunk = num;
+                                }
+                            }
+                            if (num >= m_next_to_return) {
+                                const auto pos = num - m_next_to_return;
+                                if (m_chunks.size() <= pos) {
+                                    m_chunks.resize(pos + 1);
+                                }
+                                auto& c = m_chunks[pos];
+                                c.data = std::move(data);
+                                c.exception = exception;
+                                c.ready = true;
+                            }
+                        }
+                        m_cond.notify_all();
+                    }
+                }
+
+            public:
+
+                /**
+                 * Start reading the file.
+                 *
+                 * @param fd File descriptor of a regular file. The file
+                 *           is read from the beginning. It is not closed.
+                 * @param num_threads Number of threads used for reading.
+                 * @param chunk_size Size of the chunks read in one call.
+                 */
+                ReadAhead(const int fd, const int num_threads, const std::size_t chunk_size = default_chunk_size) :
+                    m_fd(fd),
+                    m_chunk_size(chunk_size),
+                    m_max_in_flight(static_cast<std::size_t>(num_threads) * max_chunks_per_thread) {
+                    m_threads.reserve(static_cast<std::size_t>(num_threads));
+                    for (int i = 0; i < num_threads; ++i) {
+                        m_threads.emplace_back(&ReadAhead::run_in_thread, this);
+                    }
+                }
+
+                ReadAhead(const ReadAhead&) = delete;
+                ReadAhead& operator=(const ReadAhead&) = delete;
+
+                ReadAhead(ReadAhead&&) = delete;
+                ReadAhead& operator=(ReadAhead&&) = delete;
+
+                ~ReadAhead() noexcept {
+                    close();
+                }
+
+                /**
+                 * Get the next chunk from the file. Blocks until it has
+                 * been read.
+                 *
+                 * @returns The data or an empty string at the end of file.
+                 * @throws std::system_error If the read failed.
+                 */
+                std::string read() {
+                    std::unique_lock<std::mutex> lock{m_mutex};
+                    if (m_next_to_return > m_last_chunk) {
+                        return std::string{};
+                    }
+
+                    m_cond.wait(lock, [this] {
+                        return !m_chunks.empty() && m_chunks.front().ready;
+                    });
+
+                    chunk c{std::move(m_chunks.front())};
+                    m_chunks.pop_front();
+                    ++m_next_to_return;
+                    lock.unlock();
+                    m_cond.notify_all();
+
+                    if (c.exception) {
+                        std::rethrow_exception(c.exception);
+                    }
+
+                    return std::move(c.data);
+                }
+
+                /**
+                 * Stop reading and wait for all threads to finish. Reads
+                 * that are already in flight are completed first.
+                 */
+                void close() noexcept {
+                    {
+                        const std::lock_guard<std::mutex> lock{m_mutex};
+                        m_done = true;
+                    }
+                    m_cond.notify_all();
+                    for (auto& thread : m_threads) {
+                        if (thread.joinable()) {
+                            thread.join();
+                        }
+                    }
+                }
+
+            }; // class ReadAhead
+
+            /**
+             * Should the file be read with a ReadAhead? This is the case if
+             * read ahead threads are configured (see
+             * osmium::config::get_read_ahead_threads()) and the file is a
+             * regular file.
+             */
+            inline bool want_read_ahead(const int fd) noexcept {
+                if (fd < 0 || osmium::config::get_read_ahead_threads() == 0) {
+                    return false;
+                }
+                struct stat s; // NOLINT(cppcoreguidelines-pro-type-member-init,hicpp-member-init)
+                return ::fstat(fd, &s) == 0 && S_ISREG(s.st_mode); // NOLINT(hicpp-signed-bitwise)
+            }
+
+#else
+
+            inline bool want_read_ahead(const int /*fd*/) noexcept {
+                return false;
+            }
+
+#endif
+
+        } // namespace detail
+
+    } // namespace io
+
+} // namespace osmium
+
+#endif // OSMIUM_IO_DETAIL_READ_AHEAD_HPP
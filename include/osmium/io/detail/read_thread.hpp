@@ -36,9 +36,11 @@ DEALINGS IN THE SOFTWARE.
 #include <osmium/io/compression.hpp>
 #include <osmium/io/detail/queue_util.hpp>
 #include <osmium/thread/util.hpp>
+#include <osmium/util/metrics.hpp>
 
 #include <atomic>
 #include <exception>
+#include <memory>
 #include <string>
 #include <thread>
 #include <utility>
@@ -54,6 +56,11 @@ namespace osmium {
              * the input file and (optionally) decompress it. The result is
              * sent to the given queue. Any exceptions will also be send to
              * the queue.
+             *
+             * If metrics are enabled, the number of chunks and bytes read
+             * (after decompression) are counted in "reader.input_chunks" and
+             * "reader.input_bytes" and the time needed to read (and
+             * decompress) each chunk is recorded in "reader.read_us".
              */
             class ReadThreadManager {
 
@@ -61,6 +68,11 @@ namespace osmium {
                 osmium::io::Decompressor& m_decompressor;
                 future_string_queue_type& m_queue;
 
+                // only used in the sub-thread, set before it is started
+                std::shared_ptr<osmium::metrics::Counter> m_input_chunks;
+                std::shared_ptr<osmium::metrics::Counter> m_input_bytes;
+                std::shared_ptr<osmium::metrics::Histogram> m_read_time;
+
                 // used in both threads
                 std::atomic<bool> m_done;
 
@@ -72,10 +84,16 @@ namespace osmium {
 
                     try {
                         while (!m_done) {
+                            const auto start = osmium::metrics::clock_type::now();
                             std::string data{m_decompressor.read()};
                             if (at_end_of_data(data)) {
                                 break;
                             }
+                            if (m_input_chunks) {
+                                m_read_time->record(osmium::metrics::microseconds_since(start));
+                                m_input_chunks->add();
+                                m_input_bytes->add(data.size());
+                            }
                             add_to_queue(m_queue, std::move(data));
                         }
 
@@ -90,9 +108,13 @@ namespace osmium {
             public:
 
                 ReadThreadManager(osmium::io::Decompressor& decompressor,
-                                  future_string_queue_type& queue) :
+                                  future_string_queue_type& queue,
+                                  osmium::metrics::Registry* metrics = nullptr) :
                     m_decompressor(decompressor),
                     m_queue(queue),
+                    m_input_chunks(metrics ? metrics->shared_counter("reader.input_chunks") : nullptr),
+                    m_input_bytes(metrics ? metrics->shared_counter("reader.input_bytes") : nullptr),
+                    m_read_time(metrics ? metrics->shared_histogram("reader.read_us") : nullptr),
                     m_done(false),
                     m_thread(std::thread(&ReadThreadManager::run_in_thread, this)) {
                 }
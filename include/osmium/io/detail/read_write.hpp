@@ -90,6 +90,30 @@ namespace osmium {
                 return fd;
             }
 
+            /**
+             * Open file for appending. If the file doesn't exist, it is
+             * created.
+             *
+             * @param filename Name of file to be opened.
+             * @returns File descriptor of open file.
+             * @throws system_error if the file can't be opened.
+             */
+            inline int open_for_appending(const std::string& filename) {
+#ifdef _MSC_VER
+                osmium::detail::disable_invalid_parameter_handler diph;
+#endif
+
+                int flags = O_WRONLY | O_CREAT | O_APPEND; // NOLINT(hicpp-signed-bitwise)
+#ifdef _WIN32
+                flags |= O_BINARY; // NOLINT(hicpp-signed-bitwise)
+#endif
+                const int fd = ::open(filename.c_str(), flags, 0666);
+                if (fd < 0) {
+                    throw std::system_error{errno, std::system_category(), std::string("Open failed for '") + filename + "'"};
+                }
+                return fd;
+            }
+
             /**
              * Open file for reading. If the file name is empty or "-", no file
              * is opened and the stdin file descriptor (0) is returned.
@@ -228,6 +252,42 @@ namespace osmium {
                 return true;
             }
 
+#ifndef _WIN32
+            /**
+             * Reads size bytes (or less if the end of file is reached) from
+             * the file descriptor at the given offset into the input_buffer.
+             * This is a wrapper around pread(2) that doesn't change the
+             * file offset, so it can be used from several threads at the
+             * same time.
+             *
+             * @param fd File descriptor.
+             * @param input_buffer Buffer for data to be read. Must be at least size bytes long.
+             * @param size Number of bytes to read.
+             * @param offset Offset in the file to read from.
+             * @returns the number of bytes read
+             * @throws std::system_error On error.
+             */
+            inline std::size_t reliable_pread(const int fd, char* input_buffer, const std::size_t size, const std::size_t offset) {
+                std::size_t done = 0;
+
+                while (done < size) {
+                    const auto nread = ::pread(fd, input_buffer + done, size - done, static_cast<off_t>(offset + done));
+                    if (nread < 0) {
+                        if (errno == EINTR) {
+                            continue;
+                        }
+                        throw std::system_error{errno, std::system_category(), "Read failed"};
+                    }
+                    if (nread == 0) { // EOF
+                        break;
+                    }
+                    done += static_cast<std::size_t>(nread);
+                }
+
+                return done;
+            }
+#endif
+
             inline void reliable_fsync(const int fd) {
 #ifdef _MSC_VER
                 osmium::detail::disable_invalid_parameter_handler diph;
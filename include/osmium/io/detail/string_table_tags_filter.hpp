@@ -0,0 +1,192 @@
+#ifndef OSMIUM_IO_DETAIL_STRING_TABLE_TAGS_FILTER_HPP
+#define OSMIUM_IO_DETAIL_STRING_TABLE_TAGS_FILTER_HPP
+
+/*
+
+This file is part of Osmium (https://osmcode.org/libosmium).
+
+Copyright 2013-2026 Jochen Topf <jochen@topf.org> and others (see README).
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+*/
+#include <osmium/osm/types.hpp>
+#include <osmium/tags/tags_filter.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace osmium {
+
+    namespace io {
+
+        namespace detail {
+
+            using osm_string_len_type = std::pair<const char*, osmium::string_size_type>;
+
+            /**
+             * Evaluates a TagsFilter on tags given as indexes into a
+             * string table like the ones in PBF blocks.
+             *
+             * The key and value matchers of the rules are called at most
+             * once for each string in the table, the results are cached
+             * as bit masks with one bit per rule. The result for a tag is
+             * then found by and-ing the masks of the key and the value.
+             * This only works for filters with up to 64 rules, for larger
+             * filters all rules are checked for each tag.
+             */
+            class string_table_tags_filter {
+
+                enum : std::size_t {
+                    max_rules = 64
+                };
+
+                enum : uint8_t {
+                    key_done   = 0x01U,
+                    value_done = 0x02U
+                };
+
+                const osmium::TagsFilter* m_filter;
+                const std::vector<osm_string_len_type>* m_stringtable;
+
+                std::vector<uint64_t> m_key_bits;
+                std::vector<uint64_t> m_value_bits;
+                std::vector<uint8_t> m_done;
+
+                // Bits for all rules with result "true".
+                uint64_t m_true_rules = 0;
+
+                // Null-terminated copies of strings for the matchers.
+                std::string m_key;
+                std::string m_value;
+
+                bool m_use_bits;
+
+                const char* c_str(std::string& out, const uint32_t index) const {
+                    const auto& str = m_stringtable->at(index);
+                    out.assign(str.first, str.second);
+                    return out.c_str();
+                }
+
+                uint64_t key_bits(const uint32_t index) {
+                    auto& done = m_done.at(index);
+                    if (!(done & key_done)) {
+                        const char* key = c_str(m_key, index);
+                        uint64_t bits = 0;
+                        uint64_t bit = 1;
+                        for (const auto& rule : m_filter->rules()) {
+                            if (rule.second.key_matcher()(key)) {
+                                bits |= bit;
+                            }
+                            bit <<= 1U;
+                        }
+                        m_key_bits[index] = bits;
+                        done |= key_done;
+                    }
+                    return m_key_bits[index];
+                }
+
+                uint64_t value_bits(const uint32_t index) {
+                    auto& done = m_done.at(index);
+                    if (!(done & value_done)) {
+                        const char* value = c_str(m_value, index);
+                        uint64_t bits = 0;
+                        uint64_t bit = 1;
+                        for (const auto& rule : m_filter->rules()) {
+                            if (rule.second.value_matcher()(value) != rule.second.value_inverted()) {
+                                bits |= bit;
+                            }
+                            bit <<= 1U;
+                        }
+                        m_value_bits[index] = bits;
+                        done |= value_done;
+                    }
+                    return m_value_bits[index];
+                }
+
+            public:
+
+                /**
+                 * Constructor. The filter and the string table must be
+                 * available as long as this object is used. The string
+                 * table must not change.
+                 */
+                string_table_tags_filter(const osmium::TagsFilter& filter, const std::vector<osm_string_len_type>& stringtable) :
+                    m_filter(&filter),
+                    m_stringtable(&stringtable),
+                    m_use_bits(filter.count() <= max_rules) {
+                    if (m_use_bits) {
+                        m_key_bits.resize(stringtable.size());
+                        m_value_bits.resize(stringtable.size());
+                        m_done.resize(stringtable.size());
+                        uint64_t bit = 1;
+                        for (const auto& rule : filter.rules()) {
+                            if (rule.first) {
+                                m_true_rules |= bit;
+                            }
+                            bit <<= 1U;
+                        }
+                    }
+                }
+
+                /**
+                 * Get the result of the filter for a tag.
+                 *
+                 * @param key Index of the key in the string table.
+                 * @param value Index of the value in the string table.
+                 * @throws std::out_of_range If an index is not in the table.
+                 */
+                bool operator()(const uint32_t key, const uint32_t value) {
+                    if (m_use_bits) {
+                        const uint64_t bits = key_bits(key) & value_bits(value);
+                        if (bits == 0) {
+                            return m_filter->default_result();
+                        }
+                        // The lowest bit is the first matching rule.
+                        return (bits & (~bits + 1U) & m_true_rules) != 0;
+                    }
+
+                    const char* k = c_str(m_key, key);
+                    const char* v = c_str(m_value, value);
+                    for (const auto& rule : m_filter->rules()) {
+                        if (rule.second(k, v)) {
+                            return rule.first;
+                        }
+                    }
+                    return m_filter->default_result();
+                }
+
+            }; // class string_table_tags_filter
+
+        } // namespace detail
+
+    } // namespace io
+
+} // namespace osmium
+
+#endif // OSMIUM_IO_DETAIL_STRING_TABLE_TAGS_FILTER_HPP
@@ -36,7 +36,9 @@ DEALINGS IN THE SOFTWARE.
 #include <osmium/io/compression.hpp>
 #include <osmium/io/detail/queue_util.hpp>
 #include <osmium/thread/util.hpp>
+#include <osmium/util/metrics.hpp>
 
+#include <cstddef>
 #include <exception>
 #include <future>
 #include <memory>
@@ -53,6 +55,16 @@ namespace osmium {
              * This codes runs in its own thread, getting data from the given
              * queue, (optionally) compressing it, and writing it to the output
              * file.
+             *
+             * Chunks that are already waiting in the queue when a chunk is
+             * written are merged with it (up to 4 MB) and handed to the
+             * compressor in one go.
+             *
+             * If metrics are enabled, the number of chunks and bytes written
+             * (before compression) are counted in "writer.output_chunks" and
+             * "writer.output_bytes" and the time needed to compress and
+             * write each chunk is recorded in "writer.write_us". Merged
+             * chunks are counted as one.
              */
             class WriteThread {
 
@@ -60,17 +72,29 @@ namespace osmium {
                 std::unique_ptr<osmium::io::Compressor> m_compressor;
                 std::promise<std::size_t> m_promise;
                 std::atomic_bool* m_notification;
+                std::shared_ptr<osmium::metrics::Counter> m_output_chunks;
+                std::shared_ptr<osmium::metrics::Counter> m_output_bytes;
+                std::shared_ptr<osmium::metrics::Histogram> m_write_time;
+
+                // Chunks are only merged until the batch reaches this size.
+                enum : std::size_t {
+                    max_batch_size = 4UL * 1024UL * 1024UL
+                };
 
             public:
 
                 WriteThread(future_string_queue_type& input_queue,
                             std::unique_ptr<osmium::io::Compressor>&& compressor,
                             std::promise<std::size_t>&& promise,
-                            std::atomic_bool* notification) :
+                            std::atomic_bool* notification,
+                            osmium::metrics::Registry* metrics = nullptr) :
                     m_queue(input_queue),
                     m_compressor(std::move(compressor)),
                     m_promise(std::move(promise)),
-                    m_notification(notification) {
+                    m_notification(notification),
+                    m_output_chunks(metrics ? metrics->shared_counter("writer.output_chunks") : nullptr),
+                    m_output_bytes(metrics ? metrics->shared_counter("writer.output_bytes") : nullptr),
+                    m_write_time(metrics ? metrics->shared_histogram("writer.write_us") : nullptr) {
                 }
 
                 WriteThread(const WriteThread&) = delete;
@@ -85,12 +109,35 @@ namespace osmium {
                     osmium::thread::set_thread_name("_osmium_write");
 
                     try {
-                        while (true) {
-                            const std::string data{m_queue.pop()};
+                        bool done = false;
+                        while (!done) {
+                            std::string data{m_queue.pop()};
                             if (at_end_of_data(data)) {
                                 break;
                             }
-                            m_compressor->write(data);
+
+                            // If the writer is falling behind, several
+                            // chunks will be ready in the queue. Those are
+                            // written out together to get fewer, larger
+                            // writes.
+                            std::string next;
+                            while (data.size() < max_batch_size && m_queue.try_pop(next)) {
+                                if (at_end_of_data(next)) {
+                                    done = true;
+                                    break;
+                                }
+                                data.append(next);
+                            }
+
+                            if (m_output_chunks) {
+                                const auto start = osmium::metrics::clock_type::now();
+                                m_compressor->write(data);
+                                m_write_time->record(osmium::metrics::microseconds_since(start));
+                                m_output_chunks->add();
+                                m_output_bytes->add(data.size());
+                            } else {
+                                m_compressor->write(data);
+                            }
                         }
                         m_compressor->close();
                         m_promise.set_value(m_compressor->file_size());
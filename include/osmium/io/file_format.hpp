@@ -62,6 +62,65 @@ namespace osmium {
             single = 1
         };
 
+        /**
+         * Should readers attach the encoded data to the buffers they
+         * return, so that unchanged buffers can be written out without
+         * encoding them again? See osmium::memory::source_block.
+         * Currently only the PBF reader and writer support this.
+         */
+        enum class keep_source_blocks {
+            no  = 0,
+            yes = 1
+        };
+
+        /**
+         * Which parts of OSM objects should be read. Used as an option to
+         * the Reader. Parts not needed don't have to be decoded and built
+         * which can speed up reading considerably. Meta data other than
+         * the user name is controlled by osmium::io::read_meta.
+         *
+         * This is a hint, parsers are allowed to read more than requested.
+         * The PBF, O5M, and OPL parsers honour it, the XML parser doesn't.
+         *
+         * @code
+         * osmium::io::Reader reader{"input.osm.pbf", osmium::io::read_fields::ids | osmium::io::read_fields::locations};
+         * @endcode
+         */
+        namespace read_fields {
+
+            enum type : unsigned char {
+                ids       = 0x00, ///< only ids (and meta data)
+                locations = 0x01, ///< locations of nodes and way nodes
+                refs      = 0x02, ///< way node refs and relation members
+                tags      = 0x04, ///< tags
+                user      = 0x08, ///< user names
+                all       = 0x0f  ///< everything
+            }; // enum type
+
+            constexpr type operator|(const type lhs, const type rhs) noexcept {
+                return static_cast<type>(static_cast<unsigned char>(lhs) | static_cast<unsigned char>(rhs));
+            }
+
+            constexpr type operator&(const type lhs, const type rhs) noexcept {
+                return static_cast<type>(static_cast<unsigned char>(lhs) & static_cast<unsigned char>(rhs));
+            }
+
+            constexpr type operator~(const type value) noexcept {
+                return all & static_cast<type>(~static_cast<unsigned char>(value));
+            }
+
+            inline type& operator|=(type& lhs, const type rhs) noexcept {
+                lhs = lhs | rhs;
+                return lhs;
+            }
+
+            inline type& operator&=(type& lhs, const type rhs) noexcept {
+                lhs = lhs & rhs;
+                return lhs;
+            }
+
+        } // namespace read_fields
+
         inline const char* as_string(const file_format format) noexcept {
             switch (format) {
                 case file_format::xml:
@@ -147,6 +147,7 @@ namespace osmium {
                     if (nwrite == 0) {
                         detail::throw_gzip_error(m_gzfile, "write failed");
                     }
+                    fsync_if_interval_reached(m_fd, data.size());
                 }
             }
 
@@ -0,0 +1,317 @@
+#ifndef OSMIUM_IO_MERGING_READER_HPP
+#define OSMIUM_IO_MERGING_READER_HPP
+
+/*
+
+This file is part of Osmium (https://osmcode.org/libosmium).
+
+Copyright 2013-2026 Jochen Topf <jochen@topf.org> and others (see README).
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include <osmium/handler/check_order.hpp>
+#include <osmium/io/error.hpp>
+#include <osmium/io/file.hpp>
+#include <osmium/io/header.hpp>
+#include <osmium/io/reader.hpp>
+#include <osmium/memory/buffer.hpp>
+#include <osmium/memory/item_iterator.hpp>
+#include <osmium/osm/item_type.hpp>
+#include <osmium/osm/object.hpp>
+#include <osmium/osm/object_comparisons.hpp>
+#include <osmium/osm/types.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace osmium {
+
+    namespace io {
+
+        /**
+         * Reads several sorted OSM files at the same time and merges their
+         * contents into one sorted stream of nodes, ways, and relations.
+         * Use this like a Reader: Call read() until it returns an invalid
+         * buffer.
+         *
+         * Objects are ordered by type, id, and version (see
+         * osmium::object_order_type_id_version_without_timestamp). Each
+         * input must already be sorted this way, otherwise an
+         * osmium::out_of_order_error is thrown. If several inputs contain
+         * the same object with the same version, only the one from the
+         * input given first is used, the others are counted as duplicates.
+         * Timestamps are not taken into account for this. Changesets are
+         * ignored.
+         *
+         * Each input is read by its own Reader, so reading, decompressing
+         * and decoding of all inputs happens in parallel in the background
+         * while the merge is running.
+         */
+        class MergingReader {
+
+            using iterator_type = osmium::memory::ItemIterator<osmium::OSMObject>;
+
+            // Type, id, and version of the last object returned. Used to
+            // find duplicates even if that object is in a buffer which
+            // was already returned.
+            struct object_key {
+
+                osmium::item_type type = osmium::item_type::undefined;
+                osmium::object_id_type id = 0;
+                osmium::object_version_type version = 0;
+
+                object_key() noexcept = default;
+
+                explicit object_key(const osmium::OSMObject& object) noexcept :
+                    type(object.type()),
+                    id(object.id()),
+                    version(object.version()) {
+                }
+
+                bool operator==(const object_key& other) const noexcept {
+                    return type == other.type && id == other.id && version == other.version;
+                }
+
+            }; // struct object_key
+
+            struct input {
+
+                std::unique_ptr<osmium::io::Reader> reader;
+                osmium::memory::Buffer buffer{};
+                iterator_type it{};
+                iterator_type end{};
+
+            }; // struct input
+
+            struct heap_element {
+
+                const osmium::OSMObject* object;
+                std::size_t input;
+
+                // The heap is a max heap, so this is reversed: The element
+                // with the smallest object (and, for the same type, id,
+                // and version, from the first input) is at the top.
+                bool operator<(const heap_element& other) const noexcept {
+                    const osmium::object_order_type_id_version_without_timestamp order;
+                    if (order(other.object, object)) {
+                        return true;
+                    }
+                    if (order(object, other.object)) {
+                        return false;
+                    }
+                    return other.input < input;
+                }
+
+            }; // struct heap_element
+
+            std::vector<input> m_inputs;
+            std::priority_queue<heap_element> m_heap;
+            object_key m_last;
+            std::size_t m_buffer_size;
+            std::size_t m_duplicates = 0;
+            bool m_has_last = false;
+            bool m_started = false;
+
+            // Advance input n to its next object and add that to the heap.
+            void next_object(const std::size_t n) {
+                auto& in = m_inputs[n];
+
+                // The previous object of this input is needed for the
+                // order check, so its buffer is kept until then.
+                const osmium::OSMObject* previous = nullptr;
+                osmium::memory::Buffer previous_buffer;
+                if (in.it != in.end) {
+                    previous = &*in.it;
+                    ++in.it;
+                }
+                while (in.it == in.end) {
+                    if (!previous_buffer) {
+                        previous_buffer = std::move(in.buffer);
+                    }
+                    in.buffer = in.reader->read();
+                    if (!in.buffer) {
+                        in.reader->close();
+                        return;
+                    }
+                    auto range = in.buffer.select<osmium::OSMObject>();
+                    in.it = range.begin();
+                    in.end = range.end();
+                }
+
+                if (previous && osmium::object_order_type_id_version_without_timestamp{}(*in.it, *previous)) {
+                    throw osmium::out_of_order_error{"input " + std::to_string(n) + " of MergingReader not ordered", in.it->id()};
+                }
+
+                m_heap.push(heap_element{&*in.it, n});
+            }
+
+            void start() {
+                m_started = true;
+                for (std::size_t n = 0; n < m_inputs.size(); ++n) {
+                    next_object(n);
+                }
+            }
+
+        public:
+
+            enum {
+                default_buffer_size = 1024UL * 1024UL
+            };
+
+            /**
+             * Create MergingReader.
+             *
+             * @param files The input files.
+             * @param args All further arguments are given to the constructor
+             *             of the Reader of each input. See there for the
+             *             options available. Note that a pool or metrics
+             *             registry given here is shared by all Readers.
+             *
+             * @throws osmium::io_error If there was an error.
+             * @throws std::system_error If a file could not be opened.
+             */
+            template <typename... TArgs>
+            explicit MergingReader(const std::vector<osmium::io::File>& files, TArgs&&... args) :
+                m_buffer_size(default_buffer_size) {
+                m_inputs.reserve(files.size());
+                for (const auto& file : files) {
+                    m_inputs.emplace_back();
+                    m_inputs.back().reader = std::make_unique<osmium::io::Reader>(file, args...);
+                }
+            }
+
+            /**
+             * Create MergingReader from file names. See the other constructor
+             * for details.
+             */
+            template <typename... TArgs>
+            explicit MergingReader(const std::vector<std::string>& filenames, TArgs&&... args) :
+                MergingReader(std::vector<osmium::io::File>(filenames.cbegin(), filenames.cend()), std::forward<TArgs>(args)...) {
+            }
+
+            /**
+             * Set the size of the buffers returned by read(). Default is
+             * 1 MByte. Buffers can be larger if a single object doesn't fit.
+             */
+            void set_buffer_size(std::size_t size) noexcept {
+                m_buffer_size = size;
+            }
+
+            /**
+             * The number of inputs.
+             */
+            std::size_t size() const noexcept {
+                return m_inputs.size();
+            }
+
+            /**
+             * Get the header of input n.
+             *
+             * @pre @code n < size() @endcode
+             */
+            osmium::io::Header header(std::size_t n) {
+                return m_inputs[n].reader->header();
+            }
+
+            /**
+             * The number of objects that were skipped so far, because an
+             * object with the same type, id, and version was already
+             * returned from an earlier input.
+             */
+            std::size_t duplicates() const noexcept {
+                return m_duplicates;
+            }
+
+            /**
+             * Read the next buffer with merged data. An invalid buffer
+             * signals the end of all inputs.
+             *
+             * @returns Buffer.
+             * @throws Some form of osmium::io_error if there is an error.
+             * @throws osmium::out_of_order_error if an input is not sorted.
+             */
+            osmium::memory::Buffer read() {
+                if (!m_started) {
+                    start();
+                }
+
+                if (m_heap.empty()) {
+                    return osmium::memory::Buffer{};
+                }
+
+                osmium::memory::Buffer buffer{m_buffer_size, osmium::memory::Buffer::auto_grow::yes};
+
+                while (!m_heap.empty()) {
+                    const heap_element top = m_heap.top();
+                    const osmium::OSMObject& object = *top.object;
+
+                    if (buffer.committed() > 0 && buffer.committed() + object.padded_size() > buffer.capacity()) {
+                        break;
+                    }
+
+                    m_heap.pop();
+
+                    const object_key key{object};
+                    if (m_has_last && key == m_last) {
+                        ++m_duplicates;
+                    } else {
+                        buffer.add_item(object);
+                        buffer.commit();
+                        m_last = key;
+                        m_has_last = true;
+                    }
+
+                    next_object(top.input);
+                }
+
+                return buffer;
+            }
+
+            /**
+             * Close all inputs. A call to this is optional, because the
+             * destructors of the Readers will do this.
+             *
+             * @throws Some form of osmium::io_error when there is a problem.
+             */
+            void close() {
+                for (auto& in : m_inputs) {
+                    in.reader->close();
+                }
+            }
+
+        }; // class MergingReader
+
+    } // namespace io
+
+} // namespace osmium
+
+#endif // OSMIUM_IO_MERGING_READER_HPP
@@ -0,0 +1,516 @@
+#ifndef OSMIUM_IO_PBF_ID_RANGE_INDEX_HPP
+#define OSMIUM_IO_PBF_ID_RANGE_INDEX_HPP
+
+/*
+
+This file is part of Osmium (https://osmcode.org/libosmium).
+
+Copyright 2013-2026 Jochen Topf <jochen@topf.org> and others (see README).
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+*/
+
+/**
+ * @file
+ *
+ * Include this file if you want to look up single objects by id in
+ * sorted OSM PBF files.
+ *
+ * @attention If you include this file, you'll need to link with
+ *            `libz`, and enable multithreading.
+ */
+
+#include <osmium/handler/check_order.hpp>
+#include <osmium/io/detail/pbf_decoder.hpp>
+#include <osmium/io/detail/pbf_input_format.hpp>
+#include <osmium/io/detail/read_write.hpp>
+#include <osmium/io/file_format.hpp>
+#include <osmium/io/pbf.hpp>
+#include <osmium/io/read_tags_filter.hpp>
+#include <osmium/memory/buffer.hpp>
+#include <osmium/osm/entity_bits.hpp>
+#include <osmium/osm/item_type.hpp>
+#include <osmium/osm/object.hpp>
+#include <osmium/osm/object_comparisons.hpp>
+#include <osmium/osm/types.hpp>
+#include <osmium/util/file.hpp>
+
+#include <protozero/types.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace osmium {
+
+    namespace io {
+
+        namespace detail {
+
+            // Compare type and id in the same order objects are in sorted
+            // OSM files (see osmium::object_order_type_id_version).
+            inline bool id_range_less(const osmium::item_type lhs_type, const osmium::object_id_type lhs_id,
+                                      const osmium::item_type rhs_type, const osmium::object_id_type rhs_id) noexcept {
+                if (lhs_type != rhs_type) {
+                    return lhs_type < rhs_type;
+                }
+                return osmium::id_order{}(lhs_id, rhs_id);
+            }
+
+        } // namespace detail
+
+        /**
+         * One entry in a PBF id range index: Where the data of a Blob is
+         * in the file and the range of objects (by type and id) it
+         * contains. Entries are stored in index files in exactly this
+         * layout (32 bytes per entry in native byte order).
+         */
+        struct pbf_id_range {
+
+            /// Offset of the Blob (after its BlobHeader) in the file.
+            uint64_t offset = 0;
+
+            osmium::object_id_type first_id = 0;
+            osmium::object_id_type last_id = 0;
+
+            /// Size of the Blob in bytes.
+            uint32_t size = 0;
+
+            uint16_t first_type = 0;
+            uint16_t last_type = 0;
+
+            /**
+             * Is the object with the specified type and id in the range
+             * covered by this entry? This doesn't mean the object is in
+             * the blob, there can be gaps in the ids.
+             */
+            bool contains(const osmium::item_type type, const osmium::object_id_type id) const noexcept {
+                return !detail::id_range_less(type, id, static_cast<osmium::item_type>(first_type), first_id) &&
+                       !detail::id_range_less(static_cast<osmium::item_type>(last_type), last_id, type, id);
+            }
+
+        }; // struct pbf_id_range
+
+        static_assert(sizeof(pbf_id_range) == 32, "pbf_id_range must be 32 bytes");
+
+        /**
+         * Index mapping ranges of object ids (per type) to the blobs in a
+         * sorted PBF file containing them. Use build_pbf_id_range_index()
+         * to create an index for a file and an IndexedPBFReader to look
+         * up objects with it.
+         *
+         * The index is small (32 bytes per blob, about 1 MByte for a
+         * planet file), so it is kept in memory. It can be saved with
+         * dump() into a file alongside the PBF file and loaded again
+         * from there, so that the PBF file has to be scanned only once.
+         */
+        class PBFIdRangeIndex {
+
+            enum {
+                header_size = 24
+            };
+
+            static constexpr const char* magic() noexcept {
+                return "OSMPBFIX";
+            }
+
+            std::vector<pbf_id_range> m_ranges;
+            std::size_t m_file_size = 0;
+
+        public:
+
+            PBFIdRangeIndex() = default;
+
+            /**
+             * Load index from a file written with dump().
+             *
+             * @param fd File descriptor to read from. The index doesn't
+             *           take ownership, it will not close the file.
+             * @throws std::runtime_error If the file is not a valid index.
+             * @throws osmium::pbf_error If the number of entries in the
+             *         index doesn't match the size of the file.
+             * @throws std::system_error If the file can't be read.
+             */
+            explicit PBFIdRangeIndex(const int fd) {
+                std::array<char, header_size> header{};
+                if (!osmium::io::detail::read_exactly(fd, header.data(), header_size) ||
+                    std::memcmp(header.data(), magic(), 8) != 0) {
+                    throw std::runtime_error{"not a PBF id range index"};
+                }
+
+                uint64_t file_size = 0;
+                uint64_t count = 0;
+                std::memcpy(&file_size, header.data() + 8, sizeof(file_size));
+                std::memcpy(&count, header.data() + 16, sizeof(count));
+                m_file_size = static_cast<std::size_t>(file_size);
+
+                // Check the count before allocating memory for the entries,
+                // a corrupt header could ask for any amount.
+                const std::size_t size = osmium::file_size(fd);
+                const std::size_t offset = osmium::file_offset(fd);
+                const std::size_t remaining = size > offset ? size - offset : 0;
+                if (count > remaining / sizeof(pbf_id_range)) {
+                    throw osmium::pbf_error{"PBF id range index is truncated or corrupt"};
+                }
+
+                m_ranges.resize(static_cast<std::size_t>(count));
+                if (count > 0 &&
+                    !osmium::io::detail::read_exactly(fd, reinterpret_cast<char*>(m_ranges.data()), static_cast<unsigned int>(count * sizeof(pbf_id_range)))) {
+                    throw osmium::pbf_error{"PBF id range index is truncated"};
+                }
+            }
+
+            /**
+             * Add a range to the index. Ranges must be added in file order.
+             *
+             * @throws osmium::out_of_order_error If the range overlaps with
+             *         the previous range. Ranges are allowed to touch,
+             *         because different versions of the same object in
+             *         a history file can be in neighbouring blobs.
+             */
+            void add(const pbf_id_range& range) {
+                if (!m_ranges.empty()) {
+                    const auto& last = m_ranges.back();
+                    if (detail::id_range_less(static_cast<osmium::item_type>(range.first_type), range.first_id,
+                                              static_cast<osmium::item_type>(last.last_type), last.last_id)) {
+                        throw osmium::out_of_order_error{"PBF file is not sorted, can't create id range index", range.first_id};
+                    }
+                }
+                m_ranges.push_back(range);
+            }
+
+            /// The size of the PBF file this index was created for.
+            std::size_t file_size() const noexcept {
+                return m_file_size;
+            }
+
+            void set_file_size(const std::size_t size) noexcept {
+                m_file_size = size;
+            }
+
+            /// The number of ranges (blobs) in the index.
+            std::size_t size() const noexcept {
+                return m_ranges.size();
+            }
+
+            bool empty() const noexcept {
+                return m_ranges.empty();
+            }
+
+            std::vector<pbf_id_range>::const_iterator begin() const noexcept {
+                return m_ranges.cbegin();
+            }
+
+            std::vector<pbf_id_range>::const_iterator end() const noexcept {
+                return m_ranges.cend();
+            }
+
+            /**
+             * Find the range that could contain the object with the
+             * specified type and id. If several ranges could contain it
+             * (different versions in a history file), the last one is
+             * returned.
+             *
+             * @returns Pointer to the range or nullptr if there is none.
+             */
+            const pbf_id_range* find(const osmium::item_type type, const osmium::object_id_type id) const noexcept {
+                const auto it = std::upper_bound(m_ranges.cbegin(), m_ranges.cend(), id, [type](const osmium::object_id_type i, const pbf_id_range& range) {
+                    return detail::id_range_less(type, i, static_cast<osmium::item_type>(range.first_type), range.first_id);
+                });
+                if (it == m_ranges.cbegin()) {
+                    return nullptr;
+                }
+                const auto* range = &*std::prev(it);
+                return range->contains(type, id) ? range : nullptr;
+            }
+
+            /**
+             * Write the index to a file.
+             *
+             * @param fd File descriptor to write to. The index doesn't
+             *           take ownership, it will not close the file.
+             * @throws std::system_error If the file can't be written.
+             */
+            void dump(const int fd) const {
+                std::array<char, header_size> header{};
+                std::memcpy(header.data(), magic(), 8);
+                const auto file_size = static_cast<uint64_t>(m_file_size);
+                const auto count = static_cast<uint64_t>(m_ranges.size());
+                std::memcpy(header.data() + 8, &file_size, sizeof(file_size));
+                std::memcpy(header.data() + 16, &count, sizeof(count));
+                osmium::io::detail::reliable_write(fd, header.data(), header.size());
+                osmium::io::detail::reliable_write(fd, reinterpret_cast<const char*>(m_ranges.data()), m_ranges.size() * sizeof(pbf_id_range));
+            }
+
+        }; // class PBFIdRangeIndex
+
+        namespace detail {
+
+            // Read the next Blob with the expected type from the file and
+            // return its offset in the file. The offset is updated to
+            // point after the Blob. Returns false on EOF.
+            inline bool read_pbf_blob(const int fd, std::size_t& offset, const char* expected_type, std::size_t& blob_offset, std::string& blob) {
+                std::array<char, sizeof(uint32_t)> size_data{};
+                if (!osmium::io::detail::read_exactly(fd, size_data.data(), static_cast<unsigned int>(size_data.size()))) {
+                    return false;
+                }
+                const auto header_size = PBFParser::get_size_in_network_byte_order(size_data.data());
+                if (header_size > static_cast<uint32_t>(max_blob_header_size)) {
+                    throw osmium::pbf_error{"invalid BlobHeader size (> max_blob_header_size)"};
+                }
+
+                std::string header(header_size, '\0');
+                if (!osmium::io::detail::read_exactly(fd, &*header.begin(), header_size)) {
+                    throw osmium::pbf_error{"unexpected EOF"};
+                }
+                const auto size = PBFParser::decode_blob_header(protozero::data_view{header.data(), header.size()}, expected_type);
+                if (size > max_uncompressed_blob_size) {
+                    throw osmium::pbf_error{std::string{"invalid blob size: "} + std::to_string(size)};
+                }
+
+                blob_offset = offset + size_data.size() + header_size;
+                blob.resize(size);
+                if (!osmium::io::detail::read_exactly(fd, &*blob.begin(), static_cast<unsigned int>(size))) {
+                    throw osmium::pbf_error{"unexpected EOF"};
+                }
+                offset = blob_offset + size;
+
+                return true;
+            }
+
+            // Decode a data Blob into a single buffer.
+            inline osmium::memory::Buffer decode_pbf_data_blob(const std::string& blob, const osmium::io::read_meta read_metadata, const osmium::io::read_fields::type read_fields) {
+                std::string output;
+                PBFPrimitiveBlockDecoder decoder{decode_blob(blob, output), osmium::osm_entity_bits::nwr, read_metadata,
+                                                 osmium::io::read_tags_filter{}, read_fields, osmium::memory::Buffer::auto_grow::yes};
+                return decoder();
+            }
+
+        } // namespace detail
+
+        /**
+         * Create an id range index for a PBF file by reading the whole
+         * file once. Only the ids of the objects are decoded. The file
+         * must be sorted by type and id (as most PBF files are), history
+         * files are okay.
+         *
+         * @param filename Name of the PBF file.
+         * @returns The index.
+         * @throws osmium::out_of_order_error If the file is not sorted.
+         * @throws osmium::pbf_error If the file is not a valid PBF file.
+         * @throws std::system_error If the file can't be opened or read.
+         */
+        inline PBFIdRangeIndex build_pbf_id_range_index(const std::string& filename) {
+            const int fd = osmium::io::detail::open_for_reading(filename);
+
+            PBFIdRangeIndex index;
+            try {
+                std::size_t offset = 0;
+                std::size_t blob_offset = 0;
+                std::string blob;
+
+                if (!detail::read_pbf_blob(fd, offset, "OSMHeader", blob_offset, blob)) {
+                    throw osmium::pbf_error{"missing OSMHeader blob"};
+                }
+
+                while (detail::read_pbf_blob(fd, offset, "OSMData", blob_offset, blob)) {
+                    const auto buffer = detail::decode_pbf_data_blob(blob, osmium::io::read_meta::no, osmium::io::read_fields::ids);
+
+                    // Objects inside a blob don't have to be sorted, only
+                    // the blobs have to be in order.
+                    const osmium::OSMObject* first = nullptr;
+                    const osmium::OSMObject* last = nullptr;
+                    const osmium::object_order_type_id_version order;
+                    for (const auto& object : buffer.select<osmium::OSMObject>()) {
+                        if (!first || order(object, *first)) {
+                            first = &object;
+                        }
+                        if (!last || order(*last, object)) {
+                            last = &object;
+                        }
+                    }
+
+                    if (first) {
+                        pbf_id_range range;
+                        range.offset = blob_offset;
+                        range.size = static_cast<uint32_t>(blob.size());
+                        range.first_id = first->id();
+                        range.first_type = static_cast<uint16_t>(first->type());
+                        range.last_id = last->id();
+                        range.last_type = static_cast<uint16_t>(last->type());
+                        index.add(range);
+                    }
+                }
+                index.set_file_size(offset);
+            } catch (...) {
+                osmium::io::detail::reliable_close(fd);
+                throw;
+            }
+            osmium::io::detail::reliable_close(fd);
+
+            return index;
+        }
+
+        /**
+         * Look up single objects by type and id in a sorted PBF file
+         * using a PBFIdRangeIndex. Only the one blob that can contain the
+         * object is read and decoded. The last decoded blob is kept, so
+         * looking up objects near each other is fast.
+         *
+         * In contrast to the osmium::io::Reader this does not use any
+         * threads and only works on uncompressed (on the file level) PBF
+         * files which can be read with random access.
+         *
+         * Usage:
+         *
+         * @code
+         * auto index = osmium::io::build_pbf_id_range_index("planet.osm.pbf");
+         * osmium::io::IndexedPBFReader reader{"planet.osm.pbf", std::move(index)};
+         * const osmium::OSMObject* object = reader.get_object(osmium::item_type::way, 123);
+         * @endcode
+         */
+        class IndexedPBFReader {
+
+            PBFIdRangeIndex m_index;
+            osmium::memory::Buffer m_buffer{};
+            const pbf_id_range* m_current = nullptr;
+            std::size_t m_blobs_decoded = 0;
+            int m_fd;
+            osmium::io::read_meta m_read_metadata;
+
+            void load(const pbf_id_range& range) {
+                m_current = nullptr;
+                m_buffer = osmium::memory::Buffer{};
+
+                std::string blob(range.size, '\0');
+                osmium::file_seek(m_fd, static_cast<std::size_t>(range.offset));
+                if (!osmium::io::detail::read_exactly(m_fd, &*blob.begin(), range.size)) {
+                    throw osmium::pbf_error{"unexpected EOF"};
+                }
+
+                m_buffer = detail::decode_pbf_data_blob(blob, m_read_metadata, osmium::io::read_fields::all);
+                m_current = &range;
+                ++m_blobs_decoded;
+            }
+
+        public:
+
+            /**
+             * Open a PBF file for lookups.
+             *
+             * @param filename Name of the PBF file.
+             * @param index Id range index created for this file.
+             * @param read_metadata Should metadata of the objects be read?
+             * @throws std::runtime_error If the index doesn't fit the file.
+             * @throws std::system_error If the file can't be opened.
+             */
+            IndexedPBFReader(const std::string& filename, PBFIdRangeIndex index, const osmium::io::read_meta read_metadata = osmium::io::read_meta::yes) :
+                m_index(std::move(index)),
+                m_fd(osmium::io::detail::open_for_reading(filename)),
+                m_read_metadata(read_metadata) {
+                if (osmium::file_size(m_fd) != m_index.file_size()) {
+                    osmium::io::detail::reliable_close(m_fd);
+                    throw std::runtime_error{"PBF id range index doesn't match file '" + filename + "'"};
+                }
+            }
+
+            IndexedPBFReader(const IndexedPBFReader&) = delete;
+            IndexedPBFReader& operator=(const IndexedPBFReader&) = delete;
+
+            IndexedPBFReader(IndexedPBFReader&&) = delete;
+            IndexedPBFReader& operator=(IndexedPBFReader&&) = delete;
+
+            ~IndexedPBFReader() noexcept {
+                try {
+                    close();
+                } catch (...) { // NOLINT(bugprone-empty-catch)
+                    // Ignore any exceptions because destructor must not throw.
+                }
+            }
+
+            /**
+             * Close the file. No more lookups are possible after this.
+             */
+            void close() {
+                if (m_fd >= 0) {
+                    const int fd = m_fd;
+                    m_fd = -1;
+                    osmium::io::detail::reliable_close(fd);
+                }
+            }
+
+            const PBFIdRangeIndex& index() const noexcept {
+                return m_index;
+            }
+
+            /// The number of blobs decoded so far.
+            std::size_t blobs_decoded() const noexcept {
+                return m_blobs_decoded;
+            }
+
+            /**
+             * Get the object with the specified type and id. If there are
+             * several versions of the object (in a history file), the
+             * last one is returned.
+             *
+             * @returns Pointer to the object or nullptr if it is not in
+             *          the file. The pointer is only valid until the
+             *          next call to get_object() or close().
+             * @throws osmium::pbf_error If the data can't be decoded.
+             * @throws std::system_error If the file can't be read.
+             */
+            const osmium::OSMObject* get_object(const osmium::item_type type, const osmium::object_id_type id) {
+                const auto* range = m_index.find(type, id);
+                if (!range) {
+                    return nullptr;
+                }
+
+                if (range != m_current) {
+                    load(*range);
+                }
+
+                const osmium::OSMObject* result = nullptr;
+                for (const auto& object : m_buffer.select<osmium::OSMObject>()) {
+                    if (object.type() == type && object.id() == id) {
+                        result = &object;
+                    }
+                }
+                return result;
+            }
+
+        }; // class IndexedPBFReader
+
+    } // namespace io
+
+} // namespace osmium
+
+#endif // OSMIUM_IO_PBF_ID_RANGE_INDEX_HPP
@@ -0,0 +1,120 @@
+#ifndef OSMIUM_IO_READ_TAGS_FILTER_HPP
+#define OSMIUM_IO_READ_TAGS_FILTER_HPP
+
+/*
+
+This file is part of Osmium (https://osmcode.org/libosmium).
+
+Copyright 2013-2026 Jochen Topf <jochen@topf.org> and others (see README).
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+*/
+#include <osmium/osm/entity_bits.hpp>
+#include <osmium/osm/item_type.hpp>
+#include <osmium/osm/object.hpp>
+#include <osmium/tags/taglist.hpp>
+#include <osmium/tags/tags_filter.hpp>
+
+#include <memory>
+
+namespace osmium {
+
+    namespace io {
+
+        /**
+         * Option for the Reader: Only read objects of the specified types
+         * if at least one of their tags matches the filter. Objects of
+         * other types are read as usual.
+         *
+         * The PBF parser checks the tags before building the objects and
+         * evaluates the filter only once for each string in the string
+         * table of a block. For other formats the objects not matching
+         * are removed from the buffers after parsing.
+         *
+         * Usually you want to set this only for the types you are
+         * interested in. For instance to read all highways with their
+         * nodes use osmium::osm_entity_bits::way, if the filter is also
+         * applied to nodes, the untagged nodes of the ways are not read.
+         *
+         * @code
+         * osmium::TagsFilter filter{false};
+         * filter.add_rule(true, "highway");
+         * osmium::io::Reader reader{"input.osm.pbf", osmium::io::read_tags_filter{filter, osmium::osm_entity_bits::way}};
+         * @endcode
+         */
+        class read_tags_filter {
+
+            std::shared_ptr<const osmium::TagsFilter> m_filter;
+            osmium::osm_entity_bits::type m_entities = osmium::osm_entity_bits::nothing;
+
+        public:
+
+            /// Default constructed option doesn't filter anything.
+            read_tags_filter() = default;
+
+            /**
+             * Constructor.
+             *
+             * @param filter The filter. It is copied.
+             * @param entities The types of objects the filter is used for.
+             */
+            read_tags_filter(const osmium::TagsFilter& filter, const osmium::osm_entity_bits::type entities) :
+                m_filter(std::make_shared<const osmium::TagsFilter>(filter)),
+                m_entities(entities) {
+            }
+
+            /// The filter or nullptr if there is none.
+            const osmium::TagsFilter* filter() const noexcept {
+                return m_filter.get();
+            }
+
+            /// The types of objects the filter is used for.
+            osmium::osm_entity_bits::type entities() const noexcept {
+                return m_filter ? m_entities : osmium::osm_entity_bits::nothing;
+            }
+
+            /// Is the filter used for objects of this type?
+            bool applies_to(const osmium::item_type type) const noexcept {
+                return (entities() & osmium::osm_entity_bits::from_item_type(type)) != 0;
+            }
+
+            /**
+             * Should this object be kept? This is the case if the filter
+             * is not used for objects of this type or if any of the tags
+             * of the object match.
+             */
+            bool operator()(const osmium::OSMObject& object) const noexcept {
+                return !applies_to(object.type()) ||
+                       osmium::tags::match_any_of(object.tags(), *m_filter);
+            }
+
+        }; // class read_tags_filter
+
+    } // namespace io
+
+} // namespace osmium
+
+#endif // OSMIUM_IO_READ_TAGS_FILTER_HPP
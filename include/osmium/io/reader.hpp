@@ -36,16 +36,19 @@ DEALINGS IN THE SOFTWARE.
 #include <osmium/io/compression.hpp>
 #include <osmium/io/detail/input_format.hpp>
 #include <osmium/io/detail/queue_util.hpp>
+#include <osmium/io/detail/read_ahead.hpp>
 #include <osmium/io/detail/read_thread.hpp>
 #include <osmium/io/detail/read_write.hpp>
 #include <osmium/io/error.hpp>
 #include <osmium/io/file.hpp>
 #include <osmium/io/header.hpp>
+#include <osmium/io/read_tags_filter.hpp>
 #include <osmium/memory/buffer.hpp>
 #include <osmium/osm/entity_bits.hpp>
 #include <osmium/thread/pool.hpp>
 #include <osmium/thread/util.hpp>
 #include <osmium/util/config.hpp>
+#include <osmium/util/metrics.hpp>
 
 #include <cerrno>
 #include <cstdlib>
@@ -96,6 +99,10 @@ namespace osmium {
 
             osmium::io::File m_file;
 
+            // Must be declared before the queues and the read thread which
+            // are initialized with it.
+            osmium::metrics::Registry* m_metrics;
+
             osmium::thread::Pool* m_pool = nullptr;
 
             std::atomic<std::size_t> m_offset{0};
@@ -132,6 +139,10 @@ namespace osmium {
             osmium::osm_entity_bits::type m_read_which_entities = osmium::osm_entity_bits::all;
             osmium::io::read_meta m_read_metadata = osmium::io::read_meta::yes;
             osmium::io::buffers_type m_buffers_kind = osmium::io::buffers_type::any;
+            osmium::io::read_tags_filter m_tags_filter;
+            osmium::io::read_fields::type m_read_fields = osmium::io::read_fields::all;
+
+            osmium::io::keep_source_blocks m_keep_source_blocks = osmium::io::keep_source_blocks::no;
 
             void set_option(osmium::thread::Pool& pool) noexcept {
                 m_pool = &pool;
@@ -154,6 +165,43 @@ namespace osmium {
                 m_buffers_kind = value;
             }
 
+            void set_option(const osmium::io::read_tags_filter& value) {
+                m_tags_filter = value;
+            }
+
+            void set_option(osmium::io::read_fields::type value) noexcept {
+                m_read_fields = value;
+            }
+
+            void set_option(osmium::io::keep_source_blocks value) noexcept {
+                m_keep_source_blocks = value;
+            }
+
+            // The metrics registry is already set in the constructor before
+            // the other options.
+            void set_option(osmium::metrics::Registry& /*metrics*/) noexcept {
+            }
+
+            // The PBF parser filters the objects itself, for other formats
+            // they are removed here.
+            void remove_filtered_objects(osmium::memory::Buffer& buffer) const {
+                if (!m_tags_filter.filter() || m_file.format() == osmium::io::file_format::pbf) {
+                    return;
+                }
+
+                bool removed = false;
+                for (auto& object : buffer.select<osmium::OSMObject>()) {
+                    if (!m_tags_filter(object)) {
+                        object.set_removed(true);
+                        removed = true;
+                    }
+                }
+
+                if (removed) {
+                    buffer.purge_removed();
+                }
+            }
+
             // This function will run in a separate thread.
             static void parser_thread(osmium::thread::Pool& pool,
                                       int fd,
@@ -165,7 +213,11 @@ namespace osmium {
                                       osmium::osm_entity_bits::type read_which_entities,
                                       osmium::io::read_meta read_metadata,
                                       osmium::io::buffers_type buffers_kind,
-                                      bool want_buffered_pages_removed) {
+                                      bool want_buffered_pages_removed,
+                                      const osmium::io::read_tags_filter tags_filter,
+                                      osmium::io::read_fields::type read_fields,
+                                      osmium::metrics::Registry* metrics,
+                                      osmium::io::keep_source_blocks keep_source_blocks) {
                 std::promise<osmium::io::Header> promise{std::move(header_promise)};
                 osmium::io::detail::parser_arguments args = {
                     pool,
@@ -177,7 +229,11 @@ namespace osmium {
                     read_which_entities,
                     read_metadata,
                     buffers_kind,
-                    want_buffered_pages_removed};
+                    want_buffered_pages_removed,
+                    tags_filter,
+                    read_fields,
+                    metrics,
+                    keep_source_blocks};
                 creator(args)->parse();
             }
 
@@ -263,7 +319,10 @@ namespace osmium {
 
                 if (file.buffer()) {
                     decompressor = factory.create_decompressor(file.compression(), file.buffer(), file.buffer_size());
-                } else if (file.format() == file_format::pbf) {
+                } else if (file.format() == file_format::pbf && !detail::want_read_ahead(fd)) {
+                    // The PBF parser reads directly from the file, unless
+                    // the file should be read with several reads in
+                    // flight. Then the data comes through the read thread.
                     decompressor = std::unique_ptr<Decompressor>{new DummyDecompressor{}};
                 } else {
                     decompressor = factory.create_decompressor(file.compression(), fd);
@@ -305,6 +364,22 @@ namespace osmium {
              *      use in "single" mode if the input file is not sorted by
              *      type, otherwise this will be rather inefficient.
              *
+             * * osmium::io::read_fields::type: Which parts of the objects
+             *      (locations, refs, tags, user names) should be read. The
+             *      default is osmium::io::read_fields::all. Not all file
+             *      formats use this setting.
+             *
+             * * osmium::io::read_tags_filter: Only read objects of some
+             *      types if any of their tags matches a TagsFilter. See
+             *      the read_tags_filter class for details.
+             *
+             * * osmium::io::keep_source_blocks: Attach the encoded data to
+             *      the buffers (osmium::io::keep_source_blocks::yes), so
+             *      that buffers marked as unchanged can be written out
+             *      without encoding them again. Only the PBF reader does
+             *      this and only if complete objects are read (no entity,
+             *      meta data, field, or tags filters).
+             *
              * * osmium::thread::Pool&: Reference to a thread pool that should
              *      be used for reading instead of the default pool. Usually
              *      it is okay to use the statically initialized shared
@@ -312,23 +387,38 @@ namespace osmium {
              *      For instance when your program will fork, using the
              *      statically initialized pool will not work.
              *
+             * * osmium::metrics::Registry&: Collect metrics about the
+             *      reading into this registry: The "reader.*" metrics from
+             *      the read thread and the parser and the "queue.*" metrics
+             *      from the "raw_input" and "parser_results" queues. The
+             *      registry must outlive the Reader. To get metrics for
+             *      the thread pool, create your own pool with the same
+             *      registry.
+             *
              * @throws osmium::io_error If there was an error.
              * @throws std::system_error If the file could not be opened.
              */
             template <typename... TArgs>
             explicit Reader(const osmium::io::File& file, TArgs&&... args) :
                 m_file(file.check()),
+                m_metrics(osmium::metrics::detail::find_registry(args...)),
                 m_creator(detail::ParserFactory::instance().get_creator_function(m_file)),
-                m_input_queue(detail::get_input_queue_size(), "raw_input"),
+                m_input_queue(detail::get_input_queue_size(), "raw_input", m_metrics),
                 m_fd(m_file.buffer() ? -1 : open_input_file_or_url(m_file.filename(), &m_childpid)),
                 m_file_size(m_fd > 2 ? osmium::file_size(m_fd) : 0),
                 m_decompressor(make_decompressor(m_file, m_fd, &m_offset)),
-                m_read_thread_manager(*m_decompressor, m_input_queue),
-                m_osmdata_queue(detail::get_osmdata_queue_size(), "parser_results"),
+                m_read_thread_manager(*m_decompressor, m_input_queue, m_metrics),
+                m_osmdata_queue(detail::get_osmdata_queue_size(), "parser_results", m_metrics),
                 m_osmdata_queue_wrapper(m_osmdata_queue) {
 
                 (void)std::initializer_list<int>{(set_option(std::forward<TArgs>(args)), 0)...};
 
+                // Only the PBF parser can use the tags filter without the
+                // tags being read.
+                if (m_tags_filter.filter() && m_file.format() != osmium::io::file_format::pbf) {
+                    m_read_fields |= osmium::io::read_fields::tags;
+                }
+
                 if (!m_pool) {
                     m_pool = &thread::Pool::default_instance();
                 }
@@ -346,7 +436,9 @@ namespace osmium {
                                                           std::ref(m_input_queue), std::ref(m_osmdata_queue),
                                                           std::move(header_promise), &m_offset, m_read_which_entities,
                                                           m_read_metadata, m_buffers_kind,
-                                                          m_decompressor->want_buffered_pages_removed()};
+                                                          m_decompressor->want_buffered_pages_removed(),
+                                                          m_tags_filter, m_read_fields, m_metrics,
+                                                          m_keep_source_blocks};
             }
 
             template <typename... TArgs>
@@ -445,14 +537,19 @@ namespace osmium {
                 osmium::memory::Buffer buffer;
 
                 // If there are buffers on the stack, return those first.
-                if (m_back_buffers) {
+                // Skip buffers that are empty after filtering, like the
+                // loop below does.
+                while (m_back_buffers) {
                     if (m_back_buffers.has_nested_buffers()) {
                         buffer = std::move(*m_back_buffers.get_last_nested());
                     } else {
                         buffer = std::move(m_back_buffers);
                         m_back_buffers = osmium::memory::Buffer{};
                     }
-                    return buffer;
+                    remove_filtered_objects(buffer);
+                    if (buffer.committed() > 0) {
+                        return buffer;
+                    }
                 }
 
                 if (m_status != status::okay) {
@@ -480,6 +577,7 @@ namespace osmium {
                             m_back_buffers = std::move(buffer);
                             buffer = std::move(*m_back_buffers.get_last_nested());
                         }
+                        remove_filtered_objects(buffer);
                         if (buffer.committed() > 0) {
                             return buffer;
                         }
@@ -46,6 +46,7 @@ DEALINGS IN THE SOFTWARE.
 #include <osmium/thread/pool.hpp>
 #include <osmium/thread/util.hpp>
 #include <osmium/util/config.hpp>
+#include <osmium/util/metrics.hpp>
 #include <osmium/version.hpp>
 
 #include <cassert>
@@ -105,7 +106,7 @@ namespace osmium {
 
             osmium::io::File m_file;
 
-            detail::future_string_queue_type m_output_queue{detail::get_output_queue_size(), "raw_output"};
+            detail::future_string_queue_type m_output_queue;
 
             std::unique_ptr<osmium::io::detail::OutputFormat> m_output{nullptr};
 
@@ -133,15 +134,29 @@ namespace osmium {
             // Has the header already bin written to the file?
             bool m_header_written = false;
 
+            // Metrics (if enabled).
+            std::shared_ptr<osmium::metrics::Counter> m_buffers;
+            std::shared_ptr<osmium::metrics::Histogram> m_buffer_bytes;
+
+            void write_to_output(osmium::memory::Buffer&& buffer) {
+                if (m_buffers) {
+                    m_buffers->add();
+                    m_buffer_bytes->record(buffer.committed());
+                }
+                m_output->write_buffer(std::move(buffer));
+            }
+
             // This function will run in a separate thread.
             static void write_thread(detail::future_string_queue_type& output_queue,
                                      std::unique_ptr<osmium::io::Compressor>&& compressor,
                                      std::promise<std::size_t>&& write_promise,
-                                     std::atomic_bool* notification) {
+                                     std::atomic_bool* notification,
+                                     osmium::metrics::Registry* metrics) {
                 detail::WriteThread write_thread{output_queue,
                                                  std::move(compressor),
                                                  std::move(write_promise),
-                                                 notification};
+                                                 notification,
+                                                 metrics};
                 write_thread();
             }
 
@@ -160,7 +175,7 @@ namespace osmium {
                     write_header();
                 }
                 if (buffer && buffer.committed() > 0) {
-                    m_output->write_buffer(std::move(buffer));
+                    write_to_output(std::move(buffer));
                 }
             }
 
@@ -177,7 +192,7 @@ namespace osmium {
                     using std::swap;
                     swap(m_buffer, buffer);
 
-                    m_output->write_buffer(std::move(buffer));
+                    write_to_output(std::move(buffer));
                 }
             }
 
@@ -201,9 +216,15 @@ namespace osmium {
                 osmium::io::Header header;
                 overwrite allow_overwrite = overwrite::no;
                 fsync sync = fsync::no;
+                std::size_t fsync_interval = 0;
                 osmium::thread::Pool* pool = nullptr;
             };
 
+            // The metrics registry is already set in the constructor before
+            // the other options.
+            static void set_option(options_type& /*options*/, osmium::metrics::Registry& /*metrics*/) noexcept {
+            }
+
             static void set_option(options_type& options, osmium::thread::Pool& pool) {
                 options.pool = &pool;
             }
@@ -220,6 +241,10 @@ namespace osmium {
                 options.sync = value;
             }
 
+            static void set_option(options_type& options, fsync_interval value) {
+                options.fsync_interval = value.bytes();
+            }
+
             void do_close() {
                 if (m_status == status::okay) {
                     ensure_cleanup([&]() {
@@ -253,6 +278,11 @@ namespace osmium {
              *       before closing it? Can be osmium::io::fsync::yes or
              *       osmium::io::fsync::no (default).
              *
+             * * osmium::io::fsync_interval: Call fsync every time at least
+             *       this many bytes have been written (before compression).
+             *       Only for uncompressed and gzip'ed files. Default is
+             *       not to sync while writing.
+             *
              * * osmium::thread::Pool&: Reference to a thread pool that should
              *      be used for writing instead of the default pool. Usually
              *      it is okay to use the statically initialized shared
@@ -260,14 +290,28 @@ namespace osmium {
              *      For instance when your program will fork, using the
              *      statically initialized pool will not work.
              *
+             * * osmium::metrics::Registry&: Collect metrics about the
+             *      writing into this registry: The number and size of
+             *      buffers written ("writer.buffers", "writer.buffer_bytes"),
+             *      the "writer.*" metrics from the write thread, and the
+             *      "queue.*" metrics from the "raw_output" queue. The
+             *      registry must outlive the Writer.
+             *
              * @throws osmium::io_error If there was an error.
              * @throws std::system_error If the file could not be opened.
              */
             template <typename... TArgs>
             explicit Writer(const osmium::io::File& file, TArgs&&... args) :
-                m_file(file.check()) {
+                m_file(file.check()),
+                m_output_queue(detail::get_output_queue_size(), "raw_output", osmium::metrics::detail::find_registry(args...)) {
                 assert(!m_file.buffer()); // XXX can't handle pseudo-files
 
+                osmium::metrics::Registry* metrics = osmium::metrics::detail::find_registry(args...);
+                if (metrics) {
+                    m_buffers = metrics->shared_counter("writer.buffers");
+                    m_buffer_bytes = metrics->shared_histogram("writer.buffer_bytes");
+                }
+
                 options_type options;
                 (void)std::initializer_list<int>{(set_option(options, std::forward<TArgs>(args)), 0)...};
 
@@ -283,10 +327,11 @@ namespace osmium {
                     CompressionFactory::instance().create_compressor(file.compression(),
                                                                      osmium::io::detail::open_for_writing(m_file.filename(), options.allow_overwrite),
                                                                      options.sync);
+                compressor->set_fsync_interval(options.fsync_interval);
 
                 std::promise<std::size_t> write_promise;
                 m_write_future = write_promise.get_future();
-                m_thread = osmium::thread::thread_handler{write_thread, std::ref(m_output_queue), std::move(compressor), std::move(write_promise), &m_notification};
+                m_thread = osmium::thread::thread_handler{write_thread, std::ref(m_output_queue), std::move(compressor), std::move(write_promise), &m_notification, metrics};
             }
 
             template <typename... TArgs>
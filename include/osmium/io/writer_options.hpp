@@ -33,6 +33,8 @@ DEALINGS IN THE SOFTWARE.
 
 */
 
+#include <cstddef>
+
 namespace osmium {
 
     namespace io {
@@ -53,6 +55,32 @@ namespace osmium {
             yes = true
         };
 
+        /**
+         * Should the writer call fsync periodically while writing? If the
+         * number of bytes is not 0, fsync is called every time at least
+         * this many bytes have been written since the last fsync. This
+         * keeps the amount of data the operating system has to flush to
+         * disk in one go small, which can prevent long stalls when
+         * writing several large files at the same time. Use together
+         * with osmium::io::fsync::yes to also sync when the file is
+         * closed. Only supported for uncompressed and gzip'ed output.
+         */
+        class fsync_interval {
+
+            std::size_t m_bytes;
+
+        public:
+
+            constexpr explicit fsync_interval(const std::size_t bytes) noexcept :
+                m_bytes(bytes) {
+            }
+
+            constexpr std::size_t bytes() const noexcept {
+                return m_bytes;
+            }
+
+        }; // class fsync_interval
+
     } // namespace io
 
 } // namespace osmium
@@ -36,7 +36,10 @@ DEALINGS IN THE SOFTWARE.
 #include <osmium/memory/item.hpp>
 #include <osmium/memory/item_iterator.hpp>
 #include <osmium/osm/entity.hpp>
+#include <osmium/osm/item_type.hpp>
+#include <osmium/osm/types.hpp>
 #include <osmium/util/compatibility.hpp>
+#include <osmium/util/options.hpp>
 
 #include <algorithm>
 #include <cassert>
@@ -46,6 +49,7 @@ DEALINGS IN THE SOFTWARE.
 #include <iterator>
 #include <memory>
 #include <stdexcept>
+#include <string>
 #include <utility>
 
 namespace osmium {
@@ -68,6 +72,37 @@ namespace osmium {
      */
     namespace memory {
 
+        /**
+         * The encoded form of the data in a buffer as it was read from a
+         * file. Readers can attach this to the buffers they return (see
+         * Buffer::set_source_block()), so that writers can copy the
+         * original data instead of encoding the objects again if the
+         * buffer was not changed.
+         */
+        struct source_block {
+
+            /// The file format of the data, for instance "pbf".
+            std::string format;
+
+            /// The encoded data. For PBF this is the Blob message.
+            std::string data;
+
+            /// Type and id of the first and last object in the block.
+            osmium::item_type first_type = osmium::item_type::undefined;
+            osmium::object_id_type first_id = 0;
+            osmium::item_type last_type = osmium::item_type::undefined;
+            osmium::object_id_type last_id = 0;
+
+            /**
+             * The format-specific options the data was encoded with,
+             * named like the output options of that format. Writers
+             * must only copy the data if these match their own
+             * settings.
+             */
+            osmium::Options encoding;
+
+        }; // struct source_block
+
         /**
          * A memory area for storing OSM objects and other items. Each item stored
          * has a type and a length. See the Item class for details.
@@ -113,6 +148,9 @@ namespace osmium {
             uint8_t m_builder_count = 0;
 #endif
             auto_grow m_auto_grow{auto_grow::no};
+            std::shared_ptr<const source_block> m_source_block;
+            std::size_t m_unchanged_size = 0;
+            bool m_unchanged = false;
 
             static std::size_t calculate_capacity(std::size_t capacity) noexcept {
                 enum {
@@ -268,7 +306,10 @@ namespace osmium {
 #ifndef NDEBUG
                 m_builder_count(other.m_builder_count),
 #endif
-                m_auto_grow(other.m_auto_grow) {
+                m_auto_grow(other.m_auto_grow),
+                m_source_block(std::move(other.m_source_block)),
+                m_unchanged_size(other.m_unchanged_size),
+                m_unchanged(other.m_unchanged) {
                 other.m_data = nullptr;
                 other.m_capacity = 0;
                 other.m_written = 0;
@@ -289,6 +330,9 @@ namespace osmium {
                 m_builder_count = other.m_builder_count;
 #endif
                 m_auto_grow = other.m_auto_grow;
+                m_source_block = std::move(other.m_source_block);
+                m_unchanged_size = other.m_unchanged_size;
+                m_unchanged = other.m_unchanged;
                 other.m_data = nullptr;
                 other.m_capacity = 0;
                 other.m_written = 0;
@@ -466,6 +510,8 @@ namespace osmium {
                 const std::size_t num_used_bytes = m_committed;
                 m_written = 0;
                 m_committed = 0;
+                m_source_block.reset();
+                m_unchanged = false;
                 return num_used_bytes;
             }
 
@@ -785,6 +831,49 @@ namespace osmium {
                 swap(m_written, other.m_written);
                 swap(m_committed, other.m_committed);
                 swap(m_auto_grow, other.m_auto_grow);
+                swap(m_source_block, other.m_source_block);
+                swap(m_unchanged_size, other.m_unchanged_size);
+                swap(m_unchanged, other.m_unchanged);
+            }
+
+            /**
+             * Attach the encoded data this buffer was decoded from. This is
+             * used by readers, see the osmium::io::keep_source_blocks
+             * option. The buffer is not marked as unchanged by this.
+             */
+            void set_source_block(std::shared_ptr<const source_block> block) noexcept {
+                m_source_block = std::move(block);
+                m_unchanged = false;
+            }
+
+            /**
+             * Get the encoded data this buffer was decoded from. Returns
+             * an empty pointer if there is none.
+             */
+            const std::shared_ptr<const source_block>& get_source_block() const noexcept {
+                return m_source_block;
+            }
+
+            /**
+             * Mark this buffer as unchanged, so that a writer can copy the
+             * source block instead of encoding the objects in the buffer.
+             * Only call this if none of the objects in the buffer have been
+             * changed since it was read. Adding or removing objects from
+             * the buffer after this call will remove the mark again, but
+             * changes to objects in place (for instance setting way node
+             * locations) are not detected.
+             */
+            void mark_unchanged() noexcept {
+                m_unchanged = true;
+                m_unchanged_size = m_committed;
+            }
+
+            /**
+             * Has this buffer a source block and was it marked as unchanged
+             * (and has not changed in size since)?
+             */
+            bool is_unchanged() const noexcept {
+                return m_source_block && m_unchanged && m_unchanged_size == m_committed && m_written == m_committed;
             }
 
             /**
@@ -49,6 +49,7 @@ DEALINGS IN THE SOFTWARE.
 #include <osmium/util/endian.hpp>
 
 #include <cstdint>
+#include <cstring>
 
 namespace osmium {
 
@@ -94,7 +95,11 @@ namespace osmium {
      *
      * Typically you will either use the boost::crc_32_type from the Boost
      * CRC library or the osmium::CRC_zlib class which uses the zlib library
-     * for this, but other checksums are possible.
+     * for this, but other checksums are possible. The osmium::CRC_crc32c
+     * class calculates a CRC32C checksum without external dependencies.
+     *
+     * Data is handed to the policy class in as large pieces as possible,
+     * strings and node lists are added with a single process_bytes() call.
      *
      * @tparam TCRC A CRC type.
      */
@@ -149,9 +154,7 @@ namespace osmium {
         }
 
         void update_string(const char* str) noexcept {
-            while (*str) {
-                m_crc.process_byte(*str++);
-            }
+            m_crc.process_bytes(str, std::strlen(str));
         }
 
         void update(const Timestamp& timestamp) noexcept {
@@ -174,6 +177,16 @@ namespace osmium {
         }
 
         void update(const NodeRefList& node_refs) noexcept {
+#if __BYTE_ORDER == __LITTLE_ENDIAN
+            // On little endian machines the in-memory layout of the
+            // NodeRefs (id, x, y without padding) is exactly what the
+            // per-NodeRef update() would add, so the whole list can be
+            // added in one go.
+            if (sizeof(NodeRef) == sizeof(uint64_t) + 2 * sizeof(uint32_t) && !node_refs.empty()) {
+                m_crc.process_bytes(&*node_refs.cbegin(), node_refs.size() * sizeof(NodeRef));
+                return;
+            }
+#endif
             for (const NodeRef& node_ref : node_refs) {
                 update(node_ref);
             }
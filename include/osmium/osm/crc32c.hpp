@@ -0,0 +1,226 @@
+#ifndef OSMIUM_OSM_CRC32C_HPP
+#define OSMIUM_OSM_CRC32C_HPP
+
+/*
+
+This file is part of Osmium (https://osmcode.org/libosmium).
+
+Copyright 2013-2026 Jochen Topf <jochen@topf.org> and others (see README).
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include <osmium/util/endian.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE4_2__) || ((defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__))
+# define OSMIUM_CRC32C_HARDWARE
+# include <nmmintrin.h>
+#endif
+
+namespace osmium {
+
+    namespace detail {
+
+        /**
+         * Lookup tables for the slicing-by-8 implementation of CRC32C
+         * (Castagnoli polynomial, reflected).
+         */
+        struct crc32c_tables {
+
+            uint32_t table[8][256];
+
+            crc32c_tables() noexcept {
+                for (uint32_t i = 0; i < 256; ++i) {
+                    uint32_t crc = i;
+                    for (int j = 0; j < 8; ++j) {
+                        crc = (crc >> 1U) ^ ((crc & 1U) ? 0x82f63b78U : 0U);
+                    }
+                    table[0][i] = crc;
+                }
+                for (uint32_t i = 0; i < 256; ++i) {
+                    for (int t = 1; t < 8; ++t) {
+                        table[t][i] = (table[t - 1][i] >> 8U) ^ table[0][table[t - 1][i] & 0xffU];
+                    }
+                }
+            }
+
+            static const crc32c_tables& get() noexcept {
+                static const crc32c_tables tables;
+                return tables;
+            }
+
+        }; // struct crc32c_tables
+
+        /**
+         * Update the CRC32C checksum crc with size bytes from data using
+         * the table based slicing-by-8 algorithm. Works on all platforms.
+         */
+        inline uint32_t crc32c_slicing_by_8(uint32_t crc, const void* data, std::size_t size) noexcept {
+            const auto& t = crc32c_tables::get().table;
+            const auto* ptr = static_cast<const unsigned char*>(data);
+            crc = ~crc;
+
+#if __BYTE_ORDER == __LITTLE_ENDIAN
+            for (; size >= 8; size -= 8, ptr += 8) {
+                uint32_t low = 0;
+                uint32_t high = 0;
+                std::memcpy(&low, ptr, sizeof(low));
+                std::memcpy(&high, ptr + 4, sizeof(high));
+                low ^= crc;
+                crc = t[7][low & 0xffU] ^
+                      t[6][(low >> 8U) & 0xffU] ^
+                      t[5][(low >> 16U) & 0xffU] ^
+                      t[4][low >> 24U] ^
+                      t[3][high & 0xffU] ^
+                      t[2][(high >> 8U) & 0xffU] ^
+                      t[1][(high >> 16U) & 0xffU] ^
+                      t[0][high >> 24U];
+            }
+#endif
+
+            for (; size > 0; --size, ++ptr) {
+                crc = (crc >> 8U) ^ t[0][(crc ^ *ptr) & 0xffU];
+            }
+
+            return ~crc;
+        }
+
+#ifdef OSMIUM_CRC32C_HARDWARE
+        /**
+         * Update the CRC32C checksum crc with size bytes from data using
+         * the SSE4.2 crc32 instruction. Only call this if
+         * crc32c_hardware_available() returns true.
+         */
+# ifndef __SSE4_2__
+        __attribute__((target("sse4.2")))
+# endif
+        inline uint32_t crc32c_hardware(uint32_t crc, const void* data, std::size_t size) noexcept {
+            const auto* ptr = static_cast<const unsigned char*>(data);
+            crc = ~crc;
+
+# ifdef __x86_64__
+            uint64_t crc64 = crc;
+            for (; size >= 8; size -= 8, ptr += 8) {
+                uint64_t value = 0;
+                std::memcpy(&value, ptr, sizeof(value));
+                crc64 = _mm_crc32_u64(crc64, value);
+            }
+            crc = static_cast<uint32_t>(crc64);
+# endif
+
+            for (; size >= 4; size -= 4, ptr += 4) {
+                uint32_t value = 0;
+                std::memcpy(&value, ptr, sizeof(value));
+                crc = _mm_crc32_u32(crc, value);
+            }
+
+            for (; size > 0; --size, ++ptr) {
+                crc = _mm_crc32_u8(crc, *ptr);
+            }
+
+            return ~crc;
+        }
+
+        /**
+         * Does the CPU we are running on support the SSE4.2 crc32
+         * instruction? If the code was compiled with SSE4.2 enabled this
+         * is always true, otherwise the CPU is asked once.
+         */
+        inline bool crc32c_hardware_available() noexcept {
+# ifdef __SSE4_2__
+            return true;
+# else
+            static const bool available = __builtin_cpu_supports("sse4.2");
+            return available;
+# endif
+        }
+#else
+        inline bool crc32c_hardware_available() noexcept {
+            return false;
+        }
+#endif
+
+        /**
+         * Update the CRC32C checksum crc with size bytes from data using
+         * the fastest implementation available on this CPU.
+         */
+        inline uint32_t crc32c(uint32_t crc, const void* data, std::size_t size) noexcept {
+#ifdef OSMIUM_CRC32C_HARDWARE
+            if (crc32c_hardware_available()) {
+                return crc32c_hardware(crc, data, size);
+            }
+#endif
+            return crc32c_slicing_by_8(crc, data, size);
+        }
+
+    } // namespace detail
+
+    /**
+     * This class is used together with the CRC class to implement a CRC32C
+     * checksum (using the Castagnoli polynomial as in iSCSI, ext4, etc.).
+     * Note that this is a different checksum than the CRC32 calculated by
+     * CRC_zlib, the results can not be compared.
+     *
+     * On x86_64 CPUs with SSE4.2 the crc32 instruction is used, on other
+     * systems a table based slicing-by-8 algorithm. Both give the same
+     * result. No external library is needed.
+     *
+     * Usage:
+     *
+     * @code
+     * osmium::CRC<osmium::CRC_crc32c> crc32c;
+     * const osmium::Node& node = ...;
+     * crc32c.update(node);
+     * std::cout << crc32c().checksum() << '\n';
+     * @endcode
+     */
+    class CRC_crc32c {
+
+        uint32_t m_crc32c = 0;
+
+    public:
+
+        void process_byte(const unsigned char byte) noexcept {
+            m_crc32c = detail::crc32c(m_crc32c, &byte, 1U);
+        }
+
+        void process_bytes(const void* buffer, std::size_t byte_count) noexcept {
+            m_crc32c = detail::crc32c(m_crc32c, buffer, byte_count);
+        }
+
+        uint32_t checksum() const noexcept {
+            return m_crc32c;
+        }
+
+    }; // class CRC_crc32c
+
+} // namespace osmium
+
+#endif // OSMIUM_OSM_CRC32C_HPP
@@ -0,0 +1,120 @@
+#ifndef OSMIUM_OSM_CRC64_HPP
+#define OSMIUM_OSM_CRC64_HPP
+
+/*
+
+This file is part of Osmium (https://osmcode.org/libosmium).
+
+Copyright 2013-2026 Jochen Topf <jochen@topf.org> and others (see README).
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include <cstddef>
+#include <cstdint>
+
+namespace osmium {
+
+    namespace detail {
+
+        /**
+         * Lookup table for CRC-64 (ECMA-182 polynomial, reflected, as used
+         * by xz).
+         */
+        struct crc64_table {
+
+            uint64_t table[256];
+
+            crc64_table() noexcept {
+                for (uint64_t i = 0; i < 256; ++i) {
+                    uint64_t crc = i;
+                    for (int j = 0; j < 8; ++j) {
+                        crc = (crc >> 1U) ^ ((crc & 1U) ? 0xc96c5795d7870f42ULL : 0ULL);
+                    }
+                    table[i] = crc;
+                }
+            }
+
+            static const crc64_table& get() noexcept {
+                static const crc64_table table;
+                return table;
+            }
+
+        }; // struct crc64_table
+
+        /**
+         * Update the CRC-64 checksum crc with size bytes from data.
+         */
+        inline uint64_t crc64(uint64_t crc, const void* data, std::size_t size) noexcept {
+            const auto& t = crc64_table::get().table;
+            const auto* ptr = static_cast<const unsigned char*>(data);
+            crc = ~crc;
+            for (; size > 0; --size, ++ptr) {
+                crc = (crc >> 8U) ^ t[(crc ^ *ptr) & 0xffU];
+            }
+            return ~crc;
+        }
+
+    } // namespace detail
+
+    /**
+     * This class is used together with the CRC class to implement a 64 bit
+     * CRC checksum (CRC-64/XZ). Use this instead of one of the 32 bit
+     * checksums if you need a hash value per object with a low chance of
+     * collisions for large numbers of objects.
+     *
+     * Usage:
+     *
+     * @code
+     * osmium::CRC<osmium::CRC_crc64> crc64;
+     * const osmium::Node& node = ...;
+     * crc64.update(node);
+     * std::cout << crc64().checksum() << '\n';
+     * @endcode
+     */
+    class CRC_crc64 {
+
+        uint64_t m_crc64 = 0;
+
+    public:
+
+        void process_byte(const unsigned char byte) noexcept {
+            m_crc64 = detail::crc64(m_crc64, &byte, 1U);
+        }
+
+        void process_bytes(const void* buffer, std::size_t byte_count) noexcept {
+            m_crc64 = detail::crc64(m_crc64, buffer, byte_count);
+        }
+
+        uint64_t checksum() const noexcept {
+            return m_crc64;
+        }
+
+    }; // class CRC_crc64
+
+} // namespace osmium
+
+#endif // OSMIUM_OSM_CRC64_HPP
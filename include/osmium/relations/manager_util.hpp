@@ -103,6 +103,81 @@ namespace osmium {
 
         }; // class SecondPassHandler
 
+        /**
+         * This is a handler class used by relation managers to process
+         * input data in a single pass instead of the usual two passes. This
+         * only works if all relations come before any nodes and ways in
+         * the input, for instance when reading files that have been written
+         * in that order or when the relations are read from a different
+         * source first. Relations are added to the manager until the first
+         * node or way is seen. Then prepare_for_lookup() is called on the
+         * manager and all further objects are handled as in the second pass.
+         *
+         * Relations can not be members in single pass mode, because they
+         * are not available any more when the member lookup starts.
+         *
+         * @tparam TManager The manager we want to call functions on.
+         */
+        template <typename TManager>
+        class SinglePassHandler : public osmium::handler::Handler {
+
+            TManager& m_manager;
+
+            bool m_relations_done = false;
+
+            void relations_done() {
+                if (!m_relations_done) {
+                    m_manager.prepare_for_lookup();
+                    m_relations_done = true;
+                }
+            }
+
+        public:
+
+            explicit SinglePassHandler(TManager& manager) noexcept :
+                m_manager(manager) {
+            }
+
+            /**
+             * Overwrites the function in the handler parent class.
+             */
+            void node(const osmium::Node& node) {
+                relations_done();
+                m_manager.handle_node(node);
+            }
+
+            /**
+             * Overwrites the function in the handler parent class.
+             */
+            void way(const osmium::Way& way) {
+                relations_done();
+                m_manager.handle_way(way);
+            }
+
+            /**
+             * Overwrites the function in the handler parent class.
+             *
+             * @throws osmium::out_of_order_error If the relation comes
+             *         after any node or way.
+             */
+            void relation(const osmium::Relation& relation) {
+                if (m_relations_done) {
+                    throw osmium::out_of_order_error{"Relation after node or way in single pass relation processing", relation.id()};
+                }
+                m_manager.relation(relation);
+            }
+
+            /**
+             * Overwrites the function in the handler parent class.
+             *
+             * Calls the flush_output() function on the manager.
+             */
+            void flush() {
+                m_manager.flush_output();
+            }
+
+        }; // class SinglePassHandler
+
         /**
          * Read relations from file and feed them into all the managers
          * specified as parameters. Opens an osmium::io::Reader internally
@@ -43,6 +43,7 @@ DEALINGS IN THE SOFTWARE.
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <iterator>
 #include <limits>
 #include <tuple>
 #include <type_traits>
@@ -180,6 +181,12 @@ namespace osmium {
 
         public:
 
+            /**
+             * The elements of the database with the same member id as
+             * returned by find_in_shard().
+             */
+            using element_range = iterator_range<iterator>;
+
             /**
              * Return an estimate of the number of bytes currently needed
              * for the MembersDatabase. This does NOT include the memory used
@@ -293,6 +300,89 @@ namespace osmium {
                 }
             }
 
+            /**
+             * Is the object with the specified id tracked in this database,
+             * ie. is it needed as a member of any relation?
+             *
+             * This function does not change the database, so it can be
+             * called from several threads at the same time as long as no
+             * other functions changing the database are called.
+             *
+             * @pre You have to call prepare_for_lookup() before using this.
+             *
+             * Complexity: Logarithmic in the number of members tracked (as
+             *             returned by size()).
+             */
+            bool is_tracked(osmium::object_id_type id) const {
+                assert(!m_init_phase && "Call MembersDatabase::prepare_for_lookup() before calling is_tracked().");
+                return !find(id).empty();
+            }
+
+            /**
+             * Split the database into at most num_shards shards with
+             * roughly the same number of elements. Each shard covers a
+             * range of member ids, all elements with the same member id
+             * are in the same shard. Returns the position of the first
+             * element of each shard followed by size().
+             *
+             * @pre You have to call prepare_for_lookup() before using this.
+             */
+            std::vector<std::size_t> shard_offsets(std::size_t num_shards) const {
+                assert(!m_init_phase && "Call MembersDatabase::prepare_for_lookup() before calling shard_offsets().");
+                std::vector<std::size_t> offsets;
+                offsets.push_back(0);
+                for (std::size_t n = 1; n < num_shards; ++n) {
+                    const auto end = m_elements.cbegin() + static_cast<std::ptrdiff_t>(m_elements.size() * n / num_shards);
+                    if (end == m_elements.cend()) {
+                        break;
+                    }
+                    // Move the boundary back to the first element with
+                    // the same member id.
+                    const auto it = std::lower_bound(m_elements.cbegin() + static_cast<std::ptrdiff_t>(offsets.back()), end, *end, compare_member_id{});
+                    const auto pos = static_cast<std::size_t>(std::distance(m_elements.cbegin(), it));
+                    if (pos > offsets.back()) {
+                        offsets.push_back(pos);
+                    }
+                }
+                offsets.push_back(m_elements.size());
+                return offsets;
+            }
+
+            /**
+             * The member id of the element at the specified position. Use
+             * this with the positions returned by shard_offsets() to get
+             * the smallest member id in a shard.
+             *
+             * @pre pos < size()
+             */
+            osmium::object_id_type member_id_at(std::size_t pos) const noexcept {
+                assert(pos < m_elements.size());
+                return m_elements[pos].member_id;
+            }
+
+            /**
+             * Find the elements with the specified member id in the shard
+             * from position first to last (see shard_offsets()). The result
+             * can be given to MembersDatabase::add().
+             *
+             * This function does not change the database, so it can be
+             * called from several threads at the same time as long as no
+             * other functions changing the database are called.
+             *
+             * @pre You have to call prepare_for_lookup() before using this.
+             *
+             * Complexity: Logarithmic in the number of elements in the
+             *             shard.
+             */
+            element_range find_in_shard(osmium::object_id_type id, std::size_t first, std::size_t last) {
+                assert(!m_init_phase && "Call MembersDatabase::prepare_for_lookup() before calling find_in_shard().");
+                assert(first <= last && last <= m_elements.size());
+                return make_range(std::equal_range(m_elements.begin() + static_cast<std::ptrdiff_t>(first),
+                                                   m_elements.begin() + static_cast<std::ptrdiff_t>(last),
+                                                   element{id},
+                                                   compare_member_id{}));
+            }
+
             /**
              * Find the object with the specified id in the database and
              * return a pointer to it. Returns nullptr if there is no object
@@ -365,7 +455,26 @@ namespace osmium {
             template <typename TFunc>
             bool add(const TObject& object, TFunc&& func) {
                 assert(!m_init_phase && "Call MembersDatabase::prepare_for_lookup() before calling add().");
-                auto range = find(object.id());
+                return add(object, find(object.id()), std::forward<TFunc>(func));
+            }
+
+            /**
+             * Add the specified object to the database. This is the same
+             * as add(object, func) but uses the elements found for the
+             * object with find_in_shard() instead of looking them up again.
+             *
+             * @param object Object to add.
+             * @param range The elements with the id of the object.
+             * @param func If the object is the last member to complete a
+             *             relation, this function is called with the relation
+             *             as a parameter.
+             * @returns true if the object was actually added, false if no
+             *          relation needed this object.
+             * @pre You have to call prepare_for_lookup() before using this.
+             */
+            template <typename TFunc>
+            bool add(const TObject& object, element_range range, TFunc&& func) {
+                assert(!m_init_phase && "Call MembersDatabase::prepare_for_lookup() before calling add().");
 
                 if (range.empty()) {
                     // No relation needs this object.
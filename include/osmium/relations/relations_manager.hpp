@@ -47,14 +47,17 @@ DEALINGS IN THE SOFTWARE.
 #include <osmium/storage/item_stash.hpp>
 #include <osmium/tags/taglist.hpp>
 #include <osmium/tags/tags_filter.hpp>
+#include <osmium/thread/pool.hpp>
 
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <future>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace osmium {
@@ -97,6 +100,20 @@ namespace osmium {
                 m_member_relations_db(m_stash, m_relations_db) {
             }
 
+            /**
+             * Construct a RelationsManagerBase storing all relations and
+             * members in a stash with the specified storage type. Use
+             * osmium::ItemStash::storage_type::tmpfile if the data might
+             * not fit into memory.
+             */
+            explicit RelationsManagerBase(osmium::ItemStash::storage_type storage) :
+                m_stash(storage),
+                m_relations_db(m_stash),
+                m_member_nodes_db(m_stash, m_relations_db),
+                m_member_ways_db(m_stash, m_relations_db),
+                m_member_relations_db(m_stash, m_relations_db) {
+            }
+
             /// Access the internal RelationsDatabase.
             osmium::relations::RelationsDatabase& relations_database() noexcept {
                 return m_relations_db;
@@ -310,6 +327,8 @@ namespace osmium {
 
             SecondPassHandler<RelationsManager> m_handler_pass2;
 
+            SinglePassHandler<RelationsManager> m_handler_single_pass;
+
             static bool wanted_type(osmium::item_type type) noexcept {
                 return (TNodes     && type == osmium::item_type::node) ||
                        (TWays      && type == osmium::item_type::way) ||
@@ -459,12 +478,134 @@ namespace osmium {
                 rel_handle.remove();
             }
 
+            enum {
+                min_objects_per_shard = 1000
+            };
+
+            using element_range = relations::MembersDatabaseCommon::element_range;
+
+            // Relations completed by the object currently handled. They are
+            // handled in the order they were completed after the members
+            // database is done with the object.
+            std::vector<RelationHandle> m_completed_relations;
+
+            void queue_complete_relation(RelationHandle& rel_handle) {
+                m_completed_relations.push_back(rel_handle);
+            }
+
+            void handle_completed_relations() {
+                for (auto& rel_handle : m_completed_relations) {
+                    handle_complete_relation(rel_handle);
+                }
+                m_completed_relations.clear();
+            }
+
+            // If range is nullptr, the object is looked up in the members
+            // database, otherwise range is the result of an earlier lookup
+            // with find_in_shard().
+            void handle_node_impl(const osmium::Node& node, const element_range* range) {
+                m_check_order_handler.node(node);
+                derived().before_node(node);
+                const auto callback = [this](RelationHandle& rel_handle) {
+                    queue_complete_relation(rel_handle);
+                };
+                const bool added = range ? member_nodes_database().add(node, *range, callback)
+                                         : member_nodes_database().add(node, callback);
+                handle_completed_relations();
+                if (!added) {
+                    derived().node_not_in_any_relation(node);
+                }
+                derived().after_node(node);
+                possibly_flush();
+            }
+
+            void handle_way_impl(const osmium::Way& way, const element_range* range) {
+                m_check_order_handler.way(way);
+                derived().before_way(way);
+                const auto callback = [this](RelationHandle& rel_handle) {
+                    queue_complete_relation(rel_handle);
+                };
+                const bool added = range ? member_ways_database().add(way, *range, callback)
+                                         : member_ways_database().add(way, callback);
+                handle_completed_relations();
+                if (!added) {
+                    derived().way_not_in_any_relation(way);
+                }
+                derived().after_way(way);
+                possibly_flush();
+            }
+
+            void handle_relation_impl(const osmium::Relation& relation, const element_range* range) {
+                m_check_order_handler.relation(relation);
+                derived().before_relation(relation);
+                const auto callback = [this](RelationHandle& rel_handle) {
+                    queue_complete_relation(rel_handle);
+                };
+                const bool added = range ? member_relations_database().add(relation, *range, callback)
+                                         : member_relations_database().add(relation, callback);
+                handle_completed_relations();
+                if (!added) {
+                    derived().relation_not_in_any_relation(relation);
+                }
+                derived().after_relation(relation);
+                possibly_flush();
+            }
+
+            // The lookups for the objects of one type with ids in the id
+            // range of one shard of the members database.
+            struct lookup_shard {
+                relations::MembersDatabaseCommon* database;
+                std::size_t first;
+                std::size_t last;
+                std::vector<std::size_t> objects;
+            };
+
+            // Split the members database for the type into shards by id
+            // range and assign the objects of that type to them.
+            void add_lookup_shards(std::vector<lookup_shard>& shards,
+                                   const std::vector<const osmium::OSMObject*>& objects,
+                                   osmium::item_type type,
+                                   std::size_t num_shards) {
+                auto& database = member_database(type);
+                const auto offsets = database.shard_offsets(num_shards);
+
+                // Smallest member id in each shard but the first.
+                std::vector<osmium::object_id_type> boundaries;
+                for (std::size_t n = 1; n + 1 < offsets.size(); ++n) {
+                    boundaries.push_back(database.member_id_at(offsets[n]));
+                }
+
+                const std::size_t first_shard = shards.size();
+                for (std::size_t n = 0; n + 1 < offsets.size(); ++n) {
+                    shards.push_back(lookup_shard{&database, offsets[n], offsets[n + 1], {}});
+                }
+
+                for (std::size_t i = 0; i < objects.size(); ++i) {
+                    if (objects[i]->type() == type) {
+                        const auto shard = std::upper_bound(boundaries.cbegin(), boundaries.cend(), objects[i]->id()) - boundaries.cbegin();
+                        shards[first_shard + static_cast<std::size_t>(shard)].objects.push_back(i);
+                    }
+                }
+            }
+
         public:
 
             RelationsManager() :
                 RelationsManagerBase(),
                 m_check_order_handler(),
-                m_handler_pass2(*this) {
+                m_handler_pass2(*this),
+                m_handler_single_pass(*this) {
+            }
+
+            /**
+             * Construct a RelationsManager storing all relations and members
+             * in a stash with the specified storage type.
+             */
+            explicit RelationsManager(osmium::ItemStash::storage_type storage) :
+                RelationsManagerBase(storage),
+                m_check_order_handler(),
+                m_handler_pass2(*this),
+                m_handler_single_pass(*this) {
             }
 
             /**
@@ -475,6 +616,20 @@ namespace osmium {
                 return m_handler_pass2;
             }
 
+            /**
+             * Return reference to the handler for processing relations and
+             * their members in a single pass. Use this instead of
+             * read_relations() and the second pass handler if you know that
+             * all relations come before any nodes and ways in your input.
+             * This can only be used if relations are not of interest as
+             * members.
+             */
+            SinglePassHandler<RelationsManager>& single_pass_handler(const std::function<void(osmium::memory::Buffer&&)>& callback = nullptr) {
+                static_assert(!TRelations, "Single pass handler can not be used if relation members are needed.");
+                set_callback(callback);
+                return m_handler_single_pass;
+            }
+
             /**
              * Add the specified relation to the list of relations we want to
              * build. This calls the new_relation() and new_member()
@@ -504,46 +659,111 @@ namespace osmium {
 
             void handle_node(const osmium::Node& node) {
                 if (TNodes) {
-                    m_check_order_handler.node(node);
-                    derived().before_node(node);
-                    const bool added = member_nodes_database().add(node, [this](RelationHandle& rel_handle) {
-                        handle_complete_relation(rel_handle);
-                    });
-                    if (!added) {
-                        derived().node_not_in_any_relation(node);
-                    }
-                    derived().after_node(node);
-                    possibly_flush();
+                    handle_node_impl(node, nullptr);
                 }
             }
 
             void handle_way(const osmium::Way& way) {
                 if (TWays) {
-                    m_check_order_handler.way(way);
-                    derived().before_way(way);
-                    const bool added = member_ways_database().add(way, [this](RelationHandle& rel_handle) {
-                        handle_complete_relation(rel_handle);
-                    });
-                    if (!added) {
-                        derived().way_not_in_any_relation(way);
-                    }
-                    derived().after_way(way);
-                    possibly_flush();
+                    handle_way_impl(way, nullptr);
                 }
             }
 
             void handle_relation(const osmium::Relation& relation) {
                 if (TRelations) {
-                    m_check_order_handler.relation(relation);
-                    derived().before_relation(relation);
-                    const bool added = member_relations_database().add(relation, [this](RelationHandle& rel_handle) {
-                        handle_complete_relation(rel_handle);
-                    });
-                    if (!added) {
-                        derived().relation_not_in_any_relation(relation);
+                    handle_relation_impl(relation, nullptr);
+                }
+            }
+
+            /**
+             * Handle all objects in the buffer like the second pass handler
+             * does, but look up the objects in the members databases using
+             * several threads from the pool. Each members database is split
+             * into as many shards by id range as there are threads in the
+             * pool and the objects are looked up in the shard covering
+             * their id.
+             *
+             * Storing the objects, updating the relations, and calling the
+             * callbacks of the derived class is done in the calling thread
+             * in the order of the objects in the buffer using the results
+             * of the lookups. This work uses the stash and the relations
+             * database which are shared between all shards. And the
+             * results are the same as with the second pass handler.
+             *
+             * Use this instead of the second pass handler in a loop over all
+             * buffers from the reader. Call flush_output() after the last
+             * buffer.
+             *
+             * @param buffer The buffer with the input data.
+             * @param pool The thread pool used for the lookups.
+             */
+            void handle_buffer(const osmium::memory::Buffer& buffer, osmium::thread::Pool& pool = osmium::thread::Pool::default_instance()) {
+                std::vector<const osmium::OSMObject*> objects;
+                for (const auto& object : buffer.select<osmium::OSMObject>()) {
+                    if (wanted_type(object.type())) {
+                        objects.push_back(&object);
+                    }
+                }
+
+                std::size_t num_shards = static_cast<std::size_t>(pool.num_threads());
+                if (num_shards < 2 || objects.size() < min_objects_per_shard * 2) {
+                    num_shards = 1;
+                }
+
+                std::vector<lookup_shard> shards;
+                for (const auto type : {osmium::item_type::node, osmium::item_type::way, osmium::item_type::relation}) {
+                    if (wanted_type(type)) {
+                        add_lookup_shards(shards, objects, type, num_shards);
+                    }
+                }
+
+                std::vector<element_range> ranges(objects.size(), element_range{std::make_pair(element_range::iterator{}, element_range::iterator{})});
+
+                const auto lookup = [&objects, &ranges](lookup_shard& shard) {
+                    for (const auto i : shard.objects) {
+                        ranges[i] = shard.database->find_in_shard(objects[i]->id(), shard.first, shard.last);
+                    }
+                };
+
+                if (num_shards == 1) {
+                    for (auto& shard : shards) {
+                        lookup(shard);
+                    }
+                } else {
+                    std::vector<std::future<void>> futures;
+                    for (auto& shard : shards) {
+                        if (!shard.objects.empty()) {
+                            futures.push_back(pool.submit([&lookup, &shard] {
+                                lookup(shard);
+                            }));
+                        }
+                    }
+
+                    // Wait for all tasks before possibly rethrowing an
+                    // exception, they reference local variables.
+                    for (auto& future : futures) {
+                        future.wait();
+                    }
+                    for (auto& future : futures) {
+                        future.get();
+                    }
+                }
+
+                for (std::size_t i = 0; i < objects.size(); ++i) {
+                    const auto& object = *objects[i];
+                    switch (object.type()) {
+                        case osmium::item_type::node:
+                            handle_node_impl(static_cast<const osmium::Node&>(object), &ranges[i]);
+                            break;
+                        case osmium::item_type::way:
+                            handle_way_impl(static_cast<const osmium::Way&>(object), &ranges[i]);
+                            break;
+                        case osmium::item_type::relation:
+                            handle_relation_impl(static_cast<const osmium::Relation&>(object), &ranges[i]);
+                            break;
+                        default:
+                            break;
                     }
-                    derived().after_relation(relation);
-                    possibly_flush();
                 }
             }
 
@@ -0,0 +1,364 @@
+#ifndef OSMIUM_STORAGE_COMPACT_OBJECT_STORE_HPP
+#define OSMIUM_STORAGE_COMPACT_OBJECT_STORE_HPP
+
+/*
+
+This file is part of Osmium (https://osmcode.org/libosmium).
+
+Copyright 2013-2026 Jochen Topf <jochen@topf.org> and others (see README).
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include <osmium/builder/osm_object_builder.hpp>
+#include <osmium/memory/buffer.hpp>
+#include <osmium/osm/item_type.hpp>
+#include <osmium/osm/location.hpp>
+#include <osmium/osm/node.hpp>
+#include <osmium/osm/object.hpp>
+#include <osmium/osm/relation.hpp>
+#include <osmium/osm/timestamp.hpp>
+#include <osmium/osm/types.hpp>
+#include <osmium/osm/way.hpp>
+#include <osmium/storage/string_pool.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+namespace osmium {
+
+    /**
+     * Class for storing many nodes, ways, and relations in memory in a
+     * compact form. All strings (tag keys and values, roles, and user
+     * names) are kept in a StringPool which can be shared between several
+     * stores and only their 32 bit ids are stored with the objects.
+     *
+     * In contrast to the ItemStash, objects are not stored in their
+     * normal form, so it is not possible to get a reference to a stored
+     * object. Instead get() re-creates the object in a buffer. This makes
+     * the store a good fit for data that has to be kept around for a long
+     * time, but is only accessed rarely.
+     *
+     * Full member objects of relations (as used in some history files)
+     * are not stored.
+     */
+    class CompactObjectStore {
+
+    public:
+
+        /**
+         * This is the type of the handle returned by the add() call. It is
+         * used to access the object again.
+         *
+         * There is one special handle, the invalid handle. It can be created
+         * by calling the default constructor. Valid handles can only be
+         * constructed by the CompactObjectStore class.
+         */
+        class handle_type {
+
+            friend class CompactObjectStore;
+
+            std::size_t value; // NOLINT(modernize-use-default-member-init)
+
+            explicit handle_type(std::size_t new_value) noexcept :
+                value(new_value) {
+                assert(new_value > 0);
+            }
+
+        public:
+
+            /// The default constructor creates an invalid handle.
+            handle_type() noexcept :
+                value(0) {
+            }
+
+            /// Is this a valid handle?
+            bool valid() const noexcept {
+                return value != 0;
+            }
+
+            /**
+             * Print the handle for debugging purposes. An invalid handle
+             * will be printed as the single letter '-'.
+             */
+            template <typename TChar, typename TTraits>
+            friend inline std::basic_ostream<TChar, TTraits>& operator<<(std::basic_ostream<TChar, TTraits>& out, const CompactObjectStore::handle_type& handle) { // NOLINT(readability-redundant-inline-specifier)
+                if (handle.valid()) {
+                    out << handle.value;
+                } else {
+                    out << '-';
+                }
+                return out;
+            }
+
+        }; // class handle_type
+
+    private:
+
+        // Layout of an object in m_data (all values stored unaligned in
+        // native byte order):
+        //
+        // uint8_t type, uint8_t visible, int64_t id, uint32_t version,
+        // uint32_t changeset, uint32_t timestamp, uint32_t uid,
+        // uint32_t user, uint32_t number of tags,
+        // number of tags * (uint32_t key, uint32_t value), then
+        // node:     int32_t x, int32_t y
+        // way:      uint32_t number of nodes,
+        //           number of nodes * (int64_t ref, int32_t x, int32_t y)
+        // relation: uint32_t number of members,
+        //           number of members * (uint8_t type, int64_t ref, uint32_t role)
+
+        osmium::StringPool* m_pool;
+        std::vector<unsigned char> m_data;
+        std::size_t m_count = 0;
+
+        template <typename T>
+        void append(T value) {
+            const auto size = m_data.size();
+            m_data.resize(size + sizeof(T));
+            std::memcpy(&m_data[size], &value, sizeof(T));
+        }
+
+        template <typename T>
+        T read(std::size_t* pos) const noexcept {
+            assert(*pos + sizeof(T) <= m_data.size());
+            T value;
+            std::memcpy(&value, &m_data[*pos], sizeof(T));
+            *pos += sizeof(T);
+            return value;
+        }
+
+        void append_string(const char* str) {
+            append(m_pool->add(str));
+        }
+
+        const char* read_string(std::size_t* pos) const noexcept {
+            return m_pool->get(read<osmium::StringPool::id_type>(pos));
+        }
+
+        void append_location(const osmium::Location& location) {
+            append(location.x());
+            append(location.y());
+        }
+
+        osmium::Location read_location(std::size_t* pos) const noexcept {
+            const auto x = read<int32_t>(pos);
+            const auto y = read<int32_t>(pos);
+            return osmium::Location{x, y};
+        }
+
+        template <typename TBuilder>
+        std::size_t build_object(std::size_t pos, TBuilder& builder) const {
+            const auto visible = read<uint8_t>(&pos);
+            builder.set_id(read<osmium::object_id_type>(&pos));
+            builder.set_visible(visible != 0);
+            builder.set_version(read<osmium::object_version_type>(&pos));
+            builder.set_changeset(read<osmium::changeset_id_type>(&pos));
+            builder.set_timestamp(osmium::Timestamp{read<uint32_t>(&pos)});
+            builder.set_uid(read<osmium::user_id_type>(&pos));
+            builder.set_user(read_string(&pos));
+
+            const auto num_tags = read<uint32_t>(&pos);
+            if (num_tags > 0) {
+                osmium::builder::TagListBuilder tl_builder{builder};
+                for (uint32_t i = 0; i < num_tags; ++i) {
+                    const char* key = read_string(&pos);
+                    tl_builder.add_tag(key, read_string(&pos));
+                }
+            }
+
+            return pos;
+        }
+
+    public:
+
+        /**
+         * Create an empty store.
+         *
+         * @param pool The string pool used for all strings in the objects.
+         *             It must live at least as long as this store.
+         */
+        explicit CompactObjectStore(osmium::StringPool& pool) :
+            m_pool(&pool) {
+        }
+
+        /// The string pool used by this store.
+        const osmium::StringPool& pool() const noexcept {
+            return *m_pool;
+        }
+
+        /**
+         * Add an object to the store.
+         *
+         * @param object A node, way, or relation.
+         * @returns A handle to access the object again.
+         * @throws std::invalid_argument if the object is not a node, way,
+         *         or relation.
+         */
+        handle_type add(const osmium::OSMObject& object) {
+            const auto type = object.type();
+            if (type != osmium::item_type::node &&
+                type != osmium::item_type::way &&
+                type != osmium::item_type::relation) {
+                throw std::invalid_argument{"CompactObjectStore can only store nodes, ways, and relations"};
+            }
+
+            const auto offset = m_data.size();
+
+            append(static_cast<uint8_t>(type));
+            append(static_cast<uint8_t>(object.visible()));
+            append(object.id());
+            append(object.version());
+            append(object.changeset());
+            append(static_cast<uint32_t>(object.timestamp().seconds_since_epoch()));
+            append(object.uid());
+            append_string(object.user());
+
+            append(static_cast<uint32_t>(object.tags().size()));
+            for (const auto& tag : object.tags()) {
+                append_string(tag.key());
+                append_string(tag.value());
+            }
+
+            if (type == osmium::item_type::node) {
+                append_location(static_cast<const osmium::Node&>(object).location());
+            } else if (type == osmium::item_type::way) {
+                const auto& nodes = static_cast<const osmium::Way&>(object).nodes();
+                append(static_cast<uint32_t>(nodes.size()));
+                for (const auto& node_ref : nodes) {
+                    append(node_ref.ref());
+                    append_location(node_ref.location());
+                }
+            } else {
+                const auto& members = static_cast<const osmium::Relation&>(object).members();
+                append(static_cast<uint32_t>(members.size()));
+                for (const auto& member : members) {
+                    append(static_cast<uint8_t>(member.type()));
+                    append(member.ref());
+                    append_string(member.role());
+                }
+            }
+
+            ++m_count;
+            return handle_type{offset + 1};
+        }
+
+        /**
+         * The type of the object with the specified handle.
+         *
+         * @pre Handle must be valid and from this store.
+         */
+        osmium::item_type type(handle_type handle) const noexcept {
+            assert(handle.valid());
+            std::size_t pos = handle.value - 1;
+            return static_cast<osmium::item_type>(read<uint8_t>(&pos));
+        }
+
+        /**
+         * The id of the object with the specified handle.
+         *
+         * @pre Handle must be valid and from this store.
+         */
+        osmium::object_id_type id(handle_type handle) const noexcept {
+            assert(handle.valid());
+            std::size_t pos = handle.value - 1 + 2 * sizeof(uint8_t);
+            return read<osmium::object_id_type>(&pos);
+        }
+
+        /**
+         * Re-create the object with the specified handle in the buffer.
+         * The object is committed to the buffer.
+         *
+         * @pre Handle must be valid and from this store.
+         * @returns A reference to the object in the buffer.
+         */
+        osmium::OSMObject& get(handle_type handle, osmium::memory::Buffer& buffer) const {
+            assert(handle.valid());
+            std::size_t pos = handle.value - 1;
+            const auto type = static_cast<osmium::item_type>(read<uint8_t>(&pos));
+
+            if (type == osmium::item_type::node) {
+                osmium::builder::NodeBuilder builder{buffer};
+                pos = build_object(pos, builder);
+                builder.set_location(read_location(&pos));
+            } else if (type == osmium::item_type::way) {
+                osmium::builder::WayBuilder builder{buffer};
+                pos = build_object(pos, builder);
+                const auto num_nodes = read<uint32_t>(&pos);
+                osmium::builder::WayNodeListBuilder wnl_builder{builder};
+                for (uint32_t i = 0; i < num_nodes; ++i) {
+                    const auto ref = read<osmium::object_id_type>(&pos);
+                    wnl_builder.add_node_ref(ref, read_location(&pos));
+                }
+            } else {
+                assert(type == osmium::item_type::relation);
+                osmium::builder::RelationBuilder builder{buffer};
+                pos = build_object(pos, builder);
+                const auto num_members = read<uint32_t>(&pos);
+                osmium::builder::RelationMemberListBuilder rml_builder{builder};
+                for (uint32_t i = 0; i < num_members; ++i) {
+                    const auto member_type = static_cast<osmium::item_type>(read<uint8_t>(&pos));
+                    const auto ref = read<osmium::object_id_type>(&pos);
+                    rml_builder.add_member(member_type, ref, read_string(&pos));
+                }
+            }
+
+            return buffer.get<osmium::OSMObject>(buffer.commit());
+        }
+
+        /// The number of objects in the store.
+        std::size_t size() const noexcept {
+            return m_count;
+        }
+
+        /**
+         * Return an estimate of the number of bytes currently needed for
+         * the store. This does NOT include the memory used by the string
+         * pool.
+         */
+        std::size_t used_memory() const noexcept {
+            return sizeof(CompactObjectStore) + m_data.capacity();
+        }
+
+        /**
+         * Remove all objects from the store. All handles become invalid.
+         * The string pool is not changed.
+         */
+        void clear() noexcept {
+            m_data.clear();
+            m_count = 0;
+        }
+
+    }; // class CompactObjectStore
+
+} // namespace osmium
+
+#endif // OSMIUM_STORAGE_COMPACT_OBJECT_STORE_HPP
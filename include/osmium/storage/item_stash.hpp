@@ -33,12 +33,18 @@ DEALINGS IN THE SOFTWARE.
 
 */
 
+#include <osmium/index/detail/tmpfile.hpp>
+#include <osmium/io/detail/read_write.hpp>
 #include <osmium/memory/buffer.hpp>
 #include <osmium/memory/item.hpp>
+#include <osmium/util/file.hpp>
+#include <osmium/util/memory_mapping.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 #include <limits>
+#include <memory>
 #include <ostream>
 #include <vector>
 
@@ -53,11 +59,27 @@ namespace osmium {
      * Class for storing OSM data in memory. Any osmium::memory::Item can be
      * added to the stash and it will be copied into its internal Buffer. To
      * access the item again, an opaque handle is used.
+     *
+     * By default all items are kept in memory. If the stash is created
+     * with storage_type::tmpfile, the items are kept in a memory mapped
+     * temporary file instead. The operating system can then write parts
+     * of the data that are not currently used out to disk, so the stash
+     * can hold more data than fits into RAM. This is slower, but it
+     * allows working with large amounts of data (such as all members of
+     * all multipolygon relations in a planet file) on smaller machines.
      */
     class ItemStash {
 
     public:
 
+        /**
+         * Where the items in the stash are stored.
+         */
+        enum class storage_type {
+            memory  = 0, ///< in memory (default)
+            tmpfile = 1  ///< in a memory mapped temporary file
+        };
+
         /**
          * This is the type of the handle returned by the add_item() call.
          * It is used to access the item again with get_item() or get<>()
@@ -123,6 +145,54 @@ namespace osmium {
             removed_item_offset = std::numeric_limits<std::size_t>::max()
         };
 
+        /**
+         * Memory mapping of a temporary file used as backing store for
+         * the buffer if storage_type::tmpfile is used. The file is
+         * removed from the file system when it is opened and closed
+         * when this object is destroyed.
+         */
+        class tmpfile_mapping {
+
+            int m_fd;
+            osmium::MemoryMapping m_mapping;
+
+        public:
+
+            explicit tmpfile_mapping(std::size_t size) :
+                m_fd(osmium::detail::create_tmp_file()),
+                m_mapping(size, osmium::MemoryMapping::mapping_mode::write_shared, m_fd) {
+            }
+
+            tmpfile_mapping(const tmpfile_mapping&) = delete;
+            tmpfile_mapping& operator=(const tmpfile_mapping&) = delete;
+
+            tmpfile_mapping(tmpfile_mapping&&) = delete;
+            tmpfile_mapping& operator=(tmpfile_mapping&&) = delete;
+
+            ~tmpfile_mapping() noexcept {
+                try {
+                    m_mapping.unmap();
+                    osmium::io::detail::reliable_close(m_fd);
+                } catch (...) { // NOLINT(bugprone-empty-catch)
+                    // Ignore any exceptions because destructor must not throw.
+                }
+            }
+
+            std::size_t size() const noexcept {
+                return m_mapping.size();
+            }
+
+            unsigned char* data() const noexcept {
+                return m_mapping.get_addr<unsigned char>();
+            }
+
+            void resize(std::size_t new_size) {
+                m_mapping.resize(new_size);
+            }
+
+        }; // class tmpfile_mapping
+
+        std::unique_ptr<tmpfile_mapping> m_mapping;
         osmium::memory::Buffer m_buffer;
         std::vector<std::size_t> m_index;
         std::size_t m_count_items = 0;
@@ -193,15 +263,55 @@ namespace osmium {
             return m_buffer.capacity() - m_buffer.committed() < 10UL * 1024UL; // *4
         }
 
+        // Make sure there is enough space for an item of the specified
+        // size in the buffer. Buffers in memory grow automatically, but if
+        // the buffer is backed by a temporary file, the mapping has to be
+        // enlarged and the buffer re-created on top of it.
+        void reserve_space(std::size_t size) {
+            if (!m_mapping || m_buffer.committed() + size <= m_buffer.capacity()) {
+                return;
+            }
+
+            const std::size_t pagesize = osmium::get_pagesize();
+            std::size_t new_size = std::max(m_mapping->size() * 2, m_buffer.committed() + size);
+            new_size = ((new_size + pagesize - 1) / pagesize) * pagesize;
+
+            const std::size_t committed = m_buffer.committed();
+            m_buffer = osmium::memory::Buffer{};
+            m_mapping->resize(new_size);
+            m_buffer = osmium::memory::Buffer{m_mapping->data(), m_mapping->size(), committed};
+        }
+
     public:
 
         ItemStash() :
             m_buffer(initial_buffer_size, osmium::memory::Buffer::auto_grow::yes) {
         }
 
+        /**
+         * Create an ItemStash using the specified storage type.
+         */
+        explicit ItemStash(storage_type storage) {
+            if (storage == storage_type::tmpfile) {
+                m_mapping.reset(new tmpfile_mapping{initial_buffer_size});
+                m_buffer = osmium::memory::Buffer{m_mapping->data(), m_mapping->size(), 0};
+            } else {
+                m_buffer = osmium::memory::Buffer{initial_buffer_size, osmium::memory::Buffer::auto_grow::yes};
+            }
+        }
+
+        /**
+         * The type of storage used for this stash.
+         */
+        storage_type storage() const noexcept {
+            return m_mapping ? storage_type::tmpfile : storage_type::memory;
+        }
+
         /**
          * Return an estimate of the number of bytes currently used by this
-         * ItemStash instance.
+         * ItemStash instance. If the items are stored in a temporary file,
+         * this includes the size of the memory mapping, even if some of it
+         * might currently be on disk.
          *
          * Complexity: Constant.
          */
@@ -252,6 +362,7 @@ namespace osmium {
             if (should_gc()) {
                 garbage_collect();
             }
+            reserve_space(item.padded_size());
             ++m_count_items;
             const auto offset = m_buffer.committed();
             m_buffer.add_item(item);
@@ -0,0 +1,205 @@
+#ifndef OSMIUM_STORAGE_STRING_POOL_HPP
+#define OSMIUM_STORAGE_STRING_POOL_HPP
+
+/*
+
+This file is part of Osmium (https://osmcode.org/libosmium).
+
+Copyright 2013-2026 Jochen Topf <jochen@topf.org> and others (see README).
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include <osmium/storage/detail/string_store.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace osmium {
+
+    /**
+     * An append-only pool of interned strings. Each distinct string is
+     * stored only once and identified by a 32 bit id. Ids are assigned
+     * consecutively starting from 0, which is always the empty string.
+     *
+     * OSM data uses a small vocabulary of keys, common values, roles,
+     * and user names, so storing those strings once and referring to them
+     * by id needs much less memory than storing a copy with every object.
+     * The pool can be shared by several users, for instance several
+     * CompactObjectStore objects.
+     *
+     * Strings are never removed, pointers returned by get() stay valid
+     * until the pool is cleared or destroyed. The pool is not thread safe.
+     */
+    class StringPool {
+
+    public:
+
+        using id_type = uint32_t;
+
+    private:
+
+        enum : std::size_t {
+            default_chunk_size = 64UL * 1024UL
+        };
+
+        osmium::detail::StringStore m_store;
+
+        std::vector<const char*> m_strings;
+
+        std::unordered_map<const char*, id_type, osmium::detail::djb2_hash, osmium::detail::str_equal> m_index;
+
+    public:
+
+        /**
+         * Create an empty pool (containing only the empty string).
+         *
+         * @param chunk_size Memory for the strings is allocated in chunks
+         *                   of this size.
+         */
+        explicit StringPool(std::size_t chunk_size = default_chunk_size) :
+            m_store(chunk_size) {
+            assert(chunk_size > 0);
+            add("");
+        }
+
+        /**
+         * Add a string to the pool if it isn't in there already.
+         *
+         * @param str The string, must be NUL-terminated.
+         * @returns The id of the string.
+         * @throws std::length_error if the pool is full.
+         *
+         * Complexity: Constant (amortized, average).
+         */
+        id_type add(const char* str) {
+            assert(str);
+            const auto it = m_index.find(str);
+            if (it != m_index.end()) {
+                return it->second;
+            }
+
+            if (m_strings.size() > std::numeric_limits<id_type>::max()) {
+                throw std::length_error{"StringPool is full"};
+            }
+
+            const auto id = static_cast<id_type>(m_strings.size());
+            const char* copy = m_store.add(str, std::strlen(str));
+            m_strings.push_back(copy);
+            m_index.emplace(copy, id);
+
+            return id;
+        }
+
+        /**
+         * Add a string to the pool if it isn't in there already.
+         *
+         * @returns The id of the string.
+         * @throws std::length_error if the pool is full.
+         */
+        id_type add(const std::string& str) {
+            return add(str.c_str());
+        }
+
+        /**
+         * Look up the id of a string without adding it.
+         *
+         * @param str The string, must be NUL-terminated.
+         * @param id Set to the id of the string if it was found.
+         * @returns Whether the string is in the pool.
+         */
+        bool find(const char* str, id_type* id) const {
+            assert(str);
+            assert(id);
+            const auto it = m_index.find(str);
+            if (it == m_index.end()) {
+                return false;
+            }
+            *id = it->second;
+            return true;
+        }
+
+        /**
+         * Get the string with the specified id.
+         *
+         * @pre @code id < size() @endcode
+         */
+        const char* get(id_type id) const noexcept {
+            assert(id < m_strings.size());
+            return m_strings[id];
+        }
+
+        /**
+         * Get the string with the specified id.
+         *
+         * @pre @code id < size() @endcode
+         */
+        const char* operator[](id_type id) const noexcept {
+            return get(id);
+        }
+
+        /**
+         * The number of distinct strings in the pool including the empty
+         * string.
+         */
+        std::size_t size() const noexcept {
+            return m_strings.size();
+        }
+
+        /**
+         * Return an estimate of the number of bytes currently needed for
+         * the pool.
+         */
+        std::size_t used_memory() const noexcept {
+            return sizeof(StringPool) + m_store.get_used_memory() +
+                   (m_strings.capacity() * sizeof(const char*)) +
+                   (m_index.size() * (sizeof(const char*) + sizeof(id_type) + 2 * sizeof(void*))) +
+                   (m_index.bucket_count() * sizeof(void*));
+        }
+
+        /**
+         * Remove all strings from the pool. All ids and all pointers
+         * returned from get() become invalid.
+         */
+        void clear() {
+            m_index.clear();
+            m_strings.clear();
+            m_store.clear();
+            add("");
+        }
+
+    }; // class StringPool
+
+} // namespace osmium
+
+#endif // OSMIUM_STORAGE_STRING_POOL_HPP
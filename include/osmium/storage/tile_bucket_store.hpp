@@ -0,0 +1,347 @@
+#ifndef OSMIUM_STORAGE_TILE_BUCKET_STORE_HPP
+#define OSMIUM_STORAGE_TILE_BUCKET_STORE_HPP
+
+/*
+
+This file is part of Osmium (https://osmcode.org/libosmium).
+
+Copyright 2013-2026 Jochen Topf <jochen@topf.org> and others (see README).
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include <osmium/geom/tile.hpp>
+#include <osmium/io/detail/read_write.hpp>
+#include <osmium/io/error.hpp>
+#include <osmium/osm/item_type.hpp>
+#include <osmium/osm/types.hpp>
+#include <osmium/util/file.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace osmium {
+
+    /**
+     * An entry in a tile bucket: The object with the given type and id
+     * touches the tile with the given x and y coordinates.
+     *
+     * Entries are written to disk as they are in memory, so bucket files
+     * can only be read on machines with the same byte order.
+     */
+    struct tile_bucket_entry {
+
+        uint32_t x = 0;
+        uint32_t y = 0;
+        osmium::object_id_type id = 0;
+        uint32_t type = 0;
+        uint32_t reserved = 0; // makes padding explicit so all bytes are written initialized
+
+        tile_bucket_entry() noexcept = default;
+
+        tile_bucket_entry(const osmium::geom::Tile& tile, osmium::item_type object_type, osmium::object_id_type object_id) noexcept :
+            x(tile.x),
+            y(tile.y),
+            id(object_id),
+            type(static_cast<uint32_t>(object_type)) {
+        }
+
+        osmium::item_type object_type() const noexcept {
+            return static_cast<osmium::item_type>(type);
+        }
+
+        /// The tile in the given zoom level (the zoom level of the store).
+        osmium::geom::Tile tile(uint32_t zoom) const noexcept {
+            return osmium::geom::Tile{zoom, x, y};
+        }
+
+    }; // struct tile_bucket_entry
+
+    /// Entries are ordered by tile (x, then y), then type, then id.
+    inline bool operator<(const tile_bucket_entry& lhs, const tile_bucket_entry& rhs) noexcept {
+        return std::tie(lhs.x, lhs.y, lhs.type, lhs.id) < std::tie(rhs.x, rhs.y, rhs.type, rhs.id);
+    }
+
+    inline bool operator==(const tile_bucket_entry& lhs, const tile_bucket_entry& rhs) noexcept {
+        return lhs.x == rhs.x && lhs.y == rhs.y && lhs.type == rhs.type && lhs.id == rhs.id;
+    }
+
+    inline bool operator!=(const tile_bucket_entry& lhs, const tile_bucket_entry& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+    /**
+     * Stores lists of (tile, object) pairs on disk, grouped into buckets.
+     * Each bucket contains all entries for tiles inside one tile of a
+     * lower "bucket zoom" level and is stored in its own file named
+     * "Z-X-Y.tiles" (after the bucket tile) in the directory given to the
+     * constructor. The directory must exist and should be empty.
+     *
+     * Entries are added in any order and collected in memory for each
+     * bucket. When the number of entries for a bucket reaches the limit
+     * set in the constructor, they are appended to the bucket file. So
+     * the memory used is bounded by the number of buckets times that
+     * limit, independent of the amount of data. After all entries have
+     * been added, call flush() and then read the buckets one by one with
+     * read_bucket(). Each bucket can be sorted and processed in memory.
+     *
+     * This class is not thread-safe.
+     */
+    class TileBucketStore {
+
+        std::string m_directory;
+        uint32_t m_zoom;
+        uint32_t m_bucket_zoom;
+        std::size_t m_max_entries_in_memory;
+        std::vector<std::vector<tile_bucket_entry>> m_buckets;
+
+        // Has the file for this bucket been created by this store? Used
+        // to truncate files from earlier runs the first time they are
+        // written to and to ignore those files when reading.
+        std::vector<char> m_bucket_created;
+
+        std::size_t m_num_entries = 0;
+
+        void flush_bucket(std::size_t index) {
+            auto& bucket = m_buckets[index];
+            if (bucket.empty()) {
+                return;
+            }
+
+            const std::string name = filename(static_cast<uint32_t>(index));
+            const int fd = m_bucket_created[index] ? osmium::io::detail::open_for_appending(name)
+                                                   : osmium::io::detail::open_for_writing(name, osmium::io::overwrite::allow);
+            m_bucket_created[index] = 1;
+            try {
+                osmium::io::detail::reliable_write(fd,
+                                                   reinterpret_cast<const char*>(bucket.data()),
+                                                   bucket.size() * sizeof(tile_bucket_entry));
+            } catch (...) {
+                try {
+                    osmium::io::detail::reliable_close(fd);
+                } catch (...) { // NOLINT(bugprone-empty-catch)
+                    // Ignore errors on close, report the write error.
+                }
+                throw;
+            }
+            osmium::io::detail::reliable_close(fd);
+            bucket.clear();
+        }
+
+    public:
+
+        enum {
+            default_bucket_zoom = 4,
+            default_max_entries_in_memory = 4096
+        };
+
+        /**
+         * Create a store.
+         *
+         * @param directory The directory where the bucket files are
+         *                  created.
+         * @param zoom The zoom level of the tiles in the store.
+         * @param bucket_zoom The zoom level of the buckets. There are
+         *                    4^bucket_zoom buckets. The default is 4 or
+         *                    the zoom level of the tiles if that is less.
+         * @param max_entries_in_memory Number of entries collected in
+         *                              memory for each bucket before they
+         *                              are written to disk.
+         * @throws std::invalid_argument If the zoom levels are invalid.
+         */
+        explicit TileBucketStore(std::string directory,
+                                 uint32_t zoom,
+                                 uint32_t bucket_zoom = default_bucket_zoom,
+                                 std::size_t max_entries_in_memory = default_max_entries_in_memory) :
+            m_directory(std::move(directory)),
+            m_zoom(zoom),
+            m_bucket_zoom(std::min(bucket_zoom, zoom)),
+            m_max_entries_in_memory(std::max(max_entries_in_memory, static_cast<std::size_t>(1))) {
+            if (zoom > osmium::geom::Tile::max_zoom) {
+                throw std::invalid_argument{"zoom level too large for TileBucketStore"};
+            }
+            if (m_bucket_zoom > 12) {
+                throw std::invalid_argument{"bucket zoom level too large for TileBucketStore"};
+            }
+            m_buckets.resize(num_buckets());
+            m_bucket_created.resize(num_buckets());
+        }
+
+        TileBucketStore(const TileBucketStore&) = delete;
+        TileBucketStore& operator=(const TileBucketStore&) = delete;
+
+        TileBucketStore(TileBucketStore&&) = default;
+        TileBucketStore& operator=(TileBucketStore&&) = default;
+
+        /**
+         * The destructor writes all entries still in memory to disk.
+         * Errors are ignored, call flush() explicitly to see them.
+         */
+        ~TileBucketStore() noexcept {
+            try {
+                flush();
+            } catch (...) { // NOLINT(bugprone-empty-catch)
+                // Ignore any exceptions because destructor must not throw.
+            }
+        }
+
+        /// The zoom level of the tiles in this store.
+        uint32_t zoom() const noexcept {
+            return m_zoom;
+        }
+
+        /// The zoom level of the buckets.
+        uint32_t bucket_zoom() const noexcept {
+            return m_bucket_zoom;
+        }
+
+        /// The number of buckets.
+        std::size_t num_buckets() const noexcept {
+            return static_cast<std::size_t>(osmium::geom::num_tiles_in_zoom(m_bucket_zoom)) *
+                   osmium::geom::num_tiles_in_zoom(m_bucket_zoom);
+        }
+
+        /// The number of entries added to this store.
+        std::size_t size() const noexcept {
+            return m_num_entries;
+        }
+
+        /// The index of the bucket a tile (in the zoom of the store) is in.
+        uint32_t bucket_index(uint32_t x, uint32_t y) const noexcept {
+            const uint32_t shift = m_zoom - m_bucket_zoom;
+            return ((y >> shift) << m_bucket_zoom) | (x >> shift);
+        }
+
+        /// The tile (in the bucket zoom) for the bucket with the index.
+        osmium::geom::Tile bucket_tile(uint32_t index) const noexcept {
+            const uint32_t mask = osmium::geom::num_tiles_in_zoom(m_bucket_zoom) - 1;
+            return osmium::geom::Tile{m_bucket_zoom, index & mask, index >> m_bucket_zoom};
+        }
+
+        /// The name of the file for the bucket with the index.
+        std::string filename(uint32_t index) const {
+            const auto tile = bucket_tile(index);
+            return m_directory + "/" + std::to_string(tile.z) + "-" +
+                   std::to_string(tile.x) + "-" + std::to_string(tile.y) + ".tiles";
+        }
+
+        /**
+         * Add an entry.
+         *
+         * @pre The entry must be for a tile in the zoom level of the store.
+         * @throws std::system_error If writing to disk failed.
+         */
+        void add(const tile_bucket_entry& entry) {
+            const auto index = bucket_index(entry.x, entry.y);
+            m_buckets[index].push_back(entry);
+            ++m_num_entries;
+            if (m_buckets[index].size() >= m_max_entries_in_memory) {
+                flush_bucket(index);
+            }
+        }
+
+        /**
+         * Add an entry for the object with the given type and id in the
+         * tile.
+         *
+         * @pre The tile must be in the zoom level of the store.
+         * @throws std::system_error If writing to disk failed.
+         */
+        void add(const osmium::geom::Tile& tile, osmium::item_type type, osmium::object_id_type id) {
+            add(tile_bucket_entry{tile, type, id});
+        }
+
+        /**
+         * Write all entries still in memory to disk.
+         *
+         * @throws std::system_error If writing to disk failed.
+         */
+        void flush() {
+            for (std::size_t i = 0; i < m_buckets.size(); ++i) {
+                flush_bucket(i);
+            }
+        }
+
+        /**
+         * Read all entries from the bucket with the given index. Call
+         * flush() first, entries still in memory are not returned.
+         *
+         * @param index The index of the bucket.
+         * @param sort Sort the entries by tile.
+         * @returns The entries. Empty if no entries were written to the
+         *          bucket by this store. Files left over in the directory
+         *          from earlier runs are ignored.
+         * @throws osmium::io_error If the file is corrupted.
+         * @throws std::system_error If reading failed.
+         */
+        std::vector<tile_bucket_entry> read_bucket(uint32_t index, bool sort = true) const {
+            std::vector<tile_bucket_entry> entries;
+
+            if (!m_bucket_created[index]) {
+                return entries;
+            }
+
+            const std::string name = filename(index);
+            const int fd = osmium::io::detail::open_for_reading(name);
+
+            const std::size_t size = osmium::file_size(fd);
+            if (size % sizeof(tile_bucket_entry) != 0) {
+                osmium::io::detail::reliable_close(fd);
+                throw osmium::io_error{std::string("Tile bucket file '") + name + "' has invalid size"};
+            }
+
+            entries.resize(size / sizeof(tile_bucket_entry));
+            auto* data = reinterpret_cast<char*>(entries.data());
+            std::size_t offset = 0;
+            constexpr const std::size_t max_read = 100UL * 1024UL * 1024UL;
+            while (offset < size) {
+                const auto count = static_cast<unsigned int>(std::min(size - offset, max_read));
+                if (!osmium::io::detail::read_exactly(fd, data + offset, count)) {
+                    osmium::io::detail::reliable_close(fd);
+                    throw osmium::io_error{std::string("Short read from tile bucket file '") + name + "'"};
+                }
+                offset += count;
+            }
+            osmium::io::detail::reliable_close(fd);
+
+            if (sort) {
+                std::sort(entries.begin(), entries.end());
+            }
+
+            return entries;
+        }
+
+    }; // class TileBucketStore
+
+} // namespace osmium
+
+#endif // OSMIUM_STORAGE_TILE_BUCKET_STORE_HPP
@@ -0,0 +1,360 @@
+#ifndef OSMIUM_TAGS_COMPILED_TAGS_FILTER_HPP
+#define OSMIUM_TAGS_COMPILED_TAGS_FILTER_HPP
+
+/*
+
+This file is part of Osmium (https://osmcode.org/libosmium).
+
+Copyright 2013-2026 Jochen Topf <jochen@topf.org> and others (see README).
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include <osmium/memory/collection.hpp>
+#include <osmium/osm/tag.hpp>
+#include <osmium/tags/matcher.hpp>
+#include <osmium/tags/tags_filter.hpp>
+#include <osmium/util/string_matcher.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace osmium {
+
+    namespace detail {
+
+        /**
+         * Immutable hash table mapping strings to integer values. Lookups
+         * are done with C strings and don't allocate. Used in the
+         * CompiledTagsFilter.
+         */
+        class string_lookup_table {
+
+            struct slot {
+                uint32_t hash = 0;
+                uint32_t offset = 0;
+                uint32_t length = 0;
+                uint32_t value = std::numeric_limits<uint32_t>::max(); // not_found marks empty slot
+            };
+
+            std::string m_data;
+            std::vector<slot> m_slots;
+            std::size_t m_size = 0;
+
+            // FNV-1a hash, also calculates the length of the string.
+            static uint32_t hash(const char* str, std::size_t& length) noexcept {
+                uint32_t h = 2166136261U;
+                const char* p = str;
+                for (; *p != '\0'; ++p) {
+                    h ^= static_cast<unsigned char>(*p);
+                    h *= 16777619U;
+                }
+                length = static_cast<std::size_t>(p - str);
+                return h;
+            }
+
+        public:
+
+            enum : uint32_t {
+                not_found = std::numeric_limits<uint32_t>::max()
+            };
+
+            string_lookup_table() = default;
+
+            /**
+             * Create table from a map of strings to values. The values
+             * must not be equal to not_found.
+             */
+            explicit string_lookup_table(const std::map<std::string, uint32_t>& entries) :
+                m_size(entries.size()) {
+                if (entries.empty()) {
+                    return;
+                }
+
+                std::size_t num_slots = 4;
+                while (num_slots < entries.size() * 2) {
+                    num_slots *= 2;
+                }
+                m_slots.resize(num_slots);
+
+                for (const auto& entry : entries) {
+                    std::size_t length = 0;
+                    const uint32_t h = hash(entry.first.c_str(), length);
+                    std::size_t n = h & (num_slots - 1);
+                    while (m_slots[n].value != not_found) {
+                        n = (n + 1) & (num_slots - 1);
+                    }
+                    m_slots[n].hash = h;
+                    m_slots[n].offset = static_cast<uint32_t>(m_data.size());
+                    m_slots[n].length = static_cast<uint32_t>(length);
+                    m_slots[n].value = entry.second;
+                    m_data.append(entry.first);
+                }
+            }
+
+            std::size_t size() const noexcept {
+                return m_size;
+            }
+
+            bool empty() const noexcept {
+                return m_size == 0;
+            }
+
+            /**
+             * Find the value for the string.
+             *
+             * @returns The value or not_found.
+             */
+            uint32_t find(const char* str) const noexcept {
+                if (m_slots.empty()) {
+                    return not_found;
+                }
+
+                std::size_t length = 0;
+                const uint32_t h = hash(str, length);
+                const std::size_t mask = m_slots.size() - 1;
+                for (std::size_t n = h & mask; m_slots[n].value != not_found; n = (n + 1) & mask) {
+                    const auto& s = m_slots[n];
+                    if (s.hash == h && s.length == length &&
+                        !std::memcmp(m_data.data() + s.offset, str, length)) {
+                        return s.value;
+                    }
+                }
+
+                return not_found;
+            }
+
+        }; // class string_lookup_table
+
+    } // namespace detail
+
+    /**
+     * A compiled version of a TagsFilterBase. It gives the same results
+     * as the filter it was created from, but instead of checking all
+     * rules one after the other, it looks up the rules for the key of a
+     * tag in a hash table. Rules matching keys and values against fixed
+     * strings (or lists of them) are found with a lookup of the key and
+     * one of the value. Only rules with other matchers (prefix, substring,
+     * regex, inverted values, ...) are still checked one by one, and only
+     * those that come before the first rule found through the lookups.
+     *
+     * Creating the compiled filter takes some time, so this is useful for
+     * filters with many rules that are used on lots of tags. The compiled
+     * filter copies the rules, later changes to the original filter are
+     * not reflected in it.
+     *
+     * @code
+     * osmium::TagsFilter filter{false};
+     * filter.add_rule(false, osmium::TagMatcher{"highway", "motorway"});
+     * filter.add_rule(true, osmium::TagMatcher{"highway"});
+     * ...
+     * const osmium::CompiledTagsFilter compiled{filter};
+     * bool result = compiled(tag);
+     * @endcode
+     */
+    template <typename TResult>
+    class CompiledTagsFilterBase {
+
+        using rule_index = uint32_t;
+
+        // Rules for one key.
+        struct key_rules {
+
+            // Map from value to the first rule matching this key and value
+            // with fixed strings.
+            detail::string_lookup_table exact_values;
+
+            // Other rules with this key, in order.
+            std::vector<rule_index> other;
+
+        }; // struct key_rules
+
+        std::vector<std::pair<TResult, TagMatcher>> m_rules;
+        detail::string_lookup_table m_keys;
+        std::vector<key_rules> m_key_rules;
+
+        // Rules that can't be looked up by key, in order.
+        std::vector<rule_index> m_generic_rules;
+
+        TResult m_default_result;
+
+        // Get the fixed strings a StringMatcher matches. Returns false if
+        // the matcher can't be expressed this way.
+        static bool fixed_strings(const osmium::StringMatcher& matcher, std::vector<std::string>& strings) {
+            strings.clear();
+            if (const auto* m = matcher.get_if<osmium::StringMatcher::equal>()) {
+                strings.push_back(m->str());
+                return true;
+            }
+            if (const auto* m = matcher.get_if<osmium::StringMatcher::list>()) {
+                strings = m->strings();
+                return true;
+            }
+            return matcher.get_if<osmium::StringMatcher::always_false>() != nullptr;
+        }
+
+        // Does the matcher never match any tag?
+        static bool never_matches(const TagMatcher& matcher) noexcept {
+            const auto& key = matcher.key_matcher();
+            const auto& value = matcher.value_matcher();
+            return key.get_if<osmium::StringMatcher::always_false>() ||
+                   (!matcher.value_inverted() && value.get_if<osmium::StringMatcher::always_false>()) ||
+                   (matcher.value_inverted() && value.get_if<osmium::StringMatcher::always_true>());
+        }
+
+        void compile() {
+            std::map<std::string, std::pair<std::map<std::string, uint32_t>, std::vector<rule_index>>> keys;
+            std::vector<std::string> key_strings;
+            std::vector<std::string> value_strings;
+
+            for (rule_index i = 0; i < m_rules.size(); ++i) {
+                const auto& matcher = m_rules[i].second;
+                if (never_matches(matcher)) {
+                    continue;
+                }
+                if (!fixed_strings(matcher.key_matcher(), key_strings)) {
+                    m_generic_rules.push_back(i);
+                    continue;
+                }
+                const bool exact = !matcher.value_inverted() &&
+                                   fixed_strings(matcher.value_matcher(), value_strings);
+                for (const auto& key : key_strings) {
+                    auto& entry = keys[key];
+                    if (exact) {
+                        for (const auto& value : value_strings) {
+                            // Doesn't overwrite existing entries, so
+                            // the first rule wins.
+                            entry.first.emplace(value, i);
+                        }
+                    } else if (entry.second.empty() || entry.second.back() != i) {
+                        entry.second.push_back(i);
+                    }
+                }
+            }
+
+            std::map<std::string, uint32_t> key_index;
+            for (auto& key : keys) {
+                key_index.emplace(key.first, static_cast<uint32_t>(m_key_rules.size()));
+                m_key_rules.push_back(key_rules{detail::string_lookup_table{key.second.first},
+                                                std::move(key.second.second)});
+            }
+            m_keys = detail::string_lookup_table{key_index};
+        }
+
+    public:
+
+        using iterator = osmium::memory::CollectionFilterIterator<CompiledTagsFilterBase, const osmium::Tag>;
+
+        /**
+         * Compile the filter.
+         *
+         * @param filter The filter with the rules and default result.
+         */
+        explicit CompiledTagsFilterBase(const TagsFilterBase<TResult>& filter) :
+            m_rules(filter.rules()),
+            m_default_result(filter.default_result()) {
+            compile();
+        }
+
+        /**
+         * Matching function. Check the specified key and value against
+         * the rules.
+         *
+         * @returns The result of the first matching rule, or, if none of
+         *          the rules matched, the default result.
+         */
+        TResult operator()(const char* key, const char* value) const noexcept {
+            rule_index best = detail::string_lookup_table::not_found;
+
+            const uint32_t k = m_keys.find(key);
+            if (k != detail::string_lookup_table::not_found) {
+                const auto& rules = m_key_rules[k];
+                best = rules.exact_values.find(value);
+                for (const auto i : rules.other) {
+                    if (i >= best) {
+                        break;
+                    }
+                    if (m_rules[i].second(key, value)) {
+                        best = i;
+                        break;
+                    }
+                }
+            }
+
+            for (const auto i : m_generic_rules) {
+                if (i >= best) {
+                    break;
+                }
+                if (m_rules[i].second(key, value)) {
+                    best = i;
+                    break;
+                }
+            }
+
+            return best == detail::string_lookup_table::not_found ? m_default_result : m_rules[best].first;
+        }
+
+        /**
+         * Matching function. Check the specified tag against the rules.
+         *
+         * @returns The result of the first matching rule, or, if none of
+         *          the rules matched, the default result.
+         */
+        TResult operator()(const osmium::Tag& tag) const noexcept {
+            return operator()(tag.key(), tag.value());
+        }
+
+        /**
+         * Return the number of rules in this filter.
+         *
+         * Complexity: Constant.
+         */
+        std::size_t count() const noexcept {
+            return m_rules.size();
+        }
+
+        /**
+         * Is this filter empty, ie are there no rules defined?
+         *
+         * Complexity: Constant.
+         */
+        bool empty() const noexcept {
+            return m_rules.empty();
+        }
+
+    }; // class CompiledTagsFilterBase
+
+    using CompiledTagsFilter = CompiledTagsFilterBase<bool>;
+
+} // namespace osmium
+
+#endif // OSMIUM_TAGS_COMPILED_TAGS_FILTER_HPP
@@ -66,6 +66,21 @@ namespace osmium {
             return m_has_value_matcher;
         }
 
+        /// The StringMatcher used for the key.
+        const osmium::StringMatcher& key_matcher() const noexcept {
+            return m_key_matcher;
+        }
+
+        /// The StringMatcher used for the value.
+        const osmium::StringMatcher& value_matcher() const noexcept {
+            return m_value_matcher;
+        }
+
+        /// Is the result of the value matcher inverted?
+        bool value_inverted() const noexcept {
+            return !m_result;
+        }
+
         /**
          * Create a TagMatcher matching the key against the specified
          * StringMatcher.
@@ -82,6 +82,14 @@ namespace osmium {
             m_default_result(default_result) {
         }
 
+        /**
+         * The default result, the result the matching function will
+         * return if none of the rules matched.
+         */
+        TResult default_result() const noexcept {
+            return m_default_result;
+        }
+
         /**
          * Set the default result, the result the matching function will
          * return if none of the rules matched.
@@ -132,6 +140,13 @@ namespace osmium {
             return m_default_result;
         }
 
+        /**
+         * Access the rules in this filter in the order they were added.
+         */
+        const std::vector<std::pair<TResult, TagMatcher>>& rules() const noexcept {
+            return m_rules;
+        }
+
         /**
          * Return the number of rules in this filter.
          *
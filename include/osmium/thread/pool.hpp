@@ -37,9 +37,11 @@ DEALINGS IN THE SOFTWARE.
 #include <osmium/thread/queue.hpp>
 #include <osmium/thread/util.hpp>
 #include <osmium/util/config.hpp>
+#include <osmium/util/metrics.hpp>
 
 #include <cstddef>
 #include <future>
+#include <memory>
 #include <thread>
 #include <type_traits>
 #include <utility>
@@ -120,6 +122,14 @@ namespace osmium {
             }; // class thread_joiner
 
             osmium::thread::Queue<function_wrapper> m_work_queue;
+
+            // Metrics (if enabled). They must be declared before the
+            // threads, so that they are still alive when the threads
+            // are joined.
+            std::shared_ptr<osmium::metrics::Counter> m_tasks;
+            std::shared_ptr<osmium::metrics::Counter> m_busy_time;
+            std::shared_ptr<osmium::metrics::Histogram> m_task_time;
+
             std::vector<std::thread> m_threads;
             thread_joiner m_joiner;
             int m_num_threads;
@@ -129,7 +139,19 @@ namespace osmium {
                 while (true) {
                     function_wrapper task;
                     m_work_queue.wait_and_pop(task);
-                    if (task && task()) {
+                    if (!task) {
+                        continue;
+                    }
+                    if (m_tasks) {
+                        const auto start = osmium::metrics::clock_type::now();
+                        if (task()) {
+                            return;
+                        }
+                        const auto time = osmium::metrics::microseconds_since(start);
+                        m_tasks->add();
+                        m_busy_time->add(time);
+                        m_task_time->record(time);
+                    } else if (task()) {
                         // The called tasks returns true only when the
                         // worker thread should shut down.
                         return;
@@ -161,12 +183,27 @@ namespace osmium {
              *
              * If max_queue_size is 0, the queue size is read from
              * the environment variable OSMIUM_MAX_WORK_QUEUE_SIZE.
+             *
+             * If a metrics registry is given, the pool collects the
+             * number of tasks run ("pool.tasks"), the time spent in tasks
+             * ("pool.busy_us", "pool.task_us"), and the number of threads
+             * ("pool.threads") in it. The utilization of the pool is the
+             * busy time divided by the number of threads and the wall
+             * clock time. Metrics for the work queue are collected under
+             * "queue.work.*".
              */
-            explicit Pool(int num_threads = default_num_threads, std::size_t max_queue_size = default_queue_size) :
-                m_work_queue(max_queue_size > 0 ? max_queue_size : detail::get_work_queue_size(), "work"),
+            explicit Pool(int num_threads = default_num_threads, std::size_t max_queue_size = default_queue_size, osmium::metrics::Registry* metrics = nullptr) :
+                m_work_queue(max_queue_size > 0 ? max_queue_size : detail::get_work_queue_size(), "work", metrics),
                 m_joiner(m_threads),
                 m_num_threads(detail::get_pool_size(num_threads, osmium::config::get_pool_threads(), std::thread::hardware_concurrency())) {
 
+                if (metrics) {
+                    m_tasks = metrics->shared_counter("pool.tasks");
+                    m_busy_time = metrics->shared_counter("pool.busy_us");
+                    m_task_time = metrics->shared_histogram("pool.task_us");
+                    metrics->counter("pool.threads").add(static_cast<uint64_t>(m_num_threads));
+                }
+
                 try {
                     for (int i = 0; i < m_num_threads; ++i) {
                         m_threads.emplace_back(&Pool::worker_thread, this);
@@ -33,10 +33,13 @@ DEALINGS IN THE SOFTWARE.
 
 */
 
+#include <osmium/util/metrics.hpp>
+
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <cstddef>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <string>
@@ -50,6 +53,43 @@ namespace osmium {
 
     namespace thread {
 
+        namespace detail {
+
+            /**
+             * The metrics collected for a queue with the specified name:
+             * The number of push and pop calls, how often the queue was
+             * full on push or empty on pop, how long those calls had to
+             * wait (in microseconds), and the queue size after each push.
+             * A try_pop() only counts as a pop if it got a value, failed
+             * attempts are counted separately in empty_polls, so that
+             * polling doesn't distort the other numbers.
+             */
+            struct queue_metrics {
+
+                std::shared_ptr<osmium::metrics::Counter> pushes;
+                std::shared_ptr<osmium::metrics::Counter> pops;
+                std::shared_ptr<osmium::metrics::Counter> full;
+                std::shared_ptr<osmium::metrics::Counter> empty;
+                std::shared_ptr<osmium::metrics::Counter> empty_polls;
+                std::shared_ptr<osmium::metrics::Histogram> push_wait;
+                std::shared_ptr<osmium::metrics::Histogram> pop_wait;
+                std::shared_ptr<osmium::metrics::Histogram> size;
+
+                queue_metrics(osmium::metrics::Registry& registry, const std::string& name) :
+                    pushes(registry.shared_counter("queue." + name + ".pushes")),
+                    pops(registry.shared_counter("queue." + name + ".pops")),
+                    full(registry.shared_counter("queue." + name + ".full")),
+                    empty(registry.shared_counter("queue." + name + ".empty")),
+                    empty_polls(registry.shared_counter("queue." + name + ".empty_polls")),
+                    push_wait(registry.shared_histogram("queue." + name + ".push_wait_us")),
+                    pop_wait(registry.shared_histogram("queue." + name + ".pop_wait_us")),
+                    size(registry.shared_histogram("queue." + name + ".size")) {
+                }
+
+            }; // struct queue_metrics
+
+        } // namespace detail
+
         /**
          *  A thread-safe queue.
          */
@@ -75,6 +115,9 @@ namespace osmium {
 
             std::atomic<bool> m_in_use{true};
 
+            /// Metrics for this queue (if enabled).
+            std::unique_ptr<detail::queue_metrics> m_metrics;
+
 #ifdef OSMIUM_DEBUG_QUEUE_SIZE
             /// The largest size the queue has been so far.
             std::size_t m_largest_size;
@@ -97,6 +140,19 @@ namespace osmium {
             std::atomic<int> m_empty_counter;
 #endif
 
+            void wait_for_space() {
+                constexpr const std::chrono::milliseconds max_wait{10};
+                while (size() >= m_max_size) {
+                    std::unique_lock<std::mutex> lock{m_mutex};
+                    m_space_available.wait_for(lock, max_wait, [this] {
+                        return m_queue.size() < m_max_size;
+                    });
+#ifdef OSMIUM_DEBUG_QUEUE_SIZE
+                    ++m_full_counter;
+#endif
+                }
+            }
+
         public:
 
             /**
@@ -104,12 +160,17 @@ namespace osmium {
              *
              * @param max_size Maximum number of elements in the queue. Set to
              *                 0 for an unlimited size.
-             * @param name Optional name for this queue. (Used for debugging.)
+             * @param name Optional name for this queue. (Used for debugging
+             *             and as part of the metrics names.)
+             * @param metrics Optional registry. If set, metrics for this
+             *                queue are collected under the names
+             *                "queue.NAME.*".
              */
-            explicit Queue(std::size_t max_size = 0, std::string name = "") :
+            explicit Queue(std::size_t max_size = 0, std::string name = "", osmium::metrics::Registry* metrics = nullptr) :
                 m_max_size(max_size),
                 m_name(std::move(name)),
-                m_queue()
+                m_queue(),
+                m_metrics(metrics ? std::make_unique<detail::queue_metrics>(*metrics, m_name) : nullptr)
 #ifdef OSMIUM_DEBUG_QUEUE_SIZE
                 ,
                 m_largest_size(0),
@@ -150,19 +211,20 @@ namespace osmium {
                 if (!m_in_use) {
                     return;
                 }
-                constexpr const std::chrono::milliseconds max_wait{10};
 #ifdef OSMIUM_DEBUG_QUEUE_SIZE
                 ++m_push_counter;
 #endif
+                if (m_metrics) {
+                    m_metrics->pushes->add();
+                }
                 if (m_max_size) {
-                    while (size() >= m_max_size) {
-                        std::unique_lock<std::mutex> lock{m_mutex};
-                        m_space_available.wait_for(lock, max_wait, [this] {
-                            return m_queue.size() < m_max_size;
-                        });
-#ifdef OSMIUM_DEBUG_QUEUE_SIZE
-                        ++m_full_counter;
-#endif
+                    if (m_metrics && size() >= m_max_size) {
+                        m_metrics->full->add();
+                        const auto start = osmium::metrics::clock_type::now();
+                        wait_for_space();
+                        m_metrics->push_wait->record(osmium::metrics::microseconds_since(start));
+                    } else {
+                        wait_for_space();
                     }
                 }
                 const std::lock_guard<std::mutex> lock{m_mutex};
@@ -172,6 +234,9 @@ namespace osmium {
                     m_largest_size = m_queue.size();
                 }
 #endif
+                if (m_metrics) {
+                    m_metrics->size->record(m_queue.size());
+                }
                 m_data_available.notify_one();
             }
 
@@ -185,6 +250,17 @@ namespace osmium {
                     ++m_empty_counter;
                 }
 #endif
+                if (m_metrics) {
+                    m_metrics->pops->add();
+                    if (m_queue.empty() && m_in_use) {
+                        m_metrics->empty->add();
+                        const auto start = osmium::metrics::clock_type::now();
+                        m_data_available.wait(lock, [this] {
+                            return !m_in_use || !m_queue.empty();
+                        });
+                        m_metrics->pop_wait->record(osmium::metrics::microseconds_since(start));
+                    }
+                }
                 m_data_available.wait(lock, [this] {
                     return !m_in_use || !m_queue.empty();
                 });
@@ -208,8 +284,14 @@ namespace osmium {
 #ifdef OSMIUM_DEBUG_QUEUE_SIZE
                         ++m_empty_counter;
 #endif
+                        if (m_metrics) {
+                            m_metrics->empty_polls->add();
+                        }
                         return false;
                     }
+                    if (m_metrics) {
+                        m_metrics->pops->add();
+                    }
                     value = std::move(m_queue.front());
                     m_queue.pop();
                 }
@@ -103,6 +103,24 @@ namespace osmium {
             return value;
         }
 
+        /**
+         * The number of threads used for reading uncompressed input files
+         * with several reads in flight at the same time. This can help
+         * to saturate fast disks. Set with the OSMIUM_READ_AHEAD_THREADS
+         * environment variable. Returns 0 (read ahead disabled) if not
+         * set or set to an invalid value.
+         */
+        inline int get_read_ahead_threads() noexcept {
+            const char* env = osmium::detail::getenv_wrapper("OSMIUM_READ_AHEAD_THREADS");
+            if (env) {
+                const auto threads = osmium::detail::str_to_int<int>(env);
+                if (threads > 0 && threads <= 64) {
+                    return threads;
+                }
+            }
+            return 0;
+        }
+
         inline int8_t clean_page_cache_after_read() noexcept {
             const char* env = osmium::detail::getenv_wrapper("OSMIUM_CLEAN_PAGE_CACHE_AFTER_READ");
             if (env) {
@@ -0,0 +1,756 @@
+#ifndef OSMIUM_UTIL_DFA_REGEX_HPP
+#define OSMIUM_UTIL_DFA_REGEX_HPP
+
+/*
+
+This file is part of Osmium (https://osmcode.org/libosmium).
+
+Copyright 2013-2026 Jochen Topf <jochen@topf.org> and others (see README).
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include <osmium/util/compatibility.hpp>
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace osmium {
+
+    /**
+     * Exception thrown by the DFARegex constructor when the pattern uses
+     * features not supported by the DFA regex engine.
+     */
+    struct OSMIUM_EXPORT unsupported_regex_error : public std::runtime_error {
+
+        explicit unsupported_regex_error(const std::string& what) :
+            std::runtime_error(what) {
+        }
+
+        explicit unsupported_regex_error(const char* what) :
+            std::runtime_error(what) {
+        }
+
+    }; // struct unsupported_regex_error
+
+    namespace detail {
+
+        /**
+         * Parser for the subset of the ECMAScript regular expression
+         * syntax supported by DFARegex. Creates a Thompson NFA.
+         */
+        class regex_nfa_builder {
+
+        public:
+
+            enum class node_type : uint8_t {
+                match,
+                chars,
+                split,
+                assert_begin,
+                assert_end
+            };
+
+            struct node {
+                node_type type;
+                std::bitset<256> chars;
+                int out1 = -1;
+                int out2 = -1;
+
+                explicit node(node_type t) noexcept :
+                    type(t) {
+                }
+            };
+
+            enum {
+                max_nodes = 10000,
+                max_repeat = 1000
+            };
+
+        private:
+
+            enum class ast_type : uint8_t {
+                empty,
+                chars,
+                concat,
+                alternative,
+                repeat,
+                assert_begin,
+                assert_end
+            };
+
+            struct ast {
+                ast_type type;
+                std::bitset<256> chars;
+                std::vector<std::unique_ptr<ast>> children;
+                int min = 0;
+                int max = 0; // -1 = unbounded
+
+                explicit ast(ast_type t) :
+                    type(t) {
+                }
+            };
+
+            const std::string& m_pattern;
+            std::size_t m_pos = 0;
+            std::vector<node> m_nodes;
+
+            [[noreturn]] static void unsupported(const char* what) {
+                throw osmium::unsupported_regex_error{what};
+            }
+
+            bool at_end() const noexcept {
+                return m_pos >= m_pattern.size();
+            }
+
+            char peek() const noexcept {
+                return m_pattern[m_pos];
+            }
+
+            char next() {
+                if (at_end()) {
+                    unsupported("unexpected end of pattern");
+                }
+                return m_pattern[m_pos++];
+            }
+
+            static void add_range(std::bitset<256>& set, int from, int to) {
+                for (int c = from; c <= to; ++c) {
+                    set.set(static_cast<std::size_t>(c));
+                }
+            }
+
+            static int hex_value(char c) {
+                if (c >= '0' && c <= '9') {
+                    return c - '0';
+                }
+                if (c >= 'a' && c <= 'f') {
+                    return c - 'a' + 10;
+                }
+                if (c >= 'A' && c <= 'F') {
+                    return c - 'A' + 10;
+                }
+                unsupported("invalid hex escape");
+            }
+
+            // Parse the escape sequence after a backslash. Returns true if
+            // it is a class escape (\d, \w, ...), false if it is a single
+            // character, which is then the only one set.
+            bool parse_escape(std::bitset<256>& set, bool in_class) {
+                const char c = next();
+                switch (c) {
+                    case 'd':
+                    case 'D':
+                        add_range(set, '0', '9');
+                        break;
+                    case 'w':
+                    case 'W':
+                        add_range(set, '0', '9');
+                        add_range(set, 'a', 'z');
+                        add_range(set, 'A', 'Z');
+                        set.set('_');
+                        break;
+                    case 's':
+                    case 'S':
+                        add_range(set, '\t', '\r');
+                        set.set(' ');
+                        break;
+                    case 't':
+                        set.set('\t');
+                        return false;
+                    case 'n':
+                        set.set('\n');
+                        return false;
+                    case 'r':
+                        set.set('\r');
+                        return false;
+                    case 'f':
+                        set.set('\f');
+                        return false;
+                    case 'v':
+                        set.set('\v');
+                        return false;
+                    case 'b':
+                        if (!in_class) {
+                            unsupported("word boundaries are not supported");
+                        }
+                        set.set('\b');
+                        return false;
+                    case 'x': {
+                        const int high = hex_value(next());
+                        const int low = hex_value(next());
+                        set.set(static_cast<std::size_t>(high * 16 + low));
+                        return false;
+                    }
+                    default:
+                        if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) {
+                            unsupported("unsupported escape sequence");
+                        }
+                        set.set(static_cast<unsigned char>(c));
+                        return false;
+                }
+                if (c >= 'A' && c <= 'Z') {
+                    set.flip();
+                }
+                return true;
+            }
+
+            std::unique_ptr<ast> parse_class() {
+                std::unique_ptr<ast> result{new ast{ast_type::chars}};
+                bool negate = false;
+                if (!at_end() && peek() == '^') {
+                    negate = true;
+                    ++m_pos;
+                }
+                if (!at_end() && peek() == ']') {
+                    unsupported("empty character class");
+                }
+                while (true) {
+                    char c = next();
+                    if (c == ']') {
+                        break;
+                    }
+                    std::bitset<256> first;
+                    if (c == '[' && !at_end() && (peek() == ':' || peek() == '=' || peek() == '.')) {
+                        unsupported("character class names are not supported");
+                    }
+                    if (c == '\\') {
+                        if (parse_escape(first, true)) {
+                            if (!at_end() && peek() == '-' && m_pos + 1 < m_pattern.size() && m_pattern[m_pos + 1] != ']') {
+                                unsupported("range with class escape");
+                            }
+                            result->chars |= first;
+                            continue;
+                        }
+                    } else {
+                        first.set(static_cast<unsigned char>(c));
+                    }
+                    if (!at_end() && peek() == '-' && m_pos + 1 < m_pattern.size() && m_pattern[m_pos + 1] != ']') {
+                        ++m_pos;
+                        std::bitset<256> last;
+                        c = next();
+                        if (c == '\\') {
+                            if (parse_escape(last, true)) {
+                                unsupported("range with class escape");
+                            }
+                        } else {
+                            last.set(static_cast<unsigned char>(c));
+                        }
+                        int from = 0;
+                        while (!first.test(static_cast<std::size_t>(from))) {
+                            ++from;
+                        }
+                        int to = 0;
+                        while (!last.test(static_cast<std::size_t>(to))) {
+                            ++to;
+                        }
+                        if (from > to) {
+                            unsupported("invalid range");
+                        }
+                        add_range(result->chars, from, to);
+                    } else {
+                        result->chars |= first;
+                    }
+                }
+                if (negate) {
+                    result->chars.flip();
+                }
+                return result;
+            }
+
+            std::unique_ptr<ast> parse_atom() {
+                const char c = next();
+                switch (c) {
+                    case '(': {
+                        if (!at_end() && peek() == '?') {
+                            ++m_pos;
+                            if (next() != ':') {
+                                unsupported("assertions are not supported");
+                            }
+                        }
+                        auto result = parse_alternative();
+                        if (next() != ')') {
+                            unsupported("missing closing parenthesis");
+                        }
+                        return result;
+                    }
+                    case '[':
+                        return parse_class();
+                    case '.': {
+                        std::unique_ptr<ast> result{new ast{ast_type::chars}};
+                        result->chars.set();
+                        result->chars.reset('\n');
+                        result->chars.reset('\r');
+                        return result;
+                    }
+                    case '^':
+                        return std::unique_ptr<ast>{new ast{ast_type::assert_begin}};
+                    case '$':
+                        return std::unique_ptr<ast>{new ast{ast_type::assert_end}};
+                    case '\\': {
+                        std::unique_ptr<ast> result{new ast{ast_type::chars}};
+                        parse_escape(result->chars, false);
+                        return result;
+                    }
+                    case '*':
+                    case '+':
+                    case '?':
+                    case '{':
+                    case '}':
+                    case ']':
+                    case ')':
+                    case '|':
+                        unsupported("unexpected special character");
+                    default:
+                        break;
+                }
+                std::unique_ptr<ast> result{new ast{ast_type::chars}};
+                result->chars.set(static_cast<unsigned char>(c));
+                return result;
+            }
+
+            int parse_number() {
+                if (at_end() || peek() < '0' || peek() > '9') {
+                    unsupported("number expected");
+                }
+                int value = 0;
+                while (!at_end() && peek() >= '0' && peek() <= '9') {
+                    value = value * 10 + (next() - '0');
+                    if (value > max_repeat) {
+                        unsupported("repetition count too large");
+                    }
+                }
+                return value;
+            }
+
+            std::unique_ptr<ast> parse_repeat() {
+                auto atom = parse_atom();
+                while (!at_end()) {
+                    int min = 0;
+                    int max = -1;
+                    switch (peek()) {
+                        case '*':
+                            ++m_pos;
+                            break;
+                        case '+':
+                            ++m_pos;
+                            min = 1;
+                            break;
+                        case '?':
+                            ++m_pos;
+                            max = 1;
+                            break;
+                        case '{':
+                            ++m_pos;
+                            min = parse_number();
+                            max = min;
+                            if (!at_end() && peek() == ',') {
+                                ++m_pos;
+                                max = (!at_end() && peek() == '}') ? -1 : parse_number();
+                            }
+                            if (next() != '}' || (max != -1 && max < min)) {
+                                unsupported("invalid repetition");
+                            }
+                            break;
+                        default:
+                            return atom;
+                    }
+                    if (!at_end() && peek() == '?') { // non-greedy, same for search
+                        ++m_pos;
+                    }
+                    if (atom->type == ast_type::assert_begin || atom->type == ast_type::assert_end) {
+                        unsupported("repetition of assertion");
+                    }
+                    std::unique_ptr<ast> repeat{new ast{ast_type::repeat}};
+                    repeat->min = min;
+                    repeat->max = max;
+                    repeat->children.push_back(std::move(atom));
+                    atom = std::move(repeat);
+                }
+                return atom;
+            }
+
+            std::unique_ptr<ast> parse_concat() {
+                std::unique_ptr<ast> result{new ast{ast_type::concat}};
+                while (!at_end() && peek() != '|' && peek() != ')') {
+                    result->children.push_back(parse_repeat());
+                }
+                return result;
+            }
+
+            std::unique_ptr<ast> parse_alternative() {
+                std::unique_ptr<ast> result{new ast{ast_type::alternative}};
+                result->children.push_back(parse_concat());
+                while (!at_end() && peek() == '|') {
+                    ++m_pos;
+                    result->children.push_back(parse_concat());
+                }
+                return result;
+            }
+
+            int add_node(node_type type, int out1 = -1, int out2 = -1) {
+                if (m_nodes.size() >= max_nodes) {
+                    unsupported("pattern too large");
+                }
+                m_nodes.emplace_back(type);
+                m_nodes.back().out1 = out1;
+                m_nodes.back().out2 = out2;
+                return static_cast<int>(m_nodes.size() - 1);
+            }
+
+            // Build NFA nodes for the AST continuing with node next.
+            // Returns the start node.
+            int build(const ast& a, int next) {
+                switch (a.type) {
+                    case ast_type::empty:
+                        return next;
+                    case ast_type::chars: {
+                        const int n = add_node(node_type::chars, next);
+                        m_nodes[static_cast<std::size_t>(n)].chars = a.chars;
+                        return n;
+                    }
+                    case ast_type::concat:
+                        for (auto it = a.children.rbegin(); it != a.children.rend(); ++it) {
+                            next = build(**it, next);
+                        }
+                        return next;
+                    case ast_type::alternative: {
+                        int start = build(*a.children.back(), next);
+                        for (auto it = std::next(a.children.rbegin()); it != a.children.rend(); ++it) {
+                            const int alt = build(**it, next);
+                            start = add_node(node_type::split, alt, start);
+                        }
+                        return start;
+                    }
+                    case ast_type::repeat: {
+                        const ast& child = *a.children.front();
+                        if (a.max == -1) {
+                            // Loop for unbounded repetition.
+                            const int loop = add_node(node_type::split, -1, next);
+                            const int body = build(child, loop);
+                            m_nodes[static_cast<std::size_t>(loop)].out1 = body;
+                            next = loop;
+                        } else {
+                            for (int i = a.min; i < a.max; ++i) {
+                                const int body = build(child, next);
+                                next = add_node(node_type::split, body, next);
+                            }
+                        }
+                        for (int i = 0; i < a.min; ++i) {
+                            next = build(child, next);
+                        }
+                        return next;
+                    }
+                    case ast_type::assert_begin:
+                        return add_node(node_type::assert_begin, next);
+                    case ast_type::assert_end:
+                        break;
+                }
+                return add_node(node_type::assert_end, next);
+            }
+
+        public:
+
+            explicit regex_nfa_builder(const std::string& pattern) :
+                m_pattern(pattern) {
+            }
+
+            /**
+             * Parse the pattern and build the NFA.
+             *
+             * @returns The start node. Node 0 is the match node.
+             * @throws unsupported_regex_error
+             */
+            int build() {
+                auto tree = parse_alternative();
+                if (!at_end()) {
+                    unsupported("unexpected closing parenthesis");
+                }
+                m_nodes.clear();
+                add_node(node_type::match);
+                return build(*tree, 0);
+            }
+
+            const std::vector<node>& nodes() const noexcept {
+                return m_nodes;
+            }
+
+        }; // class regex_nfa_builder
+
+    } // namespace detail
+
+    /**
+     * A regular expression engine based on a deterministic finite
+     * automaton. It supports a subset of the ECMAScript syntax used by
+     * std::regex (the default): literal characters, escapes, ".",
+     * character classes (without class names like [:alpha:]), "\d",
+     * "\w", "\s" and their negations, groups (capturing and
+     * non-capturing), alternatives, the repetitions "*", "+", "?", and
+     * "{n,m}" (greedy or non-greedy), and the anchors "^" and "$". Not
+     * supported are back references, assertions ("\b", lookahead), and
+     * any flags (like icase). The constructor throws an
+     * unsupported_regex_error if the pattern uses any of those.
+     *
+     * The only operation is search(), which gives the same result as
+     * std::regex_search() with default flags. The automaton is built
+     * completely in the constructor. Searching looks at each character
+     * of the input only once, doesn't allocate, and is thread-safe.
+     *
+     * Characters are bytes, as in std::regex on char strings.
+     */
+    class DFARegex {
+
+        using nfa_node_type = detail::regex_nfa_builder::node_type;
+        using state_type = uint32_t;
+
+        enum : uint8_t {
+            flag_match_now = 1,
+            flag_match_at_end = 2,
+            flag_dead = 4
+        };
+
+        // Map from byte to character class.
+        std::vector<uint8_t> m_classes;
+        std::size_t m_num_classes = 0;
+
+        // Transition table with m_num_classes entries per state.
+        std::vector<state_type> m_table;
+        std::vector<uint8_t> m_flags;
+
+        struct builder {
+
+            const std::vector<detail::regex_nfa_builder::node>& nodes;
+            std::vector<int> stack;
+            std::vector<char> visited;
+
+            explicit builder(const std::vector<detail::regex_nfa_builder::node>& n) :
+                nodes(n),
+                visited(n.size()) {
+            }
+
+            // Follow epsilon transitions from seeds. The result contains
+            // the match, chars, and assert_end nodes reached.
+            std::vector<int> closure(const std::vector<int>& seeds, bool at_begin) {
+                std::vector<int> result;
+                std::fill(visited.begin(), visited.end(), 0);
+                stack = seeds;
+                while (!stack.empty()) {
+                    const int n = stack.back();
+                    stack.pop_back();
+                    if (n < 0 || visited[static_cast<std::size_t>(n)]) {
+                        continue;
+                    }
+                    visited[static_cast<std::size_t>(n)] = 1;
+                    const auto& nd = nodes[static_cast<std::size_t>(n)];
+                    switch (nd.type) {
+                        case nfa_node_type::split:
+                            stack.push_back(nd.out2);
+                            stack.push_back(nd.out1);
+                            break;
+                        case nfa_node_type::assert_begin:
+                            if (at_begin) {
+                                stack.push_back(nd.out1);
+                            }
+                            break;
+                        default:
+                            result.push_back(n);
+                            break;
+                    }
+                }
+                std::sort(result.begin(), result.end());
+                return result;
+            }
+
+            // Can the match node be reached from the set at the end of
+            // the input, ie. following end assertions?
+            bool match_at_end(const std::vector<int>& set, bool at_begin) {
+                std::fill(visited.begin(), visited.end(), 0);
+                stack = set;
+                while (!stack.empty()) {
+                    const int n = stack.back();
+                    stack.pop_back();
+                    if (n < 0 || visited[static_cast<std::size_t>(n)]) {
+                        continue;
+                    }
+                    visited[static_cast<std::size_t>(n)] = 1;
+                    const auto& nd = nodes[static_cast<std::size_t>(n)];
+                    switch (nd.type) {
+                        case nfa_node_type::match:
+                            return true;
+                        case nfa_node_type::split:
+                            stack.push_back(nd.out2);
+                            stack.push_back(nd.out1);
+                            break;
+                        case nfa_node_type::assert_begin:
+                            if (at_begin) {
+                                stack.push_back(nd.out1);
+                            }
+                            break;
+                        case nfa_node_type::assert_end:
+                            stack.push_back(nd.out1);
+                            break;
+                        default:
+                            break;
+                    }
+                }
+                return false;
+            }
+
+        }; // struct builder
+
+        void compute_classes(const std::vector<detail::regex_nfa_builder::node>& nodes) {
+            std::vector<uint32_t> classes(256, 0);
+            uint32_t num_classes = 1;
+            for (const auto& node : nodes) {
+                if (node.type != nfa_node_type::chars) {
+                    continue;
+                }
+                std::map<std::pair<uint32_t, bool>, uint32_t> split;
+                for (std::size_t c = 0; c < 256; ++c) {
+                    const auto key = std::make_pair(classes[c], node.chars.test(c));
+                    const auto it = split.emplace(key, static_cast<uint32_t>(split.size())).first;
+                    classes[c] = it->second;
+                }
+                num_classes = static_cast<uint32_t>(split.size());
+            }
+            m_num_classes = num_classes;
+            m_classes.resize(256);
+            for (std::size_t c = 0; c < 256; ++c) {
+                m_classes[c] = static_cast<uint8_t>(classes[c]);
+            }
+        }
+
+    public:
+
+        enum {
+            max_states = 2000
+        };
+
+        /**
+         * Compile the pattern.
+         *
+         * @throws unsupported_regex_error If the pattern uses unsupported
+         *         features or is too complex.
+         */
+        explicit DFARegex(const std::string& pattern) {
+            detail::regex_nfa_builder nfa{pattern};
+            const int start = nfa.build();
+            const auto& nodes = nfa.nodes();
+
+            compute_classes(nodes);
+
+            // One representative byte for each character class.
+            std::vector<std::size_t> representatives(m_num_classes);
+            for (std::size_t c = 256; c > 0; --c) {
+                representatives[m_classes[c - 1]] = c - 1;
+            }
+
+            builder b{nodes};
+            const std::vector<int> unanchored = b.closure({start}, false);
+
+            std::map<std::vector<int>, state_type> state_ids;
+            std::vector<std::vector<int>> states;
+
+            // The initial state is special because begin assertions
+            // hold there, so it is not shared with other states.
+            states.push_back(b.closure({start}, true));
+
+            for (std::size_t s = 0; s < states.size(); ++s) {
+                const auto set = states[s];
+                uint8_t flags = 0;
+                if (std::find(set.begin(), set.end(), 0) != set.end()) {
+                    flags |= flag_match_now | flag_match_at_end;
+                } else if (b.match_at_end(set, s == 0)) {
+                    flags |= flag_match_at_end;
+                }
+                if (set.empty()) {
+                    flags |= flag_dead;
+                }
+                m_flags.push_back(flags);
+
+                for (std::size_t cls = 0; cls < m_num_classes; ++cls) {
+                    std::vector<int> seeds;
+                    for (const int n : set) {
+                        const auto& nd = nodes[static_cast<std::size_t>(n)];
+                        if (nd.type == nfa_node_type::chars && nd.chars.test(representatives[cls])) {
+                            seeds.push_back(nd.out1);
+                        }
+                    }
+                    auto next = b.closure(seeds, false);
+                    next.insert(next.end(), unanchored.begin(), unanchored.end());
+                    std::sort(next.begin(), next.end());
+                    next.erase(std::unique(next.begin(), next.end()), next.end());
+
+                    const auto it = state_ids.find(next);
+                    if (it != state_ids.end()) {
+                        m_table.push_back(it->second);
+                    } else {
+                        if (states.size() >= max_states) {
+                            throw unsupported_regex_error{"regex too complex"};
+                        }
+                        const auto id = static_cast<state_type>(states.size());
+                        state_ids.emplace(next, id);
+                        states.push_back(std::move(next));
+                        m_table.push_back(id);
+                    }
+                }
+            }
+        }
+
+        /// The number of states of the automaton.
+        std::size_t num_states() const noexcept {
+            return m_flags.size();
+        }
+
+        /**
+         * Is there a match for the regular expression anywhere in the
+         * string? Same as std::regex_search(str, regex).
+         */
+        bool search(const char* str) const noexcept {
+            state_type state = 0;
+            for (; *str != '\0'; ++str) {
+                const uint8_t flags = m_flags[state];
+                if (flags & (flag_match_now | flag_dead)) {
+                    return (flags & flag_match_now) != 0;
+                }
+                state = m_table[state * m_num_classes + m_classes[static_cast<unsigned char>(*str)]];
+            }
+            return (m_flags[state] & flag_match_at_end) != 0;
+        }
+
+    }; // class DFARegex
+
+} // namespace osmium
+
+#endif // OSMIUM_UTIL_DFA_REGEX_HPP
@@ -35,18 +35,103 @@ DEALINGS IN THE SOFTWARE.
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cstdint>
 #include <cstdio>
 #include <iterator>
 #include <string>
 
 namespace osmium {
 
+    namespace detail {
+
+        /**
+         * Fast path for double2string() which doesn't use snprintf().
+         * Writes the number to the end of the buffer and returns a
+         * pointer to the first character written or nullptr if the
+         * value can't be handled here (in which case nothing was
+         * written). The output is exactly the same as that of
+         * snprintf() with the "%.*f" format after removing the
+         * superfluous '0' characters.
+         */
+        inline char* double2string_fast(char* end, double value, int precision) noexcept {
+            enum {
+                max_fast_precision = 15
+            };
+
+            static const double powers_of_ten[max_fast_precision + 1] = {
+                1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+                1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15
+            };
+
+            if (precision < 0 || precision > max_fast_precision) {
+                return nullptr;
+            }
+
+            const double scaled = std::abs(value) * powers_of_ten[precision];
+
+            // Also catches NaN and infinite values.
+            if (!(scaled < 4503599627370496.0)) { // 2^52
+                return nullptr;
+            }
+
+            // Round to nearest integer, ties to even, like snprintf()
+            // does with the exact value. If the scaled value happens
+            // to be exactly halfway between two integers, it might
+            // have been rounded in the multiplication, in which case
+            // the rounding error decides the direction.
+            double rounded = std::nearbyint(scaled);
+            if (std::abs(rounded - scaled) == 0.5) {
+                const double error = std::fma(std::abs(value), powers_of_ten[precision], -scaled);
+                if (error > 0.0) {
+                    rounded = std::floor(scaled) + 1.0;
+                } else if (error < 0.0) {
+                    rounded = std::floor(scaled);
+                }
+            }
+
+            auto n = static_cast<uint64_t>(rounded);
+            char* p = end;
+
+            // fractional part without trailing zeros
+            int digits = precision;
+            while (digits > 0 && n % 10 == 0) {
+                n /= 10;
+                --digits;
+            }
+            if (digits > 0) {
+                for (; digits > 0; --digits) {
+                    *--p = static_cast<char>('0' + n % 10);
+                    n /= 10;
+                }
+                *--p = '.';
+            }
+
+            // integer part
+            do {
+                *--p = static_cast<char>('0' + n % 10);
+                n /= 10;
+            } while (n > 0);
+
+            if (std::signbit(value)) {
+                *--p = '-';
+            }
+
+            return p;
+        }
+
+    } // namespace detail
+
     inline namespace util {
 
         /**
          * Write double to iterator, removing superfluous '0' characters at
          * the end. The decimal dot will also be removed if necessary.
          *
+         * For precisions up to 15 and values that are not too large
+         * this doesn't use snprintf() and is much faster, the result is
+         * the same.
+         *
          * @tparam T iterator type
          * @param iterator output iterator
          * @param value the value that should be written
@@ -62,6 +147,11 @@ namespace osmium {
 
             char buffer[max_double_length];
 
+            const char* fast = osmium::detail::double2string_fast(buffer + max_double_length, value, precision);
+            if (fast) {
+                return std::copy(fast, static_cast<const char*>(buffer + max_double_length), iterator);
+            }
+
 #ifndef _MSC_VER
             int len = snprintf(buffer, max_double_length, "%.*f", precision, value);
 #else
@@ -69,11 +159,13 @@ namespace osmium {
 #endif
             assert(len > 0 && len < max_double_length);
 
-            while (buffer[len - 1] == '0') {
-                --len;
-            }
-            if (buffer[len - 1] == '.') {
-                --len;
+            if (precision > 0) {
+                while (buffer[len - 1] == '0') {
+                    --len;
+                }
+                if (buffer[len - 1] == '.') {
+                    --len;
+                }
             }
 
             return std::copy_n(buffer, len, iterator);
@@ -0,0 +1,393 @@
+#ifndef OSMIUM_UTIL_METRICS_HPP
+#define OSMIUM_UTIL_METRICS_HPP
+
+/*
+
+This file is part of Osmium (https://osmcode.org/libosmium).
+
+Copyright 2013-2026 Jochen Topf <jochen@topf.org> and others (see README).
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+
+*/
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+namespace osmium {
+
+    /**
+     * @brief Counters and histograms for instrumenting Osmium code
+     *
+     * Metrics are collected in a Registry. They can be polled while the
+     * program is running or written out as JSON at the end. The Reader,
+     * Writer, and thread Pool collect metrics into a Registry if you give
+     * them one.
+     */
+    namespace metrics {
+
+        using clock_type = std::chrono::steady_clock;
+
+        /**
+         * Return the number of microseconds since the specified time.
+         */
+        inline uint64_t microseconds_since(const clock_type::time_point start) noexcept {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now() - start).count());
+        }
+
+        /**
+         * A counter that can be incremented from several threads at the
+         * same time.
+         */
+        class Counter {
+
+            std::atomic<uint64_t> m_value{0};
+
+        public:
+
+            void add(const uint64_t value = 1) noexcept {
+                m_value.fetch_add(value, std::memory_order_relaxed);
+            }
+
+            uint64_t value() const noexcept {
+                return m_value.load(std::memory_order_relaxed);
+            }
+
+            void reset() noexcept {
+                m_value.store(0, std::memory_order_relaxed);
+            }
+
+        }; // class Counter
+
+        /**
+         * A histogram of non-negative integer values (such as times or
+         * sizes) that can be updated from several threads at the same
+         * time. Values are counted in buckets of powers of two: Bucket 0
+         * contains the value 0, bucket n the values from 2^(n-1) to
+         * 2^n - 1.
+         */
+        class Histogram {
+
+        public:
+
+            enum {
+                num_buckets = 65
+            };
+
+        private:
+
+            std::array<std::atomic<uint64_t>, num_buckets> m_buckets{};
+            std::atomic<uint64_t> m_count{0};
+            std::atomic<uint64_t> m_sum{0};
+            std::atomic<uint64_t> m_max{0};
+
+        public:
+
+            /// The bucket a value is counted in.
+            static std::size_t bucket_for(uint64_t value) noexcept {
+                std::size_t bucket = 0;
+                while (value) {
+                    value >>= 1U;
+                    ++bucket;
+                }
+                return bucket;
+            }
+
+            /// The largest value counted in the specified bucket.
+            static uint64_t bucket_upper_bound(const std::size_t bucket) noexcept {
+                if (bucket == 0) {
+                    return 0;
+                }
+                if (bucket >= 64) {
+                    return ~uint64_t{0};
+                }
+                return (uint64_t{1} << bucket) - 1;
+            }
+
+            void record(const uint64_t value) noexcept {
+                m_buckets[bucket_for(value)].fetch_add(1, std::memory_order_relaxed);
+                m_count.fetch_add(1, std::memory_order_relaxed);
+                m_sum.fetch_add(value, std::memory_order_relaxed);
+                uint64_t max = m_max.load(std::memory_order_relaxed);
+                while (value > max && !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+                }
+            }
+
+            /// The number of values recorded.
+            uint64_t count() const noexcept {
+                return m_count.load(std::memory_order_relaxed);
+            }
+
+            /// The sum of all values recorded.
+            uint64_t sum() const noexcept {
+                return m_sum.load(std::memory_order_relaxed);
+            }
+
+            /// The largest value recorded.
+            uint64_t max() const noexcept {
+                return m_max.load(std::memory_order_relaxed);
+            }
+
+            /// The mean of all values recorded (or 0 if there are none).
+            double mean() const noexcept {
+                const auto c = count();
+                return c == 0 ? 0.0 : static_cast<double>(sum()) / static_cast<double>(c);
+            }
+
+            /// The number of values in the specified bucket.
+            uint64_t bucket(const std::size_t n) const noexcept {
+                return n < num_buckets ? m_buckets[n].load(std::memory_order_relaxed) : 0;
+            }
+
+            /**
+             * An upper bound for the specified percentile (0-100) of the
+             * values recorded. This is the upper bound of the bucket which
+             * contains the percentile, but never more than the max value.
+             */
+            uint64_t percentile(const double percent) const noexcept {
+                const auto c = count();
+                if (c == 0) {
+                    return 0;
+                }
+                auto rank = static_cast<uint64_t>(static_cast<double>(c) * percent / 100.0);
+                if (rank >= c) {
+                    rank = c - 1;
+                }
+                uint64_t seen = 0;
+                for (std::size_t n = 0; n < num_buckets; ++n) {
+                    seen += bucket(n);
+                    if (seen > rank) {
+                        const auto bound = bucket_upper_bound(n);
+                        return bound < max() ? bound : max();
+                    }
+                }
+                return max();
+            }
+
+            void reset() noexcept {
+                for (auto& bucket : m_buckets) {
+                    bucket.store(0, std::memory_order_relaxed);
+                }
+                m_count.store(0, std::memory_order_relaxed);
+                m_sum.store(0, std::memory_order_relaxed);
+                m_max.store(0, std::memory_order_relaxed);
+            }
+
+        }; // class Histogram
+
+        namespace detail {
+
+            inline void write_json_string(std::ostream& out, const std::string& str) {
+                out << '"';
+                static const char* const hex_digits = "0123456789abcdef";
+                for (const char c : str) {
+                    const auto uc = static_cast<unsigned char>(c);
+                    if (c == '"' || c == '\\') {
+                        out << '\\' << c;
+                    } else if (uc < 0x20U) {
+                        out << "\\u00" << hex_digits[uc >> 4U] << hex_digits[uc & 0x0fU];
+                    } else {
+                        out << c;
+                    }
+                }
+                out << '"';
+            }
+
+        } // namespace detail
+
+        class Registry;
+
+        namespace detail {
+
+            // Find a Registry in a list of options given to a Reader or
+            // Writer. Returns nullptr if there is none.
+
+            inline Registry* find_registry() noexcept {
+                return nullptr;
+            }
+
+            template <typename... TArgs>
+            inline Registry* find_registry(Registry& registry, TArgs&&... /*args*/) noexcept {
+                return &registry;
+            }
+
+            template <typename T, typename... TArgs>
+            inline Registry* find_registry(T&& /*arg*/, TArgs&&... args) noexcept {
+                return find_registry(args...);
+            }
+
+        } // namespace detail
+
+        /**
+         * A collection of named counters and histograms. Getting a counter
+         * or histogram is thread safe, it is created the first time it is
+         * asked for. The metrics themselves can be updated and polled from
+         * any thread.
+         *
+         * Osmium code keeps shared pointers to the metrics it updates, so
+         * they stay valid even if the registry is destroyed before all
+         * threads using them are done.
+         */
+        class Registry {
+
+            mutable std::mutex m_mutex;
+            std::map<std::string, std::shared_ptr<Counter>> m_counters;
+            std::map<std::string, std::shared_ptr<Histogram>> m_histograms;
+
+            template <typename T>
+            std::shared_ptr<T> get(std::map<std::string, std::shared_ptr<T>>& map, const std::string& name) {
+                const std::lock_guard<std::mutex> lock{m_mutex};
+                auto& ptr = map[name];
+                if (!ptr) {
+                    ptr = std::make_shared<T>();
+                }
+                return ptr;
+            }
+
+        public:
+
+            Registry() = default;
+
+            Registry(const Registry&) = delete;
+            Registry& operator=(const Registry&) = delete;
+
+            Registry(Registry&&) = delete;
+            Registry& operator=(Registry&&) = delete;
+
+            ~Registry() noexcept = default;
+
+            /// Get the counter with the specified name.
+            std::shared_ptr<Counter> shared_counter(const std::string& name) {
+                return get(m_counters, name);
+            }
+
+            /// Get the histogram with the specified name.
+            std::shared_ptr<Histogram> shared_histogram(const std::string& name) {
+                return get(m_histograms, name);
+            }
+
+            /// Get the counter with the specified name.
+            Counter& counter(const std::string& name) {
+                return *shared_counter(name);
+            }
+
+            /// Get the histogram with the specified name.
+            Histogram& histogram(const std::string& name) {
+                return *shared_histogram(name);
+            }
+
+            /**
+             * Get the value of the counter with the specified name. Returns
+             * 0 if there is no such counter.
+             */
+            uint64_t counter_value(const std::string& name) const {
+                const std::lock_guard<std::mutex> lock{m_mutex};
+                const auto it = m_counters.find(name);
+                return it == m_counters.end() ? 0 : it->second->value();
+            }
+
+            /**
+             * Is there a counter or histogram with the specified name?
+             */
+            bool contains(const std::string& name) const {
+                const std::lock_guard<std::mutex> lock{m_mutex};
+                return m_counters.count(name) > 0 || m_histograms.count(name) > 0;
+            }
+
+            /// Reset all counters and histograms to 0.
+            void reset() {
+                const std::lock_guard<std::mutex> lock{m_mutex};
+                for (auto& counter : m_counters) {
+                    counter.second->reset();
+                }
+                for (auto& histogram : m_histograms) {
+                    histogram.second->reset();
+                }
+            }
+
+            /**
+             * Write all metrics as JSON object to the stream. Counters are
+             * written as numbers in the "counters" object, histograms as
+             * objects with count, sum, mean, max, and some percentiles in
+             * the "histograms" object.
+             */
+            void write_json(std::ostream& out) const {
+                const std::lock_guard<std::mutex> lock{m_mutex};
+
+                out << "{\"counters\":{";
+                bool first = true;
+                for (const auto& counter : m_counters) {
+                    if (!first) {
+                        out << ',';
+                    }
+                    first = false;
+                    detail::write_json_string(out, counter.first);
+                    out << ':' << counter.second->value();
+                }
+
+                out << "},\"histograms\":{";
+                first = true;
+                for (const auto& histogram : m_histograms) {
+                    if (!first) {
+                        out << ',';
+                    }
+                    first = false;
+                    const auto& h = *histogram.second;
+                    detail::write_json_string(out, histogram.first);
+                    out << ":{\"count\":" << h.count()
+                        << ",\"sum\":" << h.sum()
+                        << ",\"mean\":" << h.mean()
+                        << ",\"max\":" << h.max()
+                        << ",\"p50\":" << h.percentile(50)
+                        << ",\"p90\":" << h.percentile(90)
+                        << ",\"p99\":" << h.percentile(99)
+                        << '}';
+                }
+                out << "}}";
+            }
+
+            /// Return all metrics as JSON string. See write_json().
+            std::string to_json() const {
+                std::ostringstream out;
+                write_json(out);
+                return out.str();
+            }
+
+        }; // class Registry
+
+    } // namespace metrics
+
+} // namespace osmium
+
+#endif // OSMIUM_UTIL_METRICS_HPP
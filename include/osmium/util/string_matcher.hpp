@@ -33,9 +33,12 @@ DEALINGS IN THE SOFTWARE.
 
 */
 
+#include <osmium/util/dfa_regex.hpp>
+
 #include <algorithm>
 #include <cstring>
 #include <iosfwd>
+#include <memory>
 #include <regex>
 #include <string>
 #include <utility>
@@ -120,6 +123,10 @@ namespace osmium {
                 m_str(str) {
             }
 
+            const std::string& str() const noexcept {
+                return m_str;
+            }
+
             bool match(const char* test_string) const noexcept {
                 return !std::strcmp(m_str.c_str(), test_string);
             }
@@ -189,10 +196,15 @@ namespace osmium {
 
         /**
          * Matches if the test string matches the regular expression.
+         *
+         * If created from a pattern string (instead of a std::regex), the
+         * faster DFARegex engine is used if the pattern only uses
+         * features it supports. Results are the same in any case.
          */
         class regex : public matcher {
 
             std::regex m_regex;
+            std::shared_ptr<const osmium::DFARegex> m_dfa;
 
         public:
 
@@ -200,7 +212,34 @@ namespace osmium {
                 m_regex(std::move(regex)) {
             }
 
+            /**
+             * Create from pattern in ECMAScript syntax.
+             *
+             * @param pattern The regular expression.
+             * @param flags Flags for std::regex. The DFARegex engine is
+             *              only used with the default flags.
+             * @throws std::regex_error If the pattern is invalid.
+             */
+            explicit regex(const std::string& pattern, std::regex::flag_type flags = std::regex::ECMAScript) :
+                m_regex(pattern, flags) {
+                if (flags == std::regex::ECMAScript) {
+                    try {
+                        m_dfa = std::make_shared<const osmium::DFARegex>(pattern);
+                    } catch (const osmium::unsupported_regex_error&) { // NOLINT(bugprone-empty-catch)
+                        // Use std::regex.
+                    }
+                }
+            }
+
+            /// Is the faster DFARegex engine used for matching?
+            bool uses_dfa() const noexcept {
+                return m_dfa != nullptr;
+            }
+
             bool match(const char* test_string) const noexcept {
+                if (m_dfa) {
+                    return m_dfa->search(test_string);
+                }
                 return std::regex_search(test_string, m_regex);
             }
 
@@ -236,6 +275,10 @@ namespace osmium {
                 return *this;
             }
 
+            const std::vector<std::string>& strings() const noexcept {
+                return m_strings;
+            }
+
             bool match(const char* test_string) const noexcept {
                 return std::any_of(m_strings.cbegin(), m_strings.cend(),
                                    [&test_string](const std::string& s){
@@ -395,6 +438,23 @@ namespace osmium {
             m_matcher(std::forward<TMatcher>(matcher)) {
         }
 
+        /**
+         * Get the matcher of the specified type if this StringMatcher
+         * contains one of this type.
+         *
+         * @tparam TMatcher One of the matcher classes.
+         * @returns Pointer to the matcher or nullptr if this StringMatcher
+         *          contains a matcher of a different type.
+         */
+        template <typename TMatcher>
+        const TMatcher* get_if() const noexcept {
+#ifdef OSMIUM_USE_STD_VARIANT
+            return std::get_if<TMatcher>(&m_matcher);
+#else
+            return boost::get<TMatcher>(&m_matcher);
+#endif
+        }
+
         /**
          * Match the specified string.
          */
@@ -106,7 +106,11 @@ header_buffer_type parse_xml(std::string input) {
         osmium::osm_entity_bits::all,
         osmium::io::read_meta::yes,
         osmium::io::buffers_type::any,
-        false
+        false,
+        osmium::io::read_tags_filter{},
+        osmium::io::read_fields::all,
+        nullptr,
+        osmium::io::keep_source_blocks::no
     };
     osmium::io::detail::XMLParser parser{args};
     parser.parse();
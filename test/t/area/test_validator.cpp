@@ -0,0 +1,236 @@
+#include "catch.hpp"
+
+#include <osmium/area/problem_reporter_stream.hpp>
+#include <osmium/area/validator.hpp>
+#include <osmium/builder/attr.hpp>
+#include <osmium/memory/buffer.hpp>
+#include <osmium/osm/area.hpp>
+
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace osmium::builder::attr; // NOLINT(google-build-using-namespace)
+
+static std::vector<osmium::Location> ring_locations(const osmium::NodeRefList& ring) {
+    std::vector<osmium::Location> locations;
+    for (const auto& nr : ring) {
+        locations.push_back(nr.location());
+    }
+    return locations;
+}
+
+TEST_CASE("Validator: valid area") {
+    osmium::memory::Buffer buffer{10240};
+
+    const auto pos = osmium::builder::add_area(buffer,
+        _id(2),
+        _outer_ring({
+            {1, {0.0, 0.0}},
+            {2, {3.0, 0.0}},
+            {3, {3.0, 3.0}},
+            {4, {0.0, 3.0}},
+            {1, {0.0, 0.0}}
+        }),
+        _inner_ring({
+            {5, {1.0, 1.0}},
+            {6, {1.0, 2.0}},
+            {7, {2.0, 2.0}},
+            {8, {2.0, 1.0}},
+            {5, {1.0, 1.0}}
+        })
+    );
+
+    osmium::area::Validator validator;
+    const auto result = validator.check(buffer.get<osmium::Area>(pos));
+    REQUIRE(result.valid());
+    REQUIRE(result.repairable());
+    REQUIRE(result.duplicate_nodes == 0);
+
+    osmium::memory::Buffer out_buffer{10240};
+    REQUIRE(validator.repair(buffer.get<osmium::Area>(pos), out_buffer).valid());
+    REQUIRE(out_buffer.committed() == 0);
+}
+
+TEST_CASE("Validator: repair duplicate nodes, spikes and direction") {
+    osmium::memory::Buffer buffer{10240};
+
+    const auto pos = osmium::builder::add_area(buffer,
+        _id(4),
+        _user("foo"),
+        _tag("landuse", "forest"),
+        _outer_ring({
+            {1, {0.0, 0.0}},
+            {2, {0.0, 3.0}},
+            {2, {0.0, 3.0}},
+            {3, {3.0, 3.0}},
+            {9, {4.0, 4.0}},
+            {3, {3.0, 3.0}},
+            {4, {3.0, 0.0}},
+            {1, {0.0, 0.0}}
+        })
+    );
+
+    osmium::area::Validator validator;
+    const auto result = validator.check(buffer.get<osmium::Area>(pos));
+    REQUIRE_FALSE(result.valid());
+    REQUIRE(result.repairable());
+    REQUIRE(result.duplicate_nodes == 1);
+    REQUIRE(result.spikes == 1);
+    REQUIRE(result.wrong_direction == 1);
+
+    osmium::memory::Buffer out_buffer{10240};
+    validator.repair(buffer.get<osmium::Area>(pos), out_buffer);
+    REQUIRE(out_buffer.committed() > 0);
+
+    const auto& area = out_buffer.get<osmium::Area>(0);
+    REQUIRE(area.id() == 4);
+    REQUIRE(std::string{area.user()} == "foo");
+    REQUIRE(area.tags().has_tag("landuse", "forest"));
+
+    const auto rings = area.outer_rings();
+    REQUIRE(std::distance(rings.begin(), rings.end()) == 1);
+    const std::vector<osmium::Location> expected = {
+        {0.0, 0.0}, {3.0, 0.0}, {3.0, 3.0}, {0.0, 3.0}, {0.0, 0.0}
+    };
+    REQUIRE(ring_locations(*rings.begin()) == expected);
+
+    REQUIRE(validator.check(area).valid());
+}
+
+TEST_CASE("Validator: spike at start of ring") {
+    osmium::memory::Buffer buffer{10240};
+
+    const auto pos = osmium::builder::add_area(buffer,
+        _outer_ring({
+            {9, {-1.0, -1.0}},
+            {1, {0.0, 0.0}},
+            {2, {3.0, 0.0}},
+            {3, {3.0, 3.0}},
+            {1, {0.0, 0.0}},
+            {9, {-1.0, -1.0}}
+        })
+    );
+
+    osmium::area::Validator validator;
+    const auto result = validator.check(buffer.get<osmium::Area>(pos));
+    REQUIRE(result.spikes == 1);
+    REQUIRE(result.short_rings == 0);
+    REQUIRE(result.wrong_direction == 0);
+    REQUIRE(result.repairable());
+}
+
+TEST_CASE("Validator: remove collapsed inner ring") {
+    osmium::memory::Buffer buffer{10240};
+
+    const auto pos = osmium::builder::add_area(buffer,
+        _outer_ring({
+            {1, {0.0, 0.0}},
+            {2, {3.0, 0.0}},
+            {3, {3.0, 3.0}},
+            {1, {0.0, 0.0}}
+        }),
+        _inner_ring({
+            {5, {1.0, 1.0}},
+            {6, {2.0, 1.5}},
+            {5, {1.0, 1.0}}
+        })
+    );
+
+    osmium::area::Validator validator;
+    const auto result = validator.check(buffer.get<osmium::Area>(pos));
+    REQUIRE(result.short_rings == 1);
+    REQUIRE(result.repairable());
+
+    osmium::memory::Buffer out_buffer{10240};
+    validator.repair(buffer.get<osmium::Area>(pos), out_buffer);
+    const auto& area = out_buffer.get<osmium::Area>(0);
+    REQUIRE(area.num_rings() == std::make_pair(1UL, 0UL));
+}
+
+TEST_CASE("Validator: remove ring with all nodes on one line") {
+    osmium::memory::Buffer buffer{10240};
+
+    const auto pos = osmium::builder::add_area(buffer,
+        _id(6),
+        _version(3),
+        _uid(17),
+        _outer_ring({
+            {1, {0.0, 0.0}},
+            {2, {3.0, 0.0}},
+            {3, {3.0, 3.0}},
+            {4, {0.0, 3.0}},
+            {1, {0.0, 0.0}}
+        }),
+        _inner_ring({
+            {5, {1.0, 1.0}},
+            {6, {1.5, 1.5}},
+            {7, {2.0, 2.0}},
+            {5, {1.0, 1.0}}
+        })
+    );
+
+    osmium::area::Validator validator;
+    const auto result = validator.check(buffer.get<osmium::Area>(pos));
+    REQUIRE(result.degenerate_rings == 1);
+    REQUIRE(result.wrong_direction == 0);
+    REQUIRE(result.duplicate_segments == 0);
+    REQUIRE(result.intersections == 0);
+    REQUIRE_FALSE(result.valid());
+    REQUIRE(result.repairable());
+
+    osmium::memory::Buffer out_buffer{10240};
+    validator.repair(buffer.get<osmium::Area>(pos), out_buffer);
+    REQUIRE(out_buffer.committed() > 0);
+
+    const auto& area = out_buffer.get<osmium::Area>(0);
+    REQUIRE(area.id() == 6);
+    REQUIRE(area.version() == 3);
+    REQUIRE(area.uid() == 17);
+    REQUIRE(area.num_rings() == std::make_pair(1UL, 0UL));
+    REQUIRE(validator.check(area).valid());
+}
+
+TEST_CASE("Validator: open ring can not be repaired") {
+    osmium::memory::Buffer buffer{10240};
+
+    const auto pos = osmium::builder::add_area(buffer,
+        _outer_ring({
+            {1, {0.0, 0.0}},
+            {2, {3.0, 0.0}},
+            {3, {3.0, 3.0}},
+            {4, {0.0, 3.0}}
+        })
+    );
+
+    osmium::area::Validator validator;
+    osmium::memory::Buffer out_buffer{10240};
+    const auto result = validator.repair(buffer.get<osmium::Area>(pos), out_buffer);
+    REQUIRE(result.open_rings == 1);
+    REQUIRE_FALSE(result.repairable());
+    REQUIRE(out_buffer.committed() == 0);
+}
+
+TEST_CASE("Validator: self-intersecting ring") {
+    osmium::memory::Buffer buffer{10240};
+
+    const auto pos = osmium::builder::add_area(buffer,
+        _outer_ring({
+            {1, {0.0, 0.0}},
+            {2, {3.0, 3.0}},
+            {3, {3.0, 0.0}},
+            {4, {0.0, 3.0}},
+            {1, {0.0, 0.0}}
+        })
+    );
+
+    std::ostringstream out;
+    osmium::area::ProblemReporterStream reporter{out};
+    osmium::area::Validator validator{&reporter};
+    const auto result = validator.check(buffer.get<osmium::Area>(pos));
+    REQUIRE(result.intersections == 1);
+    REQUIRE(out.str().find("intersection") != std::string::npos);
+    REQUIRE_FALSE(result.valid());
+    REQUIRE_FALSE(result.repairable());
+}
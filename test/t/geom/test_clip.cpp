@@ -0,0 +1,130 @@
+#include "catch.hpp"
+
+#include "area_helper.hpp"
+
+#include <osmium/geom/clip.hpp>
+#include <osmium/geom/wkt.hpp>
+
+#include <vector>
+
+using coordinates_vector = std::vector<osmium::geom::Coordinates>;
+
+TEST_CASE("Clip linestring") {
+    const osmium::geom::BoxClipper clipper{osmium::geom::Coordinates{0, 0}, osmium::geom::Coordinates{10, 10}};
+    std::vector<coordinates_vector> parts;
+
+    SECTION("completely inside") {
+        const coordinates_vector c = {osmium::geom::Coordinates{1, 1}, osmium::geom::Coordinates{2, 2}, osmium::geom::Coordinates{3, 1}};
+        REQUIRE(clipper.clip_linestring(c, parts) == 1);
+        REQUIRE(parts[0] == c);
+    }
+
+    SECTION("completely outside") {
+        const coordinates_vector c = {osmium::geom::Coordinates{-1, -1}, osmium::geom::Coordinates{-2, 20}, osmium::geom::Coordinates{20, 20}};
+        REQUIRE(clipper.clip_linestring(c, parts) == 0);
+        REQUIRE(parts.empty());
+    }
+
+    SECTION("crossing the box") {
+        const coordinates_vector c = {osmium::geom::Coordinates{-5, 5}, osmium::geom::Coordinates{5, 5}, osmium::geom::Coordinates{15, 5}};
+        REQUIRE(clipper.clip_linestring(c, parts) == 1);
+        const coordinates_vector expected = {osmium::geom::Coordinates{0, 5}, osmium::geom::Coordinates{5, 5}, osmium::geom::Coordinates{10, 5}};
+        REQUIRE(parts[0] == expected);
+    }
+
+    SECTION("going out and back in") {
+        const coordinates_vector c = {
+            osmium::geom::Coordinates{2, 2},
+            osmium::geom::Coordinates{2, 12},
+            osmium::geom::Coordinates{4, 12},
+            osmium::geom::Coordinates{4, 2}
+        };
+        REQUIRE(clipper.clip_linestring(c, parts) == 2);
+        const coordinates_vector expected1 = {osmium::geom::Coordinates{2, 2}, osmium::geom::Coordinates{2, 10}};
+        const coordinates_vector expected2 = {osmium::geom::Coordinates{4, 10}, osmium::geom::Coordinates{4, 2}};
+        REQUIRE(parts[0] == expected1);
+        REQUIRE(parts[1] == expected2);
+    }
+}
+
+TEST_CASE("Clip ring") {
+    osmium::geom::BoxClipper clipper{osmium::geom::Coordinates{0, 0}, osmium::geom::Coordinates{10, 10}};
+    coordinates_vector out;
+
+    SECTION("completely inside") {
+        const coordinates_vector c = {
+            osmium::geom::Coordinates{1, 1},
+            osmium::geom::Coordinates{2, 1},
+            osmium::geom::Coordinates{2, 2},
+            osmium::geom::Coordinates{1, 1}
+        };
+        clipper.clip_ring(c, out);
+        REQUIRE(out == c);
+    }
+
+    SECTION("completely outside") {
+        const coordinates_vector c = {
+            osmium::geom::Coordinates{11, 1},
+            osmium::geom::Coordinates{12, 1},
+            osmium::geom::Coordinates{12, 2},
+            osmium::geom::Coordinates{11, 1}
+        };
+        clipper.clip_ring(c, out);
+        REQUIRE(out.empty());
+    }
+
+    SECTION("box inside ring") {
+        const coordinates_vector c = {
+            osmium::geom::Coordinates{-1, -1},
+            osmium::geom::Coordinates{11, -1},
+            osmium::geom::Coordinates{11, 11},
+            osmium::geom::Coordinates{-1, 11},
+            osmium::geom::Coordinates{-1, -1}
+        };
+        clipper.clip_ring(c, out);
+        REQUIRE(out.size() == 5);
+        REQUIRE(out.front() == out.back());
+        for (const auto& p : out) {
+            REQUIRE((p.x == 0 || p.x == 10));
+            REQUIRE((p.y == 0 || p.y == 10));
+        }
+    }
+
+    SECTION("partially inside") {
+        const coordinates_vector c = {
+            osmium::geom::Coordinates{5, 5},
+            osmium::geom::Coordinates{15, 5},
+            osmium::geom::Coordinates{15, 8},
+            osmium::geom::Coordinates{5, 8},
+            osmium::geom::Coordinates{5, 5}
+        };
+        clipper.clip_ring(c, out);
+        const coordinates_vector expected = {
+            osmium::geom::Coordinates{5, 5},
+            osmium::geom::Coordinates{10, 5},
+            osmium::geom::Coordinates{10, 8},
+            osmium::geom::Coordinates{5, 8},
+            osmium::geom::Coordinates{5, 5}
+        };
+        REQUIRE(out == expected);
+    }
+}
+
+TEST_CASE("Clip area and create geometry with factory") {
+    osmium::memory::Buffer buffer{10000};
+    const osmium::Area& area = create_test_area_1outer_1inner(buffer);
+
+    osmium::geom::WKTFactory<> factory;
+    osmium::geom::BoxClipper clipper{osmium::geom::Coordinates{0.0, 0.0}, osmium::geom::Coordinates{5.0, 5.0}};
+    std::vector<osmium::geom::BoxClipper::polygon_type> polygons;
+
+    REQUIRE(clipper.clip_area(area, factory, polygons) == 1);
+    REQUIRE(polygons[0].size() == 2);
+    REQUIRE(factory.create_multipolygon_from_coordinates(polygons) ==
+            "MULTIPOLYGON(((0.1 5,0.1 0.1,5 0.1,5 5,0.1 5),(1 5,1 1,5 1,5 5,1 5)))");
+
+    osmium::geom::BoxClipper outside{osmium::geom::Coordinates{20.0, 20.0}, osmium::geom::Coordinates{30.0, 30.0}};
+    polygons.clear();
+    REQUIRE(outside.clip_area(area, factory, polygons) == 0);
+    REQUIRE_THROWS_AS(factory.create_multipolygon_from_coordinates(polygons), osmium::geometry_error);
+}
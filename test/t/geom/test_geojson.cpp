@@ -171,3 +171,24 @@ TEST_CASE("GeoJSON area geometry") {
 
 }
 
+
+TEST_CASE("GeoJSON geometries appended to string") {
+    std::string out{"["};
+    osmium::geom::GeoJSONFactory<> factory{out};
+    osmium::memory::Buffer buffer{10000};
+
+    REQUIRE(factory.create_point(osmium::Location{3.2, 4.2}).empty());
+    out += ',';
+    REQUIRE(factory.create_linestring(create_test_wnl_okay(buffer)).empty());
+    out += ',';
+    REQUIRE(factory.create_polygon(create_test_wnl_closed(buffer)).empty());
+    out += ',';
+    osmium::memory::Buffer area_buffer{10000};
+    REQUIRE(factory.create_multipolygon(create_test_area_1outer_0inner(area_buffer)).empty());
+    out += ']';
+
+    REQUIRE(out == "[{\"type\":\"Point\",\"coordinates\":[3.2,4.2]},"
+                   "{\"type\":\"LineString\",\"coordinates\":[[3.2,4.2],[3.5,4.7],[3.6,4.9]]},"
+                   "{\"type\":\"Polygon\",\"coordinates\":[[[3,3],[4.1,4.1],[3.6,4.1],[3.1,3.5],[3,3]]]},"
+                   "{\"type\":\"MultiPolygon\",\"coordinates\":[[[[3.2,4.2],[3.5,4.7],[3.6,4.9],[3.2,4.2]]]]}]");
+}
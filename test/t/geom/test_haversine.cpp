@@ -0,0 +1,76 @@
+#include "catch.hpp"
+
+#include <osmium/builder/attr.hpp>
+#include <osmium/geom/haversine.hpp>
+#include <osmium/memory/buffer.hpp>
+#include <osmium/osm/way.hpp>
+
+#include <cstddef>
+#include <vector>
+
+using namespace osmium::builder::attr; // NOLINT(google-build-using-namespace)
+
+TEST_CASE("Haversine distance between two points") {
+    const osmium::geom::Coordinates c1{0.0, 0.0};
+    const osmium::geom::Coordinates c2{1.0, 0.0};
+    REQUIRE(osmium::geom::haversine::distance(c1, c2) == Approx(111226.3).epsilon(0.00001));
+    REQUIRE(osmium::geom::haversine::distance(c1, c1) == Approx(0.0));
+}
+
+TEST_CASE("Haversine segment distances are close to exact distances") {
+    std::vector<osmium::Location> locations;
+    for (int i = 0; i < 1000; ++i) {
+        const double lon = -179.0 + (i * 0.3579);
+        const double lat = -89.9 + (i * 0.1798);
+        locations.emplace_back(lon, lat);
+        locations.emplace_back(lon + 0.0001 * (i % 7), lat - 0.00003 * (i % 5));
+    }
+    locations.emplace_back(0.0, 0.0);
+    locations.emplace_back(0.0, 0.0);
+    locations.emplace_back(0.0, 90.0);
+    locations.emplace_back(170.0, 90.0);
+    locations.emplace_back(-170.0, 89.9);
+
+    std::vector<double> distances(locations.size() - 1);
+    osmium::geom::haversine::segment_distances(locations.data(), locations.data() + locations.size(), distances.data());
+
+    for (std::size_t i = 0; i < distances.size(); ++i) {
+        const double exact = osmium::geom::haversine::distance(locations[i], locations[i + 1]);
+        REQUIRE(distances[i] == Approx(exact).epsilon(1e-11).margin(1e-6));
+    }
+}
+
+TEST_CASE("Haversine fast distance of node ref list") {
+    osmium::memory::Buffer buffer{1024 * 1024};
+    const auto pos = osmium::builder::add_way_node_list(buffer, _nodes({
+        {1, {3.2, 4.2}},
+        {2, {3.5, 4.7}},
+        {3, {3.5, 4.7}},
+        {4, {3.6, 4.9}},
+        {5, {50.0, 60.0}}
+    }));
+    const auto& wnl = buffer.get<osmium::WayNodeList>(pos);
+
+    REQUIRE(osmium::geom::haversine::fast_distance(wnl) == Approx(osmium::geom::haversine::distance(wnl)).epsilon(1e-11));
+
+    std::vector<double> distances(wnl.size() - 1);
+    osmium::geom::haversine::segment_distances(wnl, distances.data());
+    REQUIRE(distances[1] == Approx(0.0));
+    REQUIRE(distances[3] == Approx(osmium::geom::haversine::distance(wnl[3].location(), wnl[4].location())));
+}
+
+TEST_CASE("Haversine fast distance of long list spanning several batches") {
+    std::vector<osmium::Location> locations;
+    for (int i = 0; i < 2000; ++i) {
+        locations.emplace_back(8.0 + i * 0.001, 49.0 + (i % 3) * 0.0005);
+    }
+
+    double sum = 0;
+    for (std::size_t i = 0; i + 1 < locations.size(); ++i) {
+        sum += osmium::geom::haversine::distance(locations[i], locations[i + 1]);
+    }
+
+    REQUIRE(osmium::geom::haversine::fast_distance(locations.data(), locations.data() + locations.size()) == Approx(sum).epsilon(1e-11));
+    REQUIRE(osmium::geom::haversine::fast_distance(locations.data(), locations.data() + 1) == Approx(0.0));
+    REQUIRE(osmium::geom::haversine::fast_distance(locations.data(), locations.data()) == Approx(0.0));
+}
@@ -1,6 +1,12 @@
 #include "catch.hpp"
 
+#include <osmium/builder/attr.hpp>
 #include <osmium/geom/mercator_projection.hpp>
+#include <osmium/memory/buffer.hpp>
+#include <osmium/osm/way.hpp>
+
+#include <cstddef>
+#include <vector>
 
 TEST_CASE("Mercator projection") {
     const osmium::geom::MercatorProjection projection;
@@ -32,3 +38,51 @@ TEST_CASE("Mercator bounds") {
     REQUIRE(osmium::geom::detail::y_to_lat(osmium::geom::detail::lon_to_x(180.0)) == Approx(osmium::geom::MERCATOR_MAX_LAT).epsilon(0.0000001));
 }
 
+
+TEST_CASE("Batch mercator projection gives same results as single projection") {
+    std::vector<osmium::Location> locations;
+    for (int lat = -850; lat <= 850; lat += 7) {
+        locations.emplace_back(lat * 0.21 - 1.3, lat * 0.1);
+    }
+    locations.emplace_back(0.0, 0.0);
+    locations.emplace_back(180.0, osmium::geom::MERCATOR_MAX_LAT);
+    locations.emplace_back(-180.0, -osmium::geom::MERCATOR_MAX_LAT);
+
+    std::vector<osmium::geom::Coordinates> result(locations.size());
+    osmium::geom::lonlat_to_mercator(locations.data(), locations.data() + locations.size(), result.data());
+
+    for (std::size_t i = 0; i < locations.size(); ++i) {
+        const osmium::geom::Coordinates c = osmium::geom::lonlat_to_mercator(locations[i]);
+        REQUIRE(result[i].x == c.x);
+        REQUIRE(result[i].y == c.y);
+    }
+}
+
+TEST_CASE("Batch mercator projection of node ref list") {
+    osmium::memory::Buffer buffer{1024};
+    const auto pos = osmium::builder::add_way_node_list(buffer, osmium::builder::attr::_nodes({
+        {1, {3.2, 4.2}},
+        {2, {-120.5, 79.3}},
+        {3, {17.0, -83.1}},
+        {4, {3.6, 4.9}}
+    }));
+    const auto& wnl = buffer.get<osmium::WayNodeList>(pos);
+
+    std::vector<osmium::geom::Coordinates> result(wnl.size());
+    osmium::geom::lonlat_to_mercator(wnl, result.data());
+
+    const osmium::geom::MercatorProjection projection;
+    for (std::size_t i = 0; i < wnl.size(); ++i) {
+        const osmium::geom::Coordinates c = projection(wnl[i].location());
+        REQUIRE(result[i].x == c.x);
+        REQUIRE(result[i].y == c.y);
+    }
+}
+
+TEST_CASE("Batch mercator projection of empty range") {
+    const osmium::Location location{1.0, 2.0};
+    osmium::geom::Coordinates c{3.0, 4.0};
+    osmium::geom::lonlat_to_mercator(&location, &location, &c);
+    REQUIRE(c.x == Approx(3.0));
+    REQUIRE(c.y == Approx(4.0));
+}
@@ -0,0 +1,112 @@
+#include "catch.hpp"
+
+#include <osmium/builder/attr.hpp>
+#include <osmium/geom/simplify.hpp>
+#include <osmium/geom/wkt.hpp>
+#include <osmium/memory/buffer.hpp>
+#include <osmium/osm/way.hpp>
+
+#include <vector>
+
+using namespace osmium::builder::attr; // NOLINT(google-build-using-namespace)
+
+using coordinates_vector = std::vector<osmium::geom::Coordinates>;
+
+TEST_CASE("Douglas-Peucker simplification") {
+    osmium::geom::Simplifier simplifier;
+
+    SECTION("short lines are unchanged") {
+        coordinates_vector c = {osmium::geom::Coordinates{0, 0}, osmium::geom::Coordinates{1, 1}};
+        simplifier.douglas_peucker(c, 10.0);
+        REQUIRE(c.size() == 2);
+    }
+
+    SECTION("points near the line are removed") {
+        coordinates_vector c = {
+            osmium::geom::Coordinates{0, 0},
+            osmium::geom::Coordinates{1, 0.1},
+            osmium::geom::Coordinates{2, -0.1},
+            osmium::geom::Coordinates{3, 5},
+            osmium::geom::Coordinates{4, 6},
+            osmium::geom::Coordinates{5, 7}
+        };
+        simplifier.douglas_peucker(c, 0.5);
+        const coordinates_vector expected = {
+            osmium::geom::Coordinates{0, 0},
+            osmium::geom::Coordinates{2, -0.1},
+            osmium::geom::Coordinates{3, 5},
+            osmium::geom::Coordinates{5, 7}
+        };
+        REQUIRE(c == expected);
+    }
+
+    SECTION("closed ring stays closed") {
+        coordinates_vector c = {
+            osmium::geom::Coordinates{0, 0},
+            osmium::geom::Coordinates{5, 0.01},
+            osmium::geom::Coordinates{10, 0},
+            osmium::geom::Coordinates{10, 10},
+            osmium::geom::Coordinates{0, 10},
+            osmium::geom::Coordinates{0, 0}
+        };
+        simplifier.douglas_peucker(c, 0.1);
+        REQUIRE(c.size() == 5);
+        REQUIRE(c.front() == c.back());
+    }
+}
+
+TEST_CASE("Visvalingam simplification") {
+    osmium::geom::Simplifier simplifier;
+
+    coordinates_vector c = {
+        osmium::geom::Coordinates{0, 0},
+        osmium::geom::Coordinates{1, 0.1},
+        osmium::geom::Coordinates{2, 0},
+        osmium::geom::Coordinates{3, 3},
+        osmium::geom::Coordinates{4, 0}
+    };
+
+    SECTION("small tolerance keeps everything") {
+        simplifier.visvalingam(c, 0.01);
+        REQUIRE(c.size() == 5);
+    }
+
+    SECTION("remove point with small area") {
+        simplifier.visvalingam(c, 0.5);
+        const coordinates_vector expected = {
+            osmium::geom::Coordinates{0, 0},
+            osmium::geom::Coordinates{2, 0},
+            osmium::geom::Coordinates{3, 3},
+            osmium::geom::Coordinates{4, 0}
+        };
+        REQUIRE(c == expected);
+    }
+
+    SECTION("large tolerance removes all inner points") {
+        simplifier.visvalingam(c, 100.0);
+        REQUIRE(c.size() == 2);
+    }
+}
+
+TEST_CASE("Simplify way and create geometry with factory") {
+    osmium::memory::Buffer buffer{10240};
+    const auto pos = osmium::builder::add_way(buffer, _nodes({
+        {1, {0.0, 0.0}},
+        {2, {1.0, 0.001}},
+        {3, {1.0, 0.001}},
+        {4, {2.0, 0.0}},
+        {5, {2.0, 1.0}}
+    }));
+
+    osmium::geom::WKTFactory<> factory;
+    coordinates_vector c;
+    factory.project(buffer.get<osmium::Way>(pos).nodes(), c);
+    REQUIRE(c.size() == 4);
+
+    osmium::geom::Simplifier simplifier;
+    simplifier.douglas_peucker(c, 0.01);
+    REQUIRE(factory.create_linestring_from_coordinates(c.cbegin(), c.cend()) == "LINESTRING(0 0,2 0,2 1)");
+
+    c.resize(1);
+    REQUIRE_THROWS_AS(factory.create_linestring_from_coordinates(c.cbegin(), c.cend()), osmium::geometry_error);
+}
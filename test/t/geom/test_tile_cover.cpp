@@ -0,0 +1,147 @@
+#include "catch.hpp"
+
+#include <osmium/builder/attr.hpp>
+#include <osmium/geom/tile_cover.hpp>
+#include <osmium/memory/buffer.hpp>
+#include <osmium/osm/area.hpp>
+#include <osmium/osm/way.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+using namespace osmium::builder::attr; // NOLINT(google-build-using-namespace)
+
+static bool has_tile(const std::vector<osmium::geom::Tile>& tiles, uint32_t zoom, uint32_t x, uint32_t y) {
+    return std::find(tiles.begin(), tiles.end(), osmium::geom::Tile{zoom, x, y}) != tiles.end();
+}
+
+TEST_CASE("TileCover of locations") {
+    osmium::geom::TileCover cover{1};
+    REQUIRE(cover.empty());
+
+    cover.add_location(osmium::Location{});
+    REQUIRE(cover.empty());
+
+    cover.add_location(osmium::Location{10.0, 10.0});
+    cover.add_location(osmium::Location{-10.0, -10.0});
+    cover.add_location(osmium::Location{-10.0, 90.0});
+    cover.add_location(osmium::Location{11.0, 11.0});
+
+    const auto tiles = cover.tiles();
+    REQUIRE(tiles.size() == 3);
+    REQUIRE(tiles[0] == osmium::geom::Tile(1, 0, 0));
+    REQUIRE(tiles[1] == osmium::geom::Tile(1, 0, 1));
+    REQUIRE(tiles[2] == osmium::geom::Tile(1, 1, 0));
+
+    cover.clear();
+    REQUIRE(cover.empty());
+}
+
+TEST_CASE("TileCover of linestrings") {
+    osmium::memory::Buffer buffer{10240};
+
+    SECTION("horizontal line") {
+        const auto pos = osmium::builder::add_way(buffer, _nodes({
+            {1, {-10.0, 10.0}},
+            {2, {10.0, 10.0}}
+        }));
+        osmium::geom::TileCover cover{1};
+        cover.add_linestring(buffer.get<osmium::Way>(pos).nodes());
+        const auto tiles = cover.tiles();
+        REQUIRE(tiles.size() == 2);
+        REQUIRE(has_tile(tiles, 1, 0, 0));
+        REQUIRE(has_tile(tiles, 1, 1, 0));
+    }
+
+    SECTION("invalid locations are ignored") {
+        const auto pos = osmium::builder::add_way(buffer, _nodes({
+            {1, {-10.0, 10.0}},
+            {2, osmium::Location{}},
+            {3, {-10.0, -10.0}}
+        }));
+        osmium::geom::TileCover cover{1};
+        cover.add_linestring(buffer.get<osmium::Way>(pos).nodes());
+        const auto tiles = cover.tiles();
+        REQUIRE(tiles.size() == 2);
+        REQUIRE(has_tile(tiles, 1, 0, 0));
+        REQUIRE(has_tile(tiles, 1, 0, 1));
+    }
+
+    SECTION("diagonal line") {
+        const auto pos = osmium::builder::add_way(buffer, _nodes({
+            {1, {0.1, 0.2}},
+            {2, {3.1, 1.4}},
+            {3, {0.3, 2.2}}
+        }));
+        osmium::geom::TileCover cover{10};
+        cover.add_linestring(buffer.get<osmium::Way>(pos).nodes());
+        const auto tiles = cover.tiles();
+
+        // A segment not going exactly through a tile corner touches
+        // one tile more than the number of tile borders it crosses.
+        const osmium::geom::Tile a{10, osmium::Location{0.1, 0.2}};
+        const osmium::geom::Tile b{10, osmium::Location{3.1, 1.4}};
+        const osmium::geom::Tile c{10, osmium::Location{0.3, 2.2}};
+        const auto borders = [](const osmium::geom::Tile& t1, const osmium::geom::Tile& t2) {
+            return std::abs(static_cast<int>(t1.x) - static_cast<int>(t2.x)) +
+                   std::abs(static_cast<int>(t1.y) - static_cast<int>(t2.y));
+        };
+        REQUIRE(tiles.size() > static_cast<std::size_t>(borders(a, b)));
+        REQUIRE(tiles.size() <= static_cast<std::size_t>(borders(a, b) + borders(b, c) + 1));
+        REQUIRE(has_tile(tiles, 10, a.x, a.y));
+        REQUIRE(has_tile(tiles, 10, b.x, b.y));
+        REQUIRE(has_tile(tiles, 10, c.x, c.y));
+        REQUIRE(std::is_sorted(tiles.begin(), tiles.end()));
+    }
+}
+
+TEST_CASE("TileCover of area") {
+    osmium::memory::Buffer buffer{10240};
+
+    osmium::geom::TileCover cover{4};
+
+    SECTION("without hole") {
+        const auto pos = osmium::builder::add_area(buffer,
+            _outer_ring({
+                {1, {-80.0, -60.0}},
+                {2, {80.0, -60.0}},
+                {3, {80.0, 60.0}},
+                {4, {-80.0, 60.0}},
+                {1, {-80.0, -60.0}}
+            })
+        );
+        cover.add_area(buffer.get<osmium::Area>(pos));
+        const auto tiles = cover.tiles();
+        REQUIRE(tiles.size() == 64);
+        REQUIRE(has_tile(tiles, 4, 4, 4));
+        REQUIRE(has_tile(tiles, 4, 7, 7));
+        REQUIRE(has_tile(tiles, 4, 11, 11));
+        REQUIRE_FALSE(has_tile(tiles, 4, 3, 7));
+    }
+
+    SECTION("with hole") {
+        const auto pos = osmium::builder::add_area(buffer,
+            _outer_ring({
+                {1, {-80.0, -60.0}},
+                {2, {80.0, -60.0}},
+                {3, {80.0, 60.0}},
+                {4, {-80.0, 60.0}},
+                {1, {-80.0, -60.0}}
+            }),
+            _inner_ring({
+                {5, {-30.0, -30.0}},
+                {6, {-30.0, 30.0}},
+                {7, {30.0, 30.0}},
+                {8, {30.0, -30.0}},
+                {5, {-30.0, -30.0}}
+            })
+        );
+        cover.add_area(buffer.get<osmium::Area>(pos));
+        const auto tiles = cover.tiles();
+        REQUIRE(tiles.size() == 60);
+        REQUIRE(has_tile(tiles, 4, 6, 6));
+        REQUIRE_FALSE(has_tile(tiles, 4, 7, 7));
+        REQUIRE_FALSE(has_tile(tiles, 4, 8, 8));
+    }
+}
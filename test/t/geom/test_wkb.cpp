@@ -1,5 +1,6 @@
 #include "catch.hpp"
 
+#include "area_helper.hpp"
 #include "wnl_helper.hpp"
 
 #include <osmium/geom/mercator_projection.hpp>
@@ -128,8 +129,41 @@ TEST_CASE("WKB geometry factory (byte-order-dependent): polygon") {
     REQUIRE(wkb == "010300000001000000050000000000000000000840000000000000084066666666666610406666666666661040CDCCCCCCCCCC0C406666666666661040CDCCCCCCCCCC08400000000000000C4000000000000008400000000000000840");
 }
 
+TEST_CASE("WKB geometry factory (byte-order-dependent): appending to string in hex") {
+    osmium::memory::Buffer buffer{10000};
+    std::string out{"x"};
+    osmium::geom::WKBFactory<> factory{out, osmium::geom::wkb_type::wkb, osmium::geom::out_type::hex};
+
+    REQUIRE(factory.create_point(osmium::Location{3.2, 4.2}).empty());
+    REQUIRE(factory.create_linestring(create_test_wnl_okay(buffer)).empty());
+    REQUIRE(factory.create_polygon(create_test_wnl_closed(buffer)).empty());
+    REQUIRE(out == "x"
+                   "01010000009A99999999990940CDCCCCCCCCCC1040"
+                   "0102000000030000009A99999999990940CDCCCCCCCCCC10400000000000000C40CDCCCCCCCCCC1240CDCCCCCCCCCC0C409A99999999991340"
+                   "010300000001000000050000000000000000000840000000000000084066666666666610406666666666661040CDCCCCCCCCCC0C406666666666661040CDCCCCCCCCCC08400000000000000C4000000000000008400000000000000840");
+}
+
 #endif
 
+TEST_CASE("WKB geometry factory appending binary data to string") {
+    osmium::memory::Buffer buffer{10000};
+    const osmium::geom::WKBFactory<> factory{osmium::geom::wkb_type::ewkb};
+    osmium::geom::WKBFactory<> lfactory{osmium::geom::wkb_type::ewkb};
+
+    std::string out;
+    osmium::geom::WKBFactory<> append_factory{out, osmium::geom::wkb_type::ewkb};
+
+    osmium::memory::Buffer area_buffer{10000};
+    const auto& wnl = create_test_wnl_okay(buffer);
+    const auto& area = create_test_area_2outer_2inner(area_buffer);
+
+    REQUIRE(append_factory.create_point(wnl[0].location()).empty());
+    REQUIRE(append_factory.create_linestring(wnl).empty());
+    REQUIRE(append_factory.create_multipolygon(area).empty());
+
+    REQUIRE(out == factory.create_point(wnl[0].location()) + lfactory.create_linestring(wnl) + lfactory.create_multipolygon(area));
+}
+
 TEST_CASE("WKB geometry (byte-order-independent) of empty point") {
     const osmium::geom::WKBFactory<> factory{osmium::geom::wkb_type::wkb, osmium::geom::out_type::hex};
     REQUIRE_THROWS_AS(factory.create_point(osmium::Location{}), osmium::invalid_location);
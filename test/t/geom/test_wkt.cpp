@@ -153,3 +153,32 @@ TEST_CASE("WKT geometry factory") {
 
 }
 
+
+TEST_CASE("WKT geometry factory appending to string") {
+    std::string out{"x"};
+    osmium::geom::WKTFactory<> factory{out};
+
+    osmium::memory::Buffer buffer{10000};
+
+    REQUIRE(factory.create_point(osmium::Location{3.2, 4.2}).empty());
+    REQUIRE(factory.create_linestring(create_test_wnl_okay(buffer)).empty());
+    out += '\n';
+    REQUIRE(factory.create_polygon(create_test_wnl_closed(buffer)).empty());
+    osmium::memory::Buffer area_buffer{10000};
+    REQUIRE(factory.create_multipolygon(create_test_area_1outer_1inner(area_buffer)).empty());
+
+    REQUIRE(out == "xPOINT(3.2 4.2)LINESTRING(3.2 4.2,3.5 4.7,3.6 4.9)\n"
+                   "POLYGON((3 3,4.1 4.1,3.6 4.1,3.1 3.5,3 3))"
+                   "MULTIPOLYGON(((0.1 0.1,9.1 0.1,9.1 9.1,0.1 9.1,0.1 0.1),(1 1,8 1,8 8,1 8,1 1)))");
+}
+
+TEST_CASE("WKT geometry factory appending to string in ewkt") {
+    std::string out;
+    osmium::geom::WKTFactory<> factory{out, 7, osmium::geom::wkt_type::ewkt};
+
+    osmium::memory::Buffer buffer{10000};
+
+    factory.create_point(osmium::Location{3.2, 4.2});
+    factory.create_linestring(create_test_wnl_okay(buffer));
+    REQUIRE(out == "SRID=4326;POINT(3.2 4.2)SRID=4326;LINESTRING(3.2 4.2,3.5 4.7,3.6 4.9)");
+}
@@ -0,0 +1,181 @@
+#include "catch.hpp"
+
+#include <osmium/builder/attr.hpp>
+#include <osmium/handler/tile_bucketer.hpp>
+#include <osmium/memory/buffer.hpp>
+#include <osmium/storage/tile_bucket_store.hpp>
+#include <osmium/thread/pool.hpp>
+
+#include <cstdio>
+#include <vector>
+
+using namespace osmium::builder::attr; // NOLINT(google-build-using-namespace)
+
+static void remove_bucket_files(const osmium::TileBucketStore& store) {
+    for (uint32_t i = 0; i < store.num_buckets(); ++i) {
+        std::remove(store.filename(i).c_str());
+    }
+}
+
+static std::vector<osmium::tile_bucket_entry> read_all(const osmium::TileBucketStore& store) {
+    std::vector<osmium::tile_bucket_entry> entries;
+    for (uint32_t i = 0; i < store.num_buckets(); ++i) {
+        const auto bucket = store.read_bucket(i);
+        for (const auto& entry : bucket) {
+            REQUIRE(store.bucket_index(entry.x, entry.y) == i);
+        }
+        entries.insert(entries.end(), bucket.begin(), bucket.end());
+    }
+    return entries;
+}
+
+TEST_CASE("TileBucketStore") {
+    osmium::TileBucketStore store{".", 3, 1, 2};
+    REQUIRE(store.zoom() == 3);
+    REQUIRE(store.bucket_zoom() == 1);
+    REQUIRE(store.num_buckets() == 4);
+    REQUIRE(store.bucket_index(5, 2) == 1);
+    REQUIRE(store.bucket_tile(1) == osmium::geom::Tile(1, 1, 0));
+    REQUIRE(store.filename(2) == "./1-0-1.tiles");
+
+    store.add(osmium::geom::Tile{3, 1, 1}, osmium::item_type::way, 20);
+    store.add(osmium::geom::Tile{3, 1, 1}, osmium::item_type::node, 10);
+    store.add(osmium::geom::Tile{3, 0, 0}, osmium::item_type::way, 21);
+    store.add(osmium::geom::Tile{3, 7, 7}, osmium::item_type::node, 11);
+    REQUIRE(store.size() == 4);
+
+    // Three entries in bucket 0, two of them have already been written.
+    REQUIRE(store.read_bucket(0).size() == 2);
+
+    store.flush();
+    const auto bucket = store.read_bucket(0);
+    REQUIRE(bucket.size() == 3);
+    REQUIRE(bucket[0].tile(3) == osmium::geom::Tile(3, 0, 0));
+    REQUIRE(bucket[1].object_type() == osmium::item_type::node);
+    REQUIRE(bucket[1].id == 10);
+    REQUIRE(bucket[2].id == 20);
+
+    REQUIRE(store.read_bucket(1).empty());
+    REQUIRE(store.read_bucket(3).size() == 1);
+
+    remove_bucket_files(store);
+}
+
+TEST_CASE("TileBucketStore truncates old bucket files") {
+    {
+        osmium::TileBucketStore store{".", 2, 1};
+        store.add(osmium::geom::Tile{2, 0, 0}, osmium::item_type::node, 1);
+    }
+    osmium::TileBucketStore store{".", 2, 1};
+    store.add(osmium::geom::Tile{2, 0, 0}, osmium::item_type::node, 2);
+    store.flush();
+    const auto bucket = store.read_bucket(0);
+    REQUIRE(bucket.size() == 1);
+    REQUIRE(bucket[0].id == 2);
+
+    remove_bucket_files(store);
+}
+
+TEST_CASE("TileBucketStore ignores bucket files from earlier runs") {
+    {
+        osmium::TileBucketStore store{".", 2, 1};
+        store.add(osmium::geom::Tile{2, 0, 0}, osmium::item_type::node, 1);
+        store.add(osmium::geom::Tile{2, 3, 3}, osmium::item_type::node, 2);
+    }
+    osmium::TileBucketStore store{".", 2, 1};
+    store.add(osmium::geom::Tile{2, 0, 0}, osmium::item_type::node, 3);
+    store.flush();
+    REQUIRE(store.read_bucket(0).size() == 1);
+    REQUIRE(store.read_bucket(3).empty());
+
+    remove_bucket_files(store);
+}
+
+TEST_CASE("TileBucketer only writes full buckets before close") {
+    osmium::TileBucketStore store{".", 1, 1, 2};
+    osmium::handler::TileBucketer handler{store};
+    osmium::memory::Buffer buffer{10240};
+    osmium::builder::add_node(buffer, _id(1), _location(10.0, 10.0));
+    osmium::builder::add_node(buffer, _id(2), _location(-10.0, -10.0));
+    osmium::builder::add_node(buffer, _id(3), _location(11.0, 11.0));
+
+    handler(buffer);
+    handler.flush();
+    REQUIRE(store.read_bucket(1).size() == 2);
+    REQUIRE(store.read_bucket(2).empty());
+
+    handler.close();
+    REQUIRE(store.read_bucket(2).size() == 1);
+
+    remove_bucket_files(store);
+}
+
+TEST_CASE("TileBucketer with nodes, ways, and areas") {
+    osmium::memory::Buffer buffer{10240};
+    osmium::builder::add_node(buffer, _id(1), _location(10.0, 10.0));
+    osmium::builder::add_node(buffer, _id(2), _location(-10.0, -10.0));
+    osmium::builder::add_node(buffer, _id(3));
+    osmium::builder::add_way(buffer, _id(4), _nodes({
+        {1, {10.0, 10.0}},
+        {6, {-10.0, 10.0}}
+    }));
+    osmium::builder::add_relation(buffer, _id(5));
+    osmium::builder::add_area(buffer, _id(12),
+        _outer_ring({
+            {1, {10.0, 10.0}},
+            {2, {20.0, 10.0}},
+            {3, {20.0, 20.0}},
+            {1, {10.0, 10.0}}
+        })
+    );
+
+    osmium::TileBucketStore store{".", 1, 1};
+    osmium::handler::TileBucketer handler{store};
+    handler(buffer);
+    handler.close();
+
+    const auto entries = read_all(store);
+    REQUIRE(entries.size() == 2 + 2 + 1);
+    REQUIRE(store.size() == entries.size());
+
+    const std::vector<osmium::tile_bucket_entry> expected = {
+        {osmium::geom::Tile{1, 0, 0}, osmium::item_type::way, 4},
+        {osmium::geom::Tile{1, 1, 0}, osmium::item_type::node, 1},
+        {osmium::geom::Tile{1, 1, 0}, osmium::item_type::way, 4},
+        {osmium::geom::Tile{1, 1, 0}, osmium::item_type::area, 12},
+        {osmium::geom::Tile{1, 0, 1}, osmium::item_type::node, 2}
+    };
+    REQUIRE(entries == expected);
+
+    remove_bucket_files(store);
+}
+
+TEST_CASE("TileBucketer using several threads gives same result as single thread") {
+    osmium::memory::Buffer buffer{1024 * 1024};
+    for (int i = 1; i <= 5000; ++i) {
+        osmium::builder::add_node(buffer, _id(i), _location((i % 360) - 179.5, ((i * 7) % 170) - 84.5));
+    }
+
+    std::vector<osmium::tile_bucket_entry> result_single;
+    {
+        osmium::TileBucketStore store{".", 6, 2, 100};
+        osmium::handler::TileBucketer handler{store};
+        for (const auto& node : buffer.select<osmium::Node>()) {
+            handler.node(node);
+        }
+        handler.close();
+        result_single = read_all(store);
+        remove_bucket_files(store);
+    }
+
+    osmium::thread::Pool pool{4};
+    osmium::TileBucketStore store{".", 6, 2, 100};
+    osmium::handler::TileBucketer handler{store};
+    handler(buffer, pool);
+    handler.close();
+    const auto result_multi = read_all(store);
+    remove_bucket_files(store);
+
+    REQUIRE(result_single.size() == 5000);
+    REQUIRE(result_single == result_multi);
+}
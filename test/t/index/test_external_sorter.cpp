@@ -0,0 +1,111 @@
+#include "catch.hpp"
+
+#include <osmium/external_sorter.hpp>
+#include <osmium/memory/buffer.hpp>
+#include <osmium/opl.hpp>
+#include <osmium/osm/object.hpp>
+#include <osmium/visitor.hpp>
+
+#include <string>
+#include <vector>
+
+static std::vector<std::string> read_all(osmium::ExternalSorter& sorter) {
+    std::vector<std::string> result;
+    while (osmium::memory::Buffer buffer = sorter.read()) {
+        for (const auto& object : buffer.select<osmium::OSMObject>()) {
+            std::string str{osmium::item_type_to_char(object.type())};
+            str += std::to_string(object.id()) + "v" + std::to_string(object.version());
+            const char* tag = object.tags().get_value_by_key("x");
+            if (tag) {
+                str += tag;
+            }
+            result.push_back(str);
+        }
+    }
+    return result;
+}
+
+static osmium::memory::Buffer unsorted_data() {
+    osmium::memory::Buffer buffer{1024, osmium::memory::Buffer::auto_grow::yes};
+    REQUIRE(osmium::opl_parse("r1 v1", buffer));
+    REQUIRE(osmium::opl_parse("n3 v2", buffer));
+    REQUIRE(osmium::opl_parse("w2 v1 Nn1,n3", buffer));
+    REQUIRE(osmium::opl_parse("n3 v1", buffer));
+    REQUIRE(osmium::opl_parse("n-1 v1", buffer));
+    REQUIRE(osmium::opl_parse("n1 v1 Tx=a", buffer));
+    REQUIRE(osmium::opl_parse("w1 v1 Nn3", buffer));
+    REQUIRE(osmium::opl_parse("n1 v1 Tx=b", buffer));
+    return buffer;
+}
+
+static const std::vector<std::string> expected_order = {
+    "n-1v1", "n1v1a", "n1v1b", "n3v1", "n3v2", "w1v1", "w2v1", "r1v1"
+};
+
+TEST_CASE("External sorter without data") {
+    osmium::ExternalSorter sorter;
+    REQUIRE(sorter.size() == 0);
+    REQUIRE_FALSE(sorter.read());
+    REQUIRE_FALSE(sorter.read());
+}
+
+TEST_CASE("External sorter in memory") {
+    const auto buffer = unsorted_data();
+
+    osmium::ExternalSorter sorter;
+    sorter(buffer);
+
+    REQUIRE(sorter.size() == 8);
+    REQUIRE(read_all(sorter) == expected_order);
+    REQUIRE(sorter.runs() == 0);
+    REQUIRE_FALSE(sorter.read());
+}
+
+TEST_CASE("External sorter with runs on disk") {
+    const auto buffer = unsorted_data();
+
+    // Small limits force a run to be written for every few objects.
+    osmium::ExternalSorter sorter{1, 128};
+    osmium::apply(buffer, sorter);
+
+    REQUIRE(sorter.size() == 8);
+    REQUIRE(read_all(sorter) == expected_order);
+    REQUIRE(sorter.runs() > 1);
+    REQUIRE_FALSE(sorter.read());
+}
+
+TEST_CASE("External sorter with many objects") {
+    osmium::memory::Buffer buffer{1024, osmium::memory::Buffer::auto_grow::yes};
+    const int num = 5000;
+    for (int i = 0; i < num; ++i) {
+        const int id = (i * 7919) % num + 1;
+        const std::string opl = "n" + std::to_string(id) + " v1 Tname=node" + std::to_string(id);
+        REQUIRE(osmium::opl_parse(opl.c_str(), buffer));
+    }
+
+    osmium::ExternalSorter sorter{16 * 1024, 4 * 1024};
+    sorter(buffer);
+    REQUIRE(sorter.runs() > 5);
+
+    osmium::object_id_type expected_id = 1;
+    int buffers = 0;
+    while (osmium::memory::Buffer out = sorter.read()) {
+        ++buffers;
+        REQUIRE(out.committed() <= 4 * 1024);
+        for (const auto& object : out.select<osmium::OSMObject>()) {
+            REQUIRE(object.id() == expected_id);
+            ++expected_id;
+        }
+    }
+    REQUIRE(expected_id == num + 1);
+    REQUIRE(buffers > 10);
+}
+
+TEST_CASE("External sorter can not add objects after read") {
+    const auto buffer = unsorted_data();
+
+    osmium::ExternalSorter sorter;
+    sorter(buffer);
+    REQUIRE(sorter.read());
+    REQUIRE_THROWS_AS(sorter(buffer), std::logic_error);
+}
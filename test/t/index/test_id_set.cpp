@@ -4,6 +4,9 @@
 #include <osmium/osm/types.hpp>
 
 #include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <vector>
 
 TEST_CASE("Basic functionality of IdSetDense") {
     osmium::index::IdSetDense<osmium::unsigned_object_id_type> s;
@@ -254,3 +257,125 @@ TEST_CASE("Merge two IdSetSmall") {
     REQUIRE(std::equal(s1.cbegin(), s1.cend(), ids.begin()));
 }
 
+
+TEST_CASE("Empty IdSetCompact") {
+    const osmium::index::IdSetCompact<osmium::unsigned_object_id_type> s;
+
+    REQUIRE(s.empty());
+    REQUIRE(s.size() == 0); // NOLINT(readability-container-size-empty)
+    REQUIRE_FALSE(s.get(0));
+    REQUIRE_FALSE(s.get(17));
+    REQUIRE(s.begin() == s.end());
+}
+
+TEST_CASE("IdSetCompact iterator is a forward iterator") {
+    using iterator = osmium::index::IdSetCompact<osmium::unsigned_object_id_type>::const_iterator;
+    static_assert(std::is_default_constructible<iterator>::value, "forward iterators must be default constructible");
+
+    const iterator a{};
+    const iterator b{};
+    REQUIRE(a == b);
+}
+
+TEST_CASE("IdSetCompact from IdSetSmall") {
+    osmium::index::IdSetSmall<osmium::unsigned_object_id_type> small;
+    small.set(23);
+    small.set(0);
+    small.set(7);
+    small.set(55);
+    small.set(42);
+    small.sort_unique();
+
+    const osmium::index::IdSetCompact<osmium::unsigned_object_id_type> s{small};
+
+    REQUIRE_FALSE(s.empty());
+    REQUIRE(s.size() == 5);
+
+    for (osmium::unsigned_object_id_type id = 0; id < 100; ++id) {
+        REQUIRE(s.get(id) == small.get_binary_search(id));
+    }
+
+    REQUIRE(std::equal(s.cbegin(), s.cend(), small.cbegin()));
+}
+
+TEST_CASE("IdSetCompact from IdSetDense") {
+    osmium::index::IdSetDense<osmium::unsigned_object_id_type> dense;
+
+    // mix of dense and sparse areas
+    for (osmium::unsigned_object_id_type id = 1000; id < 3000; ++id) {
+        dense.set(id);
+    }
+    for (osmium::unsigned_object_id_type id = 10000; id < 1000000; id += 997) {
+        dense.set(id);
+    }
+    dense.set(1ULL << 33U);
+
+    const osmium::index::IdSetCompact<osmium::unsigned_object_id_type> s{dense};
+    REQUIRE(s.size() == dense.size());
+
+    std::size_t mismatches = 0;
+    for (osmium::unsigned_object_id_type id = 0; id < 1100000; ++id) {
+        if (s.get(id) != dense.get(id)) {
+            ++mismatches;
+        }
+    }
+    REQUIRE(mismatches == 0);
+    REQUIRE(s.get(1ULL << 33U));
+    REQUIRE_FALSE(s.get((1ULL << 33U) + 1));
+    REQUIRE_FALSE(s.get((1ULL << 33U) - 1));
+
+    REQUIRE(std::equal(s.begin(), s.end(), dense.begin()));
+}
+
+TEST_CASE("IdSetCompact with large Ids") {
+    const std::vector<osmium::unsigned_object_id_type> ids = {
+        17, 19, 1ULL << 40U, (1ULL << 40U) + 3, std::numeric_limits<osmium::unsigned_object_id_type>::max()
+    };
+
+    const osmium::index::IdSetCompact<osmium::unsigned_object_id_type> s{ids.cbegin(), ids.cend()};
+    REQUIRE(s.size() == ids.size());
+
+    for (const auto id : ids) {
+        REQUIRE(s.get(id));
+        REQUIRE_FALSE(s.get(id - 1));
+    }
+
+    REQUIRE(std::equal(s.begin(), s.end(), ids.cbegin()));
+}
+
+TEST_CASE("Union and intersection of IdSetCompact") {
+    const std::vector<osmium::unsigned_object_id_type> ids1 = {2, 7, 23, 42, 55};
+    const std::vector<osmium::unsigned_object_id_type> ids2 = {1, 2, 8, 32, 55};
+
+    const osmium::index::IdSetCompact<osmium::unsigned_object_id_type> s1{ids1.cbegin(), ids1.cend()};
+    const osmium::index::IdSetCompact<osmium::unsigned_object_id_type> s2{ids2.cbegin(), ids2.cend()};
+
+    const auto u = set_union(s1, s2);
+    REQUIRE(u.size() == 8);
+    const auto ids_union = {1, 2, 7, 8, 23, 32, 42, 55};
+    REQUIRE(std::equal(u.cbegin(), u.cend(), ids_union.begin()));
+    REQUIRE(u.get(32));
+    REQUIRE_FALSE(u.get(33));
+
+    const auto i = set_intersection(s1, s2);
+    REQUIRE(i.size() == 2);
+    const auto ids_intersection = {2, 55};
+    REQUIRE(std::equal(i.cbegin(), i.cend(), ids_intersection.begin()));
+    REQUIRE(i.get(2));
+    REQUIRE_FALSE(i.get(7));
+
+    const osmium::index::IdSetCompact<osmium::unsigned_object_id_type> empty;
+    REQUIRE(set_intersection(s1, empty).empty());
+    REQUIRE(set_union(s1, empty).size() == s1.size());
+}
+
+TEST_CASE("IdSetCompact uses less memory than IdSetSmall") {
+    osmium::index::IdSetSmall<osmium::unsigned_object_id_type> small;
+    for (osmium::unsigned_object_id_type id = 0; id < 10000000; id += 37) {
+        small.set(id);
+    }
+
+    const osmium::index::IdSetCompact<osmium::unsigned_object_id_type> s{small};
+    REQUIRE(s.size() == small.size());
+    REQUIRE(s.used_memory() * 4 < small.used_memory());
+}
@@ -0,0 +1,171 @@
+#include "catch.hpp"
+
+#include <osmium/handler/object_hash_index.hpp>
+#include <osmium/index/detail/tmpfile.hpp>
+#include <osmium/index/object_hash.hpp>
+#include <osmium/memory/buffer.hpp>
+#include <osmium/opl.hpp>
+#include <osmium/osm/crc64.hpp>
+#include <osmium/visitor.hpp>
+
+#include <unistd.h>
+
+#include <utility>
+#include <vector>
+
+using change_list = std::vector<std::pair<osmium::index::object_hash_change, osmium::object_id_type>>;
+
+static const osmium::OSMObject& parse(osmium::memory::Buffer& buffer, const char* opl) {
+    buffer.clear();
+    REQUIRE(osmium::opl_parse(opl, buffer));
+    return buffer.get<osmium::OSMObject>(0);
+}
+
+static std::vector<osmium::index::object_hash_entry> build_index(const std::vector<const char*>& objects) {
+    osmium::memory::Buffer buffer{1024, osmium::memory::Buffer::auto_grow::yes};
+    for (const auto* opl : objects) {
+        REQUIRE(osmium::opl_parse(opl, buffer));
+    }
+
+    const int fd = osmium::detail::create_tmp_file();
+    {
+        osmium::handler::ObjectHashIndex handler{fd};
+        osmium::apply(buffer, handler);
+        REQUIRE(handler.count() == objects.size());
+    }
+
+    REQUIRE(::lseek(fd, 0, SEEK_SET) == 0);
+    auto entries = osmium::index::read_object_hashes(fd);
+    ::close(fd);
+    return entries;
+}
+
+static change_list diff(const std::vector<osmium::index::object_hash_entry>& old_entries, const std::vector<osmium::index::object_hash_entry>& new_entries) {
+    change_list changes;
+    osmium::index::diff_object_hashes(old_entries, new_entries, [&](osmium::index::object_hash_change change, const osmium::index::object_hash_entry& entry) {
+        changes.emplace_back(change, entry.id);
+    });
+    return changes;
+}
+
+TEST_CASE("CRC64 check value") {
+    osmium::CRC_crc64 crc;
+    crc.process_bytes("123456789", 9);
+    REQUIRE(crc.checksum() == 0x995dc9bbdf1939faULL);
+}
+
+TEST_CASE("Object hash depends on contents") {
+    osmium::memory::Buffer buffer{1024};
+
+    const auto hash = osmium::index::object_hash(parse(buffer, "n1 v1 c3 t2020-01-01T00:00:00Z i5 ufoo Tamenity=pub x1.5 y2.5"));
+
+    REQUIRE(hash == osmium::index::object_hash(parse(buffer, "n2 v7 c8 t2021-01-01T00:00:00Z i6 ubar Tamenity=pub x1.5 y2.5")));
+    REQUIRE(hash != osmium::index::object_hash(parse(buffer, "n1 v1 Tamenity=cafe x1.5 y2.5")));
+    REQUIRE(hash != osmium::index::object_hash(parse(buffer, "n1 v1 Tamenity=pub x1.5 y2.6")));
+    REQUIRE(hash != osmium::index::object_hash(parse(buffer, "n1 v1 dD Tamenity=pub x1.5 y2.5")));
+}
+
+TEST_CASE("Object hash with metadata") {
+    osmium::memory::Buffer buffer{1024};
+    const osmium::metadata_options md{"version+user"};
+
+    const auto hash = osmium::index::object_hash(parse(buffer, "w1 v1 c3 i5 ufoo Nn1,n2"), md);
+
+    REQUIRE(hash == osmium::index::object_hash(parse(buffer, "w1 v1 c4 i6 ufoo Nn1,n2"), md));
+    REQUIRE(hash != osmium::index::object_hash(parse(buffer, "w1 v2 c3 i5 ufoo Nn1,n2"), md));
+    REQUIRE(hash != osmium::index::object_hash(parse(buffer, "w1 v1 c3 i5 ubar Nn1,n2"), md));
+}
+
+TEST_CASE("Object hash of way doesn't depend on node locations") {
+    osmium::memory::Buffer buffer{1024};
+
+    const auto hash = osmium::index::object_hash(parse(buffer, "w1 Nn1,n2"));
+    REQUIRE(hash == osmium::index::object_hash(parse(buffer, "w1 Nn1x1y2,n2x3y4")));
+    REQUIRE(hash != osmium::index::object_hash(parse(buffer, "w1 Nn2,n1")));
+}
+
+TEST_CASE("Object hash index handler writes entries in order") {
+    const auto entries = build_index({"n-3 Tfoo=bar", "n1", "n5 v2", "w1 Nn1,n5", "r1 Mw1@outer"});
+
+    REQUIRE(entries.size() == 5);
+    REQUIRE(entries[0].item_type() == osmium::item_type::node);
+    REQUIRE(entries[0].id == -3);
+    REQUIRE(entries[2].id == 5);
+    REQUIRE(entries[2].version == 2);
+    REQUIRE(entries[3].item_type() == osmium::item_type::way);
+    REQUIRE(entries[4].item_type() == osmium::item_type::relation);
+}
+
+TEST_CASE("Object hash index handler needs ordered input") {
+    osmium::memory::Buffer buffer{1024};
+    REQUIRE(osmium::opl_parse("n5", buffer));
+    REQUIRE(osmium::opl_parse("n3", buffer));
+
+    const int fd = osmium::detail::create_tmp_file();
+    osmium::handler::ObjectHashIndex handler{fd};
+    REQUIRE_THROWS_AS(osmium::apply(buffer, handler), osmium::out_of_order_error);
+    ::close(fd);
+}
+
+TEST_CASE("Diff of identical object hash indexes is empty") {
+    const auto entries = build_index({"n1 Ta=b", "n2", "w1 Nn1,n2"});
+    REQUIRE(diff(entries, entries).empty());
+}
+
+TEST_CASE("Diff of object hash indexes") {
+    const auto old_entries = build_index({"n1 v1 Ta=b", "n2 v1", "n3 v1", "w1 v1 Nn1,n2", "r5 v1 Mn1@"});
+    const auto new_entries = build_index({"n1 v2 Ta=b", "n3 v2 Ta=c", "n4 v1", "w1 v1 Nn1,n2", "w2 v1 Nn3,n4", "r5 v2 Mn1@foo"});
+
+    const change_list expected = {
+        {osmium::index::object_hash_change::deleted,  2},
+        {osmium::index::object_hash_change::modified, 3},
+        {osmium::index::object_hash_change::created,  4},
+        {osmium::index::object_hash_change::created,  2},
+        {osmium::index::object_hash_change::modified, 5}
+    };
+    REQUIRE(diff(old_entries, new_entries) == expected);
+}
+
+TEST_CASE("Diff of object hash indexes uses latest version of history data") {
+    const auto old_entries = build_index({"n1 v1 Ta=b", "n1 v2 Ta=c", "n2 v1"});
+    const auto new_entries = build_index({"n1 v3 Ta=c", "n2 v1", "n2 v2 dD"});
+
+    const change_list expected = {
+        {osmium::index::object_hash_change::modified, 2}
+    };
+    REQUIRE(diff(old_entries, new_entries) == expected);
+}
+
+TEST_CASE("Diff of object hash index files") {
+    osmium::memory::Buffer old_buffer{1024};
+    REQUIRE(osmium::opl_parse("n1 Ta=b", old_buffer));
+    REQUIRE(osmium::opl_parse("n2", old_buffer));
+    osmium::memory::Buffer new_buffer{1024};
+    REQUIRE(osmium::opl_parse("n2", new_buffer));
+    REQUIRE(osmium::opl_parse("n3", new_buffer));
+
+    const int old_fd = osmium::detail::create_tmp_file();
+    const int new_fd = osmium::detail::create_tmp_file();
+    {
+        osmium::handler::ObjectHashIndex old_handler{old_fd};
+        osmium::apply(old_buffer, old_handler);
+        osmium::handler::ObjectHashIndex new_handler{new_fd};
+        osmium::apply(new_buffer, new_handler);
+    }
+    REQUIRE(::lseek(old_fd, 0, SEEK_SET) == 0);
+    REQUIRE(::lseek(new_fd, 0, SEEK_SET) == 0);
+
+    change_list changes;
+    osmium::index::diff_object_hash_files(old_fd, new_fd, [&](osmium::index::object_hash_change change, const osmium::index::object_hash_entry& entry) {
+        changes.emplace_back(change, entry.id);
+    });
+
+    const change_list expected = {
+        {osmium::index::object_hash_change::deleted, 1},
+        {osmium::index::object_hash_change::created, 3}
+    };
+    REQUIRE(changes == expected);
+
+    ::close(old_fd);
+    ::close(new_fd);
+}
@@ -0,0 +1,168 @@
+#include "catch.hpp"
+
+#include <osmium/change_applier.hpp>
+#include <osmium/io/opl_input.hpp>
+#include <osmium/io/xml_input.hpp>
+#include <osmium/memory/buffer.hpp>
+#include <osmium/opl.hpp>
+#include <osmium/osm/object.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+    // Source returning one buffer per group of OPL lines.
+    class MockSource {
+
+        std::vector<osmium::memory::Buffer> m_buffers;
+        std::size_t m_next = 0;
+
+    public:
+
+        explicit MockSource(const std::vector<std::vector<const char*>>& groups) {
+            for (const auto& group : groups) {
+                osmium::memory::Buffer buffer{1024, osmium::memory::Buffer::auto_grow::yes};
+                for (const auto* opl : group) {
+                    REQUIRE(osmium::opl_parse(opl, buffer));
+                }
+                m_buffers.push_back(std::move(buffer));
+            }
+        }
+
+        osmium::memory::Buffer read() {
+            if (m_next == m_buffers.size()) {
+                return osmium::memory::Buffer{};
+            }
+            return std::move(m_buffers[m_next++]);
+        }
+
+    }; // class MockSource
+
+    struct Output {
+
+        std::vector<std::string> objects;
+        std::size_t buffers = 0;
+
+        void operator()(osmium::memory::Buffer&& buffer) {
+            ++buffers;
+            for (const auto& object : buffer.select<osmium::OSMObject>()) {
+                std::string str{osmium::item_type_to_char(object.type())};
+                str += std::to_string(object.id()) + "v" + std::to_string(object.version());
+                if (!object.visible()) {
+                    str += "d";
+                }
+                objects.push_back(str);
+            }
+        }
+
+    }; // struct Output
+
+    osmium::memory::Buffer parse(const std::vector<const char*>& lines) {
+        osmium::memory::Buffer buffer{1024, osmium::memory::Buffer::auto_grow::yes};
+        for (const auto* opl : lines) {
+            REQUIRE(osmium::opl_parse(opl, buffer));
+        }
+        return buffer;
+    }
+
+} // anonymous namespace
+
+TEST_CASE("Apply changes to snapshot") {
+    osmium::ChangeApplier applier;
+    applier.add_changes(parse({"n2 v3", "n5 v1", "w1 v2 dD", "n2 v2", "n4 v2 dD"}));
+    REQUIRE(applier.num_changes() == 5);
+
+    MockSource base{{{"n1 v1", "n2 v1", "n4 v1"}, {"w1 v1 Nn1,n2", "w2 v1 Nn2,n4"}, {"r1 v1"}}};
+    Output output;
+    applier.apply(base, output);
+
+    const std::vector<std::string> expected = {"n1v1", "n2v3", "n5v1", "w2v1", "r1v1"};
+    REQUIRE(output.objects == expected);
+    REQUIRE(applier.num_changes() == 4);
+    REQUIRE(applier.changes_applied() == 4);
+    REQUIRE(applier.base_objects() == 6);
+    REQUIRE(applier.unchanged_buffers() == 1);
+}
+
+TEST_CASE("Apply changes passes through unchanged buffers") {
+    osmium::ChangeApplier applier;
+    applier.add_changes(parse({"n5 v2"}));
+
+    MockSource base{{{"n1 v1", "n2 v1"}, {"n5 v1", "n6 v1"}, {"w1 v1"}, {"r1 v1"}}};
+    Output output;
+    applier.apply(base, output);
+
+    const std::vector<std::string> expected = {"n1v1", "n2v1", "n5v2", "n6v1", "w1v1", "r1v1"};
+    REQUIRE(output.objects == expected);
+    REQUIRE(applier.unchanged_buffers() == 3);
+    REQUIRE(output.buffers == 4);
+}
+
+TEST_CASE("Apply changes at the beginning and the end") {
+    osmium::ChangeApplier applier;
+    applier.add_changes(parse({"r9 v1", "n-3 v1"}));
+
+    MockSource base{{{"n1 v1"}, {"r1 v1"}}};
+    Output output;
+    applier.apply(base, output);
+
+    const std::vector<std::string> expected = {"n-3v1", "n1v1", "r1v1", "r9v1"};
+    REQUIRE(output.objects == expected);
+}
+
+TEST_CASE("Apply changes to snapshot keeps newer objects from base") {
+    osmium::ChangeApplier applier;
+    applier.add_changes(parse({"n1 v4 Ta=change", "n2 v3 dD", "w1 v3", "n3 v1"}));
+
+    MockSource base{{{"n1 v5 Ta=base", "n2 v3", "n3 v2"}, {"w1 v2"}}};
+    Output output;
+    applier.apply(base, output);
+
+    const std::vector<std::string> expected = {"n1v5", "n3v2", "w1v3"};
+    REQUIRE(output.objects == expected);
+    REQUIRE(applier.changes_applied() == 2);
+    REQUIRE(applier.changes_skipped() == 2);
+}
+
+TEST_CASE("Apply changes in history mode") {
+    osmium::ChangeApplier applier{true};
+    applier.add_changes(parse({"n2 v3", "n1 v2 dD", "n2 v2", "n2 v3"}));
+
+    MockSource base{{{"n1 v1", "n2 v1", "n2 v2"}, {"w1 v1"}}};
+    Output output;
+    applier.apply(base, output);
+
+    const std::vector<std::string> expected = {"n1v1", "n1v2d", "n2v1", "n2v2", "n2v3", "w1v1"};
+    REQUIRE(output.objects == expected);
+    REQUIRE(applier.num_changes() == 3);
+    REQUIRE(applier.unchanged_buffers() == 1);
+}
+
+TEST_CASE("Apply changes from change file to OPL file") {
+    const std::string osc{
+        "<?xml version='1.0' encoding='UTF-8'?>\n"
+        "<osmChange version='0.6' generator='test'>\n"
+        "  <modify>\n"
+        "    <node id='2' version='2' lat='1' lon='1'/>\n"
+        "  </modify>\n"
+        "  <delete>\n"
+        "    <node id='3' version='2' lat='1' lon='1'/>\n"
+        "  </delete>\n"
+        "</osmChange>\n"
+    };
+    const std::string opl{"n1 v1 x1 y1\nn2 v1 x1 y1\nn3 v1 x1 y1\nw1 v1 Nn1,n2\n"};
+
+    osmium::ChangeApplier applier;
+    applier.read_changes(osmium::io::File{osc.data(), osc.size(), "osc"});
+    REQUIRE(applier.num_changes() == 2);
+
+    osmium::io::Reader reader{osmium::io::File{opl.data(), opl.size(), "opl"}};
+    Output output;
+    applier.apply(reader, output);
+    reader.close();
+
+    const std::vector<std::string> expected = {"n1v1", "n2v2", "w1v1"};
+    REQUIRE(output.objects == expected);
+}
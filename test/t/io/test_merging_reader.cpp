@@ -0,0 +1,143 @@
+#include "catch.hpp"
+
+#include "utils.hpp"
+
+#include <osmium/io/merging_reader.hpp>
+#include <osmium/io/opl_input.hpp>
+#include <osmium/io/xml_input.hpp>
+#include <osmium/memory/buffer.hpp>
+#include <osmium/osm/object.hpp>
+
+#include <string>
+#include <vector>
+
+static osmium::io::File opl_file(const std::string& data) {
+    return osmium::io::File{data.data(), data.size(), "opl"};
+}
+
+static std::vector<std::string> read_all(osmium::io::MergingReader& reader) {
+    std::vector<std::string> result;
+    while (osmium::memory::Buffer buffer = reader.read()) {
+        for (const auto& object : buffer.select<osmium::OSMObject>()) {
+            result.push_back(osmium::item_type_to_char(object.type()) + std::to_string(object.id()) + "v" + std::to_string(object.version()));
+        }
+    }
+    return result;
+}
+
+TEST_CASE("Merging reader with no inputs") {
+    osmium::io::MergingReader reader{std::vector<osmium::io::File>{}};
+    REQUIRE(reader.size() == 0);
+    REQUIRE_FALSE(reader.read());
+}
+
+TEST_CASE("Merging reader merges sorted inputs") {
+    const std::string data1{"n1 v1\nn3 v1\nw2 v1 Nn1,n3\nr1 v1\n"};
+    const std::string data2{"n-5 v1\nn2 v1\nn4 v1\nw1 v1 Nn2,n4\n"};
+    const std::string data3{"w3 v1\n"};
+
+    osmium::io::MergingReader reader{std::vector<osmium::io::File>{opl_file(data1), opl_file(data2), opl_file(data3)}};
+    REQUIRE(reader.size() == 3);
+
+    const std::vector<std::string> expected = {
+        "n-5v1", "n1v1", "n2v1", "n3v1", "n4v1", "w1v1", "w2v1", "w3v1", "r1v1"
+    };
+    REQUIRE(read_all(reader) == expected);
+    REQUIRE(reader.duplicates() == 0);
+    REQUIRE_FALSE(reader.read());
+    reader.close();
+}
+
+TEST_CASE("Merging reader removes duplicates and keeps all versions") {
+    const std::string data1{"n1 v1 Ta=first\nn1 v2\nn2 v1\n"};
+    const std::string data2{"n1 v1 Ta=second\nn1 v3\nn2 v1\n"};
+
+    osmium::io::MergingReader reader{std::vector<osmium::io::File>{opl_file(data1), opl_file(data2)}};
+
+    std::vector<std::string> tags;
+    std::size_t count = 0;
+    while (osmium::memory::Buffer buffer = reader.read()) {
+        for (const auto& object : buffer.select<osmium::OSMObject>()) {
+            ++count;
+            if (object.id() == 1 && object.version() == 1) {
+                tags.emplace_back(object.tags().get_value_by_key("a"));
+            }
+        }
+    }
+
+    REQUIRE(count == 4);
+    REQUIRE(reader.duplicates() == 2);
+    REQUIRE(tags == std::vector<std::string>{"first"});
+}
+
+TEST_CASE("Merging reader uses first input for same version with different timestamps") {
+    const std::string data1{"n1 v1 t2020-01-02T00:00:00Z Ta=first\nn2 v1 t2020-01-01T00:00:00Z Ta=first\n"};
+    const std::string data2{"n1 v1 t2020-01-01T00:00:00Z Ta=second\nn2 v1 t2020-01-02T00:00:00Z Ta=second\n"};
+
+    osmium::io::MergingReader reader{std::vector<osmium::io::File>{opl_file(data1), opl_file(data2)}};
+
+    std::vector<std::string> tags;
+    while (osmium::memory::Buffer buffer = reader.read()) {
+        for (const auto& object : buffer.select<osmium::OSMObject>()) {
+            tags.emplace_back(object.tags().get_value_by_key("a"));
+        }
+    }
+
+    REQUIRE(tags == std::vector<std::string>{"first", "first"});
+    REQUIRE(reader.duplicates() == 2);
+}
+
+TEST_CASE("Merging reader with small output buffers") {
+    std::string data1;
+    std::string data2;
+    for (int i = 1; i <= 2000; ++i) {
+        (i % 3 ? data1 : data2) += "n" + std::to_string(i) + " Tname=node" + std::to_string(i) + "\n";
+    }
+
+    osmium::io::MergingReader reader{std::vector<osmium::io::File>{opl_file(data1), opl_file(data2)}};
+    reader.set_buffer_size(1024);
+
+    osmium::object_id_type expected_id = 1;
+    int buffers = 0;
+    while (osmium::memory::Buffer buffer = reader.read()) {
+        ++buffers;
+        for (const auto& object : buffer.select<osmium::OSMObject>()) {
+            REQUIRE(object.id() == expected_id);
+            ++expected_id;
+        }
+    }
+    REQUIRE(expected_id == 2001);
+    REQUIRE(buffers > 10);
+}
+
+TEST_CASE("Merging reader passes options to readers") {
+    const std::string data1{"n1 v1\nw1 v1\n"};
+    const std::string data2{"n2 v1\nr1 v1\n"};
+
+    osmium::io::MergingReader reader{std::vector<osmium::io::File>{opl_file(data1), opl_file(data2)}, osmium::osm_entity_bits::node};
+
+    const std::vector<std::string> expected = {"n1v1", "n2v1"};
+    REQUIRE(read_all(reader) == expected);
+}
+
+TEST_CASE("Merging reader reading files") {
+    const std::vector<std::string> filenames = {
+        with_data_dir("t/io/data.osm"),
+        with_data_dir("t/io/data.osm")
+    };
+
+    osmium::io::MergingReader reader{filenames};
+    REQUIRE(reader.header(0).get("generator") == "testdata");
+
+    const auto objects = read_all(reader);
+    REQUIRE(objects.size() == 1);
+    REQUIRE(reader.duplicates() == 1);
+}
+
+TEST_CASE("Merging reader detects unsorted input") {
+    const std::string data1{"n1 v1\n"};
+    const std::string data2{"n3 v1\nn2 v1\n"};
+
+    osmium::io::MergingReader reader{std::vector<osmium::io::File>{opl_file(data1), opl_file(data2)}};
+    REQUIRE_THROWS_AS(read_all(reader), osmium::out_of_order_error);
+}
@@ -124,3 +124,23 @@ TEST_CASE("Write uncompressed file with implicit close") {
     REQUIRE(osmium::file_size(output_file) == 3);
 }
 
+
+TEST_CASE("Write uncompressed file with fsync interval") {
+    const int count = count_fds();
+
+    const std::string output_file = "test_uncompressed_out.txt";
+    const int fd = osmium::io::detail::open_for_writing(output_file, osmium::io::overwrite::allow);
+    REQUIRE(fd > 0);
+
+    osmium::io::NoCompressor comp{fd, osmium::io::fsync::no};
+    comp.set_fsync_interval(4);
+    comp.write("foo");
+    comp.write("bar");
+    comp.write("baz");
+    comp.close();
+
+    REQUIRE(count == count_fds());
+
+    REQUIRE(comp.file_size() == 9);
+    REQUIRE(osmium::file_size(output_file) == 9);
+}
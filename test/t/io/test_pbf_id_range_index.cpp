@@ -0,0 +1,197 @@
+#include "catch.hpp"
+
+#include <osmium/builder/attr.hpp>
+#include <osmium/handler/check_order.hpp>
+#include <osmium/io/detail/read_write.hpp>
+#include <osmium/io/pbf_id_range_index.hpp>
+#include <osmium/io/pbf_output.hpp>
+#include <osmium/io/writer.hpp>
+#include <osmium/memory/buffer.hpp>
+#include <osmium/osm/node.hpp>
+#include <osmium/osm/way.hpp>
+#include <osmium/util/file.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+static const char* pbf_file_name = "test-pbf-id-range-index.osm.pbf";
+static const char* index_file_name = "test-pbf-id-range-index.osm.pbf.idx";
+
+static void write_file(osmium::memory::Buffer&& buffer) {
+    osmium::io::Header header;
+    osmium::io::Writer writer{pbf_file_name, header, osmium::io::overwrite::allow};
+    writer(std::move(buffer));
+    writer.close();
+}
+
+static void write_sorted_file() {
+    using namespace osmium::builder::attr; // NOLINT(google-build-using-namespace)
+
+    osmium::memory::Buffer buffer{1024 * 1024, osmium::memory::Buffer::auto_grow::yes};
+    osmium::builder::add_node(buffer, _id(-5), _version(1), _location(0.5, 0.5));
+    for (int i = 1; i <= 20000; ++i) {
+        osmium::builder::add_node(buffer, _id(i * 2), _version(1), _location(i * 0.001, 1.0), _tag("n", std::to_string(i * 2)));
+    }
+    for (int i = 1; i <= 10; ++i) {
+        osmium::builder::add_way(buffer, _id(i), _version(1), _nodes({i * 2, i * 2 + 2}), _tag("highway", "road"));
+    }
+    osmium::builder::add_relation(buffer, _id(7), _version(3), _member(osmium::item_type::way, 1));
+    write_file(std::move(buffer));
+}
+
+TEST_CASE("Build id range index for sorted PBF file") {
+    write_sorted_file();
+
+    const auto index = osmium::io::build_pbf_id_range_index(pbf_file_name);
+    REQUIRE(index.size() >= 4);
+    REQUIRE(index.file_size() == osmium::file_size(pbf_file_name));
+
+    const auto& first = *index.begin();
+    REQUIRE(first.first_type == static_cast<uint16_t>(osmium::item_type::node));
+    REQUIRE(first.first_id == -5);
+
+    REQUIRE(index.find(osmium::item_type::node, -5) == &first);
+    REQUIRE(index.find(osmium::item_type::node, 2) == &first);
+    REQUIRE(index.find(osmium::item_type::node, 3) == &first);
+    REQUIRE(index.find(osmium::item_type::node, 40000));
+    REQUIRE(index.find(osmium::item_type::node, -4) == nullptr); // sorted by absolute id
+    REQUIRE(index.find(osmium::item_type::node, 40002) == nullptr);
+    REQUIRE(index.find(osmium::item_type::way, 5));
+    REQUIRE(index.find(osmium::item_type::way, 11) == nullptr);
+    REQUIRE(index.find(osmium::item_type::relation, 7));
+    REQUIRE(index.find(osmium::item_type::relation, 1) == nullptr);
+
+    SECTION("Get objects") {
+        osmium::io::IndexedPBFReader reader{pbf_file_name, index};
+
+        const auto* node = reader.get_object(osmium::item_type::node, 30000);
+        REQUIRE(node);
+        REQUIRE(node->type() == osmium::item_type::node);
+        REQUIRE(node->id() == 30000);
+        REQUIRE(std::string{node->tags()["n"]} == "30000");
+        REQUIRE(static_cast<const osmium::Node*>(node)->location() == osmium::Location{15.0, 1.0});
+        REQUIRE(reader.blobs_decoded() == 1);
+
+        // Nodes in the same blob don't need another decode.
+        REQUIRE(reader.get_object(osmium::item_type::node, 30002));
+        REQUIRE_FALSE(reader.get_object(osmium::item_type::node, 30001));
+        REQUIRE(reader.blobs_decoded() == 1);
+
+        node = reader.get_object(osmium::item_type::node, -5);
+        REQUIRE(node);
+        REQUIRE(node->id() == -5);
+        REQUIRE(reader.blobs_decoded() == 2);
+
+        const auto* way = reader.get_object(osmium::item_type::way, 3);
+        REQUIRE(way);
+        REQUIRE(way->type() == osmium::item_type::way);
+        REQUIRE(static_cast<const osmium::Way*>(way)->nodes().size() == 2);
+        REQUIRE(static_cast<const osmium::Way*>(way)->nodes()[0].ref() == 6);
+
+        const auto* relation = reader.get_object(osmium::item_type::relation, 7);
+        REQUIRE(relation);
+        REQUIRE(relation->version() == 3);
+
+        REQUIRE_FALSE(reader.get_object(osmium::item_type::way, 11));
+        REQUIRE_FALSE(reader.get_object(osmium::item_type::relation, 8));
+    }
+
+    SECTION("Get objects without metadata") {
+        osmium::io::IndexedPBFReader reader{pbf_file_name, index, osmium::io::read_meta::no};
+        const auto* relation = reader.get_object(osmium::item_type::relation, 7);
+        REQUIRE(relation);
+        REQUIRE(relation->version() == 0);
+    }
+
+    SECTION("Dump and load index") {
+        const int fd = osmium::io::detail::open_for_writing(index_file_name, osmium::io::overwrite::allow);
+        index.dump(fd);
+        osmium::io::detail::reliable_close(fd);
+
+        const int rfd = osmium::io::detail::open_for_reading(index_file_name);
+        const osmium::io::PBFIdRangeIndex loaded{rfd};
+        osmium::io::detail::reliable_close(rfd);
+
+        REQUIRE(loaded.size() == index.size());
+        REQUIRE(loaded.file_size() == index.file_size());
+        REQUIRE(std::equal(loaded.begin(), loaded.end(), index.begin(), [](const osmium::io::pbf_id_range& a, const osmium::io::pbf_id_range& b) {
+            return a.offset == b.offset && a.size == b.size && a.first_id == b.first_id && a.last_id == b.last_id;
+        }));
+
+        osmium::io::IndexedPBFReader reader{pbf_file_name, loaded};
+        REQUIRE(reader.get_object(osmium::item_type::way, 10));
+
+        std::remove(index_file_name);
+    }
+
+    SECTION("Index not for this file") {
+        osmium::io::PBFIdRangeIndex other;
+        REQUIRE_THROWS_AS(osmium::io::IndexedPBFReader(pbf_file_name, other), std::runtime_error);
+    }
+
+    std::remove(pbf_file_name);
+}
+
+TEST_CASE("Loading invalid id range index fails") {
+    const int fd = osmium::io::detail::open_for_writing(index_file_name, osmium::io::overwrite::allow);
+    osmium::io::detail::reliable_write(fd, "something else entirely", 23);
+    osmium::io::detail::reliable_close(fd);
+
+    const int rfd = osmium::io::detail::open_for_reading(index_file_name);
+    REQUIRE_THROWS_AS(osmium::io::PBFIdRangeIndex{rfd}, std::runtime_error);
+    osmium::io::detail::reliable_close(rfd);
+
+    std::remove(index_file_name);
+}
+
+TEST_CASE("Loading id range index with wrong entry count fails") {
+    osmium::io::PBFIdRangeIndex index;
+    osmium::io::pbf_id_range range;
+    range.first_id = 1;
+    range.last_id = 10;
+    index.add(range);
+    range.first_id = 11;
+    range.last_id = 20;
+    index.add(range);
+
+    const int fd = osmium::io::detail::open_for_writing(index_file_name, osmium::io::overwrite::allow);
+    index.dump(fd);
+
+    SECTION("Truncated file") {
+        osmium::resize_file(fd, osmium::file_size(fd) - 1);
+    }
+
+    SECTION("Count too large") {
+        const uint64_t count = 1ULL << 60U;
+        osmium::file_seek(fd, 16);
+        osmium::io::detail::reliable_write(fd, reinterpret_cast<const char*>(&count), sizeof(count));
+    }
+
+    osmium::io::detail::reliable_close(fd);
+
+    const int rfd = osmium::io::detail::open_for_reading(index_file_name);
+    REQUIRE_THROWS_AS(osmium::io::PBFIdRangeIndex{rfd}, osmium::pbf_error);
+    osmium::io::detail::reliable_close(rfd);
+
+    std::remove(index_file_name);
+}
+
+TEST_CASE("Building id range index for unsorted PBF file fails") {
+    using namespace osmium::builder::attr; // NOLINT(google-build-using-namespace)
+
+    osmium::memory::Buffer buffer{1024 * 1024, osmium::memory::Buffer::auto_grow::yes};
+    for (int i = 10001; i <= 20000; ++i) {
+        osmium::builder::add_node(buffer, _id(i), _version(1), _location(1.0, 1.0));
+    }
+    for (int i = 1; i <= 10000; ++i) {
+        osmium::builder::add_node(buffer, _id(i), _version(1), _location(1.0, 1.0));
+    }
+    write_file(std::move(buffer));
+
+    REQUIRE_THROWS_AS(osmium::io::build_pbf_id_range_index(pbf_file_name), osmium::out_of_order_error);
+
+    std::remove(pbf_file_name);
+}
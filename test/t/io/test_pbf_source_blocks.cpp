@@ -0,0 +1,263 @@
+#include "catch.hpp"
+
+#include <osmium/builder/attr.hpp>
+#include <osmium/io/pbf_input.hpp>
+#include <osmium/io/pbf_output.hpp>
+#include <osmium/memory/buffer.hpp>
+#include <osmium/osm/node.hpp>
+#include <osmium/osm/object.hpp>
+#include <osmium/util/options.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+static const char* input_file_name = "test-source-blocks-in.osm.pbf";
+static const char* output_file_name = "test-source-blocks-out.osm.pbf";
+
+static void write_input_file() {
+    using namespace osmium::builder::attr; // NOLINT(google-build-using-namespace)
+
+    osmium::memory::Buffer buffer{1024 * 1024, osmium::memory::Buffer::auto_grow::yes};
+    for (int i = 1; i <= 20000; ++i) {
+        osmium::builder::add_node(buffer, _id(i), _version(1), _location(i * 0.001, 1.0), _tag("n", std::to_string(i)));
+    }
+    for (int i = 1; i <= 10; ++i) {
+        osmium::builder::add_way(buffer, _id(i), _version(1), _nodes({i, i + 1}));
+    }
+
+    osmium::io::Header header;
+    header.set("generator", "test");
+    osmium::io::Writer writer{input_file_name, header, osmium::io::overwrite::allow};
+    writer(std::move(buffer));
+    writer.close();
+}
+
+static std::vector<osmium::Location> read_locations(const char* file_name) {
+    std::vector<osmium::Location> locations;
+    osmium::io::Reader reader{file_name};
+    while (osmium::memory::Buffer buffer = reader.read()) {
+        for (const auto& node : buffer.select<osmium::Node>()) {
+            locations.push_back(node.location());
+        }
+    }
+    reader.close();
+    return locations;
+}
+
+TEST_CASE("PBF reader attaches source blocks if asked to") {
+    write_input_file();
+
+    osmium::io::Reader reader{input_file_name, osmium::io::keep_source_blocks::yes};
+    int buffers = 0;
+    while (osmium::memory::Buffer buffer = reader.read()) {
+        ++buffers;
+        const auto& block = buffer.get_source_block();
+        REQUIRE(block);
+        REQUIRE(block->format == "pbf");
+        REQUIRE_FALSE(block->data.empty());
+        REQUIRE_FALSE(buffer.is_unchanged());
+
+        const osmium::OSMObject* first = nullptr;
+        const osmium::OSMObject* last = nullptr;
+        for (const auto& object : buffer.select<osmium::OSMObject>()) {
+            if (!first) {
+                first = &object;
+            }
+            last = &object;
+        }
+        REQUIRE(first);
+        REQUIRE(block->first_type == first->type());
+        REQUIRE(block->first_id == first->id());
+        REQUIRE(block->last_type == last->type());
+        REQUIRE(block->last_id == last->id());
+    }
+    reader.close();
+    REQUIRE(buffers >= 3);
+
+    std::remove(input_file_name);
+}
+
+TEST_CASE("PBF reader doesn't attach source blocks if not all data is read") {
+    write_input_file();
+
+    SECTION("option not set") {
+        osmium::io::Reader reader{input_file_name};
+        const osmium::memory::Buffer buffer = reader.read();
+        REQUIRE(buffer);
+        REQUIRE_FALSE(buffer.get_source_block());
+    }
+
+    SECTION("without metadata") {
+        osmium::io::Reader reader{input_file_name, osmium::io::keep_source_blocks::yes, osmium::io::read_meta::no};
+        const osmium::memory::Buffer buffer = reader.read();
+        REQUIRE(buffer);
+        REQUIRE_FALSE(buffer.get_source_block());
+    }
+
+    SECTION("only some entities") {
+        osmium::io::Reader reader{input_file_name, osmium::io::keep_source_blocks::yes, osmium::osm_entity_bits::node};
+        const osmium::memory::Buffer buffer = reader.read();
+        REQUIRE(buffer);
+        REQUIRE_FALSE(buffer.get_source_block());
+    }
+
+    SECTION("only some fields") {
+        osmium::io::Reader reader{input_file_name, osmium::io::keep_source_blocks::yes, osmium::io::read_fields::locations};
+        const osmium::memory::Buffer buffer = reader.read();
+        REQUIRE(buffer);
+        REQUIRE_FALSE(buffer.get_source_block());
+    }
+
+    std::remove(input_file_name);
+}
+
+TEST_CASE("PBF writer copies unchanged blocks") {
+    write_input_file();
+    const auto original = read_locations(input_file_name);
+
+    {
+        osmium::io::Reader reader{input_file_name, osmium::io::keep_source_blocks::yes};
+        osmium::io::Writer writer{output_file_name, reader.header(), osmium::io::overwrite::allow};
+        int n = 0;
+        while (osmium::memory::Buffer buffer = reader.read()) {
+            // Change the location of the first node in every buffer in
+            // place. For the buffers marked as unchanged this will not
+            // show up in the output, because the original block is
+            // written.
+            for (auto& node : buffer.select<osmium::Node>()) {
+                node.set_location(osmium::Location{0.0, 0.0});
+                break;
+            }
+            if (n % 2 == 0) {
+                buffer.mark_unchanged();
+            }
+            ++n;
+            writer(std::move(buffer));
+        }
+        writer.close();
+        reader.close();
+    }
+
+    const auto result = read_locations(output_file_name);
+    REQUIRE(result.size() == original.size());
+
+    std::size_t changed = 0;
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        if (result[i] != original[i]) {
+            REQUIRE(result[i] == osmium::Location(0.0, 0.0));
+            ++changed;
+        }
+    }
+    // There are three buffers with nodes, only the changed node in the
+    // second one was written out.
+    REQUIRE(changed == 1);
+
+    std::remove(input_file_name);
+    std::remove(output_file_name);
+}
+
+TEST_CASE("PBF reader records how source blocks were encoded") {
+    write_input_file();
+
+    osmium::io::Reader reader{input_file_name, osmium::io::keep_source_blocks::yes};
+    while (osmium::memory::Buffer buffer = reader.read()) {
+        const auto& encoding = buffer.get_source_block()->encoding;
+        REQUIRE(encoding.get("pbf_compression") == "zlib");
+        REQUIRE(encoding.get("add_metadata") == "all");
+        REQUIRE_FALSE(encoding.is_true("add_visible_flag"));
+        if (buffer.get_source_block()->first_type == osmium::item_type::node) {
+            REQUIRE(encoding.is_true("pbf_dense_nodes"));
+            REQUIRE(encoding.get("locations_on_ways").empty());
+        } else {
+            REQUIRE(encoding.get("pbf_dense_nodes").empty());
+            REQUIRE(encoding.get("locations_on_ways") == "false");
+        }
+    }
+    reader.close();
+
+    std::remove(input_file_name);
+}
+
+// Copy the input file marking all buffers as unchanged after changing the
+// location of the first node in each of them. Returns the number of
+// changed locations in the output.
+static std::size_t copy_unchanged(const osmium::io::File& output_file) {
+    const auto original = read_locations(input_file_name);
+
+    osmium::io::Reader reader{input_file_name, osmium::io::keep_source_blocks::yes};
+    osmium::io::Writer writer{output_file, reader.header(), osmium::io::overwrite::allow};
+    while (osmium::memory::Buffer buffer = reader.read()) {
+        for (auto& node : buffer.select<osmium::Node>()) {
+            node.set_location(osmium::Location{0.0, 0.0});
+            break;
+        }
+        buffer.mark_unchanged();
+        writer(std::move(buffer));
+    }
+    writer.close();
+    reader.close();
+
+    const auto result = read_locations(output_file_name);
+    REQUIRE(result.size() == original.size());
+
+    std::size_t changed = 0;
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        if (result[i] != original[i]) {
+            ++changed;
+        }
+    }
+    return changed;
+}
+
+static osmium::Options output_encoding() {
+    osmium::io::Reader reader{output_file_name, osmium::io::keep_source_blocks::yes};
+    osmium::Options encoding;
+    while (osmium::memory::Buffer buffer = reader.read()) {
+        for (const auto& option : buffer.get_source_block()->encoding) {
+            encoding.set(option.first, option.second);
+        }
+    }
+    reader.close();
+    return encoding;
+}
+
+TEST_CASE("PBF writer copies unchanged blocks only if encoded the same way") {
+    write_input_file();
+
+    SECTION("same options") {
+        REQUIRE(copy_unchanged(osmium::io::File{output_file_name, "pbf,add_metadata=all,pbf_dense_nodes=true"}) == 0);
+    }
+
+    SECTION("different compression") {
+        REQUIRE(copy_unchanged(osmium::io::File{output_file_name, "pbf,pbf_compression=none"}) == 3);
+        REQUIRE(output_encoding().get("pbf_compression") == "none");
+    }
+
+    SECTION("different metadata") {
+        REQUIRE(copy_unchanged(osmium::io::File{output_file_name, "pbf,add_metadata=version+timestamp"}) == 3);
+        REQUIRE(output_encoding().get("add_metadata") == "version+timestamp");
+    }
+
+    SECTION("without dense nodes") {
+        REQUIRE(copy_unchanged(osmium::io::File{output_file_name, "pbf,pbf_dense_nodes=false"}) == 3);
+        REQUIRE(output_encoding().get("pbf_dense_nodes") == "false");
+    }
+
+    SECTION("with locations on ways") {
+        // This only affects the blocks with ways, blocks with nodes are
+        // still copied.
+        REQUIRE(copy_unchanged(osmium::io::File{output_file_name, "pbf,locations_on_ways=true"}) == 0);
+        REQUIRE(output_encoding().get("locations_on_ways") == "true");
+    }
+
+    SECTION("with history") {
+        REQUIRE(copy_unchanged(osmium::io::File{output_file_name, "osh.pbf"}) == 3);
+        REQUIRE(output_encoding().is_true("add_visible_flag"));
+    }
+
+    std::remove(input_file_name);
+    std::remove(output_file_name);
+}
@@ -0,0 +1,135 @@
+#include "catch.hpp"
+#include "utils.hpp"
+
+#include <osmium/io/detail/read_ahead.hpp>
+#include <osmium/io/detail/read_write.hpp>
+#include <osmium/io/pbf_input.hpp>
+#include <osmium/io/xml_input.hpp>
+#include <osmium/memory/buffer.hpp>
+#include <osmium/osm/object.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <string>
+
+#ifndef _WIN32
+
+static const char* file_name = "test-read-ahead.bin";
+
+static std::string create_file(const std::size_t size) {
+    std::string data;
+    data.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        data += static_cast<char>('a' + (i * 7) % 26);
+    }
+
+    const int fd = osmium::io::detail::open_for_writing(file_name, osmium::io::overwrite::allow);
+    osmium::io::detail::reliable_write(fd, data.data(), data.size());
+    osmium::io::detail::reliable_close(fd);
+
+    return data;
+}
+
+static std::string read_all(const int threads, const std::size_t chunk_size, std::size_t* chunks) {
+    const int fd = osmium::io::detail::open_for_reading(file_name);
+    osmium::io::detail::ReadAhead read_ahead{fd, threads, chunk_size};
+
+    std::string result;
+    *chunks = 0;
+    while (true) {
+        const std::string data{read_ahead.read()};
+        if (data.empty()) {
+            break;
+        }
+        REQUIRE(data.size() <= chunk_size);
+        result += data;
+        ++*chunks;
+    }
+    REQUIRE(read_ahead.read().empty());
+
+    read_ahead.close();
+    osmium::io::detail::reliable_close(fd);
+    return result;
+}
+
+TEST_CASE("Read file with read ahead") {
+    std::size_t chunks = 0;
+
+    SECTION("Size not a multiple of chunk size") {
+        const auto data = create_file(100000);
+        REQUIRE(read_all(4, 4096, &chunks) == data);
+        REQUIRE(chunks == 25);
+    }
+
+    SECTION("Size is a multiple of chunk size") {
+        const auto data = create_file(8192);
+        REQUIRE(read_all(3, 1024, &chunks) == data);
+        REQUIRE(chunks == 8);
+    }
+
+    SECTION("Single thread") {
+        const auto data = create_file(10000);
+        REQUIRE(read_all(1, 1000, &chunks) == data);
+        REQUIRE(chunks == 10);
+    }
+
+    SECTION("Empty file") {
+        create_file(0);
+        REQUIRE(read_all(2, 1024, &chunks).empty());
+        REQUIRE(chunks == 0);
+    }
+
+    std::remove(file_name);
+}
+
+TEST_CASE("Stop read ahead before end of file") {
+    create_file(100000);
+
+    const int fd = osmium::io::detail::open_for_reading(file_name);
+    {
+        osmium::io::detail::ReadAhead read_ahead{fd, 4, 1000};
+        REQUIRE(read_ahead.read().size() == 1000);
+        // destructor must not block although threads are waiting
+    }
+    osmium::io::detail::reliable_close(fd);
+
+    std::remove(file_name);
+}
+
+TEST_CASE("Reader with read ahead threads") {
+    setenv("OSMIUM_READ_AHEAD_THREADS", "3", 1);
+
+    const int fd = osmium::io::detail::open_for_reading(with_data_dir("t/io/data.osm"));
+    REQUIRE(osmium::io::detail::want_read_ahead(fd));
+    osmium::io::detail::reliable_close(fd);
+
+    for (const char* name : {"t/io/data.osm", "t/io/deleted_nodes.osh.pbf"}) {
+        int count_with = 0;
+        {
+            osmium::io::Reader reader{with_data_dir(name)};
+            while (const osmium::memory::Buffer buffer = reader.read()) {
+                count_with += static_cast<int>(std::distance(buffer.select<osmium::OSMObject>().begin(), buffer.select<osmium::OSMObject>().end()));
+            }
+            reader.close();
+        }
+
+        unsetenv("OSMIUM_READ_AHEAD_THREADS");
+        int count_without = 0;
+        {
+            osmium::io::Reader reader{with_data_dir(name)};
+            while (const osmium::memory::Buffer buffer = reader.read()) {
+                count_without += static_cast<int>(std::distance(buffer.select<osmium::OSMObject>().begin(), buffer.select<osmium::OSMObject>().end()));
+            }
+            reader.close();
+        }
+        setenv("OSMIUM_READ_AHEAD_THREADS", "3", 1);
+
+        REQUIRE(count_with > 0);
+        REQUIRE(count_with == count_without);
+    }
+
+    unsetenv("OSMIUM_READ_AHEAD_THREADS");
+}
+
+#endif
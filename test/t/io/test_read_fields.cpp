@@ -0,0 +1,105 @@
+#include "catch.hpp"
+
+#include "utils.hpp"
+
+#include <osmium/io/any_input.hpp>
+#include <osmium/io/reader.hpp>
+#include <osmium/osm/node.hpp>
+#include <osmium/osm/object.hpp>
+#include <osmium/osm/relation.hpp>
+#include <osmium/osm/way.hpp>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+struct object_summary {
+    char type;
+    osmium::object_id_type id;
+    bool has_location;
+    std::size_t tags;
+    std::size_t refs;
+    bool refs_have_locations;
+    std::string user;
+};
+
+std::vector<object_summary> read_summary(const char* filename, osmium::io::read_fields::type fields) {
+    std::vector<object_summary> objects;
+    osmium::io::Reader reader{with_data_dir(filename), fields};
+    while (const auto buffer = reader.read()) {
+        for (const auto& object : buffer.select<osmium::OSMObject>()) {
+            object_summary summary{osmium::item_type_to_char(object.type()), object.id(), false, object.tags().size(), 0, false, object.user()};
+            if (object.type() == osmium::item_type::node) {
+                summary.has_location = static_cast<const osmium::Node&>(object).location().valid();
+            } else if (object.type() == osmium::item_type::way) {
+                const auto& nodes = static_cast<const osmium::Way&>(object).nodes();
+                summary.refs = nodes.size();
+                summary.refs_have_locations = !nodes.empty() && nodes.front().location().valid();
+            } else if (object.type() == osmium::item_type::relation) {
+                summary.refs = static_cast<const osmium::Relation&>(object).members().size();
+            }
+            objects.push_back(summary);
+        }
+    }
+    reader.close();
+    return objects;
+}
+
+void check_fields(const char* filename, osmium::io::read_fields::type fields) {
+    const auto all = read_summary(filename, osmium::io::read_fields::all);
+    const auto some = read_summary(filename, fields);
+
+    REQUIRE(all.size() == some.size());
+    for (std::size_t i = 0; i < all.size(); ++i) {
+        REQUIRE(all[i].type == some[i].type);
+        REQUIRE(all[i].id == some[i].id);
+        REQUIRE(some[i].has_location == ((fields & osmium::io::read_fields::locations) && all[i].has_location));
+        REQUIRE(some[i].tags == ((fields & osmium::io::read_fields::tags) ? all[i].tags : 0));
+        REQUIRE(some[i].refs == ((fields & osmium::io::read_fields::refs) ? all[i].refs : 0));
+        REQUIRE(some[i].refs_have_locations == ((fields & osmium::io::read_fields::locations) && some[i].refs > 0 && all[i].refs_have_locations));
+        REQUIRE(some[i].user == ((fields & osmium::io::read_fields::user) ? all[i].user : std::string{}));
+    }
+}
+
+} // anonymous namespace
+
+TEST_CASE("Read fields operators") {
+    const auto fields = osmium::io::read_fields::locations | osmium::io::read_fields::tags;
+    REQUIRE((fields & osmium::io::read_fields::locations) == osmium::io::read_fields::locations);
+    REQUIRE((fields & osmium::io::read_fields::refs) == osmium::io::read_fields::ids);
+    REQUIRE((~fields & osmium::io::read_fields::all) == (osmium::io::read_fields::refs | osmium::io::read_fields::user));
+}
+
+TEST_CASE("Read only some fields from different formats") {
+    const char* filename = nullptr;
+
+    SECTION("PBF") {
+        filename = "t/io/data_pbf_tags_filter.osm.pbf";
+    }
+
+    SECTION("O5M") {
+        filename = "t/io/data-n5w1r3.osm.o5m";
+    }
+
+    SECTION("OPL") {
+        filename = "t/io/data-n5w1r3.osm.opl";
+    }
+
+    check_fields(filename, osmium::io::read_fields::ids);
+    check_fields(filename, osmium::io::read_fields::locations);
+    check_fields(filename, osmium::io::read_fields::refs);
+    check_fields(filename, osmium::io::read_fields::locations | osmium::io::read_fields::refs);
+    check_fields(filename, osmium::io::read_fields::all & ~osmium::io::read_fields::tags);
+    check_fields(filename, osmium::io::read_fields::all & ~osmium::io::read_fields::user);
+}
+
+TEST_CASE("Read fields with reading everything") {
+    const auto objects = read_summary("t/io/data-n5w1r3.osm.opl", osmium::io::read_fields::all);
+    REQUIRE(objects.size() == 9);
+    REQUIRE(objects[0].has_location);
+    REQUIRE(objects[0].user == "test");
+    REQUIRE(objects[5].tags == 1);
+    REQUIRE(objects[5].refs == 2);
+    REQUIRE(objects[7].refs == 3);
+}
@@ -0,0 +1,150 @@
+#include "catch.hpp"
+
+#include "utils.hpp"
+
+#include <osmium/io/detail/string_table_tags_filter.hpp>
+#include <osmium/io/opl_input.hpp>
+#include <osmium/io/pbf_input.hpp>
+#include <osmium/io/read_tags_filter.hpp>
+#include <osmium/io/reader.hpp>
+#include <osmium/osm/object.hpp>
+#include <osmium/tags/tags_filter.hpp>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+static std::vector<std::string> read_objects(const osmium::io::File& file, const osmium::io::read_tags_filter& tags_filter,
+                                             const osmium::io::read_meta read_metadata = osmium::io::read_meta::yes) {
+    std::vector<std::string> objects;
+    osmium::io::Reader reader{file, tags_filter, read_metadata};
+    while (const auto buffer = reader.read()) {
+        for (const auto& object : buffer.select<osmium::OSMObject>()) {
+            std::string str{osmium::item_type_to_char(object.type())};
+            str += std::to_string(object.id());
+            if (object.type() == osmium::item_type::node) {
+                const auto& location = static_cast<const osmium::Node&>(object).location();
+                str += " x" + std::to_string(location.x());
+            }
+            if (read_metadata == osmium::io::read_meta::yes) {
+                str += " c" + std::to_string(object.changeset());
+            }
+            objects.push_back(str);
+        }
+    }
+    reader.close();
+    return objects;
+}
+
+static osmium::TagsFilter highway_filter() {
+    osmium::TagsFilter filter{false};
+    filter.add_rule(false, "highway", "crossing");
+    filter.add_rule(true, "highway");
+    return filter;
+}
+
+TEST_CASE("String table tags filter gives same results as TagsFilter") {
+    const std::vector<std::string> strings = {"", "highway", "crossing", "primary", "name", "X", "building", "yes", "no"};
+    std::vector<osmium::io::detail::osm_string_len_type> table;
+    for (const auto& str : strings) {
+        table.emplace_back(str.data(), static_cast<osmium::string_size_type>(str.size()));
+    }
+
+    osmium::TagsFilter filter{false};
+    SECTION("some rules") {
+        filter.add_rule(false, "highway", "crossing");
+        filter.add_rule(true, "highway");
+        filter.add_rule(true, osmium::TagMatcher{"building", "no", true});
+    }
+    SECTION("more rules than bits") {
+        for (int i = 0; i < 70; ++i) {
+            filter.add_rule(true, "foo" + std::to_string(i));
+        }
+        filter.add_rule(true, "name", osmium::StringMatcher::prefix{"X"});
+    }
+    SECTION("no rules") {
+        filter.set_default_result(true);
+    }
+
+    osmium::io::detail::string_table_tags_filter st_filter{filter, table};
+    for (uint32_t k = 0; k < strings.size(); ++k) {
+        for (uint32_t v = 0; v < strings.size(); ++v) {
+            const osmium::TagsFilter& f = filter;
+            bool expected = f.default_result();
+            for (const auto& rule : f.rules()) {
+                if (rule.second(strings[k].c_str(), strings[v].c_str())) {
+                    expected = rule.first;
+                    break;
+                }
+            }
+            REQUIRE(st_filter(k, v) == expected);
+        }
+    }
+
+    REQUIRE_THROWS_AS(st_filter(1, 100), std::out_of_range);
+}
+
+/**
+ * t/io/data_pbf_tags_filter.osm.pbf contains a block with DenseNodes and
+ * a group with normal Nodes, some of them tagged, and a block with ways
+ * and a relation. All objects have metadata.
+ */
+TEST_CASE("Read PBF file with tags filter on ways") {
+    const osmium::io::File file{with_data_dir("t/io/data_pbf_tags_filter.osm.pbf")};
+    const auto objects = read_objects(file, osmium::io::read_tags_filter{highway_filter(), osmium::osm_entity_bits::way});
+    const std::vector<std::string> expected = {
+        "n1 x10000000 c10", "n2 x11000000 c11", "n3 x12000000 c12", "n4 x13000000 c13",
+        "n5 x14000000 c14", "n7 x15000000 c15", "n6 x20000000 c20", "n8 x21000000 c21",
+        "w10 c30", "w13 c30", "r20 c40"
+    };
+    REQUIRE(objects == expected);
+}
+
+TEST_CASE("Read PBF file with tags filter on nodes") {
+    const osmium::io::File file{with_data_dir("t/io/data_pbf_tags_filter.osm.pbf")};
+    const osmium::io::read_tags_filter tags_filter{highway_filter(), osmium::osm_entity_bits::node};
+
+    SECTION("with metadata") {
+        const std::vector<std::string> expected = {
+            "n5 x14000000 c14", "n6 x20000000 c20",
+            "w10 c30", "w11 c30", "w12 c30", "w13 c30", "r20 c40"
+        };
+        REQUIRE(read_objects(file, tags_filter) == expected);
+    }
+
+    SECTION("without metadata") {
+        const std::vector<std::string> expected = {
+            "n5 x14000000", "n6 x20000000", "w10", "w11", "w12", "w13", "r20"
+        };
+        REQUIRE(read_objects(file, tags_filter, osmium::io::read_meta::no) == expected);
+    }
+}
+
+TEST_CASE("Read PBF file with tags filter on all objects") {
+    const osmium::io::File file{with_data_dir("t/io/data_pbf_tags_filter.osm.pbf")};
+    osmium::TagsFilter filter{false};
+    filter.add_rule(true, osmium::TagMatcher{osmium::StringMatcher::regex{"^(natural|type)$"}});
+    const auto objects = read_objects(file, osmium::io::read_tags_filter{filter, osmium::osm_entity_bits::nwr});
+    const std::vector<std::string> expected = {"n7 x15000000 c15", "r20 c40"};
+    REQUIRE(objects == expected);
+}
+
+TEST_CASE("Read OPL data with tags filter") {
+    const char* data =
+        "n1 v1 c10 x1 y1\n"
+        "n2 v1 c11 x2 y1 Thighway=crossing\n"
+        "n3 v1 c12 x3 y1 Thighway=stop\n"
+        "w10 v1 c30 Thighway=residential Nn1,n2\n"
+        "w11 v1 c31 Tbuilding=yes Nn1,n3\n";
+    const osmium::io::File file{data, std::strlen(data), "opl"};
+    const auto objects = read_objects(file, osmium::io::read_tags_filter{highway_filter(), osmium::osm_entity_bits::nw});
+    const std::vector<std::string> expected = {"n3 x30000000 c12", "w10 c30"};
+    REQUIRE(objects == expected);
+}
+
+TEST_CASE("Default constructed read_tags_filter does not filter") {
+    const osmium::io::read_tags_filter tags_filter;
+    REQUIRE(tags_filter.filter() == nullptr);
+    REQUIRE(tags_filter.entities() == osmium::osm_entity_bits::nothing);
+    REQUIRE_FALSE(tags_filter.applies_to(osmium::item_type::node));
+}
@@ -9,8 +9,10 @@
 #include <osmium/visitor.hpp>
 
 #include <array>
+#include <cstdlib>
 #include <iterator>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 struct CountHandler : public osmium::handler::Handler {
@@ -385,3 +387,78 @@ TEST_CASE("Reader with single object type per buffer") {
     check_buffer_counts("t/io/data-n5w1r0", {{5, 0, 0}, {0, 1, 0}}, osmium::io::buffers_type::single);
 }
 
+
+namespace {
+
+void check_reader_metrics(const osmium::metrics::Registry& registry) {
+    const auto buffers = registry.counter_value("reader.buffers");
+    REQUIRE(buffers > 0);
+    REQUIRE(registry.counter_value("queue.parser_results.pushes") > buffers);
+    REQUIRE(registry.contains("reader.buffer_bytes"));
+    REQUIRE(registry.contains("reader.parse_us"));
+    REQUIRE(registry.contains("queue.raw_input.pushes"));
+}
+
+} // anonymous namespace
+
+TEST_CASE("Reader can collect metrics") {
+    osmium::metrics::Registry registry;
+
+    SECTION("XML") {
+        osmium::io::Reader reader{with_data_dir("t/io/data.osm"), registry};
+        CountHandler handler;
+        osmium::apply(reader, handler);
+        REQUIRE(handler.count == 1);
+        reader.close();
+        REQUIRE(registry.counter_value("reader.input_chunks") > 0);
+        REQUIRE(registry.counter_value("reader.input_bytes") == reader.file_size());
+        check_reader_metrics(registry);
+    }
+
+    SECTION("PBF") {
+        osmium::io::Reader reader{with_data_dir("t/io/data_pbf_version-1.osm.pbf"), registry};
+        CountHandler handler;
+        osmium::apply(reader, handler);
+        REQUIRE(handler.count == 1);
+        reader.close();
+        REQUIRE(registry.counter_value("reader.pbf_blobs") == 1);
+        REQUIRE(registry.counter_value("reader.input_chunks") == 1);
+        REQUIRE(registry.counter_value("reader.input_bytes") == reader.file_size());
+        check_reader_metrics(registry);
+    }
+}
+
+#ifndef _WIN32
+
+TEST_CASE("Reader records each PBF buffer once in metrics") {
+    const char* env = std::getenv("OSMIUM_USE_POOL_THREADS_FOR_PBF_PARSING");
+    const std::string old_value{env ? env : ""};
+
+    for (const char* use_pool : {"yes", "no"}) {
+        setenv("OSMIUM_USE_POOL_THREADS_FOR_PBF_PARSING", use_pool, 1);
+
+        osmium::metrics::Registry registry;
+        osmium::io::Reader reader{with_data_dir("t/io/deleted_nodes.osh.pbf"), registry};
+        std::size_t buffers = 0;
+        std::size_t bytes = 0;
+        while (const osmium::memory::Buffer buffer = reader.read()) {
+            ++buffers;
+            bytes += buffer.committed();
+        }
+        reader.close();
+
+        REQUIRE(registry.counter_value("reader.pbf_blobs") == buffers);
+        REQUIRE(registry.counter_value("reader.buffers") == buffers);
+        REQUIRE(registry.histogram("reader.buffer_bytes").count() == buffers);
+        REQUIRE(registry.histogram("reader.buffer_bytes").sum() == bytes);
+        REQUIRE(registry.histogram("reader.parse_us").count() == buffers);
+    }
+
+    if (env) {
+        setenv("OSMIUM_USE_POOL_THREADS_FOR_PBF_PARSING", old_value.c_str(), 1);
+    } else {
+        unsetenv("OSMIUM_USE_POOL_THREADS_FOR_PBF_PARSING");
+    }
+}
+
+#endif
@@ -57,6 +57,23 @@ TEST_CASE("Add zero-length string and longer strings to StringStore") {
     REQUIRE(it == ss.end());
 }
 
+TEST_CASE("Add strings larger than chunk size to StringStore") {
+    osmium::io::detail::StringStore ss{10};
+
+    const std::string large(25, 'x');
+    ss.add("foo");
+    const char* s = ss.add(large.c_str());
+    ss.add("bar");
+    REQUIRE(std::string{s} == large);
+
+    auto it = ss.begin();
+    REQUIRE(std::string{*it++} == "foo");
+    REQUIRE(std::string{*it++} == large);
+    REQUIRE(std::string{*it++} == "bar");
+    REQUIRE(it == ss.end());
+    REQUIRE(ss.get_used_memory() >= 30);
+}
+
 TEST_CASE("Add many strings to StringStore") {
     for (const char* teststring : {"", "a", "abc", "abcd", "abcde"}) {
         osmium::io::detail::StringStore ss{100};
@@ -117,6 +117,29 @@ TEST_CASE("Writer: Successful writes writing items") {
     REQUIRE(buffer_check.select<osmium::OSMObject>().cbegin()->id() == 1);
 }
 
+TEST_CASE("Writer: Successful writes with fsync interval") {
+    const int count = count_fds();
+
+    auto buffer = get_and_check_buffer();
+    const auto num = buffer.select<osmium::OSMObject>().size();
+
+    const std::string filename = "test-writer-out-fsync-interval.osm";
+    osmium::io::Writer writer{filename, osmium::io::overwrite::allow, osmium::io::fsync::yes, osmium::io::fsync_interval{100}};
+    for (const auto& item : buffer) {
+        writer(item);
+        writer.flush();
+    }
+    writer.close();
+
+    REQUIRE(count == count_fds());
+
+    osmium::io::Reader reader_check{filename};
+    const osmium::memory::Buffer buffer_check = reader_check.read();
+    REQUIRE(buffer_check);
+    REQUIRE(buffer_check.select<osmium::OSMObject>().size() == num);
+    REQUIRE(buffer_check.select<osmium::OSMObject>().cbegin()->id() == 1);
+}
+
 TEST_CASE("Writer: Successful writes using output iterator") {
     const int count = count_fds();
 
@@ -227,3 +250,23 @@ TEST_CASE("Writer with user-provided pool with outlier positive number of thread
     REQUIRE(count == count_fds());
 }
 
+
+TEST_CASE("Writer can collect metrics") {
+    osmium::metrics::Registry registry;
+
+    auto buffer = get_buffer();
+    const auto size = buffer.committed();
+
+    const std::string filename = "test-writer-out-metrics.osm";
+    osmium::io::Writer writer{filename, registry, osmium::io::overwrite::allow};
+    writer(std::move(buffer));
+    const auto file_size = writer.close();
+
+    REQUIRE(registry.counter_value("writer.buffers") == 1);
+    REQUIRE(registry.histogram("writer.buffer_bytes").max() == size);
+    REQUIRE(registry.counter_value("writer.output_chunks") > 0);
+    REQUIRE(registry.counter_value("writer.output_bytes") == file_size);
+    REQUIRE(registry.histogram("writer.write_us").count() == registry.counter_value("writer.output_chunks"));
+    REQUIRE(registry.counter_value("queue.raw_output.pops") > 0);
+    REQUIRE(registry.counter_value("queue.raw_output.pops") == registry.counter_value("queue.raw_output.pushes"));
+}
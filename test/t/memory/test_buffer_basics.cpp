@@ -3,7 +3,9 @@
 #include <osmium/memory/buffer.hpp>
 
 #include <array>
+#include <memory>
 #include <stdexcept>
+#include <utility>
 
 TEST_CASE("Buffer basics") {
     osmium::memory::Buffer invalid_buffer1;
@@ -129,3 +131,39 @@ TEST_CASE("Create buffer from existing data with bad alignment fails") {
     REQUIRE_THROWS_AS(l4(), std::invalid_argument);
 }
 
+
+TEST_CASE("Buffer with source block") {
+    osmium::memory::Buffer buffer{1024};
+    REQUIRE_FALSE(buffer.get_source_block());
+    REQUIRE_FALSE(buffer.is_unchanged());
+
+    buffer.mark_unchanged();
+    REQUIRE_FALSE(buffer.is_unchanged());
+
+    auto block = std::make_shared<osmium::memory::source_block>();
+    block->format = "pbf";
+    buffer.set_source_block(block);
+    REQUIRE(buffer.get_source_block() == block);
+    REQUIRE_FALSE(buffer.is_unchanged());
+
+    buffer.mark_unchanged();
+    REQUIRE(buffer.is_unchanged());
+
+    osmium::memory::Buffer moved{std::move(buffer)};
+    REQUIRE(moved.is_unchanged());
+    REQUIRE(moved.get_source_block() == block);
+
+    SECTION("adding data removes mark") {
+        moved.reserve_space(8);
+        REQUIRE_FALSE(moved.is_unchanged());
+        moved.commit();
+        REQUIRE_FALSE(moved.is_unchanged());
+        REQUIRE(moved.get_source_block() == block);
+    }
+
+    SECTION("clearing buffer removes source block") {
+        moved.clear();
+        REQUIRE_FALSE(moved.is_unchanged());
+        REQUIRE_FALSE(moved.get_source_block());
+    }
+}
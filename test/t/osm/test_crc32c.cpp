@@ -0,0 +1,90 @@
+#include "catch.hpp"
+
+#include <osmium/builder/attr.hpp>
+#include <osmium/memory/buffer.hpp>
+#include <osmium/osm/crc.hpp>
+#include <osmium/osm/crc32c.hpp>
+#include <osmium/osm/way.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+TEST_CASE("CRC32C check value") {
+    const char* str = "123456789";
+    REQUIRE(osmium::detail::crc32c_slicing_by_8(0, str, 9) == 0xe3069283);
+    REQUIRE(osmium::detail::crc32c(0, str, 9) == 0xe3069283);
+}
+
+TEST_CASE("CRC32C of nothing") {
+    const osmium::CRC_crc32c crc;
+    REQUIRE(crc.checksum() == 0);
+    REQUIRE(osmium::detail::crc32c(0, "", 0) == 0);
+}
+
+TEST_CASE("CRC32C implementations give the same result for all lengths and alignments") {
+    std::string data;
+    for (int i = 0; i < 300; ++i) {
+        data += static_cast<char>(i * 7 + 3);
+    }
+
+    for (std::size_t offset = 0; offset < 8; ++offset) {
+        for (std::size_t size = 0; size + offset <= data.size(); size += 13) {
+            const uint32_t expected = osmium::detail::crc32c_slicing_by_8(0, data.data() + offset, size);
+            REQUIRE(osmium::detail::crc32c(0, data.data() + offset, size) == expected);
+#ifdef OSMIUM_CRC32C_HARDWARE
+            if (osmium::detail::crc32c_hardware_available()) {
+                REQUIRE(osmium::detail::crc32c_hardware(0, data.data() + offset, size) == expected);
+            }
+#endif
+        }
+    }
+}
+
+TEST_CASE("CRC32C can be calculated incrementally") {
+    const char* str = "The quick brown fox jumps over the lazy dog";
+    const std::size_t len = std::strlen(str);
+
+    osmium::CRC_crc32c crc;
+    crc.process_bytes(str, 10);
+    crc.process_byte(static_cast<unsigned char>(str[10]));
+    crc.process_bytes(str + 11, len - 11);
+
+    REQUIRE(crc.checksum() == 0x22620404);
+    REQUIRE(crc.checksum() == osmium::detail::crc32c(0, str, len));
+}
+
+TEST_CASE("CRC32C of string is the same as byte by byte") {
+    osmium::CRC<osmium::CRC_crc32c> crc32c;
+    crc32c.update_string("foobar");
+
+    osmium::CRC_crc32c bytewise;
+    for (const char c : std::string{"foobar"}) {
+        bytewise.process_byte(static_cast<unsigned char>(c));
+    }
+
+    REQUIRE(crc32c().checksum() == bytewise.checksum());
+}
+
+TEST_CASE("CRC32C of way nodes is the same as node ref by node ref") {
+    using namespace osmium::builder::attr; // NOLINT(google-build-using-namespace)
+
+    osmium::memory::Buffer buffer{1024};
+    osmium::builder::add_way(buffer,
+        _id(17),
+        _node(osmium::NodeRef{1, osmium::Location{1.0, 2.0}}),
+        _node(osmium::NodeRef{2, osmium::Location{-3.5, 4.25}}),
+        _node(3)
+    );
+    const auto& way = buffer.get<osmium::Way>(0);
+
+    osmium::CRC<osmium::CRC_crc32c> batch;
+    batch.update(way.nodes());
+
+    osmium::CRC<osmium::CRC_crc32c> single;
+    for (const auto& node_ref : way.nodes()) {
+        single.update(node_ref);
+    }
+
+    REQUIRE(batch().checksum() == single().checksum());
+}
@@ -6,6 +6,10 @@
 #include <osmium/relations/relations_database.hpp>
 #include <osmium/storage/item_stash.hpp>
 
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
 namespace {
 
 osmium::memory::Buffer fill_buffer() {
@@ -62,6 +66,10 @@ TEST_CASE("Fill member database") {
 
     mdb.prepare_for_lookup();
 
+    REQUIRE(mdb.is_tracked(10));
+    REQUIRE(mdb.is_tracked(14));
+    REQUIRE_FALSE(mdb.is_tracked(15));
+
     int n = 0;
     int match = 0;
     for (const auto& way : buffer.select<osmium::Way>()) {
@@ -101,6 +109,48 @@ TEST_CASE("Fill member database") {
     REQUIRE(mdb.used_memory() > 100);
 }
 
+TEST_CASE("Split member database into shards by id range") {
+    const auto buffer = fill_buffer();
+
+    osmium::ItemStash stash;
+    osmium::relations::RelationsDatabase rdb{stash};
+    osmium::relations::MembersDatabase<osmium::Way> mdb{stash, rdb};
+
+    for (const auto& relation : buffer.select<osmium::Relation>()) {
+        auto handle = rdb.add(relation);
+        int n = 0;
+        for (const auto& member : relation.members()) {
+            mdb.track(handle, member.ref(), n);
+            ++n;
+        }
+    }
+
+    mdb.prepare_for_lookup();
+
+    // Both elements for way 10 must be in the same shard.
+    REQUIRE(mdb.shard_offsets(1) == std::vector<std::size_t>({0, 6}));
+    REQUIRE(mdb.shard_offsets(3) == std::vector<std::size_t>({0, 2, 4, 6}));
+    REQUIRE(mdb.shard_offsets(6) == std::vector<std::size_t>({0, 2, 3, 4, 5, 6}));
+    REQUIRE(mdb.member_id_at(2) == 11);
+
+    REQUIRE(std::distance(mdb.find_in_shard(10, 0, 2).begin(), mdb.find_in_shard(10, 0, 2).end()) == 2);
+    REQUIRE(mdb.find_in_shard(11, 0, 2).empty());
+    REQUIRE_FALSE(mdb.find_in_shard(11, 2, 4).empty());
+
+    int match = 0;
+    for (const auto& way : buffer.select<osmium::Way>()) {
+        const auto range = mdb.find_in_shard(way.id(), 0, mdb.size());
+        const bool added = mdb.add(way, range, [&](osmium::relations::RelationHandle& /*rel_handle*/) {
+            ++match;
+        });
+        REQUIRE(added == (way.id() != 15));
+    }
+
+    REQUIRE(match == 3);
+    REQUIRE(mdb.count().tracked == 0);
+    REQUIRE(mdb.get(12));
+}
+
 TEST_CASE("Member database with duplicate member in relation") {
     using namespace osmium::builder::attr; // NOLINT(google-build-using-namespace)
     osmium::memory::Buffer buffer{1024UL * 1024UL, osmium::memory::Buffer::auto_grow::yes};
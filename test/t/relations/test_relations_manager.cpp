@@ -2,14 +2,17 @@
 
 #include "utils.hpp"
 
+#include <osmium/builder/attr.hpp>
 #include <osmium/io/file.hpp>
 #include <osmium/io/xml_input.hpp>
 #include <osmium/osm/relation.hpp>
 #include <osmium/relations/relations_manager.hpp>
+#include <osmium/thread/pool.hpp>
 #include <osmium/visitor.hpp>
 
 #include <cstdlib>
 #include <iterator>
+#include <vector>
 
 struct EmptyRM : public osmium::relations::RelationsManager<EmptyRM, true, true, true> {
 };
@@ -79,6 +82,12 @@ struct CallbackRM : public osmium::relations::RelationsManager<CallbackRM, true,
 
     std::size_t count_nodes = 0;
 
+    CallbackRM() = default;
+
+    explicit CallbackRM(osmium::ItemStash::storage_type storage) :
+        RelationsManager(storage) {
+    }
+
     static bool new_relation(const osmium::Relation& /*relation*/) noexcept {
         return true;
     }
@@ -111,6 +120,42 @@ struct AnyRM : public osmium::relations::RelationsManager<AnyRM, true, true, tru
     }
 };
 
+struct OrderRM : public osmium::relations::RelationsManager<OrderRM, true, false, false> {
+
+    std::vector<osmium::object_id_type> completed;
+    std::size_t count_not_in_any = 0;
+
+    void complete_relation(const osmium::Relation& relation) {
+        completed.push_back(relation.id());
+    }
+
+    void node_not_in_any_relation(const osmium::Node& /*node*/) noexcept {
+        ++count_not_in_any;
+    }
+
+};
+
+namespace {
+
+osmium::memory::Buffer create_buffer_with_many_nodes(osmium::memory::Buffer& relations) {
+    using namespace osmium::builder::attr; // NOLINT(google-build-using-namespace)
+
+    for (osmium::object_id_type id = 1; id <= 20; ++id) {
+        osmium::builder::add_relation(relations, _id(id),
+            _member(osmium::item_type::node, id * 400, ""),
+            _member(osmium::item_type::node, id * 400 + 1, ""),
+            _member(osmium::item_type::way, id, ""));
+    }
+
+    osmium::memory::Buffer nodes{1024UL * 1024UL, osmium::memory::Buffer::auto_grow::yes};
+    for (osmium::object_id_type id = 1; id <= 10000; ++id) {
+        osmium::builder::add_node(nodes, _id(id));
+    }
+    return nodes;
+}
+
+} // anonymous namespace
+
 TEST_CASE("Use RelationsManager without any overloaded functions in derived class") {
     const osmium::io::File file{with_data_dir("t/relations/data.osm")};
 
@@ -200,6 +245,26 @@ TEST_CASE("Relations manager with callback") {
     REQUIRE(callback_called);
 }
 
+TEST_CASE("Relations manager with stash in temporary file") {
+    const osmium::io::File file{with_data_dir("t/relations/data.osm")};
+
+    CallbackRM manager{osmium::ItemStash::storage_type::tmpfile};
+
+    osmium::relations::read_relations(file, manager);
+
+    REQUIRE(manager.member_nodes_database().size() == 2);
+
+    bool callback_called = false;
+    osmium::io::Reader reader{file};
+    osmium::apply(reader, manager.handler([&](osmium::memory::Buffer&& buffer) {
+        callback_called = true;
+        REQUIRE(std::distance(buffer.begin(), buffer.end()) == 2);
+    }));
+    reader.close();
+    REQUIRE(manager.count_nodes == 2);
+    REQUIRE(callback_called);
+}
+
 TEST_CASE("Relations manager reading buffer without callback") {
     const osmium::io::File file{with_data_dir("t/relations/data.osm")};
 
@@ -221,6 +286,63 @@ TEST_CASE("Relations manager reading buffer without callback") {
     REQUIRE(manager.count_nodes == 2);
 }
 
+TEST_CASE("Relations manager with single pass handler") {
+    const osmium::io::File file{with_data_dir("t/relations/data.osm")};
+
+    CallbackRM manager;
+    auto& handler = manager.single_pass_handler();
+
+    // simulate input with relations first
+    osmium::io::Reader reader_relations{file, osmium::osm_entity_bits::relation};
+    osmium::apply(reader_relations, handler);
+    reader_relations.close();
+
+    osmium::io::Reader reader_nodes_ways{file, osmium::osm_entity_bits::node | osmium::osm_entity_bits::way};
+    osmium::apply(reader_nodes_ways, handler);
+    reader_nodes_ways.close();
+
+    REQUIRE(manager.member_nodes_database().size() == 2);
+
+    auto buffer = manager.read();
+    REQUIRE(std::distance(buffer.begin(), buffer.end()) == 2);
+
+    REQUIRE(manager.count_nodes == 2);
+}
+
+TEST_CASE("Relations manager with single pass handler and relations after nodes") {
+    const osmium::io::File file{with_data_dir("t/relations/data.osm")};
+
+    CallbackRM manager;
+
+    osmium::io::Reader reader{file};
+    REQUIRE_THROWS_AS(osmium::apply(reader, manager.single_pass_handler()), osmium::out_of_order_error);
+    reader.close();
+}
+
+TEST_CASE("Relations manager handling buffers with parallel lookup") {
+    osmium::memory::Buffer relations{1024UL * 1024UL, osmium::memory::Buffer::auto_grow::yes};
+    const auto nodes = create_buffer_with_many_nodes(relations);
+
+    OrderRM manager_serial;
+    osmium::apply(relations, manager_serial);
+    manager_serial.prepare_for_lookup();
+    osmium::apply(nodes, manager_serial.handler());
+
+    osmium::thread::Pool pool{4};
+    OrderRM manager_parallel;
+    osmium::apply(relations, manager_parallel);
+    manager_parallel.prepare_for_lookup();
+    manager_parallel.handle_buffer(nodes, pool);
+    manager_parallel.flush_output();
+
+    REQUIRE(manager_serial.completed.size() == 20);
+    REQUIRE(manager_parallel.completed == manager_serial.completed);
+    REQUIRE(manager_parallel.count_not_in_any == 10000 - 40);
+    REQUIRE(manager_parallel.count_not_in_any == manager_serial.count_not_in_any);
+    REQUIRE(manager_parallel.member_nodes_database().count().tracked == 0);
+    REQUIRE(manager_parallel.member_nodes_database().count().removed == 40);
+}
+
 TEST_CASE("Access members via RelationsManager") {
     EmptyRM manager;
 
@@ -0,0 +1,154 @@
+#include "catch.hpp"
+
+#include <osmium/builder/attr.hpp>
+#include <osmium/memory/buffer.hpp>
+#include <osmium/storage/compact_object_store.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+osmium::memory::Buffer generate_test_data() {
+    using namespace osmium::builder::attr; // NOLINT(google-build-using-namespace)
+
+    osmium::memory::Buffer buffer{1024UL * 1024UL, osmium::memory::Buffer::auto_grow::yes};
+
+    osmium::builder::add_node(buffer,
+        _id(1),
+        _version(3),
+        _cid(42),
+        _timestamp("2020-01-01T00:00:00Z"),
+        _uid(17),
+        _user("foo"),
+        _location(1.5, 2.5),
+        _tag("highway", "crossing")
+    );
+
+    osmium::builder::add_node(buffer,
+        _id(2),
+        _deleted()
+    );
+
+    osmium::builder::add_way(buffer,
+        _id(10),
+        _user("bar"),
+        _tag("highway", "primary"),
+        _tag("name", "Main Street"),
+        _nodes({{1, {1.5, 2.5}}, {2, {1.6, 2.6}}, {3, osmium::Location{}}})
+    );
+
+    osmium::builder::add_relation(buffer,
+        _id(20),
+        _user("foo"),
+        _tag("type", "multipolygon"),
+        _member(osmium::item_type::way, 10, "outer"),
+        _member(osmium::item_type::way, 11, "inner"),
+        _member(osmium::item_type::node, 1, "")
+    );
+
+    return buffer;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Compact object store handle") {
+    const osmium::CompactObjectStore::handle_type handle;
+    REQUIRE_FALSE(handle.valid());
+}
+
+TEST_CASE("Compact object store round trip") {
+    const auto input = generate_test_data();
+
+    osmium::StringPool pool;
+    osmium::CompactObjectStore store{pool};
+    REQUIRE(store.size() == 0);
+
+    std::vector<osmium::CompactObjectStore::handle_type> handles;
+    for (const auto& object : input.select<osmium::OSMObject>()) {
+        handles.push_back(store.add(object));
+        REQUIRE(handles.back().valid());
+    }
+    REQUIRE(store.size() == 4);
+
+    // empty, foo, highway, crossing, bar, primary, name, Main Street,
+    // type, multipolygon, outer, inner
+    REQUIRE(pool.size() == 12);
+
+    REQUIRE(store.type(handles[0]) == osmium::item_type::node);
+    REQUIRE(store.type(handles[2]) == osmium::item_type::way);
+    REQUIRE(store.type(handles[3]) == osmium::item_type::relation);
+    REQUIRE(store.id(handles[2]) == 10);
+
+    osmium::memory::Buffer output{1024UL, osmium::memory::Buffer::auto_grow::yes};
+    auto it = input.select<osmium::OSMObject>().begin();
+    for (const auto handle : handles) {
+        const auto& original = *it++;
+        const osmium::OSMObject& object = store.get(handle, output);
+        REQUIRE(object.type() == original.type());
+        REQUIRE(object.id() == original.id());
+        REQUIRE(object.version() == original.version());
+        REQUIRE(object.changeset() == original.changeset());
+        REQUIRE(object.timestamp() == original.timestamp());
+        REQUIRE(object.uid() == original.uid());
+        REQUIRE(object.visible() == original.visible());
+        REQUIRE(std::string{object.user()} == original.user());
+        REQUIRE(object.tags().size() == original.tags().size());
+        REQUIRE(std::equal(object.tags().cbegin(), object.tags().cend(), original.tags().cbegin()));
+    }
+
+    const auto& node = static_cast<const osmium::Node&>(store.get(handles[0], output));
+    REQUIRE(node.location() == osmium::Location(1.5, 2.5));
+    REQUIRE(std::string{node.get_value_by_key("highway")} == "crossing");
+
+    const auto& way = static_cast<const osmium::Way&>(store.get(handles[2], output));
+    REQUIRE(way.nodes().size() == 3);
+    REQUIRE(way.nodes()[1].ref() == 2);
+    REQUIRE(way.nodes()[1].location() == osmium::Location(1.6, 2.6));
+    REQUIRE_FALSE(way.nodes()[2].location().valid());
+
+    const auto& relation = static_cast<const osmium::Relation&>(store.get(handles[3], output));
+    REQUIRE(relation.members().size() == 3);
+    auto mit = relation.members().begin();
+    REQUIRE(mit->type() == osmium::item_type::way);
+    REQUIRE(mit->ref() == 10);
+    REQUIRE(std::string{mit->role()} == "outer");
+    ++mit;
+    REQUIRE(std::string{mit->role()} == "inner");
+    ++mit;
+    REQUIRE(mit->type() == osmium::item_type::node);
+    REQUIRE(std::string{mit->role()}.empty());
+
+    store.clear();
+    REQUIRE(store.size() == 0);
+    REQUIRE(pool.size() == 12);
+}
+
+TEST_CASE("Compact object stores can share a string pool") {
+    const auto input = generate_test_data();
+
+    osmium::StringPool pool;
+    osmium::CompactObjectStore store1{pool};
+    osmium::CompactObjectStore store2{pool};
+
+    for (const auto& object : input.select<osmium::OSMObject>()) {
+        store1.add(object);
+        store2.add(object);
+    }
+
+    REQUIRE(pool.size() == 12);
+    REQUIRE(store1.used_memory() == store2.used_memory());
+}
+
+TEST_CASE("Compact object store only stores nodes, ways, and relations") {
+    using namespace osmium::builder::attr; // NOLINT(google-build-using-namespace)
+
+    osmium::memory::Buffer buffer{1024UL, osmium::memory::Buffer::auto_grow::yes};
+    osmium::builder::add_area(buffer, _id(2));
+
+    osmium::StringPool pool;
+    osmium::CompactObjectStore store{pool};
+    REQUIRE_THROWS_AS(store.add(buffer.get<osmium::OSMObject>(0)), std::invalid_argument);
+}
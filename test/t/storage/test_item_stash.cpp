@@ -169,3 +169,56 @@ TEST_CASE("Fill item stash until it garbage collects") {
     REQUIRE(stash.count_removed() == 0);
 }
 
+
+TEST_CASE("Item stash in temporary file") {
+    const auto buffer = generate_test_data();
+
+    osmium::ItemStash stash{osmium::ItemStash::storage_type::tmpfile};
+    REQUIRE(stash.storage() == osmium::ItemStash::storage_type::tmpfile);
+    REQUIRE(stash.size() == 0);
+
+    const auto& node = buffer.get<osmium::Node>(0);
+
+    // add enough items so that the mapping has to grow several times
+    std::vector<osmium::ItemStash::handle_type> handles;
+    const std::size_t num_items = 200UL * 1000UL;
+    for (std::size_t i = 0; i < num_items; ++i) {
+        handles.push_back(stash.add_item(node));
+    }
+
+    REQUIRE(stash.size() == num_items);
+    REQUIRE(stash.used_memory() > num_items * node.padded_size());
+
+    for (const auto handle : handles) {
+        REQUIRE(stash.get<osmium::Node>(handle).id() == 1);
+    }
+
+    for (std::size_t i = 0; i < num_items; ++i) {
+        if (i % 2 != 0) {
+            stash.remove_item(handles[i]);
+            handles[i] = osmium::ItemStash::handle_type{};
+        }
+    }
+
+    stash.garbage_collect();
+    REQUIRE(stash.size() == num_items / 2);
+    REQUIRE(stash.count_removed() == 0);
+
+    for (const auto handle : handles) {
+        if (handle.valid()) {
+            REQUIRE(stash.get<osmium::Node>(handle).id() == 1);
+        }
+    }
+
+    const auto& way = buffer.get<osmium::Way>(100 * node.padded_size());
+    const auto handle = stash.add_item(way);
+    REQUIRE(stash.get<osmium::Way>(handle).id() == 101);
+
+    stash.clear();
+    REQUIRE(stash.size() == 0);
+}
+
+TEST_CASE("Item stash in memory reports its storage type") {
+    const osmium::ItemStash stash;
+    REQUIRE(stash.storage() == osmium::ItemStash::storage_type::memory);
+}
@@ -0,0 +1,63 @@
+#include "catch.hpp"
+
+#include <osmium/storage/string_pool.hpp>
+
+#include <cstring>
+#include <string>
+
+TEST_CASE("Empty string pool contains the empty string") {
+    const osmium::StringPool pool;
+    REQUIRE(pool.size() == 1);
+    REQUIRE(std::strcmp(pool.get(0), "") == 0);
+
+    osmium::StringPool::id_type id = 99;
+    REQUIRE(pool.find("", &id));
+    REQUIRE(id == 0);
+    REQUIRE_FALSE(pool.find("foo", &id));
+}
+
+TEST_CASE("Strings are interned in string pool") {
+    osmium::StringPool pool;
+
+    const auto highway = pool.add("highway");
+    const auto primary = pool.add("primary");
+    REQUIRE(highway == 1);
+    REQUIRE(primary == 2);
+    REQUIRE(pool.add("highway") == highway);
+    REQUIRE(pool.add(std::string{"primary"}) == primary);
+    REQUIRE(pool.add("") == 0);
+    REQUIRE(pool.size() == 3);
+
+    REQUIRE(std::strcmp(pool[highway], "highway") == 0);
+    REQUIRE(std::strcmp(pool[primary], "primary") == 0);
+
+    osmium::StringPool::id_type id = 0;
+    REQUIRE(pool.find("primary", &id));
+    REQUIRE(id == primary);
+
+    pool.clear();
+    REQUIRE(pool.size() == 1);
+    REQUIRE_FALSE(pool.find("primary", &id));
+}
+
+TEST_CASE("String pool with small chunks keeps pointers valid") {
+    osmium::StringPool pool{16};
+
+    const std::string long_string(100, 'x');
+    const auto a = pool.add("abcdefgh");
+    const char* a_ptr = pool.get(a);
+    const auto l = pool.add(long_string);
+    const auto b = pool.add("ijklmnop");
+
+    for (int i = 0; i < 1000; ++i) {
+        pool.add(std::to_string(i));
+    }
+
+    REQUIRE(pool.size() == 1004);
+    REQUIRE(pool.get(a) == a_ptr);
+    REQUIRE(std::strcmp(pool.get(a), "abcdefgh") == 0);
+    REQUIRE(pool.get(l) == long_string);
+    REQUIRE(std::strcmp(pool.get(b), "ijklmnop") == 0);
+    REQUIRE(pool.add("500") == 504);
+    REQUIRE(pool.used_memory() > 1000);
+}
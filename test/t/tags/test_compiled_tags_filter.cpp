@@ -0,0 +1,106 @@
+#include "catch.hpp"
+
+#include <osmium/builder/attr.hpp>
+#include <osmium/memory/buffer.hpp>
+#include <osmium/osm/tag.hpp>
+#include <osmium/tags/compiled_tags_filter.hpp>
+#include <osmium/tags/tags_filter.hpp>
+#include <osmium/util/string_matcher.hpp>
+
+#include <iterator>
+#include <regex>
+#include <string>
+#include <vector>
+
+TEST_CASE("String lookup table") {
+    const osmium::detail::string_lookup_table empty_table;
+    REQUIRE(empty_table.empty());
+    REQUIRE(empty_table.find("foo") == osmium::detail::string_lookup_table::not_found);
+
+    const osmium::detail::string_lookup_table table{{{"highway", 1}, {"name", 2}, {"", 3}, {"building", 4}}};
+    REQUIRE(table.size() == 4);
+    REQUIRE(table.find("highway") == 1);
+    REQUIRE(table.find("name") == 2);
+    REQUIRE(table.find("") == 3);
+    REQUIRE(table.find("building") == 4);
+    REQUIRE(table.find("high") == osmium::detail::string_lookup_table::not_found);
+    REQUIRE(table.find("highways") == osmium::detail::string_lookup_table::not_found);
+}
+
+TEST_CASE("Compiled tags filter with first match semantics") {
+    osmium::TagsFilter filter{false};
+    filter.add_rule(false, "highway", "motorway");
+    filter.add_rule(true, "highway");
+    filter.add_rule(true, osmium::StringMatcher::prefix{"addr:"});
+    filter.add_rule(false, "building", "no");
+    filter.add_rule(true, "building", osmium::StringMatcher::list{{"yes", "house"}});
+    filter.add_rule(true, "landuse", "forest", true);
+
+    const osmium::CompiledTagsFilter compiled{filter};
+    REQUIRE(compiled.count() == 6);
+    REQUIRE_FALSE(compiled.empty());
+
+    REQUIRE_FALSE(compiled("highway", "motorway"));
+    REQUIRE(compiled("highway", "primary"));
+    REQUIRE(compiled("addr:street", "Main Street"));
+    REQUIRE_FALSE(compiled("building", "no"));
+    REQUIRE(compiled("building", "house"));
+    REQUIRE_FALSE(compiled("building", "garage"));
+    REQUIRE_FALSE(compiled("landuse", "forest"));
+    REQUIRE(compiled("landuse", "meadow"));
+    REQUIRE_FALSE(compiled("name", "foo"));
+}
+
+TEST_CASE("Compiled tags filter as iterator filter") {
+    osmium::memory::Buffer buffer{10240};
+
+    const auto pos = osmium::builder::add_tag_list(buffer,
+        osmium::builder::attr::_tags({
+            { "highway", "primary" },
+            { "name", "Main Street" },
+            { "source", "GPS" }
+    }));
+    const osmium::TagList& tag_list = buffer.get<osmium::TagList>(pos);
+
+    osmium::TagsFilter filter;
+    filter.add_rule(true, "highway");
+    filter.add_rule(true, "source");
+    const osmium::CompiledTagsFilter compiled{filter};
+
+    const osmium::CompiledTagsFilter::iterator begin{compiled, tag_list.begin(), tag_list.end()};
+    const osmium::CompiledTagsFilter::iterator end{compiled, tag_list.end(), tag_list.end()};
+    REQUIRE(std::distance(begin, end) == 2);
+}
+
+TEST_CASE("Compiled tags filter gives same results as original filter") {
+    const std::vector<std::string> keys = {"highway", "building", "name", "addr:street", "amenity", "landuse", "source", ""};
+    const std::vector<std::string> values = {"yes", "no", "primary", "residential", "forest", "house", "restaurant", ""};
+
+    osmium::TagsFilterBase<int> filter{-1};
+    int result = 0;
+    filter.add_rule(result++, "amenity", "restaurant");
+    filter.add_rule(result++, osmium::StringMatcher::always_true{}, "no");
+    filter.add_rule(result++, "highway", osmium::StringMatcher::prefix{"res"});
+    filter.add_rule(result++, "highway", "primary");
+    filter.add_rule(result++, osmium::StringMatcher::list{{"building", "amenity"}}, osmium::StringMatcher::list{{"yes", "house"}});
+    filter.add_rule(result++, osmium::StringMatcher::substring{"addr"});
+    filter.add_rule(result++, "landuse", osmium::StringMatcher::always_false{});
+    filter.add_rule(result++, "landuse", std::regex{"^f"});
+    filter.add_rule(result++, "name", osmium::StringMatcher::always_false{}, true);
+    filter.add_rule(result++, "highway");
+    filter.add_rule(result++, "source", "", true);
+    filter.add_rule(result++, osmium::StringMatcher::always_false{});
+    filter.add_rule(result++, "", "");
+
+    const osmium::CompiledTagsFilterBase<int> compiled{filter};
+
+    for (const auto& key : keys) {
+        for (const auto& value : values) {
+            INFO(key << '=' << value);
+            osmium::memory::Buffer buffer{1024};
+            const auto pos = osmium::builder::add_tag_list(buffer, osmium::builder::attr::_tag(key, value));
+            const auto& tag = *buffer.get<osmium::TagList>(pos).begin();
+            REQUIRE(compiled(tag) == filter(tag));
+        }
+    }
+}
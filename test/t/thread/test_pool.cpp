@@ -104,3 +104,18 @@ TEST_CASE("can throw from job in user provided thread pool") {
     REQUIRE_THROWS_AS(future.get(), std::runtime_error);
 }
 
+
+TEST_CASE("user provided thread pool can collect metrics") {
+    osmium::metrics::Registry registry;
+    {
+        osmium::thread::Pool pool{3, 0, &registry};
+        auto future1 = pool.submit(test_job_with_result{});
+        auto future2 = pool.submit(test_job_with_result{});
+        REQUIRE(future1.get() == 42);
+        REQUIRE(future2.get() == 42);
+    }
+    REQUIRE(registry.counter_value("pool.threads") == 3);
+    REQUIRE(registry.counter_value("pool.tasks") == 2);
+    REQUIRE(registry.histogram("pool.task_us").count() == 2);
+    REQUIRE(registry.counter_value("queue.work.pushes") == 5); // including shutdown
+}
@@ -45,3 +45,25 @@ TEST_CASE("When queue is shut down, nothing goes in or out") {
     queue.wait_and_pop(value);
     REQUIRE(value.empty());
 }
+
+TEST_CASE("Queue collects metrics") {
+    osmium::metrics::Registry registry;
+    osmium::thread::Queue<int> queue{10, "test", &registry};
+
+    queue.push(1);
+    queue.push(2);
+    int value = 0;
+    queue.wait_and_pop(value);
+    REQUIRE(value == 1);
+    REQUIRE(queue.try_pop(value));
+    REQUIRE(value == 2);
+    REQUIRE_FALSE(queue.try_pop(value));
+
+    REQUIRE(registry.counter_value("queue.test.pushes") == 2);
+    REQUIRE(registry.counter_value("queue.test.pops") == 2);
+    REQUIRE(registry.counter_value("queue.test.empty") == 0);
+    REQUIRE(registry.counter_value("queue.test.empty_polls") == 1);
+    REQUIRE(registry.counter_value("queue.test.full") == 0);
+    REQUIRE(registry.histogram("queue.test.size").count() == 2);
+    REQUIRE(registry.histogram("queue.test.size").max() == 2);
+}
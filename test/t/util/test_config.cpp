@@ -82,3 +82,20 @@ TEST_CASE("get_max_queue_size") {
     REQUIRE(osmium::config::get_max_queue_size("NAME", 7) == 3);
 }
 
+
+TEST_CASE("get_read_ahead_threads") {
+    osmium::detail::env = nullptr;
+    REQUIRE(osmium::config::get_read_ahead_threads() == 0);
+    REQUIRE(osmium::detail::name == "OSMIUM_READ_AHEAD_THREADS");
+
+    osmium::detail::env = "";
+    REQUIRE(osmium::config::get_read_ahead_threads() == 0);
+    osmium::detail::env = "x";
+    REQUIRE(osmium::config::get_read_ahead_threads() == 0);
+    osmium::detail::env = "-2";
+    REQUIRE(osmium::config::get_read_ahead_threads() == 0);
+    osmium::detail::env = "1000";
+    REQUIRE(osmium::config::get_read_ahead_threads() == 0);
+    osmium::detail::env = "4";
+    REQUIRE(osmium::config::get_read_ahead_threads() == 4);
+}
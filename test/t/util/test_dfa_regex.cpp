@@ -0,0 +1,85 @@
+#include "catch.hpp"
+
+#include <osmium/util/dfa_regex.hpp>
+#include <osmium/util/string_matcher.hpp>
+
+#include <regex>
+#include <string>
+#include <vector>
+
+static bool same_as_std_regex(const std::string& pattern, const std::vector<std::string>& strings) {
+    const osmium::DFARegex dfa{pattern};
+    const std::regex re{pattern};
+    for (const auto& s : strings) {
+        if (dfa.search(s.c_str()) != std::regex_search(s, re)) {
+            UNSCOPED_INFO("pattern '" << pattern << "' string '" << s << "'");
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST_CASE("DFARegex gives same results as std::regex") {
+    const std::vector<std::string> strings = {
+        "", "a", "b", "ab", "ba", "abc", "aab", "abab", "foo", "foobar",
+        "barfoo", "Foo", "FOO", "fo", "oof", "foo bar", "foo\nbar", "foo\rbar",
+        "x1", "123", "12a", "a_b", "a-b", "a.b", "a b", "\t", "yes", "no",
+        "residential", "primary_link", "motorway", "name:de", "name:en",
+        "addr:housenumber", "aaaaaaaaaaaaaaaaaaaaaaaaaaaab", "a{b}", "a+b",
+        "\xc3\xa4", "x\xc3\xa4x"
+    };
+
+    const std::vector<std::string> patterns = {
+        "a", "^a", "a$", "^a$", "^$", "", "ab|ba", "^(ab|ba)$", "a*", "^a*$",
+        "^a+b$", "^a?b", "(ab)+", "^(ab)+$", "[abc]", "^[a-c]+$", "[^a]",
+        "^[^ab]*$", "^.$", "^...$", "^.*$", "foo", "^foo", "foo$", "^foo$",
+        "fo+", "^f.o$", "\\d", "^\\d+$", "\\D", "\\w+", "^\\w+$", "\\W",
+        "\\s", "\\S", "^[\\w-]+$", "^name:", "^name:(de|en)$", "_link$",
+        "^(motorway|primary|secondary)(_link)?$", "a{2}", "^a{2,}b$",
+        "^a{1,3}b$", "^(a|b){2}$", "\\.", "a\\.b", "\\+", "\\{", "[.]",
+        "^[0-9]{2,3}$", "(?:ab)+", "^(?:yes|no)$", "a|", "|a", "()", "^()$",
+        "(a*)*b", "^(a|ab)(c|bcd)?$", "x\xc3\xa4", "[\\t ]", "\\x41|\\x61",
+        "\\n", "bar$", "^[^\\d]+$", "[a\\-]b"
+    };
+
+    for (const auto& pattern : patterns) {
+        REQUIRE(same_as_std_regex(pattern, strings));
+    }
+}
+
+TEST_CASE("DFARegex throws on unsupported features") {
+    REQUIRE_THROWS_AS(osmium::DFARegex{"\\bfoo"}, osmium::unsupported_regex_error);
+    REQUIRE_THROWS_AS(osmium::DFARegex{"(a)\\1"}, osmium::unsupported_regex_error);
+    REQUIRE_THROWS_AS(osmium::DFARegex{"a(?=b)"}, osmium::unsupported_regex_error);
+    REQUIRE_THROWS_AS(osmium::DFARegex{"[[:alpha:]]"}, osmium::unsupported_regex_error);
+    REQUIRE_THROWS_AS(osmium::DFARegex{"(a"}, osmium::unsupported_regex_error);
+}
+
+TEST_CASE("DFARegex has a limited number of states") {
+    REQUIRE_THROWS_AS(osmium::DFARegex{"a.{20}$"}, osmium::unsupported_regex_error);
+}
+
+TEST_CASE("String matcher: regex from pattern uses DFARegex") {
+    const osmium::StringMatcher::regex m{"^foo"};
+    REQUIRE(m.uses_dfa());
+    REQUIRE(m.match("foo"));
+    REQUIRE(m.match("foobar"));
+    REQUIRE_FALSE(m.match("barfoo"));
+}
+
+TEST_CASE("String matcher: regex from pattern falls back to std::regex") {
+    const osmium::StringMatcher::regex m{"\\bfoo\\b"};
+    REQUIRE_FALSE(m.uses_dfa());
+    REQUIRE(m.match("a foo b"));
+    REQUIRE_FALSE(m.match("afoob"));
+}
+
+TEST_CASE("String matcher: regex from pattern with flags uses std::regex") {
+    const osmium::StringMatcher::regex m{"^foo", std::regex::ECMAScript | std::regex::icase};
+    REQUIRE_FALSE(m.uses_dfa());
+    REQUIRE(m.match("FOO"));
+}
+
+TEST_CASE("String matcher: regex from invalid pattern throws") {
+    REQUIRE_THROWS_AS(osmium::StringMatcher::regex{"(a"}, std::regex_error);
+}
@@ -30,3 +30,48 @@ TEST_CASE("Check double2string function") {
     REQUIRE(s6 == "-0");
 }
 
+TEST_CASE("Check double2string function rounding") {
+    std::string s1;
+    osmium::double2string(s1, 0.125, 2);
+    REQUIRE(s1 == "0.12");
+
+    std::string s2;
+    osmium::double2string(s2, 0.375, 2);
+    REQUIRE(s2 == "0.38");
+
+    std::string s3;
+    osmium::double2string(s3, 2.675, 2); // actually 2.67499999...
+    REQUIRE(s3 == "2.67");
+
+    std::string s4;
+    osmium::double2string(s4, -179.99999996, 7);
+    REQUIRE(s4 == "-180");
+
+    std::string s5;
+    osmium::double2string(s5, -0.00000001, 7);
+    REQUIRE(s5 == "-0");
+
+    std::string s6;
+    osmium::double2string(s6, 123456789.123, 3);
+    REQUIRE(s6 == "123456789.123");
+}
+
+TEST_CASE("Check double2string function with precision 0") {
+    std::string s1;
+    osmium::double2string(s1, 160.4, 0);
+    REQUIRE(s1 == "160");
+
+    std::string s2;
+    osmium::double2string(s2, 2.5, 0);
+    REQUIRE(s2 == "2");
+}
+
+TEST_CASE("Check double2string function with values not handled by fast path") {
+    std::string s1;
+    osmium::double2string(s1, 1.5, 16);
+    REQUIRE(s1 == "1.5");
+
+    std::string s2;
+    osmium::double2string(s2, 1e16, 1);
+    REQUIRE(s2 == "10000000000000000");
+}
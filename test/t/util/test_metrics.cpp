@@ -0,0 +1,117 @@
+#include "catch.hpp"
+
+#include <osmium/util/metrics.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Metrics counter") {
+    osmium::metrics::Counter counter;
+    REQUIRE(counter.value() == 0);
+    counter.add();
+    counter.add(10);
+    REQUIRE(counter.value() == 11);
+    counter.reset();
+    REQUIRE(counter.value() == 0);
+}
+
+TEST_CASE("Metrics counter can be used from several threads") {
+    osmium::metrics::Counter counter;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&counter]() {
+            for (int j = 0; j < 1000; ++j) {
+                counter.add();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    REQUIRE(counter.value() == 4000);
+}
+
+TEST_CASE("Metrics histogram buckets") {
+    REQUIRE(osmium::metrics::Histogram::bucket_for(0) == 0);
+    REQUIRE(osmium::metrics::Histogram::bucket_for(1) == 1);
+    REQUIRE(osmium::metrics::Histogram::bucket_for(2) == 2);
+    REQUIRE(osmium::metrics::Histogram::bucket_for(3) == 2);
+    REQUIRE(osmium::metrics::Histogram::bucket_for(4) == 3);
+    REQUIRE(osmium::metrics::Histogram::bucket_for(~uint64_t{0}) == 64);
+
+    REQUIRE(osmium::metrics::Histogram::bucket_upper_bound(0) == 0);
+    REQUIRE(osmium::metrics::Histogram::bucket_upper_bound(1) == 1);
+    REQUIRE(osmium::metrics::Histogram::bucket_upper_bound(3) == 7);
+    REQUIRE(osmium::metrics::Histogram::bucket_upper_bound(64) == ~uint64_t{0});
+}
+
+TEST_CASE("Metrics histogram") {
+    osmium::metrics::Histogram histogram;
+    REQUIRE(histogram.count() == 0);
+    REQUIRE(histogram.mean() == Approx(0.0));
+    REQUIRE(histogram.percentile(50) == 0);
+
+    for (uint64_t i = 1; i <= 100; ++i) {
+        histogram.record(i);
+    }
+
+    REQUIRE(histogram.count() == 100);
+    REQUIRE(histogram.sum() == 5050);
+    REQUIRE(histogram.max() == 100);
+    REQUIRE(histogram.mean() == Approx(50.5));
+    REQUIRE(histogram.bucket(1) == 1);
+    REQUIRE(histogram.bucket(7) == 37); // 64 - 100
+    REQUIRE(histogram.percentile(50) == 63);
+    REQUIRE(histogram.percentile(100) == 100);
+
+    histogram.reset();
+    REQUIRE(histogram.count() == 0);
+    REQUIRE(histogram.max() == 0);
+}
+
+TEST_CASE("Metrics registry") {
+    osmium::metrics::Registry registry;
+    REQUIRE_FALSE(registry.contains("foo"));
+    REQUIRE(registry.counter_value("foo") == 0);
+
+    registry.counter("foo").add(3);
+    REQUIRE(registry.contains("foo"));
+    REQUIRE(registry.counter_value("foo") == 3);
+
+    auto counter = registry.shared_counter("foo");
+    counter->add();
+    REQUIRE(registry.counter("foo").value() == 4);
+
+    registry.histogram("bar").record(5);
+    REQUIRE(registry.shared_histogram("bar")->count() == 1);
+
+    REQUIRE(registry.to_json() == R"({"counters":{"foo":4},"histograms":{"bar":{"count":1,"sum":5,"mean":5,"max":5,"p50":5,"p90":5,"p99":5}}})");
+
+    registry.reset();
+    REQUIRE(registry.counter_value("foo") == 0);
+    REQUIRE(registry.to_json() == R"({"counters":{"foo":0},"histograms":{"bar":{"count":0,"sum":0,"mean":0,"max":0,"p50":0,"p90":0,"p99":0}}})");
+}
+
+TEST_CASE("Metrics registry escapes names in JSON") {
+    osmium::metrics::Registry registry;
+    registry.counter("a\"b\\c").add();
+    REQUIRE(registry.to_json() == R"({"counters":{"a\"b\\c":1},"histograms":{}})");
+}
+
+TEST_CASE("Metrics registry escapes control characters in JSON") {
+    osmium::metrics::Registry registry;
+    registry.counter(std::string{"a\nb\x1f\0c", 6}).add();
+    REQUIRE(registry.to_json() == R"({"counters":{"a\u000ab\u001f\u0000c":1},"histograms":{}})");
+}
+
+TEST_CASE("Find metrics registry in options") {
+    osmium::metrics::Registry registry;
+    const int i = 1;
+    const std::string s;
+
+    REQUIRE(osmium::metrics::detail::find_registry() == nullptr);
+    REQUIRE(osmium::metrics::detail::find_registry(i, s) == nullptr);
+    REQUIRE(osmium::metrics::detail::find_registry(registry) == &registry);
+    REQUIRE(osmium::metrics::detail::find_registry(i, registry, s) == &registry);
+}